@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "benchcorpus.h"
+
+#include <cmath>
+
+#include <QDir>
+
+namespace {
+
+struct CjkWord
+{
+    const char *text;
+    const char *pinyin;
+    const char *acronym;
+};
+
+// 常见办公文件名用词，拼音与首字母直接给出，避免依赖拼音转换
+constexpr CjkWord kCjkWords[] = {
+    { "报告", "baogao", "bg" }, { "会议", "huiyi", "hy" }, { "项目", "xiangmu", "xm" },
+    { "预算", "yusuan", "ys" }, { "合同", "hetong", "ht" }, { "计划", "jihua", "jh" },
+    { "总结", "zongjie", "zj" }, { "设计", "sheji", "sj" }, { "方案", "fangan", "fa" },
+    { "照片", "zhaopian", "zp" }, { "发票", "fapiao", "fp" }, { "简历", "jianli", "jl" },
+    { "笔记", "biji", "bj" }, { "测试", "ceshi", "cs" }, { "需求", "xuqiu", "xq" },
+    { "周报", "zhoubao", "zb" }, { "财务", "caiwu", "cw" }, { "数据", "shuju", "sj" },
+    { "分析", "fenxi", "fx" }, { "文档", "wendang", "wd" }, { "截图", "jietu", "jt" },
+    { "资料", "ziliao", "zl" }, { "工作", "gongzuo", "gz" }, { "学习", "xuexi", "xx" },
+    { "旅行", "lvxing", "lx" }, { "说明", "shuoming", "sm" }, { "客户", "kehu", "kh" },
+    { "产品", "chanpin", "cp" }, { "季度", "jidu", "jd" }, { "年度", "niandu", "nd" },
+};
+
+constexpr const char *kLatinWords[] = {
+    "report", "meeting", "project", "budget", "contract", "plan", "summary", "design",
+    "draft", "photo", "invoice", "resume", "notes", "test", "spec", "weekly",
+    "finance", "data", "analysis", "document", "screenshot", "archive", "release", "backup",
+    "config", "build", "review", "roadmap", "customer", "product", "quarter", "annual",
+};
+
+struct Extension
+{
+    const char *suffix;
+    const char *fileType;
+    bool text;
+    bool image;
+};
+
+constexpr Extension kExtensions[] = {
+    { "txt", "doc", true, false }, { "md", "doc", true, false }, { "pdf", "doc", true, false },
+    { "docx", "doc", true, false }, { "xlsx", "doc", true, false }, { "pptx", "doc", true, false },
+    { "png", "pic", false, true }, { "jpg", "pic", false, true }, { "zip", "archive", false, false },
+    { "cpp", "other", true, false },
+};
+
+constexpr int kCjkWordCount = sizeof(kCjkWords) / sizeof(kCjkWords[0]);
+constexpr int kLatinWordCount = sizeof(kLatinWords) / sizeof(kLatinWords[0]);
+constexpr int kExtensionCount = sizeof(kExtensions) / sizeof(kExtensions[0]);
+
+constexpr qint64 kSecondsPerDay = 24 * 3600;
+constexpr double kMaxFileSize = 2e9;
+
+// 每个文档独立的小型随机数发生器，构造几乎没有开销，序列不依赖 Qt 版本
+class SplitMix64
+{
+public:
+    explicit SplitMix64(quint64 seed)
+        : m_state(seed) { }
+
+    quint64 next()
+    {
+        quint64 z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double real() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+    int bounded(int n) { return static_cast<int>(next() % static_cast<quint64>(n)); }
+
+private:
+    quint64 m_state;
+};
+
+}   // namespace
+
+QJsonObject BenchCorpusConfig::toJson() const
+{
+    QJsonObject obj;
+    obj["documents"] = documents;
+    obj["treeDocuments"] = treeDocuments;
+    obj["seed"] = static_cast<qint64>(seed);
+    obj["cjkRatio"] = cjkRatio;
+    obj["hiddenRatio"] = hiddenRatio;
+    obj["filesPerDirectory"] = filesPerDirectory;
+    obj["directoryFanOut"] = directoryFanOut;
+    obj["contentWords"] = contentWords;
+    obj["termVectors"] = termVectors;
+    obj["referenceTime"] = referenceTime;
+    return obj;
+}
+
+bool BenchDocument::hasText() const
+{
+    for (const Extension &ext : kExtensions) {
+        if (extension == QLatin1String(ext.suffix))
+            return ext.text;
+    }
+    return false;
+}
+
+bool BenchDocument::isImage() const
+{
+    for (const Extension &ext : kExtensions) {
+        if (extension == QLatin1String(ext.suffix))
+            return ext.image;
+    }
+    return false;
+}
+
+BenchCorpus::BenchCorpus(const QString &rootPath, const BenchCorpusConfig &config)
+    : m_rootPath(QDir::cleanPath(QDir(rootPath).absolutePath())),
+      m_config(config)
+{
+    m_config.filesPerDirectory = qMax(1, m_config.filesPerDirectory);
+    m_config.directoryFanOut = qMax(2, m_config.directoryFanOut);
+
+    QDir dir(m_rootPath);
+    do {
+        m_rootAncestors.append(QDir::cleanPath(dir.absolutePath()));
+    } while (dir.cdUp());
+}
+
+quint64 BenchCorpus::seedFor(qint64 index, quint32 stream) const
+{
+    SplitMix64 mix((static_cast<quint64>(m_config.seed) << 32) ^ static_cast<quint64>(index));
+    return mix.next() ^ (static_cast<quint64>(stream) * 0xD1B54A32D192ED03ULL);
+}
+
+QString BenchCorpus::directoryOf(qint64 index) const
+{
+    // 目录编号按 fanOut 进制展开为固定深度的路径，目录树保持平衡
+    const qint64 directoryCount = qMax<qint64>(1, (m_config.documents + m_config.filesPerDirectory - 1)
+                                                          / m_config.filesPerDirectory);
+    int depth = 1;
+    for (qint64 capacity = m_config.directoryFanOut; capacity < directoryCount; capacity *= m_config.directoryFanOut)
+        ++depth;
+
+    qint64 directory = index / m_config.filesPerDirectory;
+    QStringList parts;
+    for (int level = 0; level < depth; ++level) {
+        const int digit = static_cast<int>(directory % m_config.directoryFanOut);
+        directory /= m_config.directoryFanOut;
+
+        // 奇数位使用中文目录名，路径中同时包含中英文
+        const QString word = digit % 2 ? QString::fromUtf8(kCjkWords[(digit + level) % kCjkWordCount].text)
+                                       : QString::fromLatin1(kLatinWords[(digit + level) % kLatinWordCount]);
+        parts.prepend(QStringLiteral("%1-%2").arg(word).arg(digit, 2, 16, QLatin1Char('0')));
+    }
+    return m_rootPath + QLatin1Char('/') + parts.join(QLatin1Char('/'));
+}
+
+QStringList BenchCorpus::ancestorPaths(qint64 index) const
+{
+    QStringList ancestors;
+    QString dir = directoryOf(index);
+    while (dir.size() > m_rootPath.size()) {
+        ancestors.append(dir);
+        dir.truncate(dir.lastIndexOf(QLatin1Char('/')));
+    }
+    ancestors.append(m_rootAncestors);
+    return ancestors;
+}
+
+BenchDocument BenchCorpus::document(qint64 index) const
+{
+    SplitMix64 rng(seedFor(index, 1));
+
+    BenchDocument doc;
+    const Extension &ext = kExtensions[rng.bounded(kExtensionCount)];
+    doc.extension = QLatin1String(ext.suffix);
+    doc.fileType = QLatin1String(ext.fileType);
+    doc.hidden = rng.real() < m_config.hiddenRatio;
+
+    QStringList nameParts;
+    QStringList pinyinParts;
+    QStringList acronymParts;
+    const int wordCount = 1 + rng.bounded(3);
+    for (int i = 0; i < wordCount; ++i) {
+        if (rng.real() < m_config.cjkRatio) {
+            const CjkWord &word = kCjkWords[rng.bounded(kCjkWordCount)];
+            nameParts.append(QString::fromUtf8(word.text));
+            pinyinParts.append(QLatin1String(word.pinyin));
+            acronymParts.append(QLatin1String(word.acronym));
+        } else {
+            const QString word = QLatin1String(kLatinWords[rng.bounded(kLatinWordCount)]);
+            nameParts.append(word);
+            pinyinParts.append(word);
+            acronymParts.append(word);
+        }
+    }
+
+    // 编号保证同目录下不重名
+    const QString id = QString::number(index, 36);
+    const QString prefix = doc.hidden ? QStringLiteral(".") : QString();
+    doc.fileName = QStringLiteral("%1%2_%3.%4").arg(prefix, nameParts.join(QLatin1Char('_')), id, doc.extension);
+    doc.pinyin = QStringLiteral("%1%2_%3.%4").arg(prefix, pinyinParts.join(QLatin1Char('_')), id, doc.extension);
+    doc.pinyinAcronym = QStringLiteral("%1%2_%3.%4").arg(prefix, acronymParts.join(QLatin1Char('_')), id, doc.extension);
+    doc.path = directoryOf(index) + QLatin1Char('/') + doc.fileName;
+
+    doc.modifyTime = m_config.referenceTime - static_cast<qint64>(rng.real() * 365 * kSecondsPerDay);
+    doc.birthTime = doc.modifyTime - static_cast<qint64>(rng.real() * 30 * kSecondsPerDay);
+    // 大小按对数均匀分布，小文件多、大文件少
+    doc.fileSize = static_cast<qint64>(std::exp(rng.real() * std::log(kMaxFileSize)));
+    return doc;
+}
+
+QString BenchCorpus::content(qint64 index) const
+{
+    SplitMix64 rng(seedFor(index, 2));
+
+    QString text;
+    text.reserve(m_config.contentWords * 6);
+    for (int i = 0; i < m_config.contentWords; ++i) {
+        if (rng.real() < m_config.cjkRatio) {
+            text.append(QString::fromUtf8(kCjkWords[rng.bounded(kCjkWordCount)].text));
+        } else {
+            if (!text.isEmpty())
+                text.append(QLatin1Char(' '));
+            text.append(QLatin1String(kLatinWords[rng.bounded(kLatinWordCount)]));
+        }
+        if (rng.bounded(12) == 0)
+            text.append(QString::fromUtf8("。"));
+    }
+    return text;
+}
+
+QStringList BenchCorpus::latinKeywords()
+{
+    return { QStringLiteral("report"), QStringLiteral("budget"), QStringLiteral("screenshot") };
+}
+
+QStringList BenchCorpus::cjkKeywords()
+{
+    return { QString::fromUtf8("报告"), QString::fromUtf8("会议"), QString::fromUtf8("季度") };
+}
+
+QStringList BenchCorpus::pinyinKeywords()
+{
+    return { QStringLiteral("baogao"), QStringLiteral("huiyi"), QStringLiteral("jidu") };
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef BENCHCORPUS_H
+#define BENCHCORPUS_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 数据集规模与生成参数
+ *
+ * 参数相同则生成的目录树与索引完全相同，便于在不同版本之间对比。
+ */
+struct BenchCorpusConfig
+{
+    qint64 documents = 10000;   // 文件名索引中的文档数
+    qint64 treeDocuments = 10000;   // 实际创建在磁盘上的文件数，实时搜索遍历这部分
+    quint32 seed = 20260101;
+    double cjkRatio = 0.5;   // 名称中使用中文词的比例
+    double hiddenRatio = 0.02;
+    int filesPerDirectory = 64;
+    int directoryFanOut = 16;
+    int contentWords = 120;   // 每个全文/OCR 文档的词数
+    bool termVectors = true;   // 全文字段存储带偏移的词向量，供高亮使用
+    qint64 referenceTime = 0;   // 时间戳基准（秒），修改时间分布在其之前一年内
+
+    QJsonObject toJson() const;
+};
+
+/**
+ * @brief 一个合成文档
+ */
+struct BenchDocument
+{
+    QString path;
+    QString fileName;
+    QString extension;
+    QString fileType;   // 与文件名索引 file_type 字段取值一致
+    QString pinyin;
+    QString pinyinAcronym;
+    bool hidden = false;
+    qint64 modifyTime = 0;   // 秒
+    qint64 birthTime = 0;   // 秒
+    qint64 fileSize = 0;
+
+    bool hasText() const;   // 进入全文索引
+    bool isImage() const;   // 进入 OCR 索引
+};
+
+/**
+ * @brief 可复现的合成语料
+ *
+ * 第 i 个文档只由种子与 i 决定，不需要保存整个数据集，
+ * 生成 5M 文档时内存占用与规模无关。
+ */
+class BenchCorpus
+{
+public:
+    BenchCorpus(const QString &rootPath, const BenchCorpusConfig &config);
+
+    const QString &rootPath() const { return m_rootPath; }
+    const BenchCorpusConfig &config() const { return m_config; }
+
+    BenchDocument document(qint64 index) const;
+
+    /**
+     * @brief 全文/OCR 文档的正文，由词表中的中英文词组成
+     */
+    QString content(qint64 index) const;
+
+    /**
+     * @brief 文档所在目录，与索引中的 ancestor_paths 字段一致
+     */
+    QString directoryOf(qint64 index) const;
+
+    /**
+     * @brief 从根目录到文档所在目录的所有目录（含根目录与其上级）
+     */
+    QStringList ancestorPaths(qint64 index) const;
+
+    // 查询用的词，保证在语料中出现
+    static QStringList latinKeywords();
+    static QStringList cjkKeywords();
+    static QStringList pinyinKeywords();
+
+private:
+    quint64 seedFor(qint64 index, quint32 stream) const;
+
+    QString m_rootPath;
+    BenchCorpusConfig m_config;
+    QStringList m_rootAncestors;
+};
+
+#endif   // BENCHCORPUS_H
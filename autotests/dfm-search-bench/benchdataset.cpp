@@ -0,0 +1,338 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "benchdataset.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <lucene++/LuceneHeaders.h>
+#include <lucene++/FSDirectory.h>
+#include <lucene++/NGramAnalyzer.h>
+#include <lucene++/NumericField.h>
+
+#include <dfm-search/field_names.h>
+
+using namespace Lucene;
+using namespace dfmsearch;
+
+namespace {
+
+constexpr int kManifestVersion = 1;
+constexpr double kRamBufferMB = 128.0;
+
+QString manifestPath(const QString &workDir)
+{
+    return QDir(workDir).filePath(QStringLiteral("manifest.json"));
+}
+
+IndexWriterPtr openWriter(const QString &indexDir)
+{
+    QDir(indexDir).removeRecursively();
+    QDir().mkpath(indexDir);
+
+    IndexWriterPtr writer = newLucene<IndexWriter>(FSDirectory::open(indexDir.toStdWString()),
+                                                   newLucene<NGramAnalyzer>(1, 2),
+                                                   true,
+                                                   IndexWriter::MaxFieldLengthUNLIMITED);
+    writer->setRAMBufferSizeMB(kRamBufferMB);
+    return writer;
+}
+
+void addStored(const DocumentPtr &doc, const wchar_t *name, const QString &value, Field::Index index)
+{
+    doc->add(newLucene<Field>(name, value.toStdWString(), Field::STORE_YES, index));
+}
+
+void addNumeric(const DocumentPtr &doc, const wchar_t *name, qint64 value)
+{
+    NumericFieldPtr field = newLucene<NumericField>(name, Field::STORE_YES, true);
+    field->setLongValue(value);
+    doc->add(field);
+}
+
+void addAncestors(const DocumentPtr &doc, const wchar_t *name, const QStringList &ancestors)
+{
+    for (const QString &ancestor : ancestors)
+        addStored(doc, name, ancestor, Field::INDEX_NOT_ANALYZED);
+}
+
+QString sizeString(qint64 bytes)
+{
+    static const char *const kUnits[] = { "B", "KB", "MB", "GB" };
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024 && unit < 3) {
+        value /= 1024;
+        ++unit;
+    }
+    return QStringLiteral("%1 %2").arg(value, 0, 'f', unit == 0 ? 0 : 1).arg(QLatin1String(kUnits[unit]));
+}
+
+void reportProgress(const char *phase, qint64 done, qint64 total)
+{
+    // 每 10% 输出一次，大规模生成时便于估计剩余时间
+    const qint64 step = qMax<qint64>(1, total / 10);
+    if (done % step == 0 || done == total)
+        qInfo().noquote() << QStringLiteral("[%1] %2/%3").arg(QLatin1String(phase)).arg(done).arg(total);
+}
+
+bool writeJson(const QString &path, const QJsonObject &obj, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = QStringLiteral("Cannot write %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    file.write(QJsonDocument(obj).toJson());
+    return true;
+}
+
+}   // namespace
+
+BenchDataset::BenchDataset(const QString &workDir, const BenchCorpusConfig &config)
+    : m_workDir(QDir(workDir).absolutePath()),
+      m_corpus(QDir(workDir).absoluteFilePath(QStringLiteral("tree")), config)
+{
+}
+
+QString BenchDataset::treeRoot() const
+{
+    return m_corpus.rootPath();
+}
+
+QString BenchDataset::fileNameIndexDirectory() const
+{
+    return QDir(m_workDir).filePath(QStringLiteral("index/filename"));
+}
+
+QString BenchDataset::contentIndexDirectory() const
+{
+    return QDir(m_workDir).filePath(QStringLiteral("index/fulltext"));
+}
+
+QString BenchDataset::ocrTextIndexDirectory() const
+{
+    return QDir(m_workDir).filePath(QStringLiteral("index/ocrtext"));
+}
+
+bool BenchDataset::isReusable() const
+{
+    QFile file(manifestPath(m_workDir));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonObject manifest = QJsonDocument::fromJson(file.readAll()).object();
+    return manifest.value("version").toInt() == kManifestVersion
+            && manifest.value("config").toObject() == m_corpus.config().toJson()
+            && QDir(fileNameIndexDirectory()).exists()
+            && QDir(contentIndexDirectory()).exists()
+            && QDir(ocrTextIndexDirectory()).exists();
+}
+
+bool BenchDataset::prepare(bool reuse, QString *error)
+{
+    if (reuse && isReusable()) {
+        QFile file(manifestPath(m_workDir));
+        file.open(QIODevice::ReadOnly);
+        const QJsonObject manifest = QJsonDocument::fromJson(file.readAll()).object();
+        m_contentDocuments = manifest.value("contentDocuments").toVariant().toLongLong();
+        m_ocrDocuments = manifest.value("ocrDocuments").toVariant().toLongLong();
+        m_timings = manifest.value("timings").toObject();
+        m_reused = true;
+        qInfo() << "Reusing dataset in" << m_workDir;
+        return true;
+    }
+
+    // 先删除旧清单，生成中断时不会被误认为可复用
+    QDir().mkpath(m_workDir);
+    QFile::remove(manifestPath(m_workDir));
+
+    try {
+        if (!createTree(error) || !buildFileNameIndex(error) || !buildTextIndexes(error))
+            return false;
+    } catch (const LuceneException &e) {
+        *error = QStringLiteral("Lucene error: %1").arg(QString::fromStdWString(e.getError()));
+        return false;
+    }
+
+    if (!writeStatusFiles(error))
+        return false;
+
+    QJsonObject manifest;
+    manifest["version"] = kManifestVersion;
+    manifest["config"] = m_corpus.config().toJson();
+    manifest["contentDocuments"] = m_contentDocuments;
+    manifest["ocrDocuments"] = m_ocrDocuments;
+    manifest["timings"] = m_timings;
+    return writeJson(manifestPath(m_workDir), manifest, error);
+}
+
+bool BenchDataset::createTree(QString *error)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QDir(treeRoot()).removeRecursively();
+    if (!QDir().mkpath(treeRoot())) {
+        *error = QStringLiteral("Cannot create %1").arg(treeRoot());
+        return false;
+    }
+
+    const qint64 total = qMin(m_corpus.config().treeDocuments, m_corpus.config().documents);
+    QString lastDirectory;
+    for (qint64 i = 0; i < total; ++i) {
+        const BenchDocument doc = m_corpus.document(i);
+        const QString directory = m_corpus.directoryOf(i);
+        if (directory != lastDirectory) {
+            QDir().mkpath(directory);
+            lastDirectory = directory;
+        }
+
+        QFile file(doc.path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            *error = QStringLiteral("Cannot create %1: %2").arg(doc.path, file.errorString());
+            return false;
+        }
+        // 稀疏文件，只占用元数据，大小过滤可以得到与索引相同的结果
+        file.resize(doc.fileSize);
+        file.setFileTime(QDateTime::fromSecsSinceEpoch(doc.modifyTime), QFileDevice::FileModificationTime);
+        file.close();
+        reportProgress("tree", i + 1, total);
+    }
+
+    m_timings["treeMs"] = timer.elapsed();
+    return true;
+}
+
+bool BenchDataset::buildFileNameIndex(QString *error)
+{
+    Q_UNUSED(error)
+    QElapsedTimer timer;
+    timer.start();
+
+    IndexWriterPtr writer = openWriter(fileNameIndexDirectory());
+    const qint64 total = m_corpus.config().documents;
+    for (qint64 i = 0; i < total; ++i) {
+        const BenchDocument data = m_corpus.document(i);
+
+        DocumentPtr doc = newLucene<Document>();
+        addStored(doc, LuceneFieldNames::FileName::kFullPath, data.path, Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kFileName, data.fileName, Field::INDEX_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kFileNameLower, data.fileName.toLower(), Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kFileType, data.fileType, Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kFileExt, data.extension, Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kPinyin, data.pinyin, Field::INDEX_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kPinyinAcronym, data.pinyinAcronym, Field::INDEX_ANALYZED);
+        addStored(doc, LuceneFieldNames::FileName::kIsHidden, data.hidden ? "Y" : "N", Field::INDEX_NOT_ANALYZED);
+        addNumeric(doc, LuceneFieldNames::FileName::kModifyTime, data.modifyTime);
+        addNumeric(doc, LuceneFieldNames::FileName::kBirthTime, data.birthTime);
+        addNumeric(doc, LuceneFieldNames::FileName::kFileSize, data.fileSize);
+        addStored(doc, LuceneFieldNames::FileName::kFileSizeStr, sizeString(data.fileSize), Field::INDEX_NOT_ANALYZED);
+        addAncestors(doc, LuceneFieldNames::FileName::kAncestorPaths, m_corpus.ancestorPaths(i));
+
+        writer->addDocument(doc);
+        reportProgress("filename-index", i + 1, total);
+    }
+    writer->close();
+
+    m_timings["fileNameIndexMs"] = timer.elapsed();
+    return true;
+}
+
+bool BenchDataset::buildTextIndexes(QString *error)
+{
+    Q_UNUSED(error)
+    QElapsedTimer timer;
+    timer.start();
+
+    const Field::TermVector termVector = m_corpus.config().termVectors ? Field::TERM_VECTOR_WITH_POSITIONS_OFFSETS
+                                                                       : Field::TERM_VECTOR_NO;
+
+    IndexWriterPtr contentWriter = openWriter(contentIndexDirectory());
+    IndexWriterPtr ocrWriter = openWriter(ocrTextIndexDirectory());
+    m_contentDocuments = 0;
+    m_ocrDocuments = 0;
+
+    const qint64 total = m_corpus.config().documents;
+    for (qint64 i = 0; i < total; ++i) {
+        const BenchDocument data = m_corpus.document(i);
+        const bool isContent = data.hasText();
+        if (!isContent && !data.isImage()) {
+            reportProgress("text-indexes", i + 1, total);
+            continue;
+        }
+
+        // 全文与 OCR 索引字段同名，只是正文字段不同
+        const wchar_t *contentsField = isContent ? LuceneFieldNames::Content::kContents
+                                                 : LuceneFieldNames::OcrText::kOcrContents;
+        DocumentPtr doc = newLucene<Document>();
+        addStored(doc, LuceneFieldNames::Content::kPath, data.path, Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::Content::kFilename, data.fileName, Field::INDEX_ANALYZED);
+        addStored(doc, LuceneFieldNames::Content::kFileExt, data.extension, Field::INDEX_NOT_ANALYZED);
+        addStored(doc, LuceneFieldNames::Content::kIsHidden, data.hidden ? "Y" : "N", Field::INDEX_NOT_ANALYZED);
+        addNumeric(doc, LuceneFieldNames::Content::kModifyTime, data.modifyTime);
+        addNumeric(doc, LuceneFieldNames::Content::kBirthTime, data.birthTime);
+        addNumeric(doc, LuceneFieldNames::Content::kFileSize, data.fileSize);
+        addStored(doc, LuceneFieldNames::Content::kCheckSum, QString::number(i, 16), Field::INDEX_NOT_ANALYZED);
+        addAncestors(doc, LuceneFieldNames::Content::kAncestorPaths, m_corpus.ancestorPaths(i));
+        doc->add(newLucene<Field>(contentsField, m_corpus.content(i).toStdWString(),
+                                  Field::STORE_YES, Field::INDEX_ANALYZED, termVector));
+
+        if (isContent) {
+            contentWriter->addDocument(doc);
+            ++m_contentDocuments;
+        } else {
+            ocrWriter->addDocument(doc);
+            ++m_ocrDocuments;
+        }
+        reportProgress("text-indexes", i + 1, total);
+    }
+    contentWriter->close();
+    ocrWriter->close();
+
+    m_timings["textIndexesMs"] = timer.elapsed();
+    return true;
+}
+
+bool BenchDataset::writeStatusFiles(QString *error)
+{
+    // 语义搜索只在文件名索引处于 monitoring、全文/OCR 索引有更新时间时启用对应引擎
+    QJsonObject fileNameStatus;
+    fileNameStatus["status"] = QStringLiteral("monitoring");
+
+    QJsonObject textStatus;
+    textStatus["lastUpdateTime"] = QDateTime::fromSecsSinceEpoch(m_corpus.config().referenceTime).toString(Qt::ISODate);
+
+    return writeJson(QDir(fileNameIndexDirectory()).filePath(QStringLiteral("status.json")), fileNameStatus, error)
+            && writeJson(QDir(contentIndexDirectory()).filePath(QStringLiteral("index_status.json")), textStatus, error)
+            && writeJson(QDir(ocrTextIndexDirectory()).filePath(QStringLiteral("index_status.json")), textStatus, error);
+}
+
+QStringList BenchDataset::contentPaths(int count) const
+{
+    QStringList paths;
+    const qint64 total = m_corpus.config().documents;
+    for (qint64 i = 0; i < total && paths.size() < count; ++i) {
+        const BenchDocument doc = m_corpus.document(i);
+        if (doc.hasText())
+            paths.append(doc.path);
+    }
+    return paths;
+}
+
+QJsonObject BenchDataset::toJson() const
+{
+    QJsonObject obj;
+    obj["config"] = m_corpus.config().toJson();
+    obj["reused"] = m_reused;
+    obj["fileNameDocuments"] = m_corpus.config().documents;
+    obj["contentDocuments"] = m_contentDocuments;
+    obj["ocrDocuments"] = m_ocrDocuments;
+    obj["generationTimings"] = m_timings;
+    return obj;
+}
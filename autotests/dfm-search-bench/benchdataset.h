@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef BENCHDATASET_H
+#define BENCHDATASET_H
+
+#include "benchcorpus.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 磁盘上的基准数据集
+ *
+ * 工作目录布局：
+ *   tree/               实时搜索遍历的目录树（前 treeDocuments 个文档）
+ *   index/filename/     文件名索引，字段与 deepin-anything 一致
+ *   index/fulltext/     全文索引
+ *   index/ocrtext/      OCR 文本索引
+ *   manifest.json       生成参数，参数相同时可以直接复用
+ *
+ * 三个索引都使用 NGramAnalyzer(1, 2)，与搜索时的查询构造方式对应。
+ */
+class BenchDataset
+{
+public:
+    BenchDataset(const QString &workDir, const BenchCorpusConfig &config);
+
+    /**
+     * @brief 生成数据集
+     * @param reuse 工作目录中已有参数相同的数据集时直接使用
+     * @return 失败时返回 false 并写入 error
+     */
+    bool prepare(bool reuse, QString *error);
+
+    const BenchCorpus &corpus() const { return m_corpus; }
+
+    QString treeRoot() const;
+    QString fileNameIndexDirectory() const;
+    QString contentIndexDirectory() const;
+    QString ocrTextIndexDirectory() const;
+
+    /**
+     * @brief 全文索引中前 count 个文档的路径，高亮场景使用
+     */
+    QStringList contentPaths(int count) const;
+
+    /**
+     * @brief 生成耗时与各索引的文档数
+     */
+    QJsonObject toJson() const;
+
+private:
+    bool isReusable() const;
+    bool createTree(QString *error);
+    bool buildFileNameIndex(QString *error);
+    bool buildTextIndexes(QString *error);
+    bool writeStatusFiles(QString *error);
+
+    QString m_workDir;
+    BenchCorpus m_corpus;
+    bool m_reused = false;
+    qint64 m_contentDocuments = 0;
+    qint64 m_ocrDocuments = 0;
+    QJsonObject m_timings;   // 各阶段耗时（毫秒）
+};
+
+#endif   // BENCHDATASET_H
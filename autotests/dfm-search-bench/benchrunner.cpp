@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "benchrunner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+
+double BenchScenarioResult::percentile(double p) const
+{
+    if (latenciesMs.empty())
+        return 0;
+
+    // 最近秩法：样本较少时不插值，结果总是某次实际测得的延迟
+    std::vector<double> sorted = latenciesMs;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+QJsonObject BenchScenarioResult::toJson() const
+{
+    QJsonObject obj;
+    obj["suite"] = suite;
+    obj["name"] = name;
+    obj["query"] = query;
+    obj["iterations"] = iterations;
+    obj["resultCount"] = resultCount;
+
+    if (!error.isEmpty()) {
+        obj["error"] = error;
+        return obj;
+    }
+
+    const double totalMs = std::accumulate(latenciesMs.begin(), latenciesMs.end(), 0.0);
+    QJsonObject latency;
+    if (!latenciesMs.empty()) {
+        latency["min"] = *std::min_element(latenciesMs.begin(), latenciesMs.end());
+        latency["mean"] = totalMs / static_cast<double>(latenciesMs.size());
+        latency["p50"] = percentile(50);
+        latency["p90"] = percentile(90);
+        latency["p99"] = percentile(99);
+        latency["max"] = *std::max_element(latenciesMs.begin(), latenciesMs.end());
+    }
+    obj["latencyMs"] = latency;
+
+    QJsonObject throughput;
+    if (totalMs > 0) {
+        throughput["queriesPerSecond"] = static_cast<double>(latenciesMs.size()) * 1000.0 / totalMs;
+        throughput["resultsPerSecond"] = static_cast<double>(resultCount) * static_cast<double>(latenciesMs.size())
+                * 1000.0 / totalMs;
+    }
+    obj["throughput"] = throughput;
+
+    obj["peakRssKb"] = peakRssKb;
+    obj["peakRssIsProcessWide"] = peakRssIsProcessWide;
+    return obj;
+}
+
+BenchRunner::BenchRunner(int warmupIterations, int iterations)
+    : m_warmupIterations(qMax(0, warmupIterations)),
+      m_iterations(qMax(1, iterations))
+{
+}
+
+BenchScenarioResult BenchRunner::run(const QString &suite, const QString &name, const QString &query,
+                                     const Operation &operation) const
+{
+    BenchScenarioResult result;
+    result.suite = suite;
+    result.name = name;
+    result.query = query;
+
+    result.peakRssIsProcessWide = !resetPeakRss();
+
+    for (int i = 0; i < m_warmupIterations; ++i) {
+        if (operation(&result.error) < 0)
+            return result;
+    }
+
+    result.latenciesMs.reserve(static_cast<size_t>(m_iterations));
+    QElapsedTimer timer;
+    for (int i = 0; i < m_iterations; ++i) {
+        timer.start();
+        const qint64 count = operation(&result.error);
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        if (count < 0)
+            return result;
+
+        result.latenciesMs.push_back(static_cast<double>(elapsedNs) / 1e6);
+        result.resultCount = count;
+        ++result.iterations;
+    }
+
+    result.peakRssKb = currentPeakRssKb();
+    qInfo().noquote() << QStringLiteral("[%1] %2: p50 %3 ms, p99 %4 ms, %5 results")
+                                 .arg(suite, name)
+                                 .arg(result.percentile(50), 0, 'f', 2)
+                                 .arg(result.percentile(99), 0, 'f', 2)
+                                 .arg(result.resultCount);
+    return result;
+}
+
+qint64 BenchRunner::currentPeakRssKb()
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith("VmHWM:")) {
+            const QList<QByteArray> parts = line.mid(6).simplified().split(' ');
+            return parts.isEmpty() ? -1 : parts.first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+bool BenchRunner::resetPeakRss()
+{
+    // 写入 5 将 VmHWM 重置为当前 RSS（Linux 4.0+）
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Unbuffered))
+        return false;
+    return file.write("5", 1) == 1;
+}
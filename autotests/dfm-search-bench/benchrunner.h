@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef BENCHRUNNER_H
+#define BENCHRUNNER_H
+
+#include <functional>
+#include <vector>
+
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @brief 单个场景的测量结果
+ */
+struct BenchScenarioResult
+{
+    QString suite;   // realtime / indexed / content / ocr / semantic / highlight
+    QString name;
+    QString query;
+    int iterations = 0;
+    std::vector<double> latenciesMs;
+    qint64 resultCount = 0;   // 最后一次运行的结果数
+    qint64 peakRssKb = -1;   // 场景运行期间的峰值常驻内存，无法测量时为 -1
+    bool peakRssIsProcessWide = false;   // 内核不支持重置峰值时为进程启动以来的峰值
+    QString error;
+
+    double percentile(double p) const;
+    QJsonObject toJson() const;
+};
+
+/**
+ * @brief 场景执行器
+ *
+ * 每个场景先预热若干次，再计时运行指定次数，统计延迟分位数与吞吐量。
+ * 峰值常驻内存来自 /proc/self/status 的 VmHWM，每个场景开始前通过
+ * /proc/self/clear_refs 重置，因此是该场景自身的峰值。
+ */
+class BenchRunner
+{
+public:
+    /**
+     * @brief 执行一次搜索，返回结果数；出错时返回 -1 并写入 error
+     */
+    using Operation = std::function<qint64(QString *error)>;
+
+    BenchRunner(int warmupIterations, int iterations);
+
+    BenchScenarioResult run(const QString &suite, const QString &name, const QString &query,
+                            const Operation &operation) const;
+
+    static qint64 currentPeakRssKb();
+
+private:
+    static bool resetPeakRss();
+
+    int m_warmupIterations;
+    int m_iterations;
+};
+
+#endif   // BENCHRUNNER_H
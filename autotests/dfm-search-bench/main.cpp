@@ -0,0 +1,408 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+// dfm-search 基准测试
+//
+// 生成可复现的合成目录树与文件名/全文/OCR 索引，依次测量实时搜索、索引搜索、
+// 语义搜索与高亮的延迟分位数、吞吐量与峰值内存，并输出 JSON 供版本间对比。
+
+#include "benchcorpus.h"
+#include "benchdataset.h"
+#include "benchrunner.h"
+
+#include <memory>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QThread>
+#include <QTimer>
+
+#include <stubext.h>
+
+#include <dfm-search/contentretriever.h>
+#include <dfm-search/dsearch_global.h>
+#include <dfm-search/filenamesearchapi.h>
+#include <dfm-search/searchengine.h>
+#include <dfm-search/semanticsearcher.h>
+
+#include "utils/filenameresultcache.h"
+
+using namespace dfmsearch;
+
+namespace {
+
+constexpr int kSchemaVersion = 1;
+constexpr int kHighlightBatchSize = 50;
+constexpr int kSemanticTimeoutSecs = 60;
+
+const QStringList kAllSuites { "realtime", "indexed", "content", "ocr", "semantic", "highlight" };
+
+struct BenchSettings
+{
+    QString workDir;
+    QString output;
+    QString label;
+    QStringList suites;
+    bool reuse = false;
+    int iterations = 20;
+    int warmup = 3;
+    int threads = 0;
+    int maxResults = 0;
+};
+
+// 语义规则从源码树安装到隔离的用户配置目录，不依赖系统是否安装了规则
+void installSemanticRules(const QString &configHome)
+{
+    const QString sourceDir = QString::fromUtf8(BENCH_SOURCE_DIR) + "/src/dfm-search/dfm-search-lib/semantic/rules";
+    const QDir source(sourceDir);
+    if (!source.exists()) {
+        qWarning() << "Semantic rules not found in source tree, using installed rules:" << sourceDir;
+        return;
+    }
+
+    for (const QString &locale : source.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString targetDir = configHome + "/deepin/dfm-search/semantic/rules/" + locale;
+        QDir().mkpath(targetDir);
+        const QDir localeDir(source.filePath(locale));
+        for (const QString &file : localeDir.entryList({ "*.json" }, QDir::Files)) {
+            QFile::remove(targetDir + "/" + file);
+            QFile::copy(localeDir.filePath(file), targetDir + "/" + file);
+        }
+    }
+}
+
+qint64 runEngine(SearchType type, const SearchOptions &options, const SearchQuery &query, QString *error)
+{
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(type));
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected expected = engine->searchSync(query);
+    if (!expected.hasValue()) {
+        *error = expected.error().message();
+        return -1;
+    }
+    return expected.value().size();
+}
+
+SearchOptions baseOptions(const BenchSettings &settings, const QString &searchPath, SearchMethod method)
+{
+    SearchOptions options;
+    options.setSearchMethod(method);
+    options.setSearchPath(searchPath);
+    options.setMaxThreadCount(settings.threads);
+    if (settings.maxResults > 0)
+        options.setMaxResults(settings.maxResults);
+    return options;
+}
+
+void runRealtimeSuite(const BenchRunner &runner, const BenchSettings &settings, const BenchDataset &dataset,
+                      QJsonArray *results)
+{
+    const SearchOptions options = baseOptions(settings, dataset.treeRoot(), SearchMethod::Realtime);
+    const QList<QPair<QString, SearchQuery>> queries {
+        { "latin", SearchQuery::createSimpleQuery(BenchCorpus::latinKeywords().first()) },
+        { "cjk", SearchQuery::createSimpleQuery(BenchCorpus::cjkKeywords().first()) },
+        { "wildcard", SearchQuery("*.pdf", SearchQuery::Type::Wildcard) },
+    };
+
+    for (const auto &entry : queries) {
+        const SearchQuery query = entry.second;
+        results->append(runner.run("realtime", entry.first, query.keyword(), [&](QString *error) {
+                                  return runEngine(SearchType::FileName, options, query, error);
+                              })
+                                .toJson());
+    }
+}
+
+void runIndexedSuite(const BenchRunner &runner, const BenchSettings &settings, const BenchDataset &dataset,
+                     QJsonArray *results)
+{
+    const SearchOptions plain = baseOptions(settings, dataset.treeRoot(), SearchMethod::Indexed);
+
+    SearchOptions pinyin = plain;
+    FileNameOptionsAPI(pinyin).setPinyinEnabled(true);
+
+    SearchOptions sorted = plain;
+    sorted.setMaxResults(100);
+    sorted.setResultSort(ResultSortKey::ModifyTime, Qt::DescendingOrder);
+
+    struct Scenario
+    {
+        QString name;
+        SearchQuery query;
+        SearchOptions options;
+        bool cold;   // 每次运行前清空结果缓存
+    };
+    const QList<Scenario> scenarios {
+        { "latin", SearchQuery::createSimpleQuery(BenchCorpus::latinKeywords().first()), plain, true },
+        { "cjk", SearchQuery::createSimpleQuery(BenchCorpus::cjkKeywords().first()), plain, true },
+        { "pinyin", SearchQuery::createSimpleQuery(BenchCorpus::pinyinKeywords().first()), pinyin, true },
+        { "wildcard", SearchQuery("report*", SearchQuery::Type::Wildcard), plain, true },
+        { "sorted-top100", SearchQuery::createSimpleQuery(BenchCorpus::latinKeywords().at(1)), sorted, true },
+        { "latin-cached", SearchQuery::createSimpleQuery(BenchCorpus::latinKeywords().first()), plain, false },
+    };
+
+    for (const Scenario &scenario : scenarios) {
+        results->append(runner.run("indexed", scenario.name, scenario.query.keyword(), [&](QString *error) {
+                                  if (scenario.cold)
+                                      FileNameResultCache::instance()->clear();
+                                  return runEngine(SearchType::FileName, scenario.options, scenario.query, error);
+                              })
+                                .toJson());
+    }
+}
+
+void runTextSuite(const BenchRunner &runner, const BenchSettings &settings, const BenchDataset &dataset,
+                  SearchType type, const QString &suite, const QStringList &keywords, QJsonArray *results)
+{
+    const SearchOptions options = baseOptions(settings, dataset.treeRoot(), SearchMethod::Indexed);
+
+    QList<QPair<QString, SearchQuery>> queries {
+        { "latin", SearchQuery::createSimpleQuery(keywords.at(0)) },
+        { "cjk", SearchQuery::createSimpleQuery(keywords.at(1)) },
+        { "boolean-and", SearchQuery::createBooleanQuery(keywords, SearchQuery::BooleanOperator::AND) },
+    };
+
+    for (const auto &entry : queries) {
+        const SearchQuery query = entry.second;
+        const QString text = query.type() == SearchQuery::Type::Boolean ? keywords.join(" AND ") : query.keyword();
+        results->append(runner.run(suite, entry.first, text, [&](QString *error) {
+                                  return runEngine(type, options, query, error);
+                              })
+                                .toJson());
+    }
+}
+
+void runSemanticSuite(const BenchRunner &runner, const BenchSettings &settings, const BenchDataset &dataset,
+                      QJsonArray *results)
+{
+    const QStringList queries { "本周的pdf", "上个月的文档", "大于500M的文件", "去年的预算" };
+
+    for (const QString &text : queries) {
+        results->append(runner.run("semantic", text, text, [&](QString *error) -> qint64 {
+                                  SemanticSearcher searcher;
+                                  searcher.setSearchTimeout(kSemanticTimeoutSecs);
+                                  if (settings.maxResults > 0)
+                                      searcher.setMaxResults(settings.maxResults);
+
+                                  // 语义搜索是异步的，在局部事件循环中等待结束
+                                  qint64 count = -1;
+                                  QEventLoop loop;
+                                  QObject::connect(&searcher, &SemanticSearcher::searchFinished, &loop,
+                                                   [&](const SearchResultList &found) {
+                                                       count = found.size();
+                                                       loop.quit();
+                                                   });
+                                  QObject::connect(&searcher, &SemanticSearcher::searchCancelled, &loop, [&]() {
+                                      *error = QStringLiteral("Search cancelled or timed out");
+                                      loop.quit();
+                                  });
+                                  QObject::connect(&searcher, &SemanticSearcher::errorOccurred, &loop,
+                                                   [&](const SearchError &searchError) {
+                                                       *error = searchError.message();
+                                                       loop.quit();
+                                                   });
+                                  QTimer::singleShot(0, &searcher, [&]() {
+                                      searcher.search(text, { dataset.treeRoot() });
+                                  });
+                                  loop.exec();
+                                  return error->isEmpty() ? count : -1;
+                              })
+                                .toJson());
+    }
+}
+
+void runHighlightSuite(const BenchRunner &runner, const BenchDataset &dataset, QJsonArray *results)
+{
+    ContentRetriever retriever;
+    retriever.setIndexDirectory(SearchType::Content, dataset.contentIndexDirectory());
+
+    const QStringList paths = dataset.contentPaths(kHighlightBatchSize);
+    HighlightOptions options;
+    options.setMaxPreviewLength(200);
+
+    for (const QString &keyword : { BenchCorpus::cjkKeywords().first(), BenchCorpus::latinKeywords().first() }) {
+        results->append(runner.run("highlight", QStringLiteral("batch-%1").arg(paths.size()), keyword,
+                                   [&](QString *error) -> qint64 {
+                                       Q_UNUSED(error)
+                                       const QMap<QString, QString> highlights =
+                                               retriever.fetchHighlights(paths, keyword, SearchType::Content, options);
+                                       qint64 count = 0;
+                                       for (const QString &snippet : highlights) {
+                                           if (!snippet.isEmpty())
+                                               ++count;
+                                       }
+                                       return count;
+                                   })
+                                .toJson());
+    }
+}
+
+bool writeReport(const QString &output, const QJsonObject &report)
+{
+    const QByteArray json = QJsonDocument(report).toJson();
+    if (output.isEmpty() || output == "-") {
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write(json);
+        return true;
+    }
+
+    QFile file(output);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical() << "Cannot write report:" << output << file.errorString();
+        return false;
+    }
+    file.write(json);
+    return true;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    // 在 QCoreApplication 之前解析工作目录，以便隔离 XDG 目录（规则与缓存）
+    QString workDir = QDir::tempPath() + "/dfm-search-bench";
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "--work-dir" && i + 1 < argc)
+            workDir = QString::fromLocal8Bit(argv[i + 1]);
+        else if (arg.startsWith("--work-dir="))
+            workDir = QString::fromLocal8Bit(arg.mid(11));
+    }
+    workDir = QDir(workDir).absolutePath();
+    const QString configHome = workDir + "/xdg/config";
+    const QString cacheHome = workDir + "/xdg/cache";
+    QDir().mkpath(configHome);
+    QDir().mkpath(cacheHome);
+    qputenv("XDG_CONFIG_HOME", QFile::encodeName(configHome));
+    qputenv("XDG_CACHE_HOME", QFile::encodeName(cacheHome));
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dfm-search-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmark dfm-search on reproducible synthetic datasets");
+    parser.addHelpOption();
+
+    const QCommandLineOption workDirOption("work-dir", "Directory for the generated dataset.", "dir", workDir);
+    const QCommandLineOption docsOption("docs", "Documents in the filename index (10000 - 5000000).", "n", "10000");
+    const QCommandLineOption treeDocsOption("tree-docs", "Files created on disk for realtime search (default: min(docs, 100000)).", "n");
+    const QCommandLineOption seedOption("seed", "Random seed of the dataset.", "n", "20260101");
+    const QCommandLineOption cjkRatioOption("cjk-ratio", "Share of CJK words in names and contents.", "ratio", "0.5");
+    const QCommandLineOption contentWordsOption("content-words", "Words per content/OCR document.", "n", "120");
+    const QCommandLineOption noTermVectorsOption("no-term-vectors", "Do not store term vectors for content fields.");
+    const QCommandLineOption referenceTimeOption("reference-time", "Epoch seconds all generated times are relative to (default: today 00:00).", "secs");
+    const QCommandLineOption reuseOption("reuse", "Reuse the dataset in work-dir if it was generated with the same parameters.");
+    const QCommandLineOption suitesOption("suites", "Comma separated suites: " + kAllSuites.join(','), "list", kAllSuites.join(','));
+    const QCommandLineOption iterationsOption("iterations", "Timed runs per scenario.", "n", "20");
+    const QCommandLineOption warmupOption("warmup", "Untimed warm-up runs per scenario.", "n", "3");
+    const QCommandLineOption threadsOption("threads", "Search thread count, 0 for the library default.", "n", "0");
+    const QCommandLineOption maxResultsOption("max-results", "Result limit per search, 0 for unlimited.", "n", "0");
+    const QCommandLineOption outputOption("output", "JSON report file, '-' for stdout.", "file", "-");
+    const QCommandLineOption labelOption("label", "Free-form label stored in the report, e.g. a release tag.", "text");
+    parser.addOptions({ workDirOption, docsOption, treeDocsOption, seedOption, cjkRatioOption, contentWordsOption,
+                        noTermVectorsOption, referenceTimeOption, reuseOption, suitesOption, iterationsOption,
+                        warmupOption, threadsOption, maxResultsOption, outputOption, labelOption });
+    parser.process(app);
+
+    BenchCorpusConfig config;
+    config.documents = qBound<qint64>(1, parser.value(docsOption).toLongLong(), 50000000);
+    config.treeDocuments = parser.isSet(treeDocsOption) ? parser.value(treeDocsOption).toLongLong()
+                                                        : qMin<qint64>(config.documents, 100000);
+    config.seed = parser.value(seedOption).toUInt();
+    config.cjkRatio = qBound(0.0, parser.value(cjkRatioOption).toDouble(), 1.0);
+    config.contentWords = qMax(1, parser.value(contentWordsOption).toInt());
+    config.termVectors = !parser.isSet(noTermVectorsOption);
+    config.referenceTime = parser.isSet(referenceTimeOption)
+            ? parser.value(referenceTimeOption).toLongLong()
+            : QDateTime(QDate::currentDate(), QTime(0, 0)).toSecsSinceEpoch();
+
+    BenchSettings settings;
+    settings.workDir = workDir;
+    settings.output = parser.value(outputOption);
+    settings.label = parser.value(labelOption);
+    settings.suites = parser.value(suitesOption).split(',');
+    settings.suites.removeAll(QString());
+    settings.reuse = parser.isSet(reuseOption);
+    settings.iterations = parser.value(iterationsOption).toInt();
+    settings.warmup = parser.value(warmupOption).toInt();
+    settings.threads = parser.value(threadsOption).toInt();
+    settings.maxResults = parser.value(maxResultsOption).toInt();
+
+    for (const QString &suite : settings.suites) {
+        if (!kAllSuites.contains(suite)) {
+            qCritical() << "Unknown suite:" << suite;
+            return 1;
+        }
+    }
+
+    installSemanticRules(configHome);
+
+    BenchDataset dataset(QDir(workDir).filePath("dataset"), config);
+    QString error;
+    if (!dataset.prepare(settings.reuse, &error)) {
+        qCritical().noquote() << "Failed to generate dataset:" << error;
+        return 1;
+    }
+
+    // 索引目录重定向到生成的数据集；必须在首次查询索引状态之前完成
+    stub_ext::StubExt stub;
+    const QString fileNameIndexDir = dataset.fileNameIndexDirectory();
+    const QString contentIndexDir = dataset.contentIndexDirectory();
+    const QString ocrTextIndexDir = dataset.ocrTextIndexDirectory();
+    stub.set_lamda(Global::fileNameIndexDirectory, [fileNameIndexDir]() { return fileNameIndexDir; });
+    stub.set_lamda(Global::contentIndexDirectory, [contentIndexDir]() { return contentIndexDir; });
+    stub.set_lamda(Global::ocrTextIndexDirectory, [ocrTextIndexDir]() { return ocrTextIndexDir; });
+
+    const BenchRunner runner(settings.warmup, settings.iterations);
+    QJsonArray results;
+    for (const QString &suite : settings.suites) {
+        if (suite == "realtime")
+            runRealtimeSuite(runner, settings, dataset, &results);
+        else if (suite == "indexed")
+            runIndexedSuite(runner, settings, dataset, &results);
+        else if (suite == "content")
+            runTextSuite(runner, settings, dataset, SearchType::Content, suite,
+                         { BenchCorpus::latinKeywords().at(1), BenchCorpus::cjkKeywords().at(1) }, &results);
+        else if (suite == "ocr")
+            runTextSuite(runner, settings, dataset, SearchType::Ocr, suite,
+                         { BenchCorpus::latinKeywords().at(2), BenchCorpus::cjkKeywords().at(2) }, &results);
+        else if (suite == "semantic")
+            runSemanticSuite(runner, settings, dataset, &results);
+        else if (suite == "highlight")
+            runHighlightSuite(runner, dataset, &results);
+    }
+
+    QJsonObject host;
+    host["cpuCount"] = QThread::idealThreadCount();
+    host["kernel"] = QSysInfo::kernelVersion();
+    host["os"] = QSysInfo::prettyProductName();
+    host["qt"] = QString::fromLatin1(qVersion());
+
+    QJsonObject settingsJson;
+    settingsJson["suites"] = QJsonArray::fromStringList(settings.suites);
+    settingsJson["iterations"] = settings.iterations;
+    settingsJson["warmup"] = settings.warmup;
+    settingsJson["threads"] = settings.threads;
+    settingsJson["maxResults"] = settings.maxResults;
+
+    QJsonObject report;
+    report["schemaVersion"] = kSchemaVersion;
+    report["label"] = settings.label;
+    report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["host"] = host;
+    report["dataset"] = dataset.toJson();
+    report["settings"] = settingsJson;
+    report["results"] = results;
+
+    return writeReport(settings.output, report) ? 0 : 1;
+}
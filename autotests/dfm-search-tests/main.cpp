@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <QCoreApplication>
 #include <QTest>
 
 // Test object creation functions are defined in their respective .cpp files
@@ -20,6 +21,7 @@ extern QObject *create_tst_IsSemanticQuery();
 extern QObject *create_tst_SearchTarget();
 extern QObject *create_tst_SemanticQueryBuilderTarget();
 extern QObject *create_tst_LocationExtraction();
+extern QObject *create_tst_SemanticResultMerge();
 extern QObject *create_tst_ContentRetriever();
 extern QObject *create_tst_ContentSearchEngine();
 extern QObject *create_tst_FileNameSearchEngine();
@@ -27,9 +29,12 @@ extern QObject *create_tst_RecentSearchEngine();
 extern QObject *create_tst_CliOptions();
 extern QObject *create_tst_DConfigParsing();
 extern QObject *create_tst_SearchOutput();
+extern QObject *create_tst_KeywordScanner();
 
 int main(int argc, char *argv[])
 {
+    // 所有测试对象共用一个应用对象，需要事件循环的测试（如 D-Bus 信号）依赖它
+    QCoreApplication app(argc, argv);
     int result = 0;
 
     // Run all test objects
@@ -93,6 +98,10 @@ int main(int argc, char *argv[])
     result |= QTest::qExec(testObj14b, argc, argv);
     delete testObj14b;
 
+    QObject *testObj14c = create_tst_SemanticResultMerge();
+    result |= QTest::qExec(testObj14c, argc, argv);
+    delete testObj14c;
+
     QObject *testObj15 = create_tst_ContentRetriever();
     result |= QTest::qExec(testObj15, argc, argv);
     delete testObj15;
@@ -121,5 +130,9 @@ int main(int argc, char *argv[])
     result |= QTest::qExec(testObj21, argc, argv);
     delete testObj21;
 
+    QObject *testObj22 = create_tst_KeywordScanner();
+    result |= QTest::qExec(testObj22, argc, argv);
+    delete testObj22;
+
     return result;
 }
@@ -3,24 +3,30 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <QDir>
+#include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QTest>
 
 #include <atomic>
 #include <future>
+#include <memory>
 #include <vector>
 
 #include <dfm-search/contentretriever.h>
 #include <dfm-search/field_names.h>
 
 #include "utils/contenthighlighter.h"
+#include "utils/indexreaderpool.h"
+#include "utils/termoffsethighlighter.h"
 
 #include <lucene++/Document.h>
 #include <lucene++/Field.h>
+#include <lucene++/FieldCache.h>
 #include <lucene++/FSDirectory.h>
 #include <lucene++/IndexWriter.h>
 #include <lucene++/KeywordAnalyzer.h>
 #include <lucene++/LuceneHeaders.h>
+#include <lucene++/NGramAnalyzer.h>
 
 using namespace dfmsearch;
 using namespace Lucene;
@@ -80,6 +86,18 @@ void createIndex(const QString &indexDir, SearchType type)
     writer->close();
 }
 
+// 统计字段缓存中属于指定段的条目数
+int fieldCacheEntryCount(const IndexReaderPtr &segment)
+{
+    const LuceneObjectPtr key = segment->getFieldCacheKey();
+    int count = 0;
+    for (const FieldCacheEntryPtr &entry : FieldCache::DEFAULT()->getCacheEntries()) {
+        if (entry->getReaderKey() == key)
+            ++count;
+    }
+    return count;
+}
+
 }   // namespace
 
 class tst_ContentRetriever : public QObject
@@ -93,6 +111,10 @@ private Q_SLOTS:
     void fetchContent_semanticRoutingFailsWhenNoDConfig();
     void fetchHighlight_semanticRoutingFailsWhenNoDConfig();
     void concurrentFetch_sharedRetriever();
+    void readerPool_refreshesAfterIndexUpdate();
+    void readerPool_releasesFieldCache();
+    void requestHighlights_deliversBatches();
+    void requestHighlights_cancelStopsDelivery();
     void fetchPreview_noKeyword();
     void fetchPreview_withKeyword();
     void fetchPreview_keywordNotFound();
@@ -101,6 +123,7 @@ private Q_SLOTS:
     void fetchPreview_unlimitedNoKeyword();
     void previewSnippet_basic();
     void plainSnippet_basic();
+    void termOffsetHighlighter_matchesTextScan();
 };
 
 void tst_ContentRetriever::fetchContent_single()
@@ -235,6 +258,171 @@ void tst_ContentRetriever::concurrentFetch_sharedRetriever()
     QVERIFY(!failed.load());
 }
 
+void tst_ContentRetriever::readerPool_refreshesAfterIndexUpdate()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString contentIndexDir = tempDir.path() + "/content-index";
+    createIndex(contentIndexDir, SearchType::Content);
+
+    IndexReaderPool *pool = IndexReaderPool::instance();
+    IndexReaderPool::Lease first = pool->acquire(contentIndexDir);
+    QVERIFY(first);
+    QCOMPARE(first.reader()->numDocs(), 2);
+
+    // 索引未变化时复用同一个读取器
+    {
+        IndexReaderPool::Lease again = pool->acquire(contentIndexDir);
+        QVERIFY(again.reader() == first.reader());
+    }
+
+    IndexWriterPtr writer = newLucene<IndexWriter>(
+            FSDirectory::open(contentIndexDir.toStdWString()),
+            newLucene<KeywordAnalyzer>(),
+            false,
+            IndexWriter::MaxFieldLengthLIMITED);
+    addStoredDocument(writer, SearchType::Content, "/tmp/doc-c.txt", "doc-c.txt", "freshly added document");
+    writer->close();
+
+    // 索引变化后刷新出新读取器，旧的借用仍然可用
+    IndexReaderPool::Lease refreshed = pool->acquire(contentIndexDir);
+    QVERIFY(refreshed);
+    QVERIFY(refreshed.reader() != first.reader());
+    QCOMPARE(refreshed.reader()->numDocs(), 3);
+    QCOMPARE(first.reader()->numDocs(), 2);
+
+    ContentRetriever retriever;
+    retriever.setIndexDirectory(SearchType::Content, contentIndexDir);
+    QCOMPARE(retriever.fetchContent("/tmp/doc-c.txt", SearchType::Content),
+             QString("freshly added document"));
+
+    pool->invalidate(contentIndexDir);
+    QVERIFY(!pool->acquire(tempDir.path() + "/missing-index"));
+}
+
+void tst_ContentRetriever::readerPool_releasesFieldCache()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString contentIndexDir = tempDir.path() + "/content-index";
+    createIndex(contentIndexDir, SearchType::Content);
+
+    IndexReaderPool *pool = IndexReaderPool::instance();
+    IndexReaderPool::Lease first = pool->acquire(contentIndexDir);
+    QVERIFY(first);
+
+    Collection<IndexReaderPtr> segments = first.reader()->getSequentialSubReaders();
+    QVERIFY(segments && segments.size() == 1);
+    const IndexReaderPtr segment = segments[0];
+    FieldCache::DEFAULT()->getStrings(segment, LuceneFieldNames::Content::kPath);
+    QCOMPARE(fieldCacheEntryCount(segment), 1);
+
+    IndexWriterPtr writer = newLucene<IndexWriter>(
+            FSDirectory::open(contentIndexDir.toStdWString()),
+            newLucene<KeywordAnalyzer>(),
+            false,
+            IndexWriter::MaxFieldLengthLIMITED);
+    addStoredDocument(writer, SearchType::Content, "/tmp/doc-c.txt", "doc-c.txt", "freshly added document");
+    writer->close();
+
+    // 刷新只新增了段，未变化的段仍被新读取器使用，保留其字段缓存
+    IndexReaderPool::Lease refreshed = pool->acquire(contentIndexDir);
+    QVERIFY(refreshed.reader() != first.reader());
+    QCOMPARE(fieldCacheEntryCount(segment), 1);
+
+    // 失效时释放整个读取器的字段缓存
+    pool->invalidate(contentIndexDir);
+    QCOMPARE(fieldCacheEntryCount(segment), 0);
+}
+
+void tst_ContentRetriever::requestHighlights_deliversBatches()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString indexDir = tempDir.path() + "/content-index";
+    QDir().mkpath(indexDir);
+    IndexWriterPtr writer = newLucene<IndexWriter>(
+            FSDirectory::open(indexDir.toStdWString()),
+            newLucene<KeywordAnalyzer>(),
+            true,
+            IndexWriter::MaxFieldLengthLIMITED);
+    QStringList paths;
+    for (int i = 0; i < 40; ++i) {
+        const QString name = QString("doc-%1.txt").arg(i);
+        paths.append("/tmp/" + name);
+        addStoredDocument(writer, SearchType::Content, paths.last(), name,
+                          QString("document %1 mentions the budget").arg(i));
+    }
+    writer->close();
+    paths.append("/tmp/missing.txt");
+
+    ContentRetriever retriever;
+    retriever.setIndexDirectory(SearchType::Content, indexDir);
+    QSignalSpy readySpy(&retriever, &ContentRetriever::highlightsReady);
+    QSignalSpy finishedSpy(&retriever, &ContentRetriever::highlightsFinished);
+
+    const int requestId = retriever.requestHighlights(paths, "budget", SearchType::Content);
+    QVERIFY(requestId >= 0);
+    // 可见行提前，不影响最终结果
+    retriever.prioritizeHighlights(requestId, { "/tmp/doc-39.txt", "/tmp/doc-38.txt" });
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, 10000);
+    QCOMPARE(finishedSpy.first().at(0).toInt(), requestId);
+
+    // 结果分多批送达，合并后覆盖所有请求的路径
+    QVERIFY(readySpy.count() > 1);
+    QMap<QString, QString> merged;
+    for (const QList<QVariant> &args : std::as_const(readySpy)) {
+        QCOMPARE(args.at(0).toInt(), requestId);
+        const auto batch = args.at(1).value<QMap<QString, QString>>();
+        for (auto it = batch.cbegin(); it != batch.cend(); ++it)
+            merged.insert(it.key(), it.value());
+    }
+    QCOMPARE(merged.size(), paths.size());
+    QVERIFY(merged.value("/tmp/doc-0.txt").contains("budget"));
+    QVERIFY(merged.value("/tmp/doc-39.txt").contains("budget"));
+    QVERIFY(merged.value("/tmp/missing.txt").isEmpty());
+
+    QCOMPARE(retriever.requestHighlights({}, "budget", SearchType::Content), -1);
+    QCOMPARE(retriever.requestHighlights(paths, "budget", SearchType::FileName), -1);
+}
+
+void tst_ContentRetriever::requestHighlights_cancelStopsDelivery()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString contentIndexDir = tempDir.path() + "/content-index";
+    createIndex(contentIndexDir, SearchType::Content);
+
+    ContentRetriever retriever;
+    retriever.setIndexDirectory(SearchType::Content, contentIndexDir);
+    QSignalSpy readySpy(&retriever, &ContentRetriever::highlightsReady);
+    QSignalSpy finishedSpy(&retriever, &ContentRetriever::highlightsFinished);
+
+    QStringList paths;
+    for (int i = 0; i < 100; ++i)
+        paths.append(i % 2 ? "/tmp/doc-a.txt" : "/tmp/doc-b.txt");
+
+    // 取消前已算完的批次也不再投递
+    const int requestId = retriever.requestHighlights(paths, "budget", SearchType::Content);
+    QVERIFY(requestId >= 0);
+    retriever.cancelHighlights(requestId);
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, 10000);
+    QCOMPARE(finishedSpy.first().at(0).toInt(), requestId);
+    QCOMPARE(readySpy.count(), 0);
+
+    // 析构时等待仍在执行的任务结束
+    auto pending = std::make_unique<ContentRetriever>();
+    pending->setIndexDirectory(SearchType::Content, contentIndexDir);
+    QVERIFY(pending->requestHighlights(paths, "budget", SearchType::Content) >= 0);
+    pending.reset();
+}
+
 void tst_ContentRetriever::fetchPreview_noKeyword()
 {
     QTemporaryDir tempDir;
@@ -473,6 +661,76 @@ void tst_ContentRetriever::plainSnippet_basic()
     }
 }
 
+void tst_ContentRetriever::termOffsetHighlighter_matchesTextScan()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QString content;
+    for (int i = 0; i < 12; ++i)
+        content += QString("Paragraph %1 talks about the weather and nothing else.\n").arg(i);
+    content += QString("The   yearly Budget review is attached to the meeting notes.\n");
+    for (int i = 0; i < 4; ++i)
+        content += QString("Filler line %1 without any of the search terms.\n").arg(i);
+    content += QString("Second budget mention near the end.");
+    const std::wstring stored = content.toStdWString();
+
+    // 同一份文本分别以带偏移的词向量和不带词向量建立索引
+    const QString offsetIndexDir = tempDir.path() + "/offset-index";
+    const QString plainIndexDir = tempDir.path() + "/plain-index";
+    for (const QString &indexDir : { offsetIndexDir, plainIndexDir }) {
+        QDir().mkpath(indexDir);
+        IndexWriterPtr writer = newLucene<IndexWriter>(
+                FSDirectory::open(indexDir.toStdWString()),
+                newLucene<NGramAnalyzer>(1, 2),
+                true,
+                IndexWriter::MaxFieldLengthLIMITED);
+        DocumentPtr doc = newLucene<Document>();
+        doc->add(newLucene<Field>(LuceneFieldNames::Content::kContents, stored, Field::STORE_YES, Field::INDEX_ANALYZED,
+                                  indexDir == offsetIndexDir ? Field::TERM_VECTOR_WITH_POSITIONS_OFFSETS : Field::TERM_VECTOR_NO));
+        writer->addDocument(doc);
+        writer->close();
+    }
+
+    const IndexReaderPool::Lease offsetLease = IndexReaderPool::instance()->acquire(offsetIndexDir);
+    QVERIFY(offsetLease);
+    const TermOffsetHighlighter highlighter(offsetLease.reader(), 0, LuceneFieldNames::Content::kContents, stored);
+    QVERIFY(highlighter.isAvailable());
+    QCOMPARE(highlighter.charCount(), content.size());
+
+    const QList<QStringList> keywordLists = {
+        { "budget" },
+        { "notepad", "notes" },
+        { "notes", "budget" },
+        { "BUDGET", "weather" },
+    };
+    for (const QStringList &keywords : keywordLists) {
+        const std::optional<QString> highlighted = highlighter.customHighlight(keywords, 50, true);
+        QVERIFY(highlighted.has_value());
+        QCOMPARE(*highlighted, ContentHighlighter::customHighlight(keywords, content, 50, true));
+
+        const auto plain = highlighter.plainSnippet(keywords, 50, 50);
+        const ContentHighlighter::PlainSnippetResult expected = ContentHighlighter::plainSnippet(keywords, content, 50, 50);
+        QVERIFY(plain.has_value());
+        QCOMPARE(plain->content, expected.content);
+        QCOMPARE(plain->snippetOffset, expected.snippetOffset);
+    }
+
+    // 关键词不在文中时交给全文扫描
+    QVERIFY(!highlighter.customHighlight({ "missing" }, 50, true).has_value());
+
+    // 首个 n-gram 不在词向量中的关键词无法判断，不能跳过它去定位后面的关键词
+    QVERIFY(!highlighter.customHighlight({ "missing", "notes" }, 50, true).has_value());
+    QVERIFY(!highlighter.plainSnippet({ "missing", "notes" }, 50, 50).has_value());
+
+    // 没有词向量的索引回退到全文扫描
+    const IndexReaderPool::Lease plainLease = IndexReaderPool::instance()->acquire(plainIndexDir);
+    QVERIFY(plainLease);
+    const TermOffsetHighlighter fallback(plainLease.reader(), 0, LuceneFieldNames::Content::kContents, stored);
+    QVERIFY(!fallback.isAvailable());
+    QVERIFY(!fallback.customHighlight({ "budget" }, 50, true).has_value());
+}
+
 QObject *create_tst_ContentRetriever()
 {
     return new tst_ContentRetriever();
@@ -8,6 +8,7 @@
 
 #include <stubext.h>
 
+#include <dfm-search/contentretriever.h>
 #include <dfm-search/contentsearchapi.h>
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/field_names.h>
@@ -103,6 +104,22 @@ void createContentIndex(const QString &indexDir, const QList<TestDocument> &docu
     writer->close();
 }
 
+// 以追加方式打开写入器，每次关闭都会在索引中新增一个段
+void appendContentSegment(const QString &indexDir, const QList<TestDocument> &documents)
+{
+    IndexWriterPtr writer = newLucene<IndexWriter>(
+            FSDirectory::open(indexDir.toStdWString()),
+            newLucene<NGramAnalyzer>(1, 2),
+            false,
+            IndexWriter::MaxFieldLengthLIMITED);
+
+    for (const TestDocument &doc : documents) {
+        writer->addDocument(buildDocument(doc));
+    }
+
+    writer->close();
+}
+
 void createOcrIndex(const QString &indexDir, const QList<TestDocument> &documents)
 {
     QDir().mkpath(indexDir);
@@ -148,6 +165,8 @@ class tst_ContentSearchEngine : public QObject
 
 private Q_SLOTS:
     void search_simpleContent_usesTemporaryIndex();
+    void search_deferredHighlight_fetchesOnDemand();
+    void search_parallelSegments_matchesSequential();
     void search_booleanAnd_matchesContentOnly();
     void search_booleanOr_matchesAnyContent();
     void search_booleanOr_matchesAnyOfThreeContents();
@@ -188,6 +207,103 @@ void tst_ContentSearchEngine::search_simpleContent_usesTemporaryIndex()
     QCOMPARE(resultPaths(expected), QStringList { rootDir + "/alpha-report.txt" });
 }
 
+void tst_ContentSearchEngine::search_deferredHighlight_fetchesOnDemand()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/content-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    createContentIndex(indexDir, {
+                                     { rootDir + "/alpha-report.txt", "alpha-report.txt", "alpha budget summary", rootDir },
+                             });
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::contentIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    SearchOptions options = createBaseOptions(rootDir, indexDir);
+    ContentOptionsAPI contentOptions(options);
+    contentOptions.setFullTextRetrievalEnabled(true);
+    contentOptions.setDeferredHighlightEnabled(true);
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::Content));
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("budget"));
+    QVERIFY(expected.hasValue());
+    QCOMPARE(expected.value().size(), 1);
+
+    // 结果不携带全文相关字段，仅标记为延迟高亮
+    SearchResult result = expected.value().first();
+    ContentResultAPI resultApi(result);
+    QVERIFY(resultApi.isHighlightDeferred());
+    QVERIFY(resultApi.highlightedContent().isEmpty());
+    QCOMPARE(resultApi.charCount(), 0);
+
+    ContentRetriever retriever;
+    retriever.setIndexDirectory(SearchType::Content, indexDir);
+    QVERIFY(retriever.fetchHighlight(result.path(), "budget", SearchType::Content).contains("budget"));
+}
+
+void tst_ContentSearchEngine::search_parallelSegments_matchesSequential()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/content-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    createContentIndex(indexDir, {
+                                     { rootDir + "/alpha-report.txt", "alpha-report.txt", "alpha budget summary", rootDir },
+                                     { rootDir + "/meeting-notes.txt", "meeting-notes.txt", "meeting notes and timeline", rootDir },
+                             });
+    for (int segment = 1; segment <= 5; ++segment) {
+        QList<TestDocument> documents;
+        for (int i = 0; i < 4; ++i) {
+            const QString filename = QStringLiteral("segment%1-%2.txt").arg(segment).arg(i);
+            documents.append({ rootDir + "/" + filename, filename,
+                               i % 2 == 0 ? "quarterly budget review" : "travel notes", rootDir });
+        }
+        appendContentSegment(indexDir, documents);
+    }
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::contentIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    const auto search = [&](bool parallel, int maxResults) {
+        SearchOptions options = createBaseOptions(rootDir, indexDir);
+        options.setMaxResults(maxResults);
+        ContentOptionsAPI contentOptions(options);
+        contentOptions.setFullTextRetrievalEnabled(true);
+        contentOptions.setParallelSegmentSearchEnabled(parallel);
+
+        std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::Content));
+        engine->setSearchOptions(options);
+
+        QStringList rows;
+        const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("budget"));
+        if (expected.hasValue()) {
+            for (SearchResult result : expected.value())
+                rows.append(result.path() + "|" + ContentResultAPI(result).highlightedContent());
+        }
+        return rows;
+    };
+
+    // 并行搜索与串行搜索的结果、顺序和高亮完全一致，包括截断到 maxResults 的情况
+    const QStringList sequential = search(false, 0);
+    QCOMPARE(sequential.size(), 11);
+    QCOMPARE(search(true, 0), sequential);
+    QCOMPARE(search(true, 5), search(false, 5));
+    QCOMPARE(search(true, 5).size(), 5);
+}
+
 void tst_ContentSearchEngine::search_booleanAnd_matchesContentOnly()
 {
     QTemporaryDir tempDir;
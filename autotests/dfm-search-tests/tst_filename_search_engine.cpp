@@ -5,6 +5,8 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QSet>
+#include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QTest>
 
@@ -15,6 +17,8 @@
 #include <dfm-search/filenamesearchapi.h>
 #include <dfm-search/searchengine.h>
 #include <dfm-search/searcherror.h>
+#include <dfm-search/searchstatistics.h>
+#include <dfm-search-lib/utils/filenameresultcache.h>
 
 #include <lucene++/Document.h>
 #include <lucene++/FSDirectory.h>
@@ -39,6 +43,7 @@ struct TestDocument
     QString pinyinAcronym;
     QString hidden = "N";
     qint64 modifyTime = 1710000000;
+    bool hasModifyTime = true;
     qint64 birthTime = 1700000000;
     qint64 fileSize = 1024;
     QString fileSizeStr = "1 KB";
@@ -82,10 +87,12 @@ DocumentPtr buildDocument(const TestDocument &docData)
                               Field::STORE_YES, Field::INDEX_ANALYZED));
     doc->add(newLucene<Field>(LuceneFieldNames::FileName::kIsHidden, docData.hidden.toStdWString(),
                               Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
-    NumericFieldPtr modifyTimeField = newLucene<NumericField>(LuceneFieldNames::FileName::kModifyTime,
-                                                              Field::STORE_YES, true);
-    modifyTimeField->setLongValue(docData.modifyTime);
-    doc->add(modifyTimeField);
+    if (docData.hasModifyTime) {
+        NumericFieldPtr modifyTimeField = newLucene<NumericField>(LuceneFieldNames::FileName::kModifyTime,
+                                                                  Field::STORE_YES, true);
+        modifyTimeField->setLongValue(docData.modifyTime);
+        doc->add(modifyTimeField);
+    }
 
     NumericFieldPtr birthTimeField = newLucene<NumericField>(LuceneFieldNames::FileName::kBirthTime,
                                                              Field::STORE_YES, true);
@@ -179,6 +186,8 @@ class tst_FileNameSearchEngine : public QObject
 
 private Q_SLOTS:
     void search_simpleKeyword_matchesIndexedFilename();
+    void search_refinedKeyword_matchesAndFollowsIndexUpdates();
+    void search_refinedKeyword_equalsUncachedSearch();
     void search_booleanAnd_requiresAllTerms();
     void search_booleanOr_matchesAnyTerm();
     void search_booleanOr_matchesAnyOfThreeTerms();
@@ -192,18 +201,27 @@ private Q_SLOTS:
     void search_sizeAndTimeFilters_applyOnIndexedFields();
     void search_pinyinAndAcronym_queriesMatchIndexedFields();
     void search_detailedResults_populatesExtendedAttributes();
+    void search_maxResults_stopsCollectingAtLimit();
+    void search_resultSort_returnsTopKInOrder();
+    void search_resultSort_missingKeySortsLast();
+    void search_streaming_deliversBoundedChunksWithoutAggregation();
+    void search_statistics_deliveredBeforeFinished();
     void search_emptyKeywordWithoutFilters_returnsValidationError();
     void search_invalidFileType_returnsValidationError();
     void realtime_simpleKeyword_matchesFilesystemEntries();
     void realtime_booleanAndOr_andWildcard_queriesWork();
     void realtime_extensionFilters_areApplied();
     void realtime_hiddenAndExcludedPath_filtersWork();
+    void realtime_excludedPath_matchesPathBoundary();
     void realtime_sizeAndTimeFilters_applyWithoutIndex();
     void realtime_detailedResults_populateAttributes();
     void realtime_pinyinOption_doesNotProducePinyinMatches();
     void realtime_symlinkDirName_matchesInResults();
     void realtime_symlinkDir_notRecursedInto();
     void realtime_circularSymlinkDir_deduplicated();
+    void realtime_parallelWalk_findsNestedEntriesAndRespectsMaxResults();
+    void realtime_concurrentEngines_runOnSharedExecutor();
+    void realtime_statistics_countDirectoriesAndStatCalls();
 };
 
 void tst_FileNameSearchEngine::search_simpleKeyword_matchesIndexedFilename()
@@ -234,6 +252,101 @@ void tst_FileNameSearchEngine::search_simpleKeyword_matchesIndexedFilename()
     QCOMPARE(resultPaths(expected), QStringList { rootDir + "/alpha-report.txt" });
 }
 
+void tst_FileNameSearchEngine::search_refinedKeyword_matchesAndFollowsIndexUpdates()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    createFileNameIndex(indexDir, {
+                                      { rootDir + "/Report.txt", "Report.txt", "doc", "txt" },
+                                      { rootDir + "/reputation.txt", "reputation.txt", "doc", "txt" },
+                                      { rootDir + "/notes.txt", "notes.txt", "doc", "txt" },
+                              });
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(createBaseOptions(rootDir));
+
+    auto sortedPaths = [&engine](const QString &keyword) {
+        const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery(keyword));
+        QStringList paths = expected.hasValue() ? resultPaths(expected) : QStringList();
+        paths.sort();
+        return paths;
+    };
+
+    // 边输入边搜索：后续查询可由前一次结果在内存中细化
+    QCOMPARE(sortedPaths("rep"), (QStringList { rootDir + "/Report.txt", rootDir + "/reputation.txt" }));
+    QCOMPARE(sortedPaths("repo"), QStringList { rootDir + "/Report.txt" });
+    QCOMPARE(sortedPaths("REPU"), QStringList { rootDir + "/reputation.txt" });
+    QCOMPARE(sortedPaths("repx"), QStringList());
+
+    // 索引更新后缓存失效，新文档可以被搜到
+    createFileNameIndex(indexDir, {
+                                      { rootDir + "/Report.txt", "Report.txt", "doc", "txt" },
+                                      { rootDir + "/report-2.txt", "report-2.txt", "doc", "txt" },
+                              });
+    QCOMPARE(sortedPaths("repo"), (QStringList { rootDir + "/Report.txt", rootDir + "/report-2.txt" }));
+}
+
+void tst_FileNameSearchEngine::search_refinedKeyword_equalsUncachedSearch()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    createFileNameIndex(indexDir, {
+                                      { rootDir + "/Annual Report.txt", "Annual Report.txt", "doc", "txt" },
+                                      { rootDir + "/annual-report.txt", "annual-report.txt", "doc", "txt" },
+                                      { rootDir + "/ANNUAL report 2024.txt", "ANNUAL report 2024.txt", "doc", "txt" },
+                                      { rootDir + "/annualreport.txt", "annualreport.txt", "doc", "txt" },
+                                      { rootDir + "/manual.txt", "manual.txt", "doc", "txt" },
+                              });
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(createBaseOptions(rootDir));
+
+    auto sortedPaths = [&engine](const QString &keyword) {
+        const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery(keyword));
+        QStringList paths = expected.hasValue() ? resultPaths(expected) : QStringList();
+        paths.sort();
+        return paths;
+    };
+
+    // 先用短关键词填充缓存，再与清空缓存后直接查询索引的结果比较
+    const QStringList keywords { "AnnuaL", "annual R", "ANNUAL report", "l r", "nualRe" };
+    for (const QString &keyword : keywords) {
+        FileNameResultCache::instance()->clear();
+        QVERIFY(!sortedPaths("nu").isEmpty());
+        QCOMPARE(engine->lastStatistics().counter(SearchStatistics::Counter::CacheHits), qint64(0));
+        const QStringList refined = sortedPaths(keyword);
+        // 含空格的关键词不能由缓存细化，仍然查询索引
+        const qint64 expectedCacheHits = FileNameResultCache::isRefinableKeyword(keyword) ? 1 : 0;
+        QCOMPARE(engine->lastStatistics().counter(SearchStatistics::Counter::CacheHits), expectedCacheHits);
+
+        FileNameResultCache::instance()->clear();
+        QCOMPARE(refined, sortedPaths(keyword));
+        QCOMPARE(engine->lastStatistics().counter(SearchStatistics::Counter::CacheHits), qint64(0));
+    }
+
+    FileNameResultCache::instance()->clear();
+}
+
 void tst_FileNameSearchEngine::search_booleanAnd_requiresAllTerms()
 {
     QTemporaryDir tempDir;
@@ -699,6 +812,248 @@ void tst_FileNameSearchEngine::search_detailedResults_populatesExtendedAttribute
     QCOMPARE(api.isHidden(), false);
 }
 
+void tst_FileNameSearchEngine::search_maxResults_stopsCollectingAtLimit()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    QList<TestDocument> documents;
+    for (int i = 0; i < 6; ++i) {
+        const QString name = QString("report-%1.txt").arg(i);
+        documents.append({ rootDir + "/" + name, name, "doc", "txt" });
+    }
+    createFileNameIndex(indexDir, documents);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    SearchOptions options = createBaseOptions(rootDir);
+    options.setMaxResults(3);
+    options.setDetailedResultsEnabled(true);
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("report"));
+    QVERIFY(expected.hasValue());
+
+    const SearchResultList results = expected.value();
+    QCOMPARE(results.size(), 3);
+    QSet<QString> uniquePaths;
+    for (SearchResult result : results) {
+        FileNameResultAPI api(result);
+        QVERIFY(result.path().startsWith(rootDir + "/report-"));
+        QCOMPARE(api.filename(), QFileInfo(result.path()).fileName());
+        uniquePaths.insert(result.path());
+    }
+    QCOMPARE(uniquePaths.size(), 3);
+}
+
+void tst_FileNameSearchEngine::search_resultSort_returnsTopKInOrder()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    // 索引顺序与时间、大小、名称的顺序都不一致
+    const QList<QPair<QString, qint64>> entries {
+        { "report-c.txt", 1710000300 }, { "Report-e.txt", 1710000100 }, { "report-a.txt", 1710000500 },
+        { "report-f.txt", 1710000200 }, { "REPORT-b.txt", 1710000600 }, { "report-d.txt", 1710000400 }
+    };
+    QList<TestDocument> documents;
+    for (int i = 0; i < entries.size(); ++i) {
+        TestDocument doc { rootDir + "/" + entries[i].first, entries[i].first, "doc", "txt" };
+        doc.modifyTime = entries[i].second;
+        doc.fileSize = 100 * ((i * 5) % entries.size() + 1);
+        documents.append(doc);
+    }
+    createFileNameIndex(indexDir, documents);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    const auto search = [&rootDir](ResultSortKey key, Qt::SortOrder order, int maxResults) {
+        SearchOptions options = createBaseOptions(rootDir);
+        options.setMaxResults(maxResults);
+        options.setResultSort(key, order);
+
+        std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+        engine->setSearchOptions(options);
+        QStringList names;
+        // 通配符查询使用小写的 file_name_lower 字段，与名称大小写无关
+        for (const QString &path : resultPaths(engine->searchSync(createWildcardQuery("report*"))))
+            names.append(QFileInfo(path).fileName());
+        return names;
+    };
+
+    QCOMPARE(search(ResultSortKey::ModifyTime, Qt::DescendingOrder, 3),
+             QStringList({ "REPORT-b.txt", "report-a.txt", "report-d.txt" }));
+    QCOMPARE(search(ResultSortKey::ModifyTime, Qt::AscendingOrder, 2),
+             QStringList({ "Report-e.txt", "report-f.txt" }));
+    // 大小依次为 100、600、500、400、300、200
+    QCOMPARE(search(ResultSortKey::FileSize, Qt::DescendingOrder, 2),
+             QStringList({ "Report-e.txt", "report-a.txt" }));
+    QCOMPARE(search(ResultSortKey::FileName, Qt::AscendingOrder, 4),
+             QStringList({ "report-a.txt", "REPORT-b.txt", "report-c.txt", "report-d.txt" }));
+    QCOMPARE(search(ResultSortKey::FileName, Qt::DescendingOrder, -1),
+             QStringList({ "report-f.txt", "Report-e.txt", "report-d.txt", "report-c.txt", "REPORT-b.txt", "report-a.txt" }));
+}
+
+void tst_FileNameSearchEngine::search_resultSort_missingKeySortsLast()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    // 缺少修改时间的文档在字段缓存中读作 0，不能因此排在升序最前
+    QList<TestDocument> documents;
+    for (const QString &name : { QString("report-a.txt"), QString("report-b.txt"), QString("report-c.txt") })
+        documents.append(TestDocument { rootDir + "/" + name, name, "doc", "txt" });
+    documents[0].modifyTime = 1710000300;
+    documents[1].hasModifyTime = false;
+    documents[2].modifyTime = 1710000100;
+    createFileNameIndex(indexDir, documents);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    const auto search = [&rootDir](Qt::SortOrder order, int maxResults) {
+        SearchOptions options = createBaseOptions(rootDir);
+        options.setMaxResults(maxResults);
+        options.setResultSort(ResultSortKey::ModifyTime, order);
+
+        std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+        engine->setSearchOptions(options);
+        QStringList names;
+        for (const QString &path : resultPaths(engine->searchSync(createWildcardQuery("report*"))))
+            names.append(QFileInfo(path).fileName());
+        return names;
+    };
+
+    QCOMPARE(search(Qt::AscendingOrder, 2), QStringList({ "report-c.txt", "report-a.txt" }));
+    QCOMPARE(search(Qt::AscendingOrder, -1), QStringList({ "report-c.txt", "report-a.txt", "report-b.txt" }));
+    QCOMPARE(search(Qt::DescendingOrder, -1), QStringList({ "report-a.txt", "report-c.txt", "report-b.txt" }));
+}
+
+void tst_FileNameSearchEngine::search_streaming_deliversBoundedChunksWithoutAggregation()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    QList<TestDocument> documents;
+    for (int i = 0; i < 5; ++i) {
+        const QString name = QString("report-%1.txt").arg(i);
+        documents.append({ rootDir + "/" + name, name, "doc", "txt" });
+    }
+    createFileNameIndex(indexDir, documents);
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    SearchOptions options = createBaseOptions(rootDir);
+    options.setStreamingChunkSize(2);
+    options.setResultAggregationEnabled(false);
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(options);
+
+    QList<int> chunkSizes;
+    QSet<QString> streamedPaths;
+    QObject::connect(engine.get(), &SearchEngine::resultsFound, [&](const SearchResultList &results) {
+        chunkSizes.append(results.size());
+        for (const SearchResult &result : results)
+            streamedPaths.insert(result.path());
+    });
+
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("report"));
+    QVERIFY(expected.hasValue());
+
+    // 不汇总时完成结果为空，所有结果只经由块推送
+    QVERIFY(expected.value().isEmpty());
+    QCOMPARE(streamedPaths.size(), 5);
+    QVERIFY(chunkSizes.size() >= 3);
+    for (int size : chunkSizes)
+        QVERIFY(size > 0 && size <= 2);
+}
+
+void tst_FileNameSearchEngine::search_statistics_deliveredBeforeFinished()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    const QString indexDir = tempDir.path() + "/filename-index";
+    QVERIFY(QDir().mkpath(rootDir));
+
+    createFileNameIndex(indexDir, {
+                                      { rootDir + "/alpha-report.txt", "alpha-report.txt", "doc", "txt" },
+                                      { rootDir + "/beta-report.txt", "beta-report.txt", "doc", "txt" },
+                                      { rootDir + "/meeting-notes.txt", "meeting-notes.txt", "doc", "txt" },
+                              });
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(DFMSEARCH::Global::fileNameIndexDirectory, [&indexDir]() {
+        return indexDir;
+    });
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(createBaseOptions(rootDir));
+
+    // 统计信号先于完成信号到达，完成时 lastStatistics() 已是完整记录
+    QStringList signalOrder;
+    SearchStatistics delivered;
+    QObject::connect(engine.get(), &SearchEngine::searchStatisticsReady, [&](const SearchStatistics &stats) {
+        signalOrder.append("statistics");
+        delivered = stats;
+    });
+    QObject::connect(engine.get(), &SearchEngine::searchFinished, [&](const SearchResultList &) {
+        signalOrder.append("finished");
+    });
+
+    QSignalSpy finishedSpy(engine.get(), &SearchEngine::searchFinished);
+    engine->search(SearchQuery::createSimpleQuery("report"));
+    QVERIFY(finishedSpy.wait(5000));
+
+    QCOMPARE(signalOrder, (QStringList { "statistics", "finished" }));
+    QCOMPARE(delivered.counter(SearchStatistics::Counter::Hits), qint64(2));
+    QVERIFY(delivered.totalNanoseconds() > 0);
+    QVERIFY(delivered.phaseNanoseconds(SearchStatistics::Phase::Collect) > 0);
+    QVERIFY(delivered.phaseNanoseconds(SearchStatistics::Phase::Collect) <= delivered.totalNanoseconds());
+    QCOMPARE(delivered.counter(SearchStatistics::Counter::DirectoriesVisited), qint64(0));
+    QCOMPARE(engine->lastStatistics().toVariantMap(), delivered.toVariantMap());
+
+    const QVariantMap map = delivered.toVariantMap();
+    QCOMPARE(map.value("counters").toMap().value("hits").toLongLong(), qint64(2));
+    QVERIFY(map.value("phasesMs").toMap().contains("queryBuild"));
+
+    // 新的搜索从零开始计数
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("meeting"));
+    QVERIFY(expected.hasValue());
+    QCOMPARE(engine->lastStatistics().counter(SearchStatistics::Counter::Hits), qint64(1));
+}
+
 void tst_FileNameSearchEngine::search_emptyKeywordWithoutFilters_returnsValidationError()
 {
     QTemporaryDir tempDir;
@@ -849,6 +1204,29 @@ void tst_FileNameSearchEngine::realtime_hiddenAndExcludedPath_filtersWork()
     QVERIFY(paths.contains(rootDir + "/.hidden-plan.txt"));
 }
 
+void tst_FileNameSearchEngine::realtime_excludedPath_matchesPathBoundary()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // 排除 fo 不应影响同级的 foo，排除路径带末尾斜杠时同样生效
+    const QString rootDir = tempDir.path() + "/docs";
+    QVERIFY(QDir().mkpath(rootDir + "/fo/sub"));
+    QVERIFY(QDir().mkpath(rootDir + "/foo"));
+    QVERIFY(createFileWithSize(rootDir + "/fo/sub/plan.txt", 8));
+    QVERIFY(createFileWithSize(rootDir + "/foo/plan.txt", 8));
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+
+    SearchOptions options = createRealtimeOptions(rootDir);
+    options.setSearchExcludedPaths({ rootDir + "/fo/" });
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("plan"));
+    QVERIFY(expected.hasValue());
+    QCOMPARE(resultPaths(expected), QStringList { rootDir + "/foo/plan.txt" });
+}
+
 void tst_FileNameSearchEngine::realtime_sizeAndTimeFilters_applyWithoutIndex()
 {
     QTemporaryDir tempDir;
@@ -1033,6 +1411,118 @@ void tst_FileNameSearchEngine::realtime_circularSymlinkDir_deduplicated()
     QCOMPARE(paths.first(), symlinkDir);
 }
 
+void tst_FileNameSearchEngine::realtime_parallelWalk_findsNestedEntriesAndRespectsMaxResults()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    QStringList expectedPaths;
+    for (int i = 0; i < 8; ++i) {
+        const QString subDir = rootDir + QString("/dir%1/nested%1").arg(i);
+        QVERIFY(QDir().mkpath(subDir));
+        for (int j = 0; j < 5; ++j) {
+            const QString filePath = subDir + QString("/match-%1-%2.txt").arg(i).arg(j);
+            QVERIFY(createFileWithSize(filePath, 8));
+            expectedPaths.append(filePath);
+        }
+        QVERIFY(createFileWithSize(subDir + "/other.txt", 8));
+    }
+
+    SearchOptions options = createRealtimeOptions(rootDir);
+    options.setMaxThreadCount(4);
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected allExpected = engine->searchSync(SearchQuery::createSimpleQuery("match"));
+    QVERIFY(allExpected.hasValue());
+    QStringList paths = resultPaths(allExpected);
+    paths.sort();
+    expectedPaths.sort();
+    QCOMPARE(paths, expectedPaths);
+
+    options.setMaxResults(7);
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected limitedExpected = engine->searchSync(SearchQuery::createSimpleQuery("match"));
+    QVERIFY(limitedExpected.hasValue());
+    QCOMPARE(limitedExpected.value().size(), 7);
+}
+
+void tst_FileNameSearchEngine::realtime_concurrentEngines_runOnSharedExecutor()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    QVERIFY(QDir().mkpath(rootDir));
+    QVERIFY(createFileWithSize(rootDir + "/alpha.txt", 8));
+    QVERIFY(createFileWithSize(rootDir + "/beta.txt", 8));
+    QVERIFY(createFileWithSize(rootDir + "/gamma.txt", 8));
+
+    const QStringList keywords { "alpha", "beta", "gamma" };
+    std::vector<std::unique_ptr<SearchEngine>> engines;
+    std::vector<std::unique_ptr<QSignalSpy>> spies;
+    for (const QString &keyword : keywords) {
+        SearchOptions options = createRealtimeOptions(rootDir);
+        options.setSearchPriority(keywords.indexOf(keyword));
+
+        engines.emplace_back(SearchEngine::create(SearchType::FileName));
+        engines.back()->setSearchOptions(options);
+        spies.emplace_back(new QSignalSpy(engines.back().get(), &SearchEngine::searchFinished));
+        engines.back()->search(SearchQuery::createSimpleQuery(keyword));
+    }
+
+    // 引擎不再各自持有线程，多个异步搜索共享执行器并各自完成
+    for (size_t i = 0; i < engines.size(); ++i) {
+        QSignalSpy &spy = *spies[i];
+        QVERIFY(spy.count() > 0 || spy.wait(5000));
+        const SearchResultList results = spy.takeFirst().at(0).value<SearchResultList>();
+        QCOMPARE(results.size(), 1);
+        QCOMPARE(results.first().path(), rootDir + "/" + keywords.at(static_cast<int>(i)) + ".txt");
+    }
+
+    // 搜索进行中销毁引擎应等待策略退出而不是崩溃
+    std::unique_ptr<SearchEngine> transient(SearchEngine::create(SearchType::FileName));
+    transient->setSearchOptions(createRealtimeOptions(rootDir));
+    transient->search(SearchQuery::createSimpleQuery("alpha"));
+    transient.reset();
+}
+
+void tst_FileNameSearchEngine::realtime_statistics_countDirectoriesAndStatCalls()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString rootDir = tempDir.path() + "/docs";
+    for (int i = 0; i < 3; ++i) {
+        const QString subDir = rootDir + QString("/dir%1").arg(i);
+        QVERIFY(QDir().mkpath(subDir));
+        QVERIFY(createFileWithSize(subDir + "/plan.txt", 8));
+        QVERIFY(createFileWithSize(subDir + "/other.txt", 8));
+    }
+
+    SearchOptions options = createRealtimeOptions(rootDir);
+    options.setDetailedResultsEnabled(true);
+
+    std::unique_ptr<SearchEngine> engine(SearchEngine::create(SearchType::FileName));
+    engine->setSearchOptions(options);
+
+    const SearchResultExpected expected = engine->searchSync(SearchQuery::createSimpleQuery("plan"));
+    QVERIFY(expected.hasValue());
+    QCOMPARE(expected.value().size(), 3);
+
+    // 根目录和三个子目录都被读取，实时搜索不打开索引、不加载文档
+    const SearchStatistics stats = engine->lastStatistics();
+    QCOMPARE(stats.counter(SearchStatistics::Counter::Hits), qint64(3));
+    QCOMPARE(stats.counter(SearchStatistics::Counter::DirectoriesVisited), qint64(4));
+    QVERIFY(stats.counter(SearchStatistics::Counter::StatCalls) > 0);
+    QCOMPARE(stats.counter(SearchStatistics::Counter::DocumentsLoaded), qint64(0));
+    QCOMPARE(stats.phaseNanoseconds(SearchStatistics::Phase::IndexOpen), qint64(0));
+    QVERIFY(stats.phaseNanoseconds(SearchStatistics::Phase::Collect) > 0);
+}
+
 QObject *create_tst_FileNameSearchEngine()
 {
     return new tst_FileNameSearchEngine();
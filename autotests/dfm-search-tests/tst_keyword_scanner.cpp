@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <QElapsedTimer>
+#include <QTest>
+
+#include "utils/contenthighlighter.h"
+#include "utils/keywordscanner.h"
+
+using namespace dfmsearch;
+
+namespace {
+
+// 约 2M 字符的测试文本，关键词只出现在末尾，迫使扫描遍历全文
+QString largeText(bool chinese)
+{
+    const QString line = chinese
+            ? QStringLiteral("这是一段用于性能测试的中文文本，其中包含会议纪要和项目进度说明。\n")
+            : QStringLiteral("This is a line of English filler text used for the scanner benchmark.\n");
+    QString text;
+    text.reserve(2 * 1024 * 1024 + 128);
+    while (text.size() < 2 * 1024 * 1024)
+        text += line;
+    text += chinese ? QStringLiteral("年度预算报告在最后。") : QStringLiteral("The yearly Budget report is last.");
+    return text;
+}
+
+// 旧实现：每个关键词各扫描一遍，并逐个插入标记
+QString referenceHighlight(const QString &text, const QStringList &keywords)
+{
+    QString result = text;
+    for (const QString &keyword : keywords) {
+        int pos = 0;
+        while ((pos = result.indexOf(keyword, pos, Qt::CaseInsensitive)) != -1) {
+            result.insert(pos + keyword.length(), "</b>");
+            result.insert(pos, "<b>");
+            pos += keyword.length() + 7;
+        }
+    }
+    return result;
+}
+
+}   // namespace
+
+class tst_KeywordScanner : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void firstAndEarliest_followKeywordOrder();
+    void caseFolding_matchesChineseAndLatin();
+    void wildcards_matchWithinLine();
+    void wildcards_manyStarsStayLinear();
+    void highlight_singlePassWithoutNestedTags();
+    void customHighlight_usesWildcards();
+    void benchmarkScan_data();
+    void benchmarkScan();
+};
+
+void tst_KeywordScanner::firstAndEarliest_followKeywordOrder()
+{
+    const QString text = QStringLiteral("budget first, then meeting Notes, then budget again");
+    const KeywordScanner scanner({ "missing", "notes", "budget" });
+    QVERIFY(!scanner.isEmpty());
+
+    const KeywordScanner::Match first = scanner.firstInKeywordOrder(text);
+    QCOMPARE(first.keyword, 1);
+    QCOMPARE(first.position, text.indexOf("Notes"));
+    QCOMPARE(first.length, 5);
+
+    const KeywordScanner::Match earliest = scanner.earliest(text);
+    QCOMPARE(earliest.keyword, 2);
+    QCOMPARE(earliest.position, 0);
+
+    QVERIFY(!scanner.firstInKeywordOrder("nothing here").isValid());
+    QVERIFY(KeywordScanner({ "", "*", "??" }).isEmpty());
+}
+
+void tst_KeywordScanner::caseFolding_matchesChineseAndLatin()
+{
+    const KeywordScanner scanner({ "预算", "ÉTÉ" });
+    const QString text = QStringLiteral("l'été dernier, 年度预算报告");
+
+    const QVector<KeywordScanner::Match> found = scanner.matches(text);
+    QCOMPARE(found.size(), 2);
+    QCOMPARE(found.at(0).position, 2);
+    QCOMPARE(found.at(0).keyword, 1);
+    QCOMPARE(text.mid(found.at(1).position, found.at(1).length), QStringLiteral("预算"));
+}
+
+void tst_KeywordScanner::wildcards_matchWithinLine()
+{
+    const QString text = QStringLiteral("the bud\nget and the budget");
+
+    // '*' 不跨行，取最短匹配
+    const KeywordScanner star({ "bud*t" });
+    const KeywordScanner::Match starMatch = star.firstInKeywordOrder(text);
+    QCOMPARE(text.mid(starMatch.position, starMatch.length), QStringLiteral("budget"));
+    QCOMPARE(starMatch.position, text.lastIndexOf("budget"));
+
+    const KeywordScanner question({ "?udg?t" });
+    const KeywordScanner::Match questionMatch = question.earliest(text);
+    QCOMPARE(text.mid(questionMatch.position, questionMatch.length), QStringLiteral("budget"));
+
+    // 首尾的 '*' 不扩展匹配范围
+    const KeywordScanner outer({ "*dge*" });
+    const KeywordScanner::Match outerMatch = outer.earliest(text);
+    QCOMPARE(text.mid(outerMatch.position, outerMatch.length), QStringLiteral("dge"));
+}
+
+void tst_KeywordScanner::wildcards_manyStarsStayLinear()
+{
+    // 每个 'a' 都命中锚点，多个 '*' 的回溯不能随 '*' 的个数指数增长
+    QString text(4000, QLatin1Char('a'));
+    const KeywordScanner scanner({ "a*a*a*x" });
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!scanner.earliest(text).isValid());
+    QVERIFY2(timer.elapsed() < 5000, qPrintable(QString::number(timer.elapsed())));
+
+    text += QLatin1Char('x');
+    const KeywordScanner::Match match = scanner.earliest(text);
+    QVERIFY(match.isValid());
+    QCOMPARE(match.position + match.length, text.size());
+    QVERIFY(match.position > 0);
+}
+
+void tst_KeywordScanner::highlight_singlePassWithoutNestedTags()
+{
+    const KeywordScanner scanner({ "b", "bud", "budget" });
+    QCOMPARE(scanner.highlight(QStringLiteral("Budget b bud")),
+             QStringLiteral("<b>Budget</b> <b>b</b> <b>bud</b>"));
+
+    // 没有匹配时原样返回
+    QCOMPARE(scanner.highlight(QStringLiteral("none")), QStringLiteral("none"));
+    QCOMPARE(KeywordScanner({ "x" }).highlight(QStringLiteral("axbx"), "[", "]"), QStringLiteral("a[x]b[x]"));
+}
+
+void tst_KeywordScanner::customHighlight_usesWildcards()
+{
+    const QString content = QStringLiteral("Meeting notes: the yearly budget review is attached.");
+    const QString snippet = ContentHighlighter::customHighlight({ "bud*t" }, content, 50, true);
+    QVERIFY(snippet.contains(QStringLiteral("<b>budget</b>")));
+
+    const ContentHighlighter::PlainSnippetResult plain = ContentHighlighter::plainSnippet({ "Y?arly" }, content, 20, 20);
+    QVERIFY(plain.content.contains(QStringLiteral("yearly")));
+}
+
+void tst_KeywordScanner::benchmarkScan_data()
+{
+    QTest::addColumn<bool>("chinese");
+    QTest::addColumn<bool>("useScanner");
+
+    QTest::newRow("english-indexOf") << false << false;
+    QTest::newRow("english-scanner") << false << true;
+    QTest::newRow("chinese-indexOf") << true << false;
+    QTest::newRow("chinese-scanner") << true << true;
+}
+
+void tst_KeywordScanner::benchmarkScan()
+{
+    QFETCH(bool, chinese);
+    QFETCH(bool, useScanner);
+
+    const QString text = largeText(chinese);
+    const QStringList keywords = chinese
+            ? QStringList { "年度预算", "季度总结", "报告" }
+            : QStringList { "yearly budget", "quarterly summary", "report" };
+
+    // 查找定位与整段高亮都与旧实现结果一致
+    const KeywordScanner scanner(keywords);
+    const QString tail = text.right(64);
+    QCOMPARE(scanner.highlight(tail), referenceHighlight(tail, keywords));
+
+    int position = -1;
+    if (useScanner) {
+        QBENCHMARK {
+            position = KeywordScanner(keywords).earliest(text).position;
+        }
+    } else {
+        QBENCHMARK {
+            position = -1;
+            for (const QString &keyword : keywords) {
+                const int pos = text.indexOf(keyword, 0, Qt::CaseInsensitive);
+                if (pos != -1 && (position == -1 || pos < position))
+                    position = pos;
+            }
+        }
+    }
+    QCOMPARE(position, text.indexOf(keywords.first(), 0, Qt::CaseInsensitive));
+}
+
+QObject *create_tst_KeywordScanner()
+{
+    return new tst_KeywordScanner();
+}
+
+#include "tst_keyword_scanner.moc"
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <QDBusConnection>
+#include <QDBusMessage>
 #include <QDateTime>
 #include <QFileInfo>
 #include <QSignalSpy>
@@ -12,6 +14,7 @@
 #include <dfm-search/searchoptions.h>
 #include <dfm-search/timeresultapi.h>
 
+#include "recentsearch/recentitemstore.h"
 #include "recentsearch/recentstrategies/recentsearchstrategy.h"
 
 using namespace DFMSEARCH;
@@ -64,16 +67,43 @@ QList<RecentItem> createBlacklistTestItems()
     };
 }
 
+constexpr auto kRecentService = "org.deepin.Filemanager.Daemon";
+constexpr auto kRecentPath = "/org/deepin/Filemanager/Daemon/RecentManager";
+constexpr auto kRecentInterface = "org.deepin.Filemanager.Daemon.RecentManager";
+
+QVariantMap recentEntry(const QString &path, qint64 modified)
+{
+    return { { "Path", path }, { "Href", "file://" + path }, { "modified", modified } };
+}
+
 } // namespace
 
-// 可测试的 RecentSearchStrategy 子类，提供访问 fetchAddr 的接口
+// 替代 RecentManager 的本地 DBus 服务，仅实现 GetItemsInfo
+class FakeRecentManager : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.Filemanager.Daemon.RecentManager")
+
+public:
+    QVariantList items;
+    int callCount = 0;
+
+public Q_SLOTS:
+    QVariantList GetItemsInfo()
+    {
+        ++callCount;
+        return items;
+    }
+};
+
+// 可测试的 RecentSearchStrategy 子类，提供访问 snapshotAddr 的接口
 class TestableRecentStrategy : public RecentSearchStrategy
 {
 public:
     using RecentSearchStrategy::RecentSearchStrategy;
 
-    auto fetchAddr() const {
-        return VADDR(TestableRecentStrategy, fetchRecentItems);
+    auto snapshotAddr() const {
+        return VADDR(TestableRecentStrategy, recentSnapshot);
     }
 };
 
@@ -99,6 +129,7 @@ private Q_SLOTS:
     void search_excludedPathsFilter_emptyKeepsAllItems();
     void search_excludedPathsCombinedWithKeyword_appliesBoth();
     void search_excludedPathsFilter_respectsPathBoundary();
+    void store_refreshesOnRecentManagerSignal();
 };
 
 void tst_RecentSearchEngine::initTestCase()
@@ -115,8 +146,8 @@ void tst_RecentSearchEngine::search_emptyFetch_returnsEmptyResult()
     TestableRecentStrategy strategy(opts);
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), []() -> QList<RecentItem> {
-        return {};
+    stub.set_lamda(strategy.snapshotAddr(), []() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems({});
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -135,8 +166,8 @@ void tst_RecentSearchEngine::search_noFilter_returnsAllItems()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -155,8 +186,8 @@ void tst_RecentSearchEngine::search_keywordFilter_matchesOnlyFilenameWithKeyword
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -181,8 +212,8 @@ void tst_RecentSearchEngine::search_extensionFilter_matchesOnlyGivenExtensions()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -209,8 +240,8 @@ void tst_RecentSearchEngine::search_timeRangeFilter_keepsOnlyItemsInRange()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -240,8 +271,8 @@ void tst_RecentSearchEngine::search_combinedFilter_matchesIntersection()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -261,9 +292,9 @@ void tst_RecentSearchEngine::search_dbusFailure_doesNotCrashReturnsEmpty()
     TestableRecentStrategy strategy(opts);
 
     stub_ext::StubExt stub;
-    // DBus 失败模拟：fetchRecentItems 返回空列表
-    stub.set_lamda(strategy.fetchAddr(), []() -> QList<RecentItem> {
-        return {};
+    // DBus 失败模拟：快照为空
+    stub.set_lamda(strategy.snapshotAddr(), []() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems({});
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -286,8 +317,8 @@ void tst_RecentSearchEngine::search_detailedResults_containsExtendedAttributes()
     auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -316,8 +347,8 @@ void tst_RecentSearchEngine::search_maxResults_truncatesResultCount()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -338,8 +369,8 @@ void tst_RecentSearchEngine::search_resultFoundEnabled_emitsSignalPerItem()
     const auto testItems = createTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy foundSpy(&strategy, &BaseSearchStrategy::resultFound);
@@ -359,8 +390,8 @@ void tst_RecentSearchEngine::search_excludedPathsFilter_removesBlacklistedItems(
     const auto testItems = createBlacklistTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -390,8 +421,8 @@ void tst_RecentSearchEngine::search_excludedPathsFilter_emptyKeepsAllItems()
     const auto testItems = createBlacklistTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -412,8 +443,8 @@ void tst_RecentSearchEngine::search_excludedPathsCombinedWithKeyword_appliesBoth
     const auto testItems = createBlacklistTestItems();
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [testItems]() -> QList<RecentItem> {
-        return testItems;
+    stub.set_lamda(strategy.snapshotAddr(), [testItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(testItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -447,8 +478,8 @@ void tst_RecentSearchEngine::search_excludedPathsFilter_respectsPathBoundary()
     };
 
     stub_ext::StubExt stub;
-    stub.set_lamda(strategy.fetchAddr(), [boundaryItems]() -> QList<RecentItem> {
-        return boundaryItems;
+    stub.set_lamda(strategy.snapshotAddr(), [boundaryItems]() -> RecentItemSnapshotPtr {
+        return RecentItemSnapshot::fromItems(boundaryItems);
     });
 
     QSignalSpy finishedSpy(&strategy, &BaseSearchStrategy::searchFinished);
@@ -466,6 +497,46 @@ void tst_RecentSearchEngine::search_excludedPathsFilter_respectsPathBoundary()
     QVERIFY(!paths.contains("/home/uos/Downloads/file.txt"));
 }
 
+void tst_RecentSearchEngine::store_refreshesOnRecentManagerSignal()
+{
+    // 变更信号通过事件循环送达，应用对象由 main() 创建
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected())
+        QSKIP("No session bus available");
+    if (!bus.registerService(kRecentService))
+        QSKIP("RecentManager is already running, cannot install the stand-in service");
+
+    const qint64 now = QDateTime::currentDateTime().toSecsSinceEpoch();
+    FakeRecentManager manager;
+    manager.items = { recentEntry("/tmp/test/report.pdf", now),
+                      recentEntry("/tmp/test/notes.txt", now) };
+    QVERIFY(bus.registerObject(kRecentPath, &manager, QDBusConnection::ExportAllSlots));
+
+    RecentItemStore *store = RecentItemStore::instance();
+    store->invalidate();
+    const RecentItemSnapshotPtr first = store->snapshot();
+    QCOMPARE(first->size(), 2);
+    QCOMPARE(first->fileNames.at(0), QString("report.pdf"));
+    QCOMPARE(first->suffixes.at(1), QString("txt"));
+    const quint64 refreshes = store->refreshCount();
+
+    // 没有变更时复用快照，不再调用 DBus
+    QCOMPARE(store->snapshot(), first);
+    QCOMPARE(manager.callCount, 1);
+
+    // RecentManager 发出变更信号后，下一次取快照时重新拉取
+    manager.items.append(recentEntry("/tmp/test/budget.xlsx", now));
+    QDBusMessage signal = QDBusMessage::createSignal(kRecentPath, kRecentInterface, "ItemAdded");
+    signal << QString("/tmp/test/budget.xlsx") << recentEntry("/tmp/test/budget.xlsx", now);
+    QVERIFY(bus.send(signal));
+    QTRY_COMPARE(store->snapshot()->size(), 3);
+    QVERIFY(store->refreshCount() > refreshes);
+
+    bus.unregisterObject(kRecentPath);
+    bus.unregisterService(kRecentService);
+    store->invalidate();
+}
+
 QObject *create_tst_RecentSearchEngine()
 {
     return new tst_RecentSearchEngine();
@@ -2,23 +2,130 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <QTest>
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QSemaphore>
+#include <QThread>
 
 #include <lucene++/LuceneHeaders.h>
 #include <lucene++/PhraseQuery.h>
 #include <lucene++/TermQuery.h>
 
 #include <dfm-search/dsearch_global.h>
+#include <dfm-search/filenamesearchapi.h>
+#include <dfm-search/sizerangefilter.h>
+#include <dfm-search-lib/core/resultbatcher.h>
+#include <dfm-search-lib/core/searchexecutor.h>
+#include <dfm-search-lib/core/searchstrategy/resultstreamlimiter.h>
 #include <dfm-search-lib/utils/filenameblacklistmatcher.h>
+#include <dfm-search-lib/utils/filenamematcher.h>
+#include <dfm-search-lib/utils/filenameresultcache.h>
+#include <dfm-search-lib/utils/indexstatewatcher.h>
 #include <dfm-search-lib/utils/lucenequeryutils.h>
+#include <dfm-search-lib/utils/paralleldirwalker.h>
+#include <dfm-search-lib/utils/pathmatcher.h>
+#include <dfm-search-lib/utils/pinyinsyllables.h>
 
 using namespace DFMSEARCH;
 
+namespace {
+
+// 旧实现：正则清洗输入，按 QSet 递归尝试所有切分，用于对照与性能比较
+bool referencePinyinHelper(const QString &str, int startPos, const QSet<QString> &validSyllables)
+{
+    if (startPos >= str.length())
+        return true;
+    for (int syllableLen = qMin(6, str.length() - startPos); syllableLen >= 1; syllableLen--) {
+        if (validSyllables.contains(str.mid(startPos, syllableLen))
+            && referencePinyinHelper(str, startPos + syllableLen, validSyllables))
+            return true;
+    }
+    return false;
+}
+
+bool referenceIsPinyinSequence(const QString &input)
+{
+    static const QSet<QString> kSyllables = [] {
+        QSet<QString> set;
+        for (const QString &syllable : PinyinSyllables::syllables())
+            set.insert(syllable);
+        return set;
+    }();
+
+    QString cleaned = input;
+    cleaned.remove(QRegularExpression("[^a-zA-Z]"));
+    if (cleaned.isEmpty())
+        return false;
+    const QString str = cleaned.toLower();
+    if (str.length() == 1 && (str[0] == 'i' || str[0] == 'u' || str[0] == 'v'))
+        return false;
+    if (str.length() >= 3 && str.count(str[0]) == str.length())
+        return false;
+    return referencePinyinHelper(str, 0, kSyllables);
+}
+
+// 随机 ASCII 文件名与由音节拼成的长拼音串，种子固定以便复现
+QStringList pinyinBenchmarkInputs(bool longPinyin)
+{
+    QRandomGenerator random(20260101);
+    const QStringList syllables = PinyinSyllables::syllables();
+    QStringList inputs;
+    for (int i = 0; i < 1000; ++i) {
+        QString input;
+        if (longPinyin) {
+            while (input.size() < 40)
+                input += syllables.at(random.bounded(syllables.size()));
+        } else {
+            const int length = random.bounded(4, 24);
+            for (int c = 0; c < length; ++c)
+                input += QChar(random.bounded(0x20, 0x7f));
+        }
+        inputs.append(input);
+    }
+    return inputs;
+}
+
+// 遍历 root，返回相对 root 的全部条目路径（已排序）
+QStringList walkRelativePaths(ParallelDirWalker &walker, const QString &root)
+{
+    QStringList paths;
+    walker.walk(
+            root,
+            [](const DirEntry &entry, SearchResultList &batch) {
+                batch.append(SearchResult(entry.filePath()));
+            },
+            [&](const SearchResultList &batch) {
+                for (const SearchResult &result : batch)
+                    paths.append(result.path().mid(root.size() + 1));
+            });
+    paths.sort();
+    return paths;
+}
+
+bool writeTestFile(const QString &path, const QByteArray &data = QByteArray("data"))
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+}   // namespace
+
 class tst_SearchUtils : public QObject
 {
     Q_OBJECT
@@ -29,9 +136,25 @@ private Q_SLOTS:
     void testGlobal();
     void testPinyin();
     void testPinyinAcronym();
+    void testPinyinMatchesReference();
+    void benchmarkPinyinSequence_data();
+    void benchmarkPinyinSequence();
     void testAnythingStatus();
     void testFileNameBlacklistMatcher();
+    void testPathMatcher();
+    void testDirEntryUnknownType();
+    void testParallelDirWalkerSymlinkLoop();
+    void testParallelDirWalkerBindMountLoop();
+    void testParallelDirWalkerUnreadableDirectory();
+    void testParallelDirWalkerHiddenAndExcluded();
+    void testParallelDirWalkerBusyExecutor();
+    void testParallelDirWalkerBoundedOutbox();
+    void testFileNameMatcher();
+    void testResultBatcher();
+    void testResultStreamLimiterGeneration();
+    void testFileNameResultCache();
     void testNGramSearchQuery();
+    void testIndexStateWatcher();
 
 private:
     void doTestPinyin(const QString &caseName, const QString &input, bool expected);
@@ -181,6 +304,61 @@ void tst_SearchUtils::testPinyin()
     }
 }
 
+void tst_SearchUtils::testPinyinMatchesReference()
+{
+    // 编译期字典树与旧的递归切分结果完全一致
+    for (bool longPinyin : { false, true }) {
+        QStringList inputs = pinyinBenchmarkInputs(longPinyin);
+        // 长拼音串尾部追加干扰，覆盖切分失败需要回溯的情况
+        if (longPinyin) {
+            for (int i = 0; i < inputs.size(); i += 3)
+                inputs[i] += QStringLiteral("zh");
+        }
+        for (const QString &input : std::as_const(inputs))
+            QVERIFY2(Global::isPinyinSequence(input) == referenceIsPinyinSequence(input), qPrintable(input));
+    }
+
+    for (const QString &input : { "xian", "xiana", "ZHUANGzhuang", "aaa", "nvnv", "a1b2", "ü", "lüe", "shangaiguo" })
+        QCOMPARE(Global::isPinyinSequence(input), referenceIsPinyinSequence(input));
+}
+
+void tst_SearchUtils::benchmarkPinyinSequence_data()
+{
+    QTest::addColumn<bool>("longPinyin");
+    QTest::addColumn<bool>("useTrie");
+
+    QTest::newRow("random-ascii-reference") << false << false;
+    QTest::newRow("random-ascii-trie") << false << true;
+    QTest::newRow("long-pinyin-reference") << true << false;
+    QTest::newRow("long-pinyin-trie") << true << true;
+}
+
+void tst_SearchUtils::benchmarkPinyinSequence()
+{
+    QFETCH(bool, longPinyin);
+    QFETCH(bool, useTrie);
+
+    const QStringList inputs = pinyinBenchmarkInputs(longPinyin);
+    int matched = 0;
+    if (useTrie) {
+        QBENCHMARK {
+            matched = 0;
+            for (const QString &input : inputs)
+                matched += Global::isPinyinSequence(input);
+        }
+    } else {
+        QBENCHMARK {
+            matched = 0;
+            for (const QString &input : inputs)
+                matched += referenceIsPinyinSequence(input);
+        }
+    }
+
+    // 由音节拼成的输入全部是拼音
+    if (longPinyin)
+        QCOMPARE(matched, inputs.size());
+}
+
 void tst_SearchUtils::doTestPinyinAcronym(const QString &caseName, const QString &input, bool expected)
 {
     bool actual = Global::isPinyinAcronymSequence(input);
@@ -303,6 +481,376 @@ void tst_SearchUtils::testFileNameBlacklistMatcher()
                                  false);
 }
 
+void tst_SearchUtils::testPathMatcher()
+{
+    // 绝对前缀按路径边界匹配
+    {
+        const PathMatcher matcher(QStringList { "/home/a/fo", "/opt/data/" });
+        QVERIFY(matcher.matches("/home/a/fo"));
+        QVERIFY(matcher.matches("/home/a/fo/"));
+        QVERIFY(matcher.matches("/home/a/fo/bar/baz.txt"));
+        QVERIFY(!matcher.matches("/home/a/foo"));
+        QVERIFY(!matcher.matches("/home/a/foo/bar"));
+        QVERIFY(!matcher.matches("/home/a"));
+        QVERIFY(matcher.matches("/opt/data"));
+        QVERIFY(matcher.matches("/opt//data/./x"));
+        QVERIFY(matcher.matches("/home/b/../a/fo/x"));
+        QVERIFY(!matcher.matches("/home/a/fo/../foo"));
+        QVERIFY(!matcher.matches("home/a/fo"));
+        QVERIFY(!matcher.matches(QString()));
+    }
+
+    // 根目录命中所有绝对路径，相对路径与空串被忽略
+    {
+        const PathMatcher matcher(QStringList { "/", "relative", "" });
+        QVERIFY(matcher.matches("/any/path"));
+        QVERIFY(!matcher.matches("any/relative"));
+    }
+
+    // 黑名单：绝对路径作为前缀，其余作为目录名
+    {
+        const PathMatcher matcher = PathMatcher::fromBlacklist(QStringList { " /home/test/workspace ", "node_modules", "  " });
+        QVERIFY(matcher.matches("/home/test/workspace/a.txt"));
+        QVERIFY(!matcher.matches("/home/test/workspace2"));
+        QVERIFY(matcher.matches("/home/test/proj/node_modules/pkg"));
+        QVERIFY(matcher.matches("proj/node_modules"));
+        QVERIFY(!matcher.matches("/home/test/proj/my_node_modules"));
+    }
+
+    QVERIFY(PathMatcher().isEmpty());
+    QVERIFY(!PathMatcher().matches("/home"));
+    QVERIFY(PathMatcher(QStringList { "relative" }).isEmpty());
+}
+
+void tst_SearchUtils::testDirEntryUnknownType()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString root = tempDir.path();
+    QVERIFY(QDir().mkpath(root + "/sub"));
+    QVERIFY(writeTestFile(root + "/file.txt", "12345"));
+    QVERIFY(QFile::link(root + "/sub", root + "/link"));
+
+    const int dirFd = ::open(QFile::encodeName(root).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    QVERIFY(dirFd >= 0);
+    std::atomic<int> statCount { 0 };
+
+    // 构造条目不产生系统调用，DT_UNKNOWN 在首次查询类型时 lstat 一次并缓存
+    {
+        const DirEntry entry(dirFd, root, "sub", DT_UNKNOWN, &statCount);
+        QCOMPARE(statCount.load(), 0);
+        QVERIFY(entry.isDir());
+        QCOMPARE(statCount.load(), 1);
+        QVERIFY(!entry.isFile());
+        QVERIFY(!entry.isSymLink());
+        QCOMPARE(statCount.load(), 1);
+    }
+
+    // 类型确定后，大小等元数据仍按需 statx 一次
+    {
+        statCount.store(0);
+        const DirEntry entry(dirFd, root, "file.txt", DT_UNKNOWN, &statCount);
+        QVERIFY(entry.isFile());
+        QCOMPARE(statCount.load(), 1);
+        QCOMPARE(entry.size(), qint64(5));
+        QCOMPARE(entry.size(), qint64(5));
+        QCOMPARE(statCount.load(), 2);
+    }
+
+    // 链接条目本身是链接，isDir() 跟随到目标
+    {
+        const DirEntry entry(dirFd, root, "link", DT_UNKNOWN, &statCount);
+        QVERIFY(entry.isSymLink());
+        QVERIFY(entry.isDir());
+    }
+
+    // d_type 已知时不产生系统调用
+    {
+        statCount.store(0);
+        const DirEntry entry(dirFd, root, "sub", DT_DIR, &statCount);
+        QVERIFY(entry.isDir());
+        QVERIFY(!entry.isSymLink());
+        QCOMPARE(statCount.load(), 0);
+    }
+
+    ::close(dirFd);
+}
+
+void tst_SearchUtils::testParallelDirWalkerSymlinkLoop()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // a/b/up 指回 a，链接的名称参与匹配但不会被递归进入
+    const QString root = tempDir.path();
+    QVERIFY(QDir().mkpath(root + "/a/b"));
+    QVERIFY(writeTestFile(root + "/a/b/file.txt"));
+    QVERIFY(QFile::link(root + "/a", root + "/a/b/up"));
+
+    ParallelDirWalker walker(2, nullptr);
+    QCOMPARE(walkRelativePaths(walker, root), (QStringList { "a", "a/b", "a/b/file.txt", "a/b/up" }));
+    QCOMPARE(walker.visitedDirectories(), 3);
+    // 名称匹配不需要元数据，d_type 已知的条目不产生 stat
+    QCOMPARE(walker.statCalls(), 1);
+}
+
+void tst_SearchUtils::testParallelDirWalkerBindMountLoop()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // 绑定挂载形成的循环只能靠 (dev, ino) 识别，需要挂载权限
+    const QString root = tempDir.path();
+    QVERIFY(QDir().mkpath(root + "/a/mnt"));
+    QVERIFY(writeTestFile(root + "/a/file.txt"));
+
+    const QByteArray source = QFile::encodeName(root + "/a");
+    const QByteArray target = QFile::encodeName(root + "/a/mnt");
+    if (::geteuid() != 0 || ::mount(source.constData(), target.constData(), nullptr, MS_BIND, nullptr) != 0)
+        QSKIP("bind mount is not permitted");
+
+    ParallelDirWalker walker(2, nullptr);
+    const QStringList paths = walkRelativePaths(walker, root);
+    const int visited = walker.visitedDirectories();
+    ::umount2(target.constData(), MNT_DETACH);
+
+    // a/mnt 与 a 是同一目录，只作为条目出现，不再遍历其内容
+    QCOMPARE(paths, (QStringList { "a", "a/file.txt", "a/mnt" }));
+    QCOMPARE(visited, 2);
+}
+
+void tst_SearchUtils::testParallelDirWalkerUnreadableDirectory()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString root = tempDir.path();
+    QVERIFY(QDir().mkpath(root + "/locked"));
+    QVERIFY(QDir().mkpath(root + "/open"));
+    QVERIFY(writeTestFile(root + "/locked/secret.txt"));
+    QVERIFY(writeTestFile(root + "/open/x.txt"));
+    QVERIFY(writeTestFile(root + "/z.txt"));
+
+    const QByteArray locked = QFile::encodeName(root + "/locked");
+    QCOMPARE(::chmod(locked.constData(), 0), 0);
+    if (::access(locked.constData(), R_OK) == 0) {
+        ::chmod(locked.constData(), 0755);
+        QSKIP("permission bits are not enforced for this user");
+    }
+
+    ParallelDirWalker walker(2, nullptr);
+    const QStringList paths = walkRelativePaths(walker, root);
+    const int visited = walker.visitedDirectories();
+    ::chmod(locked.constData(), 0755);
+
+    // 无法读取的目录本身仍作为条目出现，遍历跳过其内容并继续处理其余目录
+    QCOMPARE(paths, (QStringList { "locked", "open", "open/x.txt", "z.txt" }));
+    QCOMPARE(visited, 2);
+}
+
+void tst_SearchUtils::testParallelDirWalkerHiddenAndExcluded()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString root = tempDir.path();
+    QVERIFY(QDir().mkpath(root + "/.hidden"));
+    QVERIFY(QDir().mkpath(root + "/visible"));
+    QVERIFY(QDir().mkpath(root + "/skip/deeper"));
+    QVERIFY(writeTestFile(root + "/.hidden/a.txt"));
+    QVERIFY(writeTestFile(root + "/.dotfile"));
+    QVERIFY(writeTestFile(root + "/visible/b.txt"));
+    QVERIFY(writeTestFile(root + "/skip/c.txt"));
+    QVERIFY(writeTestFile(root + "/skip/deeper/d.txt"));
+
+    // 隐藏条目不出现也不递归；排除的目录只有自身条目出现，其内容被剪枝
+    {
+        ParallelDirWalker walker(2, nullptr);
+        walker.setExcludedPaths({ root + "/skip" });
+        QCOMPARE(walkRelativePaths(walker, root), (QStringList { "skip", "visible", "visible/b.txt" }));
+        QCOMPARE(walker.visitedDirectories(), 2);
+    }
+
+    {
+        ParallelDirWalker walker(2, nullptr);
+        walker.setExcludedPaths({ root + "/skip" });
+        walker.setIncludeHidden(true);
+        QCOMPARE(walkRelativePaths(walker, root),
+                 (QStringList { ".dotfile", ".hidden", ".hidden/a.txt", "skip", "visible", "visible/b.txt" }));
+        QCOMPARE(walker.visitedDirectories(), 3);
+    }
+
+    // 根目录被排除时不遍历任何内容
+    {
+        ParallelDirWalker walker(2, nullptr);
+        walker.setExcludedPaths({ root });
+        QVERIFY(walkRelativePaths(walker, root).isEmpty());
+        QCOMPARE(walker.visitedDirectories(), 0);
+    }
+}
+
+void tst_SearchUtils::testParallelDirWalkerBusyExecutor()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString root = tempDir.path();
+    QStringList expected;
+    for (int i = 0; i < 4; ++i) {
+        const QString dir = QString("dir%1").arg(i);
+        QVERIFY(QDir().mkpath(root + "/" + dir));
+        QVERIFY(writeTestFile(root + "/" + dir + "/file.txt"));
+        expected << dir << dir + "/file.txt";
+    }
+
+    // 占满共享执行器的唯一线程，辅助工作者无法开始，遍历由调用者线程独自完成
+    SearchExecutor *executor = SearchExecutor::instance();
+    const int oldMaxThreadCount = executor->maxThreadCount();
+    executor->setMaxThreadCount(1);
+    QSemaphore started;
+    QSemaphore release;
+    executor->submit([&]() {
+        started.release();
+        release.acquire();
+    },
+                     0);
+    QVERIFY(started.tryAcquire(1, 5000));
+
+    ParallelDirWalker walker(4, nullptr);
+    const QStringList paths = walkRelativePaths(walker, root);
+
+    release.release();
+    executor->setMaxThreadCount(oldMaxThreadCount);
+
+    QCOMPARE(paths, expected);
+    QCOMPARE(walker.visitedDirectories(), 5);
+}
+
+void tst_SearchUtils::testParallelDirWalkerBoundedOutbox()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString root = tempDir.path();
+    int expectedEntries = 0;
+    for (int i = 0; i < 8; ++i) {
+        const QString dir = root + QString("/dir%1").arg(i);
+        QVERIFY(QDir().mkpath(dir));
+        ++expectedEntries;
+        for (int j = 0; j < 20; ++j) {
+            QVERIFY(writeTestFile(dir + QString("/file%1.txt").arg(j)));
+            ++expectedEntries;
+        }
+    }
+
+    ParallelDirWalker walker(4, nullptr);
+    walker.setBatchSize(1);
+    walker.setOutboxCapacity(2);
+
+    // 第一次回调时消费方停顿，其他工作者只能积压到上限后等待
+    int delivered = 0;
+    int maxQueued = 0;
+    bool held = false;
+    walker.walk(
+            root,
+            [](const DirEntry &entry, SearchResultList &batch) {
+                batch.append(SearchResult(entry.filePath()));
+            },
+            [&](const SearchResultList &batch) {
+                if (!held) {
+                    held = true;
+                    QThread::msleep(200);
+                }
+                maxQueued = qMax(maxQueued, walker.queuedBatches());
+                delivered += batch.size();
+            });
+
+    QVERIFY(maxQueued <= 2);
+    QCOMPARE(delivered, expectedEntries);
+}
+
+void tst_SearchUtils::testFileNameMatcher()
+{
+    SearchOptions options;
+
+    // 简单查询：默认不区分大小写，中文首字符走直接定位路径
+    {
+        FileNameMatcher matcher(SearchQuery("Report"), options);
+        QVERIFY(matcher.matchName("annual_REPORT.txt"));
+        QVERIFY(!matcher.matchName("repo.txt"));
+
+        FileNameMatcher chinese(SearchQuery("报告a"), options);
+        QVERIFY(chinese.matchName("年度报告A.doc"));
+        QVERIFY(!chinese.matchName("年度报表A.doc"));
+
+        // 非字母类别但有大小写之分的首字符（So、Nl）不能走直接定位路径
+        FileNameMatcher circled(SearchQuery("ⓐ"), options);
+        QVERIFY(circled.matchName("Ⓐ.txt"));
+        QVERIFY(circled.matchName("ⓐ.txt"));
+        FileNameMatcher circledUpper(SearchQuery("Ⓐ"), options);
+        QVERIFY(circledUpper.matchName("ⓐ.txt"));
+
+        FileNameMatcher roman(SearchQuery("ⅰ卷"), options);
+        QVERIFY(roman.matchName("第Ⅰ卷.pdf"));
+        FileNameMatcher romanUpper(SearchQuery("Ⅰ卷"), options);
+        QVERIFY(romanUpper.matchName("第ⅰ卷.pdf"));
+        QVERIFY(!romanUpper.matchName("第Ⅱ卷.pdf"));
+    }
+
+    // 区分大小写
+    {
+        SearchOptions caseOptions;
+        caseOptions.setCaseSensitive(true);
+        FileNameMatcher matcher(SearchQuery("Report"), caseOptions);
+        QVERIFY(matcher.matchName("Report.txt"));
+        QVERIFY(!matcher.matchName("report.txt"));
+    }
+
+    // 通配符：整名匹配，支持 * ? 与字符集
+    {
+        FileNameMatcher matcher(SearchQuery("*.tx?", SearchQuery::Type::Wildcard), options);
+        QVERIFY(matcher.matchName("a.TXT"));
+        QVERIFY(!matcher.matchName("a.txt.bak"));
+
+        FileNameMatcher sets(SearchQuery("file[0-9][!a].log", SearchQuery::Type::Wildcard), options);
+        QVERIFY(sets.matchName("File3b.log"));
+        QVERIFY(!sets.matchName("file3a.log"));
+        QVERIFY(!sets.matchName("filex1.log"));
+
+        FileNameMatcher backtrack(SearchQuery("a*b*c", SearchQuery::Type::Wildcard), options);
+        QVERIFY(backtrack.matchName("axxbyybzc"));
+        QVERIFY(!backtrack.matchName("axxbyybz"));
+    }
+
+    // 布尔查询：AND / OR
+    {
+        FileNameMatcher andMatcher(SearchQuery::createBooleanQuery({ "foo", "bar" }), options);
+        QVERIFY(andMatcher.matchName("bar_foo"));
+        QVERIFY(!andMatcher.matchName("foo_baz"));
+
+        FileNameMatcher orMatcher(SearchQuery::createBooleanQuery({ "foo", "bar" }, SearchQuery::BooleanOperator::OR), options);
+        QVERIFY(orMatcher.matchName("bar.txt"));
+        QVERIFY(!orMatcher.matchName("baz.txt"));
+    }
+
+    // 后缀与大小过滤
+    {
+        SearchOptions filterOptions;
+        FileNameOptionsAPI api(filterOptions);
+        api.setFileExtensions({ "txt" });
+        filterOptions.setSizeRangeFilter(SizeRangeFilter().setRange(10, 100).setIncludeUpper(false));
+
+        FileNameMatcher matcher(SearchQuery(""), filterOptions);
+        QVERIFY(matcher.matchName("anything"));
+        QVERIFY(matcher.matchSuffix("TXT"));
+        QVERIFY(!matcher.matchSuffix("md"));
+        QVERIFY(matcher.matchSize(10));
+        QVERIFY(!matcher.matchSize(100));
+        QVERIFY(!matcher.matchSize(9));
+    }
+}
+
 void tst_SearchUtils::testGlobal()
 {
     // Test supported content search extensions
@@ -337,6 +885,139 @@ void tst_SearchUtils::testGlobal()
     Q_UNUSED(blacklistPaths);
 }
 
+void tst_SearchUtils::testResultBatcher()
+{
+    using Reason = ResultBatcher::FlushReason;
+    ResultBatcher batcher;
+
+    // 前两条结果立即发送
+    batcher.reset(2, 100, 200);
+    QCOMPARE(batcher.add(1, 0), Reason::Immediate);
+    batcher.flushed(Reason::Immediate, 0, 1000000);
+    QCOMPARE(batcher.add(1, 5), Reason::Immediate);
+    batcher.flushed(Reason::Immediate, 5, 1000000);
+
+    // 1 条/ms 的接收方在 16ms 预算内只能处理 16 条，阈值随之收缩
+    QCOMPARE(batcher.sizeThreshold(), 16);
+
+    // 未达阈值时等待，截止时间从最早一条待发送结果开始计算
+    QCOMPARE(batcher.add(10, 10), Reason::None);
+    QCOMPARE(batcher.remainingLatency(50), qint64(160));
+    QCOMPARE(batcher.add(6, 60), Reason::Size);
+    batcher.flushed(Reason::Size, 60, 16000000);
+
+    // 达到延迟上限时发送
+    QCOMPARE(batcher.add(1, 100), Reason::None);
+    QCOMPARE(batcher.add(1, 300), Reason::Deadline);
+    batcher.flushed(Reason::Deadline, 300, 2000000);
+
+    // 快速接收方让阈值增长到上限
+    for (int i = 0; i < 10; ++i) {
+        batcher.add(batcher.sizeThreshold(), 400);
+        batcher.flushed(Reason::Size, 400, 1000);
+    }
+    QCOMPARE(batcher.sizeThreshold(), 100);
+
+    const ResultBatcher::Statistics stats = batcher.statistics();
+    QCOMPARE(stats.immediateBatches, 2);
+    QCOMPARE(stats.deadlineBatches, 1);
+    QCOMPARE(stats.sizeBatches, 11);
+    QCOMPARE(stats.batchCount, 14);
+    QCOMPARE(stats.minBatchSize, 1);
+    QCOMPARE(stats.maxBatchSize, 100);
+    QCOMPARE(stats.maxLatencyMs, qint64(200));
+    QCOMPARE(batcher.remainingLatency(500), qint64(-1));
+}
+
+void tst_SearchUtils::testResultStreamLimiterGeneration()
+{
+    ResultStreamLimiter limiter(2);
+    limiter.reset();
+    const quint64 previous = limiter.generation();
+    QVERIFY(limiter.acquire(previous, nullptr));
+    QVERIFY(limiter.acquire(previous, nullptr));
+
+    // 新搜索开始后，上一次搜索的块才被引擎处理
+    limiter.reset();
+    const quint64 current = limiter.generation();
+    QVERIFY(current != previous);
+    QVERIFY(limiter.acquire(current, nullptr));
+    limiter.release(previous);
+    limiter.release(previous);
+    QCOMPARE(limiter.inFlight(), 1);
+
+    // 上一次搜索的策略不能再占用新搜索的名额
+    QVERIFY(!limiter.acquire(previous, nullptr));
+    QCOMPARE(limiter.inFlight(), 1);
+
+    // 遗留的归还不会腾出名额，新搜索最多仍只有 capacity 个在途块
+    QVERIFY(limiter.acquire(current, nullptr));
+    QCOMPARE(limiter.inFlight(), 2);
+    std::atomic<bool> cancelled { true };
+    QVERIFY(!limiter.acquire(current, &cancelled));
+
+    limiter.release(current);
+    QCOMPARE(limiter.inFlight(), 1);
+}
+
+void tst_SearchUtils::testFileNameResultCache()
+{
+    FileNameResultCache *cache = FileNameResultCache::instance();
+    cache->clear();
+
+    FileNameResultCache::Key key;
+    key.scope = "tst-scope";
+    key.keyword = "re";
+    key.generation = 1;
+    key.refinable = true;
+
+    const SearchResultList superset { SearchResult("/a/report.txt"), SearchResult("/a/Repair.txt"),
+                                      SearchResult("/a/reply.txt"), SearchResult("/a/rep/x-re.txt") };
+    cache->insert(key, superset, true);
+
+    SearchResultList results;
+    QVERIFY(cache->lookup(key, -1, &results));
+    QCOMPARE(results.size(), 4);
+    QVERIFY(cache->lookup(key, 2, &results));
+    QCOMPARE(results.size(), 2);
+
+    // 细化只看文件名部分，父目录名不参与匹配
+    FileNameResultCache::Key refined = key;
+    refined.keyword = "rep";
+    QVERIFY(cache->lookup(refined, -1, &results));
+    QCOMPARE(results.size(), 3);
+    refined.keyword = "repa";
+    QVERIFY(cache->lookup(refined, -1, &results));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().path(), QString("/a/Repair.txt"));
+
+    // 不同条件或新的索引版本不命中
+    FileNameResultCache::Key other = refined;
+    other.scope = "tst-other-scope";
+    QVERIFY(!cache->lookup(other, -1, &results));
+    other = refined;
+    other.generation = 2;
+    QVERIFY(!cache->lookup(other, -1, &results));
+
+    // 截断的结果不能用于细化
+    FileNameResultCache::Key truncatedKey = key;
+    truncatedKey.scope = "tst-truncated";
+    cache->insert(truncatedKey, superset, false);
+    truncatedKey.keyword = "rep";
+    QVERIFY(!cache->lookup(truncatedKey, -1, &results));
+
+    // 只有能保证与 n-gram 查询一致的关键词才允许细化
+    QVERIFY(FileNameResultCache::isRefinableKeyword("Report-2024.txt"));
+    QVERIFY(FileNameResultCache::isRefinableKeyword(QStringLiteral("报告")));
+    QVERIFY(!FileNameResultCache::isRefinableKeyword(QString()));
+    QVERIFY(!FileNameResultCache::isRefinableKeyword("annual report"));
+    QVERIFY(!FileNameResultCache::isRefinableKeyword(QStringLiteral("Straße")));
+    QVERIFY(!FileNameResultCache::isRefinableKeyword(QStringLiteral("Été")));
+
+    cache->clear();
+    QCOMPARE(cache->size(), 0);
+}
+
 void tst_SearchUtils::testNGramSearchQuery()
 {
     Lucene::QueryPtr oneCharQuery = LuceneQueryUtils::buildNGramSearchQuery("contents", "A");
@@ -373,6 +1054,54 @@ void tst_SearchUtils::testNGramSearchQuery()
     QCOMPARE(oddPhraseQuery->getPositions()[2], 7);
 }
 
+void tst_SearchUtils::testIndexStateWatcher()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileNameDir = tempDir.filePath("anything");
+    const QString contentDir = tempDir.filePath("fulltext-index");
+    const QString ocrDir = tempDir.filePath("ocrtext-index");
+    QVERIFY(QDir().mkpath(fileNameDir));
+    QVERIFY(QDir().mkpath(contentDir));
+
+    const auto writeStatus = [](const QString &path, const QJsonObject &obj) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QJsonDocument(obj).toJson());
+    };
+
+    writeStatus(fileNameDir + "/status.json", { { "status", "Scanning" }, { "version", "3" } });
+    writeStatus(contentDir + "/index_status.json", { { "lastUpdateTime", "2026-01-01 10:00:00" }, { "version", 2 } });
+
+    // 直接读取
+    IndexState fileNameState = IndexStateWatcher::readState(fileNameDir, "status.json");
+    QVERIFY(!fileNameState.exists);
+    QCOMPARE(fileNameState.status, std::optional<QString>("scanning"));
+    QCOMPARE(fileNameState.version, 3);
+    const IndexState missing = IndexStateWatcher::readState(ocrDir, "index_status.json");
+    QVERIFY(!missing.status);
+    QVERIFY(missing.lastUpdateTime.isEmpty());
+    QCOMPARE(missing.version, -1);
+
+    IndexStateWatcher watcher(fileNameDir, contentDir, ocrDir);
+    QSignalSpy spy(&watcher, &IndexStateWatcher::indexStateChanged);
+    QCOMPARE(watcher.state(IndexStateWatcher::Index::Content).version, 2);
+    QCOMPARE(watcher.state(IndexStateWatcher::Index::Content).lastUpdateTime, QString("2026-01-01 10:00:00"));
+
+    // 状态文件变化
+    writeStatus(fileNameDir + "/status.json", { { "status", "monitoring" }, { "version", 3 } });
+    QVERIFY(spy.wait(5000));
+    QCOMPARE(spy.takeFirst().at(0).value<IndexStateWatcher::Index>(), IndexStateWatcher::Index::FileName);
+    QCOMPARE(watcher.state(IndexStateWatcher::Index::FileName).status, std::optional<QString>("monitoring"));
+
+    // 索引目录在监视开始后才创建
+    QVERIFY(QDir().mkpath(ocrDir));
+    writeStatus(ocrDir + "/index_status.json", { { "lastUpdateTime", "2026-01-02 10:00:00" }, { "version", 1 } });
+    QTRY_VERIFY_WITH_TIMEOUT(watcher.state(IndexStateWatcher::Index::OcrText).version == 1, 5000);
+    QTRY_VERIFY_WITH_TIMEOUT(!spy.isEmpty(), 5000);
+    QCOMPARE(spy.takeFirst().at(0).value<IndexStateWatcher::Index>(), IndexStateWatcher::Index::OcrText);
+}
+
 QObject *create_tst_SearchUtils()
 {
     return new tst_SearchUtils();
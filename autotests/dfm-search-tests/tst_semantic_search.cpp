@@ -10,15 +10,23 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include <memory>
 
 #include <dfm-search/semanticsearcher.h>
 
 #include "semantic/semanticruleengine.h"
+#include "semantic/compiledrulegroup.h"
+#include "semantic/rulebundle.h"
 #include "semantic/intentparser.h"
 #include "semantic/ruleconfigloader.h"
 #include "semantic/extractors/keywordextractor.h"
 #include "semantic/semanticquerybuilder.h"
 #include "semantic/extractors/locationextractor.h"
+#include "semantic/semanticsearcher_p.h"
 
 using namespace DFMSEARCH;
 
@@ -75,6 +83,10 @@ private Q_SLOTS:
     void matchAllReturnsAll();
     void ruleMetadataAccess();
     void hasGroupCheck();
+    void requiredLiterals_data();
+    void requiredLiterals();
+    void compiledMatchKeepsPriorityOrder();
+    void ruleBundleRoundTrip();
 };
 
 void tst_RuleEngine::parseValidGroup()
@@ -188,6 +200,130 @@ void tst_RuleEngine::hasGroupCheck()
     QCOMPARE(engine.groupNames().size(), 0);
 }
 
+void tst_RuleEngine::requiredLiterals_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QStringList>("literals");
+
+    QTest::newRow("alternation") << QString("去年一整年|去年|上一年")
+                                 << QStringList { "去年一整年", "去年", "上一年" };
+    QTest::newRow("longest-factor") << QString("(今天|明天)的?文件") << QStringList { "文件" };
+    QTest::newRow("quantified-class") << QString("\\d{2,4}年") << QStringList { "年" };
+    QTest::newRow("optional-char") << QString("a?b") << QStringList { "b" };
+    QTest::newRow("repeated-char") << QString("ab+c") << QStringList { "ab" };
+    QTest::newRow("lookahead") << QString("(?=x)abc") << QStringList { "abc" };
+    QTest::newRow("escaped-punct") << QString("\\.txt") << QStringList { ".txt" };
+    QTest::newRow("hex-escape") << QString("\\x41bc") << QStringList { "bc" };
+    QTest::newRow("unknown-branch") << QString("文件|\\d+") << QStringList();
+    QTest::newRow("inline-option") << QString("(?i)abc") << QStringList();
+    QTest::newRow("class-only") << QString("[年\\./\\-]") << QStringList();
+    QTest::newRow("backreference") << QString("(a)\\1") << QStringList();
+}
+
+void tst_RuleEngine::requiredLiterals()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QStringList, literals);
+
+    QCOMPARE(CompiledRuleGroup::requiredLiterals(pattern), literals);
+}
+
+void tst_RuleEngine::compiledMatchKeepsPriorityOrder()
+{
+    const auto makeRule = [](const QString &id, const QString &pattern, int priority, bool enabled = true) {
+        QJsonObject rule;
+        rule["id"] = id;
+        rule["pattern"] = pattern;
+        rule["priority"] = priority;
+        rule["enabled"] = enabled;
+        return rule;
+    };
+
+    QJsonObject ruleGroup;
+    ruleGroup["name"] = "compiled";
+    ruleGroup["version"] = "1.0.0";
+    ruleGroup["rules"] = QJsonArray({ makeRule("digits", "\\d+", 10),
+                                      makeRule("file", "文件", 100),
+                                      makeRule("last_year", "去年|上一年", 200),
+                                      makeRule("disabled", "文件", 300, false) });
+    QJsonObject root;
+    root["groups"] = QJsonArray({ ruleGroup });
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("rules.json");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument(root).toJson());
+    file.close();
+
+    SemanticRuleEngine engine;
+    QVERIFY(engine.loadRuleFile(path));
+
+    QRegularExpressionMatch match;
+    QString ruleId;
+    QVERIFY(engine.match("compiled", "上一年的文件", match, &ruleId));
+    QCOMPARE(ruleId, QString("last_year"));
+    QCOMPARE(match.captured(), QString("上一年"));
+
+    // The disabled rule has the highest priority but is never tried
+    QVERIFY(engine.match("compiled", "文件 2024", match, &ruleId));
+    QCOMPARE(ruleId, QString("file"));
+
+    QStringList ids;
+    const QList<QRegularExpressionMatch> all = engine.matchAll("compiled", "2024 文件和文件", &ids);
+    QCOMPARE(all.size(), 3);
+    QCOMPARE(ids, QStringList({ "file", "file", "digits" }));
+
+    QVERIFY(!engine.match("compiled", "无关内容", match, &ruleId));
+    QVERIFY(engine.matchAll("compiled", "无关内容").isEmpty());
+    QVERIFY(!engine.match("missing", "文件", match));
+}
+
+void tst_RuleEngine::ruleBundleRoundTrip()
+{
+    RuleGroup time;
+    QVERIFY(buildGroupFromJson(makeRuleJson("time", "time_today", "今天|today", 200,
+                                            { { "type", "preset" }, { "preset", "today" } }),
+                               time));
+    RuleGroup noise;
+    QVERIFY(buildGroupFromJson(makeRuleJson("noise", "noise_de", "的", 10), noise));
+
+    QMap<QString, RuleGroup> groups { { time.name, time }, { noise.name, noise } };
+    const QMap<QString, QString> filePaths { { "time", "/rules/time_rules.json" } };
+    const QByteArray fingerprint(20, 'f');
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("cache/rules.bundle");
+    QVERIFY(RuleBundle::save(path, fingerprint, groups, filePaths));
+
+    QMap<QString, RuleGroup> loaded;
+    QMap<QString, QString> loadedPaths;
+    QVERIFY(RuleBundle::load(path, fingerprint, loaded, loadedPaths));
+    QCOMPARE(loaded.keys(), groups.keys());
+    QCOMPARE(loadedPaths, filePaths);
+    const Rule &rule = loaded.value("time").rules.first();
+    QCOMPARE(rule.id, QString("time_today"));
+    QCOMPARE(rule.priority, 200);
+    QCOMPARE(rule.metadata.value("preset").toString(), QString("today"));
+    QVERIFY(rule.regex.match("TODAY").hasMatch());
+
+    // Stale, corrupt and missing bundles are rejected
+    QVERIFY(!RuleBundle::load(path, QByteArray(20, 'g'), loaded, loadedPaths));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray bytes = file.readAll();
+    bytes[bytes.size() - 1] = static_cast<char>(bytes.at(bytes.size() - 1) ^ 0x1);
+    file.seek(0);
+    file.write(bytes);
+    file.close();
+    QVERIFY(!RuleBundle::load(path, fingerprint, loaded, loadedPaths));
+
+    QVERIFY(!RuleBundle::load(dir.filePath("missing.bundle"), fingerprint, loaded, loadedPaths));
+}
+
 // ===== tst_TimeExtraction =====
 
 class tst_TimeExtraction : public QObject
@@ -1029,6 +1165,7 @@ private Q_SLOTS:
     void locationAndTime();
     void keywordOnlyNoMatch();
     void consecutiveCalls();
+    void parseCacheHitsAndInvalidation();
     void noiseWordsOnly();
     void hiddenFile();
     void structuredKeywordRule();
@@ -1271,6 +1408,43 @@ void tst_IsSemanticQuery::consecutiveCalls()
     QVERIFY(!p1);
 }
 
+void tst_IsSemanticQuery::parseCacheHitsAndInvalidation()
+{
+    const QString input = "今天的pdf";
+    ParsedIntent first;
+    m_parser->parse(input, first);
+
+    // Same input: answered from the cache with an identical intent
+    const quint64 hits = m_parser->cacheHits();
+    const quint64 misses = m_parser->cacheMisses();
+    ParsedIntent second;
+    m_parser->parse(input, second);
+    QCOMPARE(m_parser->cacheHits(), hits + 1);
+    QCOMPARE(m_parser->cacheMisses(), misses);
+    QCOMPARE(second.fileExtensions(), first.fileExtensions());
+    QCOMPARE(second.keywords(), first.keywords());
+    QCOMPARE(second.timeConstraint().preset(), first.timeConstraint().preset());
+    QCOMPARE(second.consumedSpans().size(), first.consumedSpans().size());
+
+    // Reloading rules invalidates cached intents
+    const QString dir = sourceRulesDir();
+    const QString ruleFile = QDir(dir).entryList({ "*.json" }, QDir::Files, QDir::Name).first();
+    QVERIFY(m_engine->loadRuleFile(dir + "/" + ruleFile));
+    ParsedIntent third;
+    m_parser->parse(input, third);
+    QCOMPARE(m_parser->cacheMisses(), misses + 1);
+    QCOMPARE(third.fileExtensions(), first.fileExtensions());
+
+    // Capacity 0 disables caching
+    m_parser->setCacheCapacity(0);
+    ParsedIntent fourth;
+    m_parser->parse(input, fourth);
+    m_parser->parse(input, fourth);
+    QCOMPARE(m_parser->cacheHits(), hits + 1);
+    QCOMPARE(m_parser->cacheMisses(), misses + 3);
+    m_parser->setCacheCapacity(64);
+}
+
 void tst_IsSemanticQuery::noiseWordsOnly()
 {
     // Noise words alone (search action words) without any semantic dimension
@@ -1892,6 +2066,171 @@ void tst_SemanticQueryBuilderTarget::noKeywordWithFileExtensions()
     QCOMPARE(plan.fileNameQuery.type(), SearchQuery::Type::Simple);
 }
 
+// ===== tst_SemanticResultMerge =====
+
+// Drives the merge path of SemanticSearcherData with idle sub-engines, so the
+// order in which engines deliver chunks and finish is fully controlled.
+class tst_SemanticResultMerge : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void resultsArriveBeforeSlowestEngineFinishes();
+    void noDuplicatesAcrossEngines();
+    void excludePatternsMatchCaseInsensitively();
+    void finishedCarriesDeduplicatedListTruncatedAtMax();
+
+private:
+    QList<SearchEngine *> startFakeSearch(SemanticSearcher *searcher, SemanticSearcherData *data, int engineCount) const;
+    static SearchResultList makeResults(const QStringList &paths);
+    static QStringList pathsOf(const SearchResultList &results);
+    static QStringList foundPaths(const QSignalSpy &spy);
+};
+
+QList<SearchEngine *> tst_SemanticResultMerge::startFakeSearch(SemanticSearcher *searcher, SemanticSearcherData *data,
+                                                                int engineCount) const
+{
+    QList<SearchEngine *> engines;
+    for (int i = 0; i < engineCount; ++i)
+        engines.append(SearchEngine::create(SearchType::FileName, searcher));
+
+    data->engines = engines;
+    data->pendingFinishCount.store(engineCount);
+    data->status.store(SearchStatus::Searching);
+    return engines;
+}
+
+SearchResultList tst_SemanticResultMerge::makeResults(const QStringList &paths)
+{
+    SearchResultList results;
+    for (const QString &path : paths)
+        results.append(SearchResult(path));
+    return results;
+}
+
+QStringList tst_SemanticResultMerge::pathsOf(const SearchResultList &results)
+{
+    QStringList paths;
+    for (const SearchResult &result : results)
+        paths.append(result.path());
+    return paths;
+}
+
+QStringList tst_SemanticResultMerge::foundPaths(const QSignalSpy &spy)
+{
+    QStringList paths;
+    for (const QList<QVariant> &args : spy)
+        paths += pathsOf(args.at(0).value<SearchResultList>());
+    return paths;
+}
+
+void tst_SemanticResultMerge::resultsArriveBeforeSlowestEngineFinishes()
+{
+    SemanticSearcher searcher;
+    SemanticSearcherData data(&searcher);
+    const QList<SearchEngine *> engines = startFakeSearch(&searcher, &data, 2);
+    SearchEngine *fast = engines.at(0);
+    SearchEngine *slow = engines.at(1);
+
+    QSignalSpy foundSpy(&searcher, &SemanticSearcher::resultsFound);
+    QSignalSpy finishedSpy(&searcher, &SemanticSearcher::searchFinished);
+
+    // The fast engine's chunk is forwarded immediately, before anything finishes
+    data.onEngineResults(fast, makeResults({ "/tmp/a.txt", "/tmp/b.txt" }));
+    QCOMPARE(foundSpy.count(), 1);
+    QCOMPARE(finishedSpy.count(), 0);
+
+    data.onEngineFinished({});
+    QCOMPARE(finishedSpy.count(), 0);
+
+    // The slow engine keeps streaming while the search is still open
+    data.onEngineResults(slow, makeResults({ "/tmp/c.txt" }));
+    QCOMPARE(foundSpy.count(), 2);
+    QCOMPARE(finishedSpy.count(), 0);
+
+    // Chunks queued from engines of another search are ignored
+    std::unique_ptr<SearchEngine> stale(SearchEngine::create(SearchType::FileName));
+    data.onEngineResults(stale.get(), makeResults({ "/tmp/stale.txt" }));
+    QCOMPARE(foundSpy.count(), 2);
+
+    data.onEngineFinished({});
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(data.status.load(), SearchStatus::Finished);
+    QCOMPARE(foundPaths(foundSpy), (QStringList { "/tmp/a.txt", "/tmp/b.txt", "/tmp/c.txt" }));
+}
+
+void tst_SemanticResultMerge::noDuplicatesAcrossEngines()
+{
+    SemanticSearcher searcher;
+    SemanticSearcherData data(&searcher);
+    const QList<SearchEngine *> engines = startFakeSearch(&searcher, &data, 3);
+
+    QSignalSpy foundSpy(&searcher, &SemanticSearcher::resultsFound);
+    QSignalSpy finishedSpy(&searcher, &SemanticSearcher::searchFinished);
+
+    // The same file found by name, content and OCR is reported once
+    data.onEngineResults(engines.at(0), makeResults({ "/tmp/report.pdf", "/tmp/notes.txt" }));
+    data.onEngineResults(engines.at(1), makeResults({ "/tmp/notes.txt", "/tmp/report.pdf" }));
+    data.onEngineResults(engines.at(2), makeResults({ "/tmp/scan.png", "/tmp/report.pdf", "/tmp/scan.png" }));
+    // Engines that do not stream deliver their results with searchFinished
+    data.onEngineFinished(makeResults({ "/tmp/notes.txt", "/tmp/summary.md" }));
+    data.onEngineFinished({});
+    data.onEngineFinished({});
+
+    const QStringList expected { "/tmp/report.pdf", "/tmp/notes.txt", "/tmp/scan.png", "/tmp/summary.md" };
+    QCOMPARE(foundPaths(foundSpy), expected);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(pathsOf(finishedSpy.at(0).at(0).value<SearchResultList>()), expected);
+}
+
+void tst_SemanticResultMerge::excludePatternsMatchCaseInsensitively()
+{
+    SemanticSearcher searcher;
+    SemanticSearcherData data(&searcher);
+    const QList<SearchEngine *> engines = startFakeSearch(&searcher, &data, 1);
+
+    const QString pattern = "*_thumb.jpg";
+    data.excludeNamePatterns = { pattern };
+    data.excludeNameMatchers.emplace_back(SearchQuery(pattern, SearchQuery::Type::Wildcard), SearchOptions());
+
+    // Same decisions as the QDir::match() the matchers replaced
+    const QStringList paths { "/tmp/IMG_THUMB.JPG", "/tmp/photo_Thumb.jpg", "/tmp/photo.jpg",
+                              "/tmp/thumb.jpg", "/tmp/a_thumb.jpg/inside.txt" };
+    for (const QString &path : paths)
+        QCOMPARE(data.isExcludedName(path), QDir::match(pattern, QFileInfo(path).fileName()));
+
+    QSignalSpy finishedSpy(&searcher, &SemanticSearcher::searchFinished);
+    data.onEngineResults(engines.at(0), makeResults(paths));
+    data.onEngineFinished({});
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(pathsOf(finishedSpy.at(0).at(0).value<SearchResultList>()),
+             (QStringList { "/tmp/photo.jpg", "/tmp/thumb.jpg", "/tmp/a_thumb.jpg/inside.txt" }));
+}
+
+void tst_SemanticResultMerge::finishedCarriesDeduplicatedListTruncatedAtMax()
+{
+    SemanticSearcher searcher;
+    SemanticSearcherData data(&searcher);
+    data.maxResults = 3;
+    const QList<SearchEngine *> engines = startFakeSearch(&searcher, &data, 2);
+
+    QSignalSpy foundSpy(&searcher, &SemanticSearcher::resultsFound);
+    QSignalSpy finishedSpy(&searcher, &SemanticSearcher::searchFinished);
+
+    data.onEngineResults(engines.at(0), makeResults({ "/tmp/a.txt", "/tmp/b.txt" }));
+    data.onEngineResults(engines.at(1), makeResults({ "/tmp/b.txt", "/tmp/c.txt", "/tmp/d.txt", "/tmp/e.txt" }));
+    // Nothing is forwarded once the limit is reached
+    data.onEngineFinished(makeResults({ "/tmp/f.txt" }));
+    data.onEngineFinished({});
+
+    const QStringList expected { "/tmp/a.txt", "/tmp/b.txt", "/tmp/c.txt" };
+    QCOMPARE(foundSpy.count(), 2);
+    QCOMPARE(foundPaths(foundSpy), expected);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(pathsOf(finishedSpy.at(0).at(0).value<SearchResultList>()), expected);
+}
+
 // ===== Factory functions =====
 
 QObject *create_tst_RuleEngine()
@@ -1930,5 +2269,9 @@ QObject *create_tst_LocationExtraction()
 {
     return new tst_LocationExtraction();
 }
+QObject *create_tst_SemanticResultMerge()
+{
+    return new tst_SemanticResultMerge();
+}
 
 #include "tst_semantic_search.moc"
@@ -33,6 +33,7 @@ private Q_SLOTS:
     void textSearchResult_birthTimestamp();
     void textSearchResult_charCount();
     void textSearchResult_plainSnippetAttributes();
+    void textSearchResult_typedSlotsAndSharedCopies();
 
     // ContentOptionsAPI tests
     void contentOptions_inheritance();
@@ -214,6 +215,40 @@ void tst_TextSearchAPI::textSearchResult_plainSnippetAttributes()
     QCOMPARE(result.customAttribute("snippetOffset").toInt(), 42);
 }
 
+void tst_TextSearchAPI::textSearchResult_typedSlotsAndSharedCopies()
+{
+    SearchResult result("/test/path");
+    TextSearchResultAPI api(result);
+    api.setModifyTimestamp(1710000000);
+    api.setIsHidden(true);
+    api.setFilename("path");
+    result.setCustomAttribute("vendorScore", 0.5);
+
+    // 类型化字段仍可按原有键读取
+    QCOMPARE(result.customAttribute("modifyTimestamp").toLongLong(), qint64(1710000000));
+    QCOMPARE(result.customAttribute("isHidden").toBool(), true);
+    QCOMPARE(result.customAttribute("filename").toString(), QString("path"));
+    QVERIFY(!result.hasCustomAttribute("birthTimestamp"));
+
+    const QVariantMap attributes = result.customAttributes();
+    QCOMPARE(attributes.size(), 4);
+    QCOMPARE(attributes.value("vendorScore").toDouble(), 0.5);
+
+    // 通过键写入的值也能被类型化接口读到
+    result.setCustomAttribute("charCount", 7);
+    QCOMPARE(api.charCount(), 7);
+
+    // 副本共享数据，修改时分离
+    SearchResult copy = result;
+    TextSearchResultAPI copyApi(copy);
+    copyApi.setFilename("other");
+    copy.setPath("/other/path");
+    QCOMPARE(api.filename(), QString("path"));
+    QCOMPARE(result.path(), QString("/test/path"));
+    QCOMPARE(copyApi.filename(), QString("other"));
+    QCOMPARE(copyApi.modifyTimestamp(), qint64(1710000000));
+}
+
 // ==================== ContentOptionsAPI Tests ====================
 
 void tst_TextSearchAPI::contentOptions_inheritance()
@@ -125,7 +125,14 @@ private:
  * 3. On demand (e.g., scroll into view), call fetchHighlight() per path
  *
  * This decouples highlight extraction from the search pipeline,
- * enabling lazy-loading similar to thumbnail fetching.
+ * enabling lazy-loading similar to thumbnail fetching. Searches run with
+ * TextSearchOptionsAPI::setDeferredHighlightEnabled() mark their results
+ * for this pattern.
+ *
+ * For views that show many results, requestHighlights() computes the
+ * highlights asynchronously in parallel batches. The request can be
+ * reprioritized as the visible range changes and cancelled when the
+ * result list is replaced.
  */
 class ContentRetriever : public QObject
 {
@@ -213,6 +220,60 @@ public:
     PreviewResult fetchPreview(const QString &path, SearchType type,
                                const PreviewOptions &options = {}) const;
 
+    /**
+     * @brief Asynchronously fetch highlights for multiple files
+     *
+     * The paths are split into small batches that are processed in parallel
+     * on the shared search executor, in the order given. Every finished batch
+     * is delivered through highlightsReady(); highlightsFinished() is emitted
+     * once no batch of the request is left, including after cancellation.
+     * Signals are delivered in the thread this object lives in.
+     *
+     * @param paths   Absolute file paths, most important first (e.g. visible rows)
+     * @param keyword Search keyword (supports comma-separated for multi-keyword)
+     * @param type    SearchType::Content, SearchType::Ocr or SearchType::Semantic
+     * @param options Highlight configuration (preview length, HTML toggle)
+     * @return Request id, or -1 if there is nothing to fetch
+     */
+    int requestHighlights(const QStringList &paths,
+                          const QString &keyword,
+                          SearchType type,
+                          const HighlightOptions &options = {});
+
+    /**
+     * @brief Move pending paths of a request to the front of its queue
+     *
+     * Call this when the visible range changes so that rows scrolled into
+     * view are highlighted before the rest. Paths that are already being
+     * processed or that are not part of the request are ignored.
+     */
+    void prioritizeHighlights(int requestId, const QStringList &paths);
+
+    /**
+     * @brief Cancel a highlight request
+     *
+     * Batches that have not started are dropped, no further highlightsReady()
+     * is emitted for the request.
+     */
+    void cancelHighlights(int requestId);
+
+    /**
+     * @brief Cancel all highlight requests of this retriever
+     */
+    void cancelAllHighlights();
+
+Q_SIGNALS:
+    /**
+     * @brief A batch of an asynchronous highlight request has been computed
+     * @param highlights Mapping of path -> highlighted content (empty string if not found)
+     */
+    void highlightsReady(int requestId, const QMap<QString, QString> &highlights);
+
+    /**
+     * @brief All batches of an asynchronous highlight request have finished
+     */
+    void highlightsFinished(int requestId);
+
 private:
     struct Private;
     std::unique_ptr<Private> d;
@@ -247,6 +247,16 @@ enum class TimeUnit {
 };
 Q_ENUM_NS(TimeUnit)
 
+// Enumeration for the key indexed search results are ordered by
+enum class ResultSortKey {
+    None,         // Index collection order (default)
+    ModifyTime,   // File modification time
+    BirthTime,    // File creation time
+    FileSize,     // File size in bytes
+    FileName      // File name, case-insensitive
+};
+Q_ENUM_NS(ResultSortKey)
+
 DFM_SEARCH_END_NS
 
 Q_DECLARE_METATYPE(DFMSEARCH::SearchType);
@@ -10,6 +10,7 @@
 #include <dfm-search/searchoptions.h>
 #include <dfm-search/searchquery.h>
 #include <dfm-search/searcherror.h>
+#include <dfm-search/searchstatistics.h>
 
 DFM_SEARCH_BEGIN_NS
 
@@ -103,6 +104,16 @@ public:
      */
     void cancel();
 
+    /**
+     * @brief Get the statistics of the current or last search
+     *
+     * While a search is running the statistics are incomplete; after
+     * searchFinished() they hold the complete record of that search.
+     *
+     * @return Phase durations and counters of the search
+     */
+    SearchStatistics lastStatistics() const;
+
 Q_SIGNALS:
     /**
      * @brief Emitted when a search operation starts
@@ -127,6 +138,12 @@ Q_SIGNALS:
      */
     void searchFinished(const DFMSEARCH::SearchResultList &results);
 
+    /**
+     * @brief Emitted right before searchFinished with the statistics of the search
+     * @param statistics Phase durations and counters of the finished search
+     */
+    void searchStatisticsReady(const DFMSEARCH::SearchStatistics &statistics);
+
     /**
      * @brief Emitted when a search operation is cancelled
      */
@@ -159,6 +159,38 @@ public:
      */
     void setMaxResults(int count);
 
+    /**
+     * @brief Sets the order in which results are returned.
+     *
+     * With a sort key, indexed filename, content and OCR searches keep only the
+     * best maxResults() hits while collecting, in a single pass over the index,
+     * and return them in the requested order: for example ModifyTime with
+     * Qt::DescendingOrder and maxResults() 200 yields the 200 most recently
+     * modified matches. Hits with equal keys keep index order. Other search
+     * methods ignore this setting.
+     *
+     * @param key   Sort key, ResultSortKey::None (default) keeps index order
+     * @param order Sort direction
+     * @sa resultSortKey(), resultSortOrder()
+     */
+    void setResultSort(ResultSortKey key, Qt::SortOrder order);
+
+    /**
+     * @brief Returns the result sort key.
+     *
+     * @return The sort key, ResultSortKey::None if results are not sorted
+     * @sa setResultSort()
+     */
+    ResultSortKey resultSortKey() const;
+
+    /**
+     * @brief Returns the result sort direction.
+     *
+     * @return The sort direction (default Qt::AscendingOrder)
+     * @sa setResultSort()
+     */
+    Qt::SortOrder resultSortOrder() const;
+
     /**
      * @brief Set a custom option
      */
@@ -239,10 +271,11 @@ public:
     /**
      * @brief Sets the batch processing time interval in milliseconds.
      *
-     * This controls how frequently search results are batched and emitted during
-     * asynchronous search operations. A larger interval reduces the frequency of
-     * signal emissions but may make the UI feel less responsive. A smaller interval
-     * provides more responsive updates but may impact performance with high result volumes.
+     * This is the latency deadline of result batching during asynchronous search
+     * operations: a pending result is never held back longer than this interval.
+     * Batches are also flushed earlier once they reach the adaptive size threshold
+     * (see setMaxBatchSize()), and the first results bypass batching entirely
+     * (see setBatchImmediateCount()).
      *
      * @param milliseconds Batch time interval in milliseconds (minimum 50, maximum 5000)
      * @sa batchTime()
@@ -257,6 +290,132 @@ public:
      */
     int batchTime() const;
 
+    /**
+     * @brief Sets how many results are emitted immediately at the start of a search.
+     *
+     * The first results of an asynchronous search are delivered as soon as they are
+     * found, without waiting for the batch deadline, so that the UI can show them
+     * with minimal latency. Subsequent results are batched.
+     *
+     * @param count Number of results emitted without batching (default 32, 0 disables)
+     * @sa batchImmediateCount(), setBatchTime()
+     */
+    void setBatchImmediateCount(int count);
+
+    /**
+     * @brief Returns how many results are emitted immediately at the start of a search.
+     *
+     * @return Number of results emitted without batching
+     * @sa setBatchImmediateCount()
+     */
+    int batchImmediateCount() const;
+
+    /**
+     * @brief Sets the upper bound of the batch size threshold.
+     *
+     * A batch is flushed as soon as it holds as many results as the current size
+     * threshold, or when the batch deadline expires, whichever comes first. The
+     * threshold adapts to the measured throughput of the @c resultsFound consumers:
+     * a slow consumer receives smaller batches so that a single delivery stays short,
+     * a fast consumer receives larger batches up to this bound.
+     *
+     * @param size Maximum results per batch (minimum 1, default 500)
+     * @sa maxBatchSize(), setBatchTime()
+     */
+    void setMaxBatchSize(int size);
+
+    /**
+     * @brief Returns the upper bound of the batch size threshold.
+     *
+     * @return Maximum results per batch
+     * @sa setMaxBatchSize()
+     */
+    int maxBatchSize() const;
+
+    /**
+     * @brief Sets the maximum number of worker threads a single search may use.
+     *
+     * Only search methods that can traverse in parallel honour this value; at the
+     * moment that is the real-time filename search, which walks directories on
+     * several threads with work stealing. Indexed searches ignore it.
+     *
+     * @param count Number of worker threads, 0 (default) selects QThread::idealThreadCount()
+     * @sa maxThreadCount()
+     */
+    void setMaxThreadCount(int count);
+
+    /**
+     * @brief Returns the maximum number of worker threads a single search may use.
+     *
+     * @return Worker thread count, 0 means automatic
+     * @sa setMaxThreadCount()
+     */
+    int maxThreadCount() const;
+
+    /**
+     * @brief Sets the scheduling priority of searches started with these options.
+     *
+     * All search engines share one bounded pool of worker threads. When every
+     * thread is busy, queued searches with a higher priority start first; running
+     * searches are never preempted.
+     *
+     * @param priority Scheduling priority, higher values start first (default 0)
+     * @sa searchPriority()
+     */
+    void setSearchPriority(int priority);
+
+    /**
+     * @brief Returns the scheduling priority of searches started with these options.
+     *
+     * @return Scheduling priority
+     * @sa setSearchPriority()
+     */
+    int searchPriority() const;
+
+    /**
+     * @brief Enables streaming result delivery in fixed-size chunks.
+     *
+     * When the chunk size is greater than 0, indexed and real-time strategies push
+     * their results to the engine in chunks of this size through a bounded queue:
+     * if the consumer falls behind, the search thread waits instead of piling up
+     * results. Every chunk is delivered through the @c resultsFound signal (or the
+     * result callback), independent of resultFoundEnabled().
+     *
+     * @param size Results per chunk, 0 (default) disables streaming
+     * @sa streamingChunkSize(), setResultAggregationEnabled()
+     */
+    void setStreamingChunkSize(int size);
+
+    /**
+     * @brief Returns the streaming chunk size.
+     *
+     * @return Results per chunk, 0 means streaming is disabled
+     * @sa setStreamingChunkSize()
+     */
+    int streamingChunkSize() const;
+
+    /**
+     * @brief Enables or disables keeping the aggregated result list.
+     *
+     * By default every result is also kept in the list passed to @c searchFinished
+     * and returned by synchronous searches. In streaming mode this can be disabled
+     * so that peak memory is bounded by the chunk size instead of the hit count;
+     * @c searchFinished then carries an empty list and consumers must collect the
+     * streamed chunks themselves. Has no effect when streaming is disabled.
+     *
+     * @param enable Set @c false to drop results once they have been streamed
+     * @sa resultAggregationEnabled(), setStreamingChunkSize()
+     */
+    void setResultAggregationEnabled(bool enable);
+
+    /**
+     * @brief Returns whether the aggregated result list is kept.
+     *
+     * @return @c true (default) if all results are kept until the search finishes
+     * @sa setResultAggregationEnabled()
+     */
+    bool resultAggregationEnabled() const;
+
     /**
      * @brief Sets the time range filter for search operations.
      *
@@ -4,6 +4,9 @@
 #ifndef SEARCHRESULT_H
 #define SEARCHRESULT_H
 
+#include <QSharedDataPointer>
+#include <QVariantMap>
+
 #include <DExpected>
 
 #include <dfm-search/dsearch_global.h>
@@ -19,6 +22,11 @@ class SearchResultData;
  * This class encapsulates all information about a search result, including its path
  * and any custom attributes that may be associated with it. It provides methods to
  * access and modify these properties.
+ *
+ * SearchResult is implicitly shared: copies are cheap and share their data until
+ * one of them is modified. The attributes set by the result API classes
+ * (FileNameResultAPI, ContentResultAPI, ...) are stored in compact typed slots and
+ * remain readable through customAttribute() under their usual keys.
  */
 class SearchResult
 {
@@ -106,7 +114,8 @@ public:
     QVariantMap customAttributes() const;
 
 protected:
-    std::unique_ptr<SearchResultData> d;
+    friend class SearchResultData;
+    QSharedDataPointer<SearchResultData> d;
 };
 
 using SearchResultList = QList<DFMSEARCH::SearchResult>;
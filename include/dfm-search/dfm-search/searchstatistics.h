@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef SEARCHSTATISTICS_H
+#define SEARCHSTATISTICS_H
+
+#include <QSharedDataPointer>
+#include <QVariantMap>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+class SearchStatisticsData;
+
+/**
+ * @brief The SearchStatistics class records where the time of one search went.
+ *
+ * Every search collects per-phase durations and a few counters while it runs.
+ * SearchEngine delivers them through searchStatisticsReady() right before
+ * searchFinished(), and keeps the last ones available via lastStatistics().
+ * Recording only reads a monotonic clock at phase boundaries and bumps
+ * integers, so it is always enabled.
+ *
+ * Phases that do not apply to a search type stay at zero, e.g. a real-time
+ * filename search has no IndexOpen phase and an indexed one visits no
+ * directories. When results are built on several threads, DocumentLoad and
+ * Highlight hold the time summed over all threads and may exceed the wall
+ * time of the search.
+ *
+ * Example usage:
+ * @code
+ * connect(engine, &SearchEngine::searchStatisticsReady, this, [](const SearchStatistics &stats) {
+ *     qDebug() << "collect" << stats.phaseMilliseconds(SearchStatistics::Phase::Collect) << "ms,"
+ *              << stats.counter(SearchStatistics::Counter::Hits) << "hits";
+ *     reportToDashboard(stats.toVariantMap());
+ * });
+ * @endcode
+ */
+class SearchStatistics
+{
+public:
+    /**
+     * @brief Phases of a search, in the order they normally run
+     */
+    enum class Phase {
+        Validation,   ///< Checking the query and options before dispatch
+        QueryBuild,   ///< Building the Lucene query or compiling the filename matcher
+        IndexOpen,   ///< Acquiring an index reader or the recent-file snapshot
+        Collect,   ///< Running the query or walking directories to find hits
+        DocumentLoad,   ///< Loading stored fields and building results
+        Highlight,   ///< Building highlighted snippets
+        Emit   ///< Time spent in receivers of resultsFound()
+    };
+    static constexpr int PhaseCount = static_cast<int>(Phase::Emit) + 1;
+
+    /**
+     * @brief Counters of work done by a search
+     */
+    enum class Counter {
+        Hits,   ///< Matches found, before maxResults is applied when known
+        DocumentsLoaded,   ///< Index documents loaded to build results
+        StoredBytesRead,   ///< Size of the stored field values loaded, text counted one byte per character
+        DirectoriesVisited,   ///< Directories read by a real-time search
+        StatCalls,   ///< stat() calls made by a real-time search
+        CacheHits   ///< Searches answered from the filename result cache without querying the index
+    };
+    static constexpr int CounterCount = static_cast<int>(Counter::CacheHits) + 1;
+
+    SearchStatistics();
+    SearchStatistics(const SearchStatistics &other);
+    SearchStatistics(SearchStatistics &&other) noexcept;
+    ~SearchStatistics();
+
+    SearchStatistics &operator=(const SearchStatistics &other);
+    SearchStatistics &operator=(SearchStatistics &&other) noexcept;
+
+    // ---------- Phases ----------
+
+    /**
+     * @brief Get the time spent in a phase
+     * @param phase The phase
+     * @return Duration in nanoseconds
+     */
+    qint64 phaseNanoseconds(Phase phase) const;
+
+    /**
+     * @brief Get the time spent in a phase
+     * @param phase The phase
+     * @return Duration in milliseconds
+     */
+    double phaseMilliseconds(Phase phase) const;
+
+    /**
+     * @brief Add time to a phase
+     * @param phase The phase
+     * @param nsecs Duration in nanoseconds; phases entered several times accumulate
+     */
+    void addPhaseTime(Phase phase, qint64 nsecs);
+
+    // ---------- Counters ----------
+
+    /**
+     * @brief Get the value of a counter
+     * @param counter The counter
+     * @return The counter value
+     */
+    qint64 counter(Counter counter) const;
+
+    /**
+     * @brief Add to a counter
+     * @param counter The counter
+     * @param value Amount to add
+     */
+    void addCounter(Counter counter, qint64 value = 1);
+
+    // ---------- Totals ----------
+
+    /**
+     * @brief Get the wall time from search() to searchFinished()
+     * @return Duration in nanoseconds, 0 when not measured
+     */
+    qint64 totalNanoseconds() const;
+
+    /**
+     * @brief Set the wall time of the search
+     * @param nsecs Duration in nanoseconds
+     */
+    void setTotalNanoseconds(qint64 nsecs);
+
+    /**
+     * @brief Add all phases and counters of another statistics object to this one
+     * @param other The statistics to add
+     * @return Reference to this object
+     */
+    SearchStatistics &merge(const SearchStatistics &other);
+
+    /**
+     * @brief Reset all phases, counters and the total to zero
+     */
+    void clear();
+
+    /**
+     * @brief Check whether nothing has been recorded
+     * @return true if all values are zero
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Export the statistics for logging or dashboards
+     *
+     * Keys are "totalMs", "phasesMs" (a map keyed by phaseName()) and
+     * "counters" (a map keyed by counterName()).
+     *
+     * @return The statistics as a variant map
+     */
+    QVariantMap toVariantMap() const;
+
+    /**
+     * @brief Get the stable key of a phase, e.g. "queryBuild"
+     */
+    static QString phaseName(Phase phase);
+
+    /**
+     * @brief Get the stable key of a counter, e.g. "storedBytesRead"
+     */
+    static QString counterName(Counter counter);
+
+private:
+    QSharedDataPointer<SearchStatisticsData> d;
+};
+
+DFM_SEARCH_END_NS
+
+Q_DECLARE_METATYPE(DFMSEARCH::SearchStatistics)
+
+#endif   // SEARCHSTATISTICS_H
@@ -96,6 +96,10 @@ public:
      * Equivalent to the parsing performed internally by search() before
      * searchStarted fires; the same ParsedIntent is emitted via intentParsed().
      *
+     * Recently parsed inputs are cached until the rules are reloaded, so
+     * calling this on every keystroke or before search() does not repeat
+     * the extractor pipeline for the same text.
+     *
      * @param input The natural language query string
      * @return The parsed intent. If parsing yields no constraints, the returned
      *         ParsedIntent has an invalid timeConstraint, invalid sizeConstraint,
@@ -179,8 +183,8 @@ public:
      * @brief Set the maximum number of results to return
      *
      * Each sub-engine (FileName, Content, OCR) will be limited to this count.
-     * After all engines finish, results are deduplicated and truncated
-     * to this count.
+     * Results are deduplicated as they arrive, and no further results are
+     * forwarded once this count is reached.
      *
      * @param count Maximum result count (0 = unlimited, default 0)
      */
@@ -221,7 +225,12 @@ Q_SIGNALS:
 
     /**
      * @brief Emitted when search results are found
-     * @param results The found search results
+     *
+     * Results are forwarded as soon as any sub-engine delivers them, without
+     * waiting for the other engines. Each batch only contains paths that were
+     * not reported before and that pass the exclude name patterns.
+     *
+     * @param results The newly found search results
      */
     void resultsFound(const DFMSEARCH::SearchResultList &results);
 
@@ -75,6 +75,45 @@ public:
      */
     bool isFullTextRetrievalEnabled() const;
 
+    /**
+     * @brief Enables or disables deferred highlighting.
+     *
+     * Only takes effect together with full-text retrieval. When enabled, the search
+     * does not load the stored text of the matched documents: results are returned
+     * as soon as they are found and are marked with TextSearchResultAPI::isHighlightDeferred().
+     * Highlights are then computed on demand for the rows that are actually shown,
+     * through ContentRetriever::requestHighlights() or ContentRetriever::fetchHighlights().
+     *
+     * @param enable Set to @c true to defer highlighting, @c false to highlight during the search.
+     */
+    void setDeferredHighlightEnabled(bool enable);
+
+    /**
+     * @brief Returns whether deferred highlighting is enabled.
+     *
+     * @return @c true if highlighting is deferred, @c false otherwise (default).
+     */
+    bool isDeferredHighlightEnabled() const;
+
+    /**
+     * @brief Enables or disables parallel segment search.
+     *
+     * When enabled, the index segments are searched concurrently on a shared thread pool,
+     * and loading and highlighting the matched documents is also spread across threads.
+     * Results and their order are the same as with a sequential search; this mainly
+     * speeds up large indexes made of many segments.
+     *
+     * @param enable Set to @c true to search segments in parallel, @c false to search sequentially.
+     */
+    void setParallelSegmentSearchEnabled(bool enable);
+
+    /**
+     * @brief Returns whether parallel segment search is enabled.
+     *
+     * @return @c true if segments are searched in parallel, @c false otherwise (default).
+     */
+    bool isParallelSegmentSearchEnabled() const;
+
     // ==================== File Extension Filter ====================
 
     /**
@@ -145,6 +184,22 @@ public:
      */
     void setHighlightedContent(const QString &content);
 
+    /**
+     * @brief Check whether the highlighted content of this result has been deferred
+     *
+     * A deferred result carries no highlighted content or character count. The result
+     * path is the handle used to fetch them later through ContentRetriever.
+     *
+     * @return true if the highlight must be fetched on demand, false otherwise
+     */
+    bool isHighlightDeferred() const;
+
+    /**
+     * @brief Mark the highlighted content of this result as deferred
+     * @param deferred true if the highlight must be fetched on demand
+     */
+    void setHighlightDeferred(bool deferred);
+
     // ==================== File Size ====================
 
     /**
@@ -18,10 +18,15 @@
 #include <dfm-search/field_names.h>
 #include <dfm-search/timerangefilter.h>
 
+#include "core/searchresultdata.h"
+#include "core/searchstrategy/phasetimer.h"
 #include "utils/cancellablecollector.h"
 #include "utils/contenthighlighter.h"
+#include "utils/indexreaderpool.h"
 #include "utils/lucenequeryutils.h"
 #include "utils/lucene_cancellation_compat.h"
+#include "utils/parallelsegmentsearch.h"
+#include "utils/termoffsethighlighter.h"
 #include "utils/timerangeutils.h"
 
 using namespace Lucene;
@@ -335,16 +340,16 @@ QueryPtr ContentIndexedStrategy::buildSimpleContentsQuery(const SearchQuery &que
 void ContentIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr &searcher,
                                                   const Lucene::Collection<Lucene::ScoreDocPtr> &scoreDocs)
 {
-    // Measure the time taken to process search results
-    QElapsedTimer resultTimer;
-    resultTimer.start();
-
     auto docsSize = scoreDocs.size();
 
     ContentOptionsAPI optAPI(m_options);
     bool enableHTML = optAPI.isSearchResultHighlightEnabled();
     int previewLen = optAPI.maxPreviewLength() > 0 ? optAPI.maxPreviewLength() : 50;
     bool enableRetrieval = optAPI.isFullTextRetrievalEnabled();
+    // 延迟高亮时不读取存储的全文，由调用方按需通过 ContentRetriever 获取
+    const bool deferHighlight = enableRetrieval && optAPI.isDeferredHighlightEnabled();
+    if (deferHighlight)
+        enableRetrieval = false;
     bool detailedResults = m_options.detailedResultsEnabled();
 
     // Build field selector to avoid loading the large 'contents' field when not needed.
@@ -365,19 +370,22 @@ void ContentIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
     Lucene::FieldSelectorPtr fieldSelector = newLucene<Lucene::MapFieldSelector>(fieldsToLoad);
 
     // Pre-allocate to avoid reallocation during append
-    m_results.reserve(m_results.size() + static_cast<int>(docsSize));
+    if (!isStreaming())
+        m_results.reserve(m_results.size() + static_cast<int>(docsSize));
 
-    for (int32_t i = 0; i < docsSize; ++i) {
-        if (m_cancelledRef && m_cancelledRef->load()) {
-            qInfo() << "Content search cancelled";
-            break;
-        }
+    // 结果可能在多个线程中生成，先累加到原子量，结束后一次写入统计
+    std::atomic<qint64> buildNs { 0 };
+    std::atomic<qint64> highlightNs { 0 };
+    std::atomic<qint64> documentsLoaded { 0 };
+    std::atomic<qint64> storedBytes { 0 };
 
+    // 读取文档并生成结果；并行处理时在多个线程中调用，只读访问共享状态
+    const auto buildResult = [&](int32_t i) -> std::optional<SearchResult> {
         try {
             Lucene::ScoreDocPtr scoreDoc = scoreDocs[i];
             if (!scoreDoc || scoreDoc->doc < 0) {
                 qWarning() << "Invalid ScoreDoc at index" << i;
-                continue;
+                return std::nullopt;
             }
 
             Lucene::DocumentPtr doc;
@@ -385,42 +393,61 @@ void ContentIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
                 doc = searcher->doc(scoreDoc->doc, fieldSelector);
                 if (!doc) {
                     qWarning() << "Failed to retrieve document at index:" << scoreDoc->doc;
-                    continue;
+                    return std::nullopt;
                 }
             } catch (const Lucene::LuceneException &e) {
                 qWarning() << "Exception while retrieving document:" << QString::fromStdWString(e.getError());
-                continue;
+                return std::nullopt;
             } catch (const std::exception &e) {
                 qWarning() << "Standard exception while retrieving document:" << e.what();
-                continue;
+                return std::nullopt;
             }
+            documentsLoaded.fetch_add(1, std::memory_order_relaxed);
+            storedBytes.fetch_add(LuceneQueryUtils::storedFieldsSize(doc), std::memory_order_relaxed);
 
             // Path filtering, hidden file exclusion — handled at query layer
             Lucene::String pathField = doc->get(LuceneFieldNames::Content::kPath);
             if (pathField.empty()) {
                 qWarning() << "Document missing path field at index:" << scoreDoc->doc;
-                continue;
+                return std::nullopt;
             }
 
             SearchResult result(QString::fromStdWString(pathField));
             ContentResultAPI resultApi(result);
-            result.setCustomAttribute("plainContentMatch", QString());
-            result.setCustomAttribute("snippetOffset", -1);
+            SearchResultData *resultData = SearchResultData::get(result);
+            resultData->setString(ResultSlot::PlainContentMatch, QString());
+            resultData->setInt64(ResultSlot::SnippetOffset, -1);
+            if (deferHighlight)
+                resultApi.setHighlightDeferred(true);
 
             if (enableRetrieval) {
                 try {
                     Lucene::String contentField = doc->get(LuceneFieldNames::Content::kContents);
                     if (!contentField.empty()) {
-                        const QString content = QString::fromStdWString(contentField);
+                        QElapsedTimer highlightTimer;
+                        highlightTimer.start();
+                        // 索引存储了词偏移时只解码命中附近的文本，否则扫描全文
+                        const TermOffsetHighlighter offsetHighlighter(searcher->getIndexReader(), scoreDoc->doc,
+                                                                      LuceneFieldNames::Content::kContents, contentField);
+                        std::optional<QString> highlightedContent = offsetHighlighter.customHighlight(m_keywords, previewLen, enableHTML);
                         // Fix: keep a dedicated plain-text snippet for CLI verbose output
                         // instead of reusing HTML-oriented highlightedContent.
-                        const ContentHighlighter::PlainSnippetResult plainSnippet = ContentHighlighter::plainSnippet(
-                                m_keywords, content, previewLen, previewLen);
-                        const QString highlightedContent = ContentHighlighter::customHighlight(m_keywords, content, previewLen, enableHTML);
-                        resultApi.setHighlightedContent(highlightedContent);
-                        resultApi.setCharCount(content.size());
-                        result.setCustomAttribute("plainContentMatch", plainSnippet.content);
-                        result.setCustomAttribute("snippetOffset", plainSnippet.snippetOffset);
+                        std::optional<ContentHighlighter::PlainSnippetResult> plainSnippet = offsetHighlighter.plainSnippet(
+                                m_keywords, previewLen, previewLen);
+                        int charCount = 0;
+                        if (highlightedContent && plainSnippet) {
+                            charCount = offsetHighlighter.charCount();
+                        } else {
+                            const QString content = QString::fromStdWString(contentField);
+                            plainSnippet = ContentHighlighter::plainSnippet(m_keywords, content, previewLen, previewLen);
+                            highlightedContent = ContentHighlighter::customHighlight(m_keywords, content, previewLen, enableHTML);
+                            charCount = content.size();
+                        }
+                        resultApi.setHighlightedContent(*highlightedContent);
+                        resultApi.setCharCount(charCount);
+                        resultData->setString(ResultSlot::PlainContentMatch, plainSnippet->content);
+                        resultData->setInt64(ResultSlot::SnippetOffset, plainSnippet->snippetOffset);
+                        highlightNs.fetch_add(highlightTimer.nsecsElapsed(), std::memory_order_relaxed);
                     }
                 } catch (const Lucene::LuceneException &e) {
                     qWarning() << "Exception retrieving content field:" << QString::fromStdWString(e.getError());
@@ -474,27 +501,41 @@ void ContentIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
                 }
             }
 
-            // 添加到结果集合
-            m_results.append(std::move(result));
-
-            // 实时发送结果
-            if (Q_UNLIKELY(m_options.resultFoundEnabled()))
-                emit resultFound(m_results.last());
+            return result;
 
         } catch (const Lucene::LuceneException &e) {
             qWarning() << "Error processing result:" << QString::fromStdWString(e.getError());
-            continue;
+            return std::nullopt;
         } catch (const std::exception &e) {
             qWarning() << "Standard exception:" << e.what();
-            continue;
+            return std::nullopt;
         } catch (...) {
             qWarning() << "Unknown exception during result processing";
-            continue;
+            return std::nullopt;
         }
-    }
-
-    qInfo() << "Content result processing time:" << resultTimer.elapsed() << "ms";
-    emit searchFinished(m_results);
+    };
+
+    const auto timedBuildResult = [&](int32_t i) {
+        QElapsedTimer buildTimer;
+        buildTimer.start();
+        std::optional<SearchResult> result = buildResult(i);
+        buildNs.fetch_add(buildTimer.nsecsElapsed(), std::memory_order_relaxed);
+        return result;
+    };
+
+    ParallelSegmentSearch::processHits(docsSize, optAPI.isParallelSegmentSearchEnabled(), m_cancelledRef, timedBuildResult,
+                                       [this](SearchResult &&result) { return addResult(std::move(result)); });
+    if (m_cancelledRef && m_cancelledRef->load())
+        qInfo() << "Content search cancelled";
+
+    // 高亮在生成结果的过程中进行，从文档加载阶段中扣除
+    m_statistics.addPhaseTime(SearchStatistics::Phase::DocumentLoad, buildNs.load() - highlightNs.load());
+    m_statistics.addPhaseTime(SearchStatistics::Phase::Highlight, highlightNs.load());
+    m_statistics.addCounter(SearchStatistics::Counter::DocumentsLoaded, documentsLoaded.load());
+    m_statistics.addCounter(SearchStatistics::Counter::StoredBytesRead, storedBytes.load());
+
+    flushResults();
+    finishSearch();
 }
 
 void ContentIndexedStrategy::performContentSearch(const SearchQuery &query)
@@ -505,7 +546,7 @@ void ContentIndexedStrategy::performContentSearch(const SearchQuery &query)
     if (!m_cancelledRef) {
         qWarning("ContentIndexedStrategy::performContentSearch: cancellation flag is null, aborting search");
         emit errorOccurred(SearchError(ContentSearchErrorCode::ContentIndexException));
-        emit searchFinished(m_results);
+        finishSearch();
         return;
     }
 
@@ -514,27 +555,23 @@ void ContentIndexedStrategy::performContentSearch(const SearchQuery &query)
     SearchCancellationGuard guard(m_cancelledRef);
 
     try {
-        // 获取索引目录
-        FSDirectoryPtr directory = FSDirectory::open(m_indexDir.toStdWString());
-        if (!directory) {
-            qWarning() << "Failed to open index directory:" << m_indexDir;
+        // 从进程级读取器池借用读取器，索引有变化时才会增量刷新
+        PhaseTimer indexOpenTimer(m_statistics, SearchStatistics::Phase::IndexOpen);
+        const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(m_indexDir);
+        indexOpenTimer.stop();
+        if (!lease || lease.reader()->numDocs() == 0) {
+            qWarning() << "Index is empty or cannot be opened:" << m_indexDir;
             emit errorOccurred(SearchError(ContentSearchErrorCode::ContentIndexNotFound));
             return;
         }
 
-        // 获取索引读取器
-        IndexReaderPtr reader = IndexReader::open(directory, true);
-        if (!reader || reader->numDocs() == 0) {
-            qWarning() << "Index is empty or cannot be opened";
-            emit errorOccurred(SearchError(ContentSearchErrorCode::ContentIndexNotFound));
-            return;
-        }
-
-        // 创建搜索器
-        IndexSearcherPtr searcher = newLucene<IndexSearcher>(reader);
+        const IndexReaderPtr &reader = lease.reader();
+        const IndexSearcherPtr &searcher = lease.searcher();
 
         // 构建查询
+        PhaseTimer queryBuildTimer(m_statistics, SearchStatistics::Phase::QueryBuild);
         m_currentQuery = buildLuceneQuery(query);
+        queryBuildTimer.stop();
         if (!m_currentQuery) {
             qWarning() << "Failed to build Lucene query";
             emit errorOccurred(SearchError(ContentSearchErrorCode::ContentIndexException));
@@ -542,32 +579,44 @@ void ContentIndexedStrategy::performContentSearch(const SearchQuery &query)
         }
 
         // 执行搜索
-        // Measure the time taken to execute the search
-        QElapsedTimer searchTimer;
-        searchTimer.start();
-
         int32_t maxResults = m_options.maxResults() > 0 ? m_options.maxResults() : reader->numDocs();
 
+        // 指定排序时遍历全部命中，只保留排序最靠前的 maxResults 个
+        ParallelSegmentSearch::Sort sort;
+        sort.key = m_options.resultSortKey();
+        sort.order = m_options.resultSortOrder();
+        sort.fields = SortedHitQueue::contentIndexFields();
+
         // 使用自定义 CancellableCollector 实现可中断搜索
         Collection<ScoreDocPtr> scoreDocs;
+        PhaseTimer collectTimer(m_statistics, SearchStatistics::Phase::Collect);
         try {
-            // 创建可取消的收集器
-            boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(m_cancelledRef, maxResults);
-
-            // 执行搜索，使用自定义收集器
+            int32_t totalHits = 0;
             qInfo() << "Content search execution start:" << query.keyword();
-            searcher->search(m_currentQuery, collector);
-            // 获取收集到的文档
-            scoreDocs = collector->getScoreDocs();
-
-            qInfo() << "Content search execution time:" << searchTimer.elapsed() << "ms"
-                    << "Total hits:" << collector->getTotalHits()
-                    << "Collected:" << scoreDocs.size()
-                    << "Keyword:" << query.keyword()
-                    << "Cancelled" << (m_cancelledRef ? m_cancelledRef->load() : false);
+            if (ContentOptionsAPI(m_options).isParallelSegmentSearchEnabled()) {
+                // 每个段使用独立的可取消收集器并行搜索，按段顺序合并
+                const ParallelSegmentSearch::Hits hits = ParallelSegmentSearch::search(
+                        searcher, m_currentQuery, m_cancelledRef, maxResults, sort);
+                scoreDocs = hits.scoreDocs;
+                totalHits = hits.totalHits;
+            } else {
+                // 创建可取消的收集器
+                boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(m_cancelledRef, maxResults);
+                collector->setSort(sort.key, sort.order, sort.fields);
+
+                // 执行搜索，使用自定义收集器
+                searcher->search(m_currentQuery, collector);
+                // 获取收集到的文档
+                scoreDocs = collector->getScoreDocs();
+                totalHits = collector->getTotalHits();
+            }
+
+            collectTimer.stop();
+            m_statistics.addCounter(SearchStatistics::Counter::Hits, totalHits);
         } catch (const SearchCancelledException &e) {
             qInfo() << "Content search cancelled during execution";
-            emit searchFinished(m_results);
+            collectTimer.stop();
+            finishSearch();
             return;
         } catch (const RuntimeException &e) {
 #if LUCENE_HAS_SEARCH_CANCELLATION
@@ -576,7 +625,8 @@ void ContentIndexedStrategy::performContentSearch(const SearchQuery &query)
             QString errorMsg = QString::fromStdWString(e.getError());
             if (errorMsg.contains("cancelled", Qt::CaseInsensitive)) {
                 qInfo() << "Content search cancelled in phraseFreq():" << errorMsg;
-                emit searchFinished(m_results);
+                collectTimer.stop();
+                finishSearch();
                 return;
             }
 #endif
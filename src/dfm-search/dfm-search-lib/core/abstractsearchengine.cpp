@@ -12,6 +12,7 @@ AbstractSearchEngine::AbstractSearchEngine(QObject *parent)
 {
     qRegisterMetaType<DFMSEARCH::SearchError>();
     qRegisterMetaType<DFMSEARCH::SearchResult>();
+    qRegisterMetaType<DFMSEARCH::SearchStatistics>();
 }
 
 AbstractSearchEngine::~AbstractSearchEngine()
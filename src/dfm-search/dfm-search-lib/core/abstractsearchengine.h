@@ -91,6 +91,12 @@ public:
      */
     virtual void cancel() = 0;
 
+    /**
+     * @brief Get the statistics of the current or last search
+     * @return Phase durations and counters recorded so far
+     */
+    virtual SearchStatistics lastStatistics() const = 0;
+
 Q_SIGNALS:
     /**
      * @brief Emitted when a search operation starts
@@ -115,6 +121,12 @@ Q_SIGNALS:
      */
     void searchFinished(const DFMSEARCH::SearchResultList &results);
 
+    /**
+     * @brief Emitted right before searchFinished with the statistics of the search
+     * @param statistics Phase durations and counters of the finished search
+     */
+    void searchStatisticsReady(const DFMSEARCH::SearchStatistics &statistics);
+
     /**
      * @brief Emitted when a search operation is cancelled
      */
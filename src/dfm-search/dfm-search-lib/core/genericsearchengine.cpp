@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "genericsearchengine.h"
+#include "searchstrategy/phasetimer.h"
 
 #include <QMutexLocker>
 #include <QFileInfo>
@@ -11,8 +12,6 @@
 DFM_SEARCH_BEGIN_NS
 DCORE_USE_NAMESPACE
 
-constexpr int kDefaultBatchTime = 1000;   // 1000ms
-
 GenericSearchEngine::GenericSearchEngine(QObject *parent)
     : AbstractSearchEngine(parent),
       m_worker(nullptr)
@@ -20,21 +19,23 @@ GenericSearchEngine::GenericSearchEngine(QObject *parent)
     // 设置初始状态
     m_status.store(SearchStatus::Ready);
 
-    // 设置批处理定时器
-    m_batchTimer.setInterval(kDefaultBatchTime);
+    // 批处理定时器只负责延迟上限，每次有结果开始等待时按剩余时间启动
+    m_batchTimer.setSingleShot(true);
     connect(&m_batchTimer, &QTimer::timeout, this, [this]() {
-        if (!m_batchResults.isEmpty() && m_status.load() == SearchStatus::Searching) {
-            emit resultsFound(m_batchResults);
-            m_batchResults.clear();
-        }
+        if (m_status.load() == SearchStatus::Searching)
+            flushBatch(ResultBatcher::FlushReason::Deadline);
     });
 }
 
 GenericSearchEngine::~GenericSearchEngine()
 {
-    // 停止工作线程
-    m_workerThread.quit();
-    m_workerThread.wait();
+    // 通知正在执行的搜索尽快结束，并唤醒可能正在等待引擎消费结果块的策略
+    m_cancelled.store(true);
+    m_streamLimiter.close();
+
+    // 策略引用了引擎的取消标志和限流器，必须等它结束后才能销毁引擎
+    if (m_worker)
+        m_worker->waitForIdle();
 
     // 停止批处理定时器
     m_batchTimer.stop();
@@ -42,20 +43,22 @@ GenericSearchEngine::~GenericSearchEngine()
 
 void GenericSearchEngine::init()
 {
-    // 创建工作对象
-    m_worker = new SearchWorker();
-    m_worker->moveToThread(&m_workerThread);
-
-    // 连接线程生命周期信号
-    connect(&m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    // 创建工作对象，与引擎处于同一线程，搜索在共享执行器中运行
+    m_worker = new SearchWorker(this);
 
-    // 连接控制信号（主线程 -> 工作线程）
+    // 连接控制信号
     connect(this, &GenericSearchEngine::requestSearch,
             m_worker, &SearchWorker::doSearch);
 
-    // 连接结果信号（工作线程 -> 主线程）
+    // 连接结果信号（工作对象已将策略信号排队回本线程）
     connect(m_worker, &SearchWorker::resultFound,
             this, &GenericSearchEngine::handleSearchResult);
+    connect(m_worker, &SearchWorker::resultsFound,
+            this, &GenericSearchEngine::handleSearchResults);
+    connect(m_worker, &SearchWorker::resultsStreamed,
+            this, &GenericSearchEngine::handleResultsStreamed);
+    connect(m_worker, &SearchWorker::statisticsReady,
+            this, &GenericSearchEngine::handleStatisticsReady);
     connect(m_worker, &SearchWorker::searchFinished,
             this, &GenericSearchEngine::handleSearchFinished);
     connect(m_worker, &SearchWorker::errorOccurred,
@@ -66,9 +69,7 @@ void GenericSearchEngine::init()
 
     // 将引擎级取消标志注入 worker，使策略能即时读取取消状态
     m_worker->setEngineCancelledFlag(&m_cancelled);
-
-    // 启动工作线程
-    m_workerThread.start();
+    m_worker->setResultStreamLimiter(&m_streamLimiter);
 }
 
 SearchOptions GenericSearchEngine::searchOptions() const
@@ -79,9 +80,6 @@ SearchOptions GenericSearchEngine::searchOptions() const
 void GenericSearchEngine::setSearchOptions(const SearchOptions &options)
 {
     m_options = options;
-    
-    // 更新批处理定时器间隔
-    m_batchTimer.setInterval(m_options.batchTime());
 }
 
 SearchStatus GenericSearchEngine::status() const
@@ -101,16 +99,18 @@ void GenericSearchEngine::search(const SearchQuery &query)
     // 清空结果列表
     m_results.clear();
 
-    // 清空批处理结果并启动定时器
-    m_batchResults.clear();
-    m_batchTimer.setInterval(m_options.batchTime());
-    m_batchTimer.start();
+    // 清空批处理结果
+    resetBatching();
+    resetStreaming();
+    resetStatistics();
 
     // 保存当前查询
     m_currentQuery = query;
 
     // 验证搜索条件
+    PhaseTimer validationTimer(m_statistics, SearchStatistics::Phase::Validation);
     auto validationResult = validateSearchConditions();
+    validationTimer.stop();
     if (validationResult.isError()) {
         reportError(validationResult);
         setStatus(SearchStatus::Error);
@@ -132,9 +132,12 @@ SearchResultExpected GenericSearchEngine::searchSync(const SearchQuery &query)
 {
     // 保存当前查询
     m_currentQuery = query;
+    resetStatistics();
 
     // 验证搜索条件
+    PhaseTimer validationTimer(m_statistics, SearchStatistics::Phase::Validation);
     auto validationResult = validateSearchConditions();
+    validationTimer.stop();
     if (validationResult.isError()) {
         return DUnexpected<SearchError>(validationResult);
     }
@@ -151,12 +154,25 @@ void GenericSearchEngine::cancel()
     // 停止批处理定时器
     m_batchTimer.stop();
 
+    // 唤醒等待背压的策略，使其立即看到取消
+    m_streamLimiter.close();
+
     if (m_status.load() != SearchStatus::Ready && m_status.load() != SearchStatus::Finished) {
         setStatus(SearchStatus::Cancelled);
         emit searchCancelled();
     }
 }
 
+ResultBatcher::Statistics GenericSearchEngine::batchStatistics() const
+{
+    return m_batcher.statistics();
+}
+
+SearchStatistics GenericSearchEngine::lastStatistics() const
+{
+    return m_statistics;
+}
+
 void GenericSearchEngine::handleSearchResult(const DFMSEARCH::SearchResult &result)
 {
     // 存储结果到全局结果列表
@@ -164,7 +180,7 @@ void GenericSearchEngine::handleSearchResult(const DFMSEARCH::SearchResult &resu
 
     // 如果设置了回调，立即调用回调，如果回调返回true则终止搜索
     if (m_callback) {
-        if (m_callback(result)) {
+        if (invokeCallback(result)) {
             // 回调返回 true，取消搜索
             cancel();
             return;
@@ -173,33 +189,153 @@ void GenericSearchEngine::handleSearchResult(const DFMSEARCH::SearchResult &resu
 
     // 将结果添加到批处理队列
     m_batchResults.append(result);
+    enqueueBatch(1);
 }
 
-void GenericSearchEngine::handleSearchFinished(const DFMSEARCH::SearchResultList &results)
+void GenericSearchEngine::handleSearchResults(const DFMSEARCH::SearchResultList &results)
 {
-    // 停止批处理定时器
-    m_batchTimer.stop();
+    // 已取消（包括回调请求终止）时丢弃排队中的批次
+    if (m_cancelled.load())
+        return;
 
-    // 发送剩余的批处理结果
-    if (!m_batchResults.isEmpty()) {
-        emit resultsFound(m_batchResults);
-        m_batchResults.clear();
+    if (!m_callback) {
+        m_results.append(results);
+        m_batchResults.append(results);
+        enqueueBatch(results.size());
+        return;
     }
 
+    for (const SearchResult &result : results) {
+        handleSearchResult(result);
+        if (m_cancelled.load())
+            return;
+    }
+}
+
+void GenericSearchEngine::handleSearchFinished(const DFMSEARCH::SearchResultList &results)
+{
+    // 发送剩余的批处理结果
+    flushBatch(ResultBatcher::FlushReason::Final);
+
     // 确保所有结果都已添加到m_results
-    if (m_results.size() != results.size()) {
+    // 流式策略在完成信号中不携带结果，此时保留按块汇总的列表
+    const bool streamed = m_streaming && results.isEmpty();
+    if (!streamed && m_results.size() != results.size()) {
         m_results = results;
     }
 
     // 设置状态为完成
     setStatus(SearchStatus::Finished);
 
+    // 统计先于完成信号发出，接收方在 searchFinished 中即可读取 lastStatistics()
+    m_statistics.setTotalNanoseconds(m_searchClock.nsecsElapsed());
+    emit searchStatisticsReady(m_statistics);
+
     // 如果没有通过 handleSearchResult 中断搜索，在这里执行最终检查
     // 注意：通常在 handleSearchResult 已处理大部分情况，此处仅作为备用
     // 发送完成信号
     emit searchFinished(m_results);
 }
 
+void GenericSearchEngine::handleStatisticsReady(const DFMSEARCH::SearchStatistics &statistics)
+{
+    m_statistics.merge(statistics);
+}
+
+void GenericSearchEngine::handleResultsStreamed(const DFMSEARCH::SearchResultList &results, quint64 generation)
+{
+    // 每个流式块对应策略占用的一个在途名额，无论是否丢弃都要归还；
+    // 上一次搜索遗留的块由限制器按代号忽略，结果也不再交给新的搜索
+    m_streamLimiter.release(generation);
+    if (generation != m_streamLimiter.generation())
+        return;
+
+    handleStreamedResults(results);
+}
+
+void GenericSearchEngine::handleStreamedResults(const DFMSEARCH::SearchResultList &results)
+{
+    // 已取消（包括回调请求终止）时丢弃排队中的块
+    if (m_cancelled.load())
+        return;
+
+    if (m_callback) {
+        for (const SearchResult &result : results) {
+            if (invokeCallback(result)) {
+                // 回调返回 true，取消搜索
+                cancel();
+                return;
+            }
+        }
+    }
+
+    // 不汇总时结果交给调用方后即释放，峰值内存只与块大小有关
+    if (m_options.resultAggregationEnabled())
+        m_results.append(results);
+
+    // 块本身就是一个批次，直接发送而不再进入 m_batchResults
+    PhaseTimer emitTimer(m_statistics, SearchStatistics::Phase::Emit);
+    emit resultsFound(results);
+}
+
+void GenericSearchEngine::resetBatching()
+{
+    m_batchTimer.stop();
+    m_batchResults.clear();
+    m_batcher.reset(m_options.batchImmediateCount(), m_options.maxBatchSize(), m_options.batchTime());
+    m_batchClock.start();
+}
+
+void GenericSearchEngine::enqueueBatch(int count)
+{
+    const qint64 now = m_batchClock.elapsed();
+    const ResultBatcher::FlushReason reason = m_batcher.add(count, now);
+    if (reason != ResultBatcher::FlushReason::None) {
+        flushBatch(reason);
+        return;
+    }
+
+    // 首条待发送结果开始计时，之后的结果不再推迟截止时间
+    if (!m_batchTimer.isActive())
+        m_batchTimer.start(static_cast<int>(m_batcher.remainingLatency(now)));
+}
+
+void GenericSearchEngine::flushBatch(ResultBatcher::FlushReason reason)
+{
+    m_batchTimer.stop();
+    if (m_batchResults.isEmpty())
+        return;
+
+    SearchResultList batch;
+    batch.swap(m_batchResults);
+
+    // 测量接收方处理本批次的耗时，用于调整后续批次大小
+    QElapsedTimer consumerTimer;
+    consumerTimer.start();
+    emit resultsFound(batch);
+    const qint64 consumerNs = consumerTimer.nsecsElapsed();
+    m_batcher.flushed(reason, m_batchClock.elapsed(), consumerNs);
+    m_statistics.addPhaseTime(SearchStatistics::Phase::Emit, consumerNs);
+}
+
+bool GenericSearchEngine::invokeCallback(const SearchResult &result)
+{
+    PhaseTimer emitTimer(m_statistics, SearchStatistics::Phase::Emit);
+    return m_callback(result);
+}
+
+void GenericSearchEngine::resetStatistics()
+{
+    m_statistics.clear();
+    m_searchClock.start();
+}
+
+void GenericSearchEngine::resetStreaming()
+{
+    m_streaming = m_options.streamingChunkSize() > 0;
+    m_streamLimiter.reset();
+}
+
 void GenericSearchEngine::handleErrorOccurred(const DFMSEARCH::SearchError &error)
 {
     // 停止批处理定时器
@@ -221,6 +357,8 @@ SearchResultExpected GenericSearchEngine::doSyncSearch(const SearchQuery &query)
     m_cancelled.store(false);
     // 重置同步搜索状态
     m_results.clear();
+    resetBatching();
+    resetStreaming();
     m_lastError = SearchError(SearchErrorCode::Success);
 
     // 创建事件循环
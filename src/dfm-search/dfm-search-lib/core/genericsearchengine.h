@@ -4,11 +4,12 @@
 #ifndef GENERICSEARCHENGINE_H
 #define GENERICSEARCHENGINE_H
 
-#include <QThread>
 #include <QMutex>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "abstractsearchengine.h"
+#include "resultbatcher.h"
 #include "searchstrategy/searchworker.h"
 
 DFM_SEARCH_BEGIN_NS
@@ -17,8 +18,10 @@ DFM_SEARCH_BEGIN_NS
  * @brief The GenericSearchEngine class provides a base implementation for all search engines
  *
  * This class implements the common functionality required by all search engines,
- * including thread management, result handling, and error reporting. It serves as
- * a base class for specific search engine implementations.
+ * including result handling and error reporting. It serves as a base class for
+ * specific search engine implementations. Engines do not own threads: searches
+ * run on the library-wide SearchExecutor pool, so creating and destroying
+ * engines is cheap.
  */
 class GenericSearchEngine : public AbstractSearchEngine
 {
@@ -37,7 +40,7 @@ public:
     virtual ~GenericSearchEngine();
 
     /**
-     * @brief Initialize the search engine and its worker thread
+     * @brief Initialize the search engine and its worker
      */
     virtual void init() override;
 
@@ -85,9 +88,21 @@ public:
      */
     void cancel() override;
 
+    /**
+     * @brief Get the batching counters of the current or last search
+     * @return Batch sizes, flush latencies and the current size threshold
+     */
+    ResultBatcher::Statistics batchStatistics() const;
+
+    /**
+     * @brief Get the statistics of the current or last search
+     * @return Phase durations and counters recorded so far
+     */
+    SearchStatistics lastStatistics() const override;
+
 Q_SIGNALS:
     /**
-     * @brief Internal signal to request worker thread to execute search
+     * @brief Internal signal to request the worker to execute search
      */
     void requestSearch(const DFMSEARCH::SearchQuery &query,
                       const DFMSEARCH::SearchOptions &options,
@@ -122,31 +137,100 @@ private Q_SLOTS:
      */
     void handleSearchResult(const DFMSEARCH::SearchResult &result);
 
+    /**
+     * @brief Handle a batch of new search results
+     * @param results The found search results
+     */
+    void handleSearchResults(const DFMSEARCH::SearchResultList &results);
+
+    /**
+     * @brief Handle a chunk pushed by a streaming strategy
+     * @param results The chunk of search results
+     * @param generation The stream limiter generation the chunk was acquired under
+     */
+    void handleResultsStreamed(const DFMSEARCH::SearchResultList &results, quint64 generation);
+
     /**
      * @brief Handle search completion
      * @param results The list of all search results
      */
     void handleSearchFinished(const DFMSEARCH::SearchResultList &results);
 
+    /**
+     * @brief Merge the statistics recorded by the strategy
+     * @param statistics The strategy statistics, delivered before searchFinished
+     */
+    void handleStatisticsReady(const DFMSEARCH::SearchStatistics &statistics);
+
     /**
      * @brief Handle search errors
      * @param error The SearchError that occurred
      */
     void handleErrorOccurred(const DFMSEARCH::SearchError &error);
 
+private:
+    /**
+     * @brief Deliver a streamed chunk of the current search to the callback or batcher
+     * @param results The chunk of search results
+     */
+    void handleStreamedResults(const DFMSEARCH::SearchResultList &results);
+
+    /**
+     * @brief Prepare streaming state before a new search is dispatched
+     */
+    void resetStreaming();
+
+    /**
+     * @brief Reset batching state before a new search is dispatched
+     */
+    void resetBatching();
+
+    /**
+     * @brief Clear the statistics and start timing a new search
+     */
+    void resetStatistics();
+
+    /**
+     * @brief Run the result callback, accounting its time to the emit phase
+     * @param result The result to pass to the callback
+     * @return The callback's request to stop the search
+     */
+    bool invokeCallback(const SearchResult &result);
+
+    /**
+     * @brief Account for results appended to the pending batch and flush if due
+     * @param count Number of results just appended
+     */
+    void enqueueBatch(int count);
+
+    /**
+     * @brief Emit the pending batch
+     * @param reason Why the batch is flushed, recorded in the batching counters
+     */
+    void flushBatch(ResultBatcher::FlushReason reason);
+
 protected:
     SearchOptions m_options;   ///< Current search options
     SearchQuery m_currentQuery;   ///< Current search query
     SearchEngine::ResultCallback m_callback;   ///< Current result callback
     SearchResultList m_results;   ///< List of search results
 
-    QThread m_workerThread;   ///< Worker thread for search operations
-    SearchWorker *m_worker;   ///< Search worker object
+    SearchWorker *m_worker;   ///< Search worker object, submits searches to the shared executor
     SearchError m_lastError;   ///< Last occurred error
 
     // Result batching members
-    QTimer m_batchTimer;   ///< Timer for batch sending results
+    QTimer m_batchTimer;   ///< Single-shot timer enforcing the batch latency deadline
     SearchResultList m_batchResults;   ///< Cached results waiting to be sent
+    ResultBatcher m_batcher;   ///< Decides when pending results are flushed
+    QElapsedTimer m_batchClock;   ///< Time base for batch latencies
+
+    // Result streaming members
+    ResultStreamLimiter m_streamLimiter;   ///< Bounds chunks queued between strategy and engine
+    bool m_streaming { false };   ///< Whether the current search streams its results in chunks
+
+    // Statistics members
+    SearchStatistics m_statistics;   ///< Statistics of the current or last search
+    QElapsedTimer m_searchClock;   ///< Wall time of the current search
 };
 
 DFM_SEARCH_END_NS
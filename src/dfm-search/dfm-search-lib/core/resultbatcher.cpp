@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "resultbatcher.h"
+
+#include <algorithm>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// 单次发送在接收方的目标耗时，约为一帧
+constexpr qint64 kDeliveryBudgetNs = 16 * 1000 * 1000;
+// 大小阈值的下限，避免吞吐很低时退化为逐条发送
+constexpr int kMinSizeThreshold = 16;
+// 发送耗时的测量下限，过短的耗时视为计时误差
+constexpr qint64 kMinConsumerNs = 1000;
+// 吞吐估计的平滑系数
+constexpr double kThroughputSmoothing = 0.3;
+}   // namespace
+
+ResultBatcher::ResultBatcher()
+{
+    reset(0, 1, 0);
+}
+
+void ResultBatcher::reset(int immediateCount, int maxBatchSize, int maxLatencyMs)
+{
+    m_immediateCount = std::max(0, immediateCount);
+    m_maxBatchSize = std::max(1, maxBatchSize);
+    m_maxLatencyMs = std::max(0, maxLatencyMs);
+    // 尚无吞吐测量时按上限批量，首批立即发送的结果会提供第一次测量
+    m_threshold = m_maxBatchSize;
+    m_resultsPerNs = 0.0;
+    m_pending = 0;
+    m_firstPendingMs = 0;
+    m_stats = Statistics();
+}
+
+ResultBatcher::FlushReason ResultBatcher::add(int count, qint64 nowMs)
+{
+    if (count <= 0)
+        return FlushReason::None;
+
+    if (m_pending == 0)
+        m_firstPendingMs = nowMs;
+    m_pending += count;
+
+    if (m_stats.deliveredResults < m_immediateCount)
+        return FlushReason::Immediate;
+    if (m_pending >= m_threshold)
+        return FlushReason::Size;
+    if (nowMs - m_firstPendingMs >= m_maxLatencyMs)
+        return FlushReason::Deadline;
+    return FlushReason::None;
+}
+
+qint64 ResultBatcher::remainingLatency(qint64 nowMs) const
+{
+    if (m_pending == 0)
+        return -1;
+    return std::max<qint64>(0, m_firstPendingMs + m_maxLatencyMs - nowMs);
+}
+
+void ResultBatcher::flushed(FlushReason reason, qint64 nowMs, qint64 consumerNs)
+{
+    const int size = m_pending;
+    m_pending = 0;
+    if (size == 0)
+        return;
+
+    const qint64 latency = std::max<qint64>(0, nowMs - m_firstPendingMs);
+
+    m_stats.minBatchSize = m_stats.batchCount == 0 ? size : std::min(m_stats.minBatchSize, size);
+    m_stats.maxBatchSize = std::max(m_stats.maxBatchSize, size);
+    ++m_stats.batchCount;
+    m_stats.deliveredResults += size;
+    m_stats.totalLatencyMs += latency;
+    m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latency);
+
+    switch (reason) {
+    case FlushReason::Immediate:
+        ++m_stats.immediateBatches;
+        break;
+    case FlushReason::Size:
+        ++m_stats.sizeBatches;
+        break;
+    case FlushReason::Deadline:
+        ++m_stats.deadlineBatches;
+        break;
+    default:
+        break;
+    }
+
+    updateThreshold(size, consumerNs);
+}
+
+ResultBatcher::Statistics ResultBatcher::statistics() const
+{
+    Statistics stats = m_stats;
+    stats.sizeThreshold = m_threshold;
+    return stats;
+}
+
+void ResultBatcher::updateThreshold(int size, qint64 consumerNs)
+{
+    const double rate = double(size) / double(std::max(consumerNs, kMinConsumerNs));
+    m_resultsPerNs = m_resultsPerNs > 0.0
+            ? kThroughputSmoothing * rate + (1.0 - kThroughputSmoothing) * m_resultsPerNs
+            : rate;
+
+    // 使一次发送在接收方的耗时约为预算值：接收方越慢，批次越小
+    const double target = m_resultsPerNs * double(kDeliveryBudgetNs);
+    const int lower = std::min(kMinSizeThreshold, m_maxBatchSize);
+    m_threshold = static_cast<int>(std::clamp(target, double(lower), double(m_maxBatchSize)));
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef RESULTBATCHER_H
+#define RESULTBATCHER_H
+
+#include <QtGlobal>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 引擎端结果批处理策略
+ *
+ * 决定何时把待发送结果作为一个批次发出：
+ * - 搜索开始后的前 immediateCount 条结果立即发送，保证首条结果的延迟
+ * - 之后待发送结果达到大小阈值，或最早一条等待超过 maxLatencyMs 时发送，以先到者为准
+ * - 大小阈值根据 resultsFound 接收方的实测吞吐调整，使单次发送耗时约为一帧
+ *
+ * 本类只做决策和计数，不持有结果也不读取时钟，时间由调用方传入。
+ */
+class ResultBatcher
+{
+public:
+    enum class FlushReason {
+        None,   ///< 继续等待
+        Immediate,   ///< 首批结果立即发送
+        Size,   ///< 达到大小阈值
+        Deadline,   ///< 达到延迟上限
+        Final   ///< 搜索结束时发送剩余结果
+    };
+
+    struct Statistics
+    {
+        int batchCount { 0 };   ///< 发送的批次数
+        int immediateBatches { 0 };   ///< 因首批立即发送的批次数
+        int sizeBatches { 0 };   ///< 因达到大小阈值发送的批次数
+        int deadlineBatches { 0 };   ///< 因达到延迟上限发送的批次数
+        qint64 deliveredResults { 0 };   ///< 发送的结果总数
+        int minBatchSize { 0 };
+        int maxBatchSize { 0 };
+        qint64 totalLatencyMs { 0 };   ///< 各批次最早结果等待时间之和
+        qint64 maxLatencyMs { 0 };   ///< 单批次最早结果的最长等待时间
+        int sizeThreshold { 0 };   ///< 当前大小阈值
+
+        double averageBatchSize() const { return batchCount > 0 ? double(deliveredResults) / batchCount : 0.0; }
+        double averageLatencyMs() const { return batchCount > 0 ? double(totalLatencyMs) / batchCount : 0.0; }
+    };
+
+    ResultBatcher();
+
+    /**
+     * @brief 新搜索开始前重置状态
+     * @param immediateCount 立即发送的结果数
+     * @param maxBatchSize 大小阈值的上限
+     * @param maxLatencyMs 结果最长等待时间
+     */
+    void reset(int immediateCount, int maxBatchSize, int maxLatencyMs);
+
+    /**
+     * @brief 记录新加入的待发送结果
+     * @return 需要立即发送时返回发送原因，否则返回 FlushReason::None
+     */
+    FlushReason add(int count, qint64 nowMs);
+
+    /**
+     * @brief 距最早待发送结果的截止时间还有多少毫秒，无待发送结果时返回 -1
+     */
+    qint64 remainingLatency(qint64 nowMs) const;
+
+    /**
+     * @brief 记录一次发送
+     * @param reason 发送原因
+     * @param nowMs 当前时间
+     * @param consumerNs 本次发送在接收方花费的时间
+     */
+    void flushed(FlushReason reason, qint64 nowMs, qint64 consumerNs);
+
+    int pendingCount() const { return m_pending; }
+    int sizeThreshold() const { return m_threshold; }
+    Statistics statistics() const;
+
+private:
+    void updateThreshold(int size, qint64 consumerNs);
+
+    int m_immediateCount { 0 };
+    int m_maxBatchSize { 1 };
+    int m_maxLatencyMs { 0 };
+    int m_threshold { 1 };
+    double m_resultsPerNs { 0.0 };   // 接收方吞吐的指数平滑估计
+
+    int m_pending { 0 };
+    qint64 m_firstPendingMs { 0 };
+
+    Statistics m_stats;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // RESULTBATCHER_H
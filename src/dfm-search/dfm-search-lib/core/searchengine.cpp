@@ -79,6 +79,8 @@ void SearchEngine::setSearchType(SearchType type)
             this, &SearchEngine::resultsFound);
     connect(d_ptr.get(), &AbstractSearchEngine::statusChanged,
             this, &SearchEngine::statusChanged);
+    connect(d_ptr.get(), &AbstractSearchEngine::searchStatisticsReady,
+            this, &SearchEngine::searchStatisticsReady);
     connect(d_ptr.get(), &AbstractSearchEngine::searchFinished,
             this, &SearchEngine::searchFinished);
     connect(d_ptr.get(), &AbstractSearchEngine::searchCancelled,
@@ -143,4 +145,12 @@ void SearchEngine::cancel()
         d_ptr->cancel();
     }
 }
+
+SearchStatistics SearchEngine::lastStatistics() const
+{
+    if (d_ptr) {
+        return d_ptr->lastStatistics();
+    }
+    return SearchStatistics();
+}
 DFM_SEARCH_END_NS
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "searchexecutor.h"
+
+#include <QThread>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// 语义搜索会同时发起文件名、全文、OCR 三个子搜索，至少保证它们能并行
+constexpr int kMinThreadCount = 3;
+// 空闲线程保留时间，覆盖用户连续输入时的多次搜索
+constexpr int kThreadExpiryMs = 60 * 1000;
+
+class SearchTask : public QRunnable
+{
+public:
+    explicit SearchTask(SearchExecutor::Task task)
+        : m_task(std::move(task))
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override { m_task(); }
+
+private:
+    SearchExecutor::Task m_task;
+};
+}   // namespace
+
+SearchExecutor *SearchExecutor::instance()
+{
+    static SearchExecutor executor;
+    return &executor;
+}
+
+SearchExecutor::SearchExecutor()
+{
+    m_pool.setMaxThreadCount(qMax(kMinThreadCount, QThread::idealThreadCount()));
+    m_pool.setExpiryTimeout(kThreadExpiryMs);
+}
+
+QRunnable *SearchExecutor::submit(Task task, int priority)
+{
+    QRunnable *runnable = new SearchTask(std::move(task));
+    m_pool.start(runnable, priority);
+    return runnable;
+}
+
+bool SearchExecutor::cancelPending(QRunnable *handle)
+{
+    if (!handle || !m_pool.tryTake(handle))
+        return false;
+
+    // 移出队列后所有权归调用方
+    delete handle;
+    return true;
+}
+
+void SearchExecutor::setMaxThreadCount(int count)
+{
+    m_pool.setMaxThreadCount(qMax(1, count));
+}
+
+int SearchExecutor::maxThreadCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+int SearchExecutor::activeThreadCount() const
+{
+    return m_pool.activeThreadCount();
+}
+
+DFM_SEARCH_END_NS
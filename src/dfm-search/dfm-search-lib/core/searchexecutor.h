@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef SEARCHEXECUTOR_H
+#define SEARCHEXECUTOR_H
+
+#include <functional>
+
+#include <QThreadPool>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 库级共享的搜索执行器
+ *
+ * 所有搜索引擎的策略都在同一个有界线程池中执行，引擎本身不再持有线程：
+ * - 线程数有上限，空闲线程在超时后才退出，连续搜索不会反复创建、销毁线程
+ * - 线程全忙时按优先级排队，优先级高的任务先开始
+ * - 取消是协作式的：已开始的任务通过引擎的取消标志尽快结束，
+ *   尚未开始的任务可以用 cancelPending() 直接移出队列
+ */
+class SearchExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    static SearchExecutor *instance();
+
+    /**
+     * @brief 提交一个搜索任务
+     * @param task 在线程池中执行的任务
+     * @param priority 优先级，数值大的先开始
+     * @return 任务句柄，仅在任务开始执行前可用于 cancelPending()
+     */
+    QRunnable *submit(Task task, int priority);
+
+    /**
+     * @brief 将尚未开始的任务移出队列并销毁
+     * @return 任务已开始或已结束时返回 false
+     */
+    bool cancelPending(QRunnable *handle);
+
+    void setMaxThreadCount(int count);
+    int maxThreadCount() const;
+    int activeThreadCount() const;
+
+private:
+    SearchExecutor();
+    Q_DISABLE_COPY(SearchExecutor)
+
+    QThreadPool m_pool;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // SEARCHEXECUTOR_H
@@ -150,6 +150,22 @@ void SearchOptions::setMaxResults(int count)
     d->maxResults = count;
 }
 
+void SearchOptions::setResultSort(ResultSortKey key, Qt::SortOrder order)
+{
+    d->resultSortKey = key;
+    d->resultSortOrder = order;
+}
+
+ResultSortKey SearchOptions::resultSortKey() const
+{
+    return d->resultSortKey;
+}
+
+Qt::SortOrder SearchOptions::resultSortOrder() const
+{
+    return d->resultSortOrder;
+}
+
 void SearchOptions::setCustomOption(const QString &key, const QVariant &value)
 {
     d->customOptions[key] = value;
@@ -211,6 +227,66 @@ int SearchOptions::batchTime() const
     return d->batchTimeMs;
 }
 
+void SearchOptions::setBatchImmediateCount(int count)
+{
+    d->batchImmediateCount = qMax(0, count);
+}
+
+int SearchOptions::batchImmediateCount() const
+{
+    return d->batchImmediateCount;
+}
+
+void SearchOptions::setMaxBatchSize(int size)
+{
+    d->maxBatchSize = qMax(1, size);
+}
+
+int SearchOptions::maxBatchSize() const
+{
+    return d->maxBatchSize;
+}
+
+void SearchOptions::setMaxThreadCount(int count)
+{
+    d->maxThreadCount = qMax(0, count);
+}
+
+int SearchOptions::maxThreadCount() const
+{
+    return d->maxThreadCount;
+}
+
+void SearchOptions::setSearchPriority(int priority)
+{
+    d->searchPriority = priority;
+}
+
+int SearchOptions::searchPriority() const
+{
+    return d->searchPriority;
+}
+
+void SearchOptions::setStreamingChunkSize(int size)
+{
+    d->streamingChunkSize = qMax(0, size);
+}
+
+int SearchOptions::streamingChunkSize() const
+{
+    return d->streamingChunkSize;
+}
+
+void SearchOptions::setResultAggregationEnabled(bool enable)
+{
+    d->resultAggregationEnabled = enable;
+}
+
+bool SearchOptions::resultAggregationEnabled() const
+{
+    return d->resultAggregationEnabled;
+}
+
 void SearchOptions::setTimeRangeFilter(const TimeRangeFilter &filter)
 {
     d->timeRangeFilter = filter;
@@ -36,11 +36,19 @@ public:
     bool includeHidden;   ///< Whether to include hidden files
     bool hiddenOnly;   ///< Whether to search hidden files only (exclude non-hidden)
     int maxResults;   ///< Maximum number of results to return
+    ResultSortKey resultSortKey { ResultSortKey::None };   ///< Key results are ordered by
+    Qt::SortOrder resultSortOrder { Qt::AscendingOrder };   ///< Direction of the result order
     QVariantHash customOptions;   ///< Custom search options
     bool resultFoundEnabled;   ///< Whether to enable result found notifications
     bool detailedResultsEnabled;   ///< Whether to include detailed information in search results
     int syncSearchTimeoutSecs { 60 };
     int batchTimeMs { 1000 };   ///< Batch processing time interval in milliseconds
+    int batchImmediateCount { 32 };   ///< Results emitted without batching at search start
+    int maxBatchSize { 500 };   ///< Upper bound of the adaptive batch size threshold
+    int maxThreadCount { 0 };   ///< Worker threads for parallel search, 0 means automatic
+    int searchPriority { 0 };   ///< Scheduling priority in the shared search executor
+    int streamingChunkSize { 0 };   ///< Results per streamed chunk, 0 disables streaming
+    bool resultAggregationEnabled { true };   ///< Whether to keep the aggregated result list
     TimeRangeFilter timeRangeFilter;   ///< Time range filter for search
     SizeRangeFilter sizeRangeFilter;   ///< File size range filter for search
 };
@@ -4,14 +4,52 @@
 
 #include <dfm-search/searchresult.h>
 
+#include <QHash>
+
 #include "searchresultdata.h"
 
 DFM_SEARCH_BEGIN_NS
 
+namespace {
+// Attribute keys used by the result APIs, indexed by ResultSlot
+const char *const kSlotKeys[] = {
+    "fileSizeBytes",
+    "modifyTimestamp",
+    "birthTimestamp",
+    "charCount",
+    "snippetOffset",
+    "isHidden",
+    "isDirectory",
+    "highlightDeferred",
+    "filename",
+    "fileExtension",
+    "fileType",
+    "size",
+    "modifiedTime",
+    "highlightedContent",
+    "plainContentMatch",
+    "ocrContent",
+    "checksum",
+};
+static_assert(sizeof(kSlotKeys) / sizeof(kSlotKeys[0]) == static_cast<size_t>(ResultSlot::Count),
+              "every ResultSlot needs an attribute key");
+
+// Interned key table, built once
+const QHash<QString, ResultSlot> &slotTable()
+{
+    static const QHash<QString, ResultSlot> table = [] {
+        QHash<QString, ResultSlot> t;
+        for (int i = 0; i < static_cast<int>(ResultSlot::Count); ++i)
+            t.insert(QString::fromLatin1(kSlotKeys[i]), static_cast<ResultSlot>(i));
+        return t;
+    }();
+    return table;
+}
+}   // namespace
+
 /////////
 SearchResultData::SearchResultData()
 {
-
 }
 
 SearchResultData::SearchResultData(const QString &path)
@@ -20,39 +58,233 @@ SearchResultData::SearchResultData(const QString &path)
 }
 
 SearchResultData::SearchResultData(const SearchResultData &other)
-    : path(other.path),
-      customAttributes(other.customAttributes)
+    : QSharedData(other),
+      path(other.path),
+      m_fileSizeBytes(other.m_fileSizeBytes),
+      m_modifyTimestamp(other.m_modifyTimestamp),
+      m_birthTimestamp(other.m_birthTimestamp),
+      m_charCount(other.m_charCount),
+      m_snippetOffset(other.m_snippetOffset),
+      m_present(other.m_present),
+      m_isHidden(other.m_isHidden),
+      m_isDirectory(other.m_isDirectory),
+      m_highlightDeferred(other.m_highlightDeferred),
+      m_extra(other.m_extra ? std::make_unique<Extra>(*other.m_extra) : nullptr)
 {
 }
 
-SearchResultData::SearchResultData(SearchResultData &&other) noexcept
-    : path(std::move(other.path)),
-      customAttributes(std::move(other.customAttributes))
+SearchResultData::~SearchResultData() = default;
+
+ResultSlot SearchResultData::slotForKey(const QString &key)
 {
+    return slotTable().value(key, ResultSlot::Count);
 }
 
-SearchResultData &SearchResultData::operator=(SearchResultData &&other) noexcept
+QString SearchResultData::keyForSlot(ResultSlot slot)
 {
-    if (this != &other) {
-        path = std::move(other.path);
-        customAttributes = std::move(other.customAttributes);
+    return QString::fromLatin1(kSlotKeys[static_cast<int>(slot)]);
+}
+
+void SearchResultData::clear(ResultSlot slot)
+{
+    m_present &= ~bit(slot);
+    if (isStringSlot(slot) && m_extra)
+        m_extra->strings[static_cast<int>(slot) - kFirstStringSlot].clear();
+}
+
+void SearchResultData::setInt64(ResultSlot slot, qint64 value)
+{
+    switch (slot) {
+    case ResultSlot::FileSizeBytes:
+        m_fileSizeBytes = value;
+        break;
+    case ResultSlot::ModifyTimestamp:
+        m_modifyTimestamp = value;
+        break;
+    case ResultSlot::BirthTimestamp:
+        m_birthTimestamp = value;
+        break;
+    case ResultSlot::CharCount:
+        m_charCount = static_cast<qint32>(value);
+        break;
+    case ResultSlot::SnippetOffset:
+        m_snippetOffset = static_cast<qint32>(value);
+        break;
+    default:
+        Q_ASSERT_X(false, "SearchResultData::setInt64", "not a numeric slot");
+        return;
+    }
+    m_present |= bit(slot);
+}
+
+qint64 SearchResultData::int64(ResultSlot slot) const
+{
+    switch (slot) {
+    case ResultSlot::FileSizeBytes:
+        return m_fileSizeBytes;
+    case ResultSlot::ModifyTimestamp:
+        return m_modifyTimestamp;
+    case ResultSlot::BirthTimestamp:
+        return m_birthTimestamp;
+    case ResultSlot::CharCount:
+        return m_charCount;
+    case ResultSlot::SnippetOffset:
+        return m_snippetOffset;
+    default:
+        return 0;
+    }
+}
+
+void SearchResultData::setBool(ResultSlot slot, bool value)
+{
+    switch (slot) {
+    case ResultSlot::IsHidden:
+        m_isHidden = value;
+        break;
+    case ResultSlot::IsDirectory:
+        m_isDirectory = value;
+        break;
+    case ResultSlot::HighlightDeferred:
+        m_highlightDeferred = value;
+        break;
+    default:
+        Q_ASSERT_X(false, "SearchResultData::setBool", "not a boolean slot");
+        return;
+    }
+    m_present |= bit(slot);
+}
+
+bool SearchResultData::boolean(ResultSlot slot) const
+{
+    switch (slot) {
+    case ResultSlot::IsHidden:
+        return m_isHidden;
+    case ResultSlot::IsDirectory:
+        return m_isDirectory;
+    case ResultSlot::HighlightDeferred:
+        return m_highlightDeferred;
+    default:
+        return false;
+    }
+}
+
+void SearchResultData::setString(ResultSlot slot, const QString &value)
+{
+    Q_ASSERT_X(isStringSlot(slot) && slot != ResultSlot::Count, "SearchResultData::setString", "not a string slot");
+    extra().strings[static_cast<int>(slot) - kFirstStringSlot] = value;
+    m_present |= bit(slot);
+}
+
+QString SearchResultData::string(ResultSlot slot) const
+{
+    if (!m_extra || !isStringSlot(slot) || slot == ResultSlot::Count)
+        return QString();
+    return m_extra->strings[static_cast<int>(slot) - kFirstStringSlot];
+}
+
+void SearchResultData::setAttribute(const QString &key, const QVariant &value)
+{
+    const ResultSlot slot = slotForKey(key);
+    // Invalid values keep the old "key present, value invalid" semantics in the generic map
+    if (slot != ResultSlot::Count && value.isValid()) {
+        if (m_extra)
+            m_extra->customAttributes.remove(key);
+        setSlotValue(slot, value);
+        return;
+    }
+
+    if (slot != ResultSlot::Count)
+        clear(slot);
+    extra().customAttributes[key] = value;
+}
+
+QVariant SearchResultData::attribute(const QString &key) const
+{
+    const ResultSlot slot = slotForKey(key);
+    if (slot != ResultSlot::Count && has(slot))
+        return slotValue(slot);
+    return m_extra ? m_extra->customAttributes.value(key) : QVariant();
+}
+
+bool SearchResultData::hasAttribute(const QString &key) const
+{
+    const ResultSlot slot = slotForKey(key);
+    if (slot != ResultSlot::Count && has(slot))
+        return true;
+    return m_extra && m_extra->customAttributes.contains(key);
+}
+
+QVariantMap SearchResultData::attributes() const
+{
+    QVariantMap map = m_extra ? m_extra->customAttributes : QVariantMap();
+    for (int i = 0; i < static_cast<int>(ResultSlot::Count); ++i) {
+        const ResultSlot slot = static_cast<ResultSlot>(i);
+        if (has(slot))
+            map.insert(keyForSlot(slot), slotValue(slot));
+    }
+    return map;
+}
+
+SearchResultData::Extra &SearchResultData::extra()
+{
+    if (!m_extra)
+        m_extra = std::make_unique<Extra>();
+    return *m_extra;
+}
+
+QVariant SearchResultData::slotValue(ResultSlot slot) const
+{
+    switch (slot) {
+    case ResultSlot::FileSizeBytes:
+    case ResultSlot::ModifyTimestamp:
+    case ResultSlot::BirthTimestamp:
+        return QVariant::fromValue(int64(slot));
+    case ResultSlot::CharCount:
+    case ResultSlot::SnippetOffset:
+        return QVariant(static_cast<int>(int64(slot)));
+    case ResultSlot::IsHidden:
+    case ResultSlot::IsDirectory:
+    case ResultSlot::HighlightDeferred:
+        return QVariant(boolean(slot));
+    default:
+        return QVariant(string(slot));
+    }
+}
+
+void SearchResultData::setSlotValue(ResultSlot slot, const QVariant &value)
+{
+    switch (slot) {
+    case ResultSlot::FileSizeBytes:
+    case ResultSlot::ModifyTimestamp:
+    case ResultSlot::BirthTimestamp:
+    case ResultSlot::CharCount:
+    case ResultSlot::SnippetOffset:
+        setInt64(slot, value.toLongLong());
+        break;
+    case ResultSlot::IsHidden:
+    case ResultSlot::IsDirectory:
+    case ResultSlot::HighlightDeferred:
+        setBool(slot, value.toBool());
+        break;
+    default:
+        setString(slot, value.toString());
+        break;
     }
-    return *this;
 }
 /////////
 
 SearchResult::SearchResult()
-    : d(std::make_unique<SearchResultData>())
+    : d(new SearchResultData())
 {
 }
 
 SearchResult::SearchResult(const QString &path)
-    : d(std::make_unique<SearchResultData>(path))
+    : d(new SearchResultData(path))
 {
 }
 
 SearchResult::SearchResult(const SearchResult &other)
-    : d(std::make_unique<SearchResultData>(*other.d))
+    : d(other.d)
 {
 }
 
@@ -65,9 +297,7 @@ SearchResult::~SearchResult() = default;
 
 SearchResult &SearchResult::operator=(const SearchResult &other)
 {
-    if (this != &other) {
-        d = std::make_unique<SearchResultData>(*other.d);
-    }
+    d = other.d;
     return *this;
 }
 
@@ -91,22 +321,22 @@ void SearchResult::setPath(const QString &path)
 
 void SearchResult::setCustomAttribute(const QString &key, const QVariant &value)
 {
-    d->customAttributes[key] = value;
+    d->setAttribute(key, value);
 }
 
 QVariant SearchResult::customAttribute(const QString &key) const
 {
-    return d->customAttributes.value(key);
+    return d->attribute(key);
 }
 
 bool SearchResult::hasCustomAttribute(const QString &key) const
 {
-    return d->customAttributes.contains(key);
+    return d->hasAttribute(key);
 }
 
 QVariantMap SearchResult::customAttributes() const
 {
-    return d->customAttributes;
+    return d->attributes();
 }
 
 DFM_SEARCH_END_NS
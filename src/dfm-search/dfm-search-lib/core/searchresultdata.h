@@ -4,62 +4,126 @@
 #ifndef SEARCH_RESULT_DATA_H
 #define SEARCH_RESULT_DATA_H
 
+#include <memory>
+
 #include <QString>
-#include <QDateTime>
+#include <QSharedData>
 #include <QVariantMap>
-#include <QStringList>
 
 #include <dfm-search/dsearch_global.h>
+#include <dfm-search/searchresult.h>
 
 DFM_SEARCH_BEGIN_NS
 
 /**
- * @brief The SearchResultData class provides the base private implementation for SearchResult
+ * @brief Typed attribute slots of a search result
+ *
+ * Every well-known attribute key set by the result APIs maps to one slot. Numeric
+ * and boolean slots are stored inline, string slots live in the optional side
+ * structure. Keys that are not listed here fall back to a generic QVariantMap.
+ */
+enum class ResultSlot : quint8 {
+    // Inline numeric and boolean slots
+    FileSizeBytes,
+    ModifyTimestamp,
+    BirthTimestamp,
+    CharCount,
+    SnippetOffset,
+    IsHidden,
+    IsDirectory,
+    HighlightDeferred,
+
+    // String slots in the side structure
+    Filename,
+    FileExtension,
+    FileType,
+    Size,
+    ModifiedTime,
+    HighlightedContent,
+    PlainContentMatch,
+    OcrContent,
+    Checksum,
+
+    Count
+};
+
+/**
+ * @brief The SearchResultData class provides the private implementation for SearchResult
  *
- * This class implements the PIMPL pattern for SearchResult, containing only the
- * data fields that are common to all types of search results.
+ * The data is implicitly shared: copying a SearchResult only bumps a reference
+ * count, the data is detached on the first write. Common attributes use fixed
+ * typed slots instead of string-keyed QVariant map nodes, so a result with all
+ * detail fields set needs at most two allocations besides its strings.
  */
-class SearchResultData
+class SearchResultData : public QSharedData
 {
 public:
-    /**
-     * @brief Default constructor
-     */
     SearchResultData();
+    explicit SearchResultData(const QString &path);
+    SearchResultData(const SearchResultData &other);
+    ~SearchResultData();
 
     /**
-     * @brief Constructor with path
-     * @param path The file path
+     * @brief Access the private data of a result, used by the result API classes
+     *
+     * The non-const overload detaches the result if its data is shared.
      */
-    SearchResultData(const QString &path);
+    static SearchResultData *get(SearchResult &result) { return result.d.data(); }
+    static const SearchResultData *get(const SearchResult &result) { return result.d.constData(); }
 
     /**
-     * @brief Copy constructor
-     * @param other The SearchResultData object to copy from
+     * @brief Map an attribute key to its slot
+     * @return The slot, or ResultSlot::Count for keys without a slot
      */
-    SearchResultData(const SearchResultData &other);
+    static ResultSlot slotForKey(const QString &key);
+    static QString keyForSlot(ResultSlot slot);
 
-    /**
-     * @brief Default destructor
-     */
-    ~SearchResultData() = default;
+    bool has(ResultSlot slot) const { return m_present & bit(slot); }
+    void clear(ResultSlot slot);
 
-    /**
-     * @brief Move constructor
-     * @param other The SearchResultData object to move from
-     */
-    SearchResultData(SearchResultData &&other) noexcept;
+    void setInt64(ResultSlot slot, qint64 value);
+    qint64 int64(ResultSlot slot) const;
+    void setBool(ResultSlot slot, bool value);
+    bool boolean(ResultSlot slot) const;
+    void setString(ResultSlot slot, const QString &value);
+    QString string(ResultSlot slot) const;
 
-    /**
-     * @brief Move assignment operator
-     * @param other The SearchResultData object to move from
-     * @return Reference to this object
-     */
-    SearchResultData &operator=(SearchResultData &&other) noexcept;
+    // String-keyed access, backing SearchResult::customAttribute() and friends
+    void setAttribute(const QString &key, const QVariant &value);
+    QVariant attribute(const QString &key) const;
+    bool hasAttribute(const QString &key) const;
+    QVariantMap attributes() const;
 
-    // Public data fields
     QString path;   ///< The file path
-    QVariantMap customAttributes;   ///< Custom attributes associated with the result
+
+private:
+    static constexpr int kFirstStringSlot = static_cast<int>(ResultSlot::Filename);
+    static constexpr int kStringSlotCount = static_cast<int>(ResultSlot::Count) - kFirstStringSlot;
+
+    // Optional fields, allocated on first use
+    struct Extra
+    {
+        QString strings[kStringSlotCount];
+        QVariantMap customAttributes;   ///< Attributes without a typed slot
+    };
+
+    static quint32 bit(ResultSlot slot) { return 1u << static_cast<int>(slot); }
+    static bool isStringSlot(ResultSlot slot) { return static_cast<int>(slot) >= kFirstStringSlot; }
+
+    Extra &extra();
+    QVariant slotValue(ResultSlot slot) const;
+    void setSlotValue(ResultSlot slot, const QVariant &value);
+
+    qint64 m_fileSizeBytes { 0 };
+    qint64 m_modifyTimestamp { 0 };
+    qint64 m_birthTimestamp { 0 };
+    qint32 m_charCount { 0 };
+    qint32 m_snippetOffset { 0 };
+    quint32 m_present { 0 };   ///< Bit set of slots that hold a value
+    bool m_isHidden { false };
+    bool m_isDirectory { false };
+    bool m_highlightDeferred { false };
+    std::unique_ptr<Extra> m_extra;
 };
 
 DFM_SEARCH_END_NS
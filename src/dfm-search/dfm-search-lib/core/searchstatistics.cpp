@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include <dfm-search/searchstatistics.h>
+
+#include <array>
+
+DFM_SEARCH_BEGIN_NS
+
+class SearchStatisticsData : public QSharedData
+{
+public:
+    std::array<qint64, SearchStatistics::PhaseCount> phaseNs {};
+    std::array<qint64, SearchStatistics::CounterCount> counters {};
+    qint64 totalNs { 0 };
+};
+
+SearchStatistics::SearchStatistics()
+    : d(new SearchStatisticsData)
+{
+}
+
+SearchStatistics::SearchStatistics(const SearchStatistics &other) = default;
+
+SearchStatistics::SearchStatistics(SearchStatistics &&other) noexcept = default;
+
+SearchStatistics::~SearchStatistics() = default;
+
+SearchStatistics &SearchStatistics::operator=(const SearchStatistics &other) = default;
+
+SearchStatistics &SearchStatistics::operator=(SearchStatistics &&other) noexcept = default;
+
+qint64 SearchStatistics::phaseNanoseconds(Phase phase) const
+{
+    return d->phaseNs[static_cast<size_t>(phase)];
+}
+
+double SearchStatistics::phaseMilliseconds(Phase phase) const
+{
+    return static_cast<double>(phaseNanoseconds(phase)) / 1e6;
+}
+
+void SearchStatistics::addPhaseTime(Phase phase, qint64 nsecs)
+{
+    if (nsecs > 0)
+        d->phaseNs[static_cast<size_t>(phase)] += nsecs;
+}
+
+qint64 SearchStatistics::counter(Counter counter) const
+{
+    return d->counters[static_cast<size_t>(counter)];
+}
+
+void SearchStatistics::addCounter(Counter counter, qint64 value)
+{
+    if (value != 0)
+        d->counters[static_cast<size_t>(counter)] += value;
+}
+
+qint64 SearchStatistics::totalNanoseconds() const
+{
+    return d->totalNs;
+}
+
+void SearchStatistics::setTotalNanoseconds(qint64 nsecs)
+{
+    d->totalNs = nsecs;
+}
+
+SearchStatistics &SearchStatistics::merge(const SearchStatistics &other)
+{
+    if (other.isEmpty())
+        return *this;
+
+    for (int i = 0; i < PhaseCount; ++i)
+        d->phaseNs[static_cast<size_t>(i)] += other.d->phaseNs[static_cast<size_t>(i)];
+    for (int i = 0; i < CounterCount; ++i)
+        d->counters[static_cast<size_t>(i)] += other.d->counters[static_cast<size_t>(i)];
+    d->totalNs += other.d->totalNs;
+    return *this;
+}
+
+void SearchStatistics::clear()
+{
+    if (!isEmpty())
+        d = new SearchStatisticsData;
+}
+
+bool SearchStatistics::isEmpty() const
+{
+    if (d->totalNs != 0)
+        return false;
+    for (qint64 value : d->phaseNs) {
+        if (value != 0)
+            return false;
+    }
+    for (qint64 value : d->counters) {
+        if (value != 0)
+            return false;
+    }
+    return true;
+}
+
+QVariantMap SearchStatistics::toVariantMap() const
+{
+    QVariantMap phases;
+    for (int i = 0; i < PhaseCount; ++i) {
+        const Phase phase = static_cast<Phase>(i);
+        phases.insert(phaseName(phase), phaseMilliseconds(phase));
+    }
+
+    QVariantMap counters;
+    for (int i = 0; i < CounterCount; ++i) {
+        const Counter c = static_cast<Counter>(i);
+        counters.insert(counterName(c), counter(c));
+    }
+
+    QVariantMap map;
+    map.insert(QStringLiteral("totalMs"), static_cast<double>(d->totalNs) / 1e6);
+    map.insert(QStringLiteral("phasesMs"), phases);
+    map.insert(QStringLiteral("counters"), counters);
+    return map;
+}
+
+QString SearchStatistics::phaseName(Phase phase)
+{
+    switch (phase) {
+    case Phase::Validation:
+        return QStringLiteral("validation");
+    case Phase::QueryBuild:
+        return QStringLiteral("queryBuild");
+    case Phase::IndexOpen:
+        return QStringLiteral("indexOpen");
+    case Phase::Collect:
+        return QStringLiteral("collect");
+    case Phase::DocumentLoad:
+        return QStringLiteral("documentLoad");
+    case Phase::Highlight:
+        return QStringLiteral("highlight");
+    case Phase::Emit:
+        return QStringLiteral("emit");
+    }
+    return QString();
+}
+
+QString SearchStatistics::counterName(Counter counter)
+{
+    switch (counter) {
+    case Counter::Hits:
+        return QStringLiteral("hits");
+    case Counter::DocumentsLoaded:
+        return QStringLiteral("documentsLoaded");
+    case Counter::StoredBytesRead:
+        return QStringLiteral("storedBytesRead");
+    case Counter::DirectoriesVisited:
+        return QStringLiteral("directoriesVisited");
+    case Counter::StatCalls:
+        return QStringLiteral("statCalls");
+    case Counter::CacheHits:
+        return QStringLiteral("cacheHits");
+    }
+    return QString();
+}
+
+DFM_SEARCH_END_NS
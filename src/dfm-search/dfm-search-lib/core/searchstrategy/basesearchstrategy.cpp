@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "basesearchstrategy.h"
+
+DFM_SEARCH_BEGIN_NS
+
+bool BaseSearchStrategy::isStreaming() const
+{
+    return m_streamLimiter && m_options.streamingChunkSize() > 0;
+}
+
+bool BaseSearchStrategy::addResult(SearchResult &&result)
+{
+    if (!isStreaming()) {
+        m_results.append(std::move(result));
+
+        // 实时发送结果
+        if (Q_UNLIKELY(m_options.resultFoundEnabled()))
+            emit resultFound(m_results.last());
+        return true;
+    }
+
+    if (m_streamChunk.isEmpty())
+        m_streamChunk.reserve(m_options.streamingChunkSize());
+    m_streamChunk.append(std::move(result));
+
+    if (m_streamChunk.size() >= m_options.streamingChunkSize())
+        return flushResults();
+    return true;
+}
+
+bool BaseSearchStrategy::addResults(const SearchResultList &results)
+{
+    if (!isStreaming()) {
+        m_results.append(results);
+
+        if (Q_UNLIKELY(m_options.resultFoundEnabled()))
+            emit resultsFound(results);
+        return true;
+    }
+
+    for (const SearchResult &result : results) {
+        if (!addResult(SearchResult(result)))
+            return false;
+    }
+    return true;
+}
+
+bool BaseSearchStrategy::flushResults()
+{
+    if (m_streamChunk.isEmpty())
+        return true;
+
+    // 在途块已满时在此等待引擎消费，取消时丢弃当前块
+    if (!m_streamLimiter->acquire(m_streamGeneration, m_cancelledRef)) {
+        m_streamChunk.clear();
+        return false;
+    }
+
+    emit resultsStreamed(m_streamChunk, m_streamGeneration);
+
+    // 排队的信号参数共享同一份数据，clear() 只释放引用而不复制
+    m_streamChunk.clear();
+    return true;
+}
+
+void BaseSearchStrategy::finishSearch()
+{
+    emit statisticsReady(m_statistics);
+    emit searchFinished(m_results);
+}
+
+DFM_SEARCH_END_NS
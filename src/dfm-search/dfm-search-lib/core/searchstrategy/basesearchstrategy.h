@@ -10,6 +10,9 @@
 #include <dfm-search/searchoptions.h>
 #include <dfm-search/searchresult.h>
 #include <dfm-search/searcherror.h>
+#include <dfm-search/searchstatistics.h>
+
+#include "resultstreamlimiter.h"
 
 DFM_SEARCH_BEGIN_NS
 
@@ -73,26 +76,101 @@ public:
         m_cancelledRef = flag;
     }
 
+    /**
+     * @brief 注入引擎的流式背压限制器，未注入时不启用流式模式
+     * @param generation 引擎派发本次搜索时限制器的代号
+     */
+    void setResultStreamLimiter(ResultStreamLimiter *limiter, quint64 generation)
+    {
+        m_streamLimiter = limiter;
+        m_streamGeneration = generation;
+    }
+
+    /**
+     * @brief 获取本次搜索到目前为止的统计
+     */
+    SearchStatistics statistics() const { return m_statistics; }
+
 Q_SIGNALS:
     /**
      * @brief 找到搜索结果信号
      */
     void resultFound(const DFMSEARCH::SearchResult &result);
 
+    /**
+     * @brief 批量找到搜索结果信号
+     *
+     * 供一次产生多条结果的策略使用（如并行实时搜索），避免逐条发射信号
+     */
+    void resultsFound(const DFMSEARCH::SearchResultList &results);
+
+    /**
+     * @brief 流式结果块信号
+     *
+     * 每个块占用限制器的一个在途名额，引擎处理后按 generation 归还
+     */
+    void resultsStreamed(const DFMSEARCH::SearchResultList &results, quint64 generation);
+
     /**
      * @brief 搜索完成信号
      */
     void searchFinished(const DFMSEARCH::SearchResultList &results);
 
+    /**
+     * @brief 搜索统计信号，由 finishSearch() 紧接在 searchFinished 之前发射
+     */
+    void statisticsReady(const DFMSEARCH::SearchStatistics &statistics);
+
     /**
      * @brief 搜索出错信号
      */
     void errorOccurred(const DFMSEARCH::SearchError &error);
 
 protected:
+    /**
+     * @brief 是否以固定大小的块流式推送结果
+     *
+     * 流式模式下结果不进入 m_results，searchFinished 携带空列表，
+     * 由引擎根据 resultAggregationEnabled() 决定是否汇总
+     */
+    bool isStreaming() const;
+
+    /**
+     * @brief 统一的结果出口
+     *
+     * 非流式模式下追加到 m_results，并在 resultFoundEnabled 时逐条发射 resultFound；
+     * 流式模式下攒入当前块，满块后推送
+     *
+     * @return 搜索已取消时返回 false，调用方应停止产生结果
+     */
+    bool addResult(SearchResult &&result);
+
+    /**
+     * @brief 一次添加多条结果，语义同 addResult()
+     */
+    bool addResults(const SearchResultList &results);
+
+    /**
+     * @brief 推送流式模式下尚未满的最后一个块，发射 searchFinished 前调用
+     */
+    bool flushResults();
+
+    /**
+     * @brief 结束搜索：依次发射 statisticsReady 与 searchFinished
+     *
+     * 两个信号按发射顺序排队送达，引擎处理完成信号时统计已经到位
+     */
+    void finishSearch();
+
     SearchOptions m_options;
     SearchResultList m_results;
+    SearchStatistics m_statistics;   // 本次搜索的阶段耗时与计数，只在搜索线程中写入
     std::atomic<bool> *m_cancelledRef { nullptr };
+
+private:
+    ResultStreamLimiter *m_streamLimiter { nullptr };
+    quint64 m_streamGeneration { 0 };
+    SearchResultList m_streamChunk;   // 流式模式下正在攒的块
 };
 
 DFM_SEARCH_END_NS
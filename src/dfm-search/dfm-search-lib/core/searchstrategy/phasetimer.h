@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PHASETIMER_H
+#define PHASETIMER_H
+
+#include <QElapsedTimer>
+
+#include <dfm-search/searchstatistics.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 把一段代码的耗时计入搜索统计的某个阶段
+ *
+ * 离开作用域或调用 stop() 时记录，重复 stop() 只记录一次。
+ * 只在起止处各读一次单调时钟，可以常驻在搜索路径上。
+ */
+class PhaseTimer
+{
+public:
+    PhaseTimer(SearchStatistics &statistics, SearchStatistics::Phase phase)
+        : m_statistics(&statistics), m_phase(phase)
+    {
+        m_timer.start();
+    }
+
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    /**
+     * @brief 提前结束计时
+     * @return 本阶段经过的纳秒数，已经结束过时返回 0
+     */
+    qint64 stop()
+    {
+        if (!m_statistics)
+            return 0;
+
+        const qint64 elapsed = m_timer.nsecsElapsed();
+        m_statistics->addPhaseTime(m_phase, elapsed);
+        m_statistics = nullptr;
+        return elapsed;
+    }
+
+private:
+    SearchStatistics *m_statistics;
+    SearchStatistics::Phase m_phase;
+    QElapsedTimer m_timer;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // PHASETIMER_H
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "resultstreamlimiter.h"
+
+#include <QMutexLocker>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// 等待期间检查取消标志的间隔
+constexpr unsigned long kCancelPollMs = 50;
+}   // namespace
+
+ResultStreamLimiter::ResultStreamLimiter(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+}
+
+bool ResultStreamLimiter::acquire(quint64 generation, const std::atomic<bool> *cancelled)
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_closed && generation == m_generation && m_inFlight >= m_capacity) {
+        if (cancelled && cancelled->load())
+            return false;
+        m_notFull.wait(&m_mutex, kCancelPollMs);
+    }
+
+    if (m_closed || generation != m_generation || (cancelled && cancelled->load()))
+        return false;
+
+    ++m_inFlight;
+    return true;
+}
+
+void ResultStreamLimiter::release(quint64 generation)
+{
+    QMutexLocker locker(&m_mutex);
+    // 上一次搜索遗留的块在 reset() 之后才被处理，名额已随 reset() 清零
+    if (generation != m_generation)
+        return;
+
+    --m_inFlight;
+    m_notFull.wakeOne();
+}
+
+void ResultStreamLimiter::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_inFlight = 0;
+    m_closed = false;
+    ++m_generation;
+    m_notFull.wakeAll();
+}
+
+void ResultStreamLimiter::close()
+{
+    QMutexLocker locker(&m_mutex);
+    m_closed = true;
+    m_notFull.wakeAll();
+}
+
+int ResultStreamLimiter::inFlight() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_inFlight;
+}
+
+quint64 ResultStreamLimiter::generation() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_generation;
+}
+
+DFM_SEARCH_END_NS
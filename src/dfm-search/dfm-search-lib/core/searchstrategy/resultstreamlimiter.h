@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef RESULTSTREAMLIMITER_H
+#define RESULTSTREAMLIMITER_H
+
+#include <atomic>
+
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 流式结果的在途块限制（背压）
+ *
+ * 结果块本身仍通过排队的 resultsFound 信号传给引擎，本类只限制已发出但
+ * 引擎尚未处理的块数：策略发出每个块前调用 acquire()，在途块已满时阻塞；
+ * 引擎处理完一个块后调用 release()。这样消费方跟不上时，搜索线程会等待，
+ * 而不是在事件队列中堆积结果。
+ *
+ * 每次 reset() 开始新的一代，acquire()/release() 都带上搜索开始时取得的代号，
+ * 上一次搜索遗留的块在 reset() 之后才归还时不会占用新搜索的名额。
+ */
+class ResultStreamLimiter
+{
+public:
+    explicit ResultStreamLimiter(int capacity = 4);
+
+    /**
+     * @brief 占用一个在途名额，已满时阻塞等待
+     * @param generation 本次搜索开始时的 generation()
+     * @param cancelled 引擎级取消标志，等待期间会定期检查，可以为空
+     * @return 取消、已关闭或已有新搜索开始时返回 false，此时不应再发出结果块
+     */
+    bool acquire(quint64 generation, const std::atomic<bool> *cancelled);
+
+    /**
+     * @brief 归还一个在途名额（引擎线程调用）
+     * @param generation 占用名额时使用的代号，与当前代号不同时忽略
+     */
+    void release(quint64 generation);
+
+    /**
+     * @brief 新搜索开始前清空计数、重新打开并开始新的一代
+     */
+    void reset();
+
+    /**
+     * @brief 关闭并唤醒所有等待者，之后 acquire() 一律失败
+     */
+    void close();
+
+    int inFlight() const;
+
+    /**
+     * @brief 当前代号，引擎派发搜索时记录并随结果块一起传回
+     */
+    quint64 generation() const;
+
+private:
+    mutable QMutex m_mutex;
+    QWaitCondition m_notFull;
+    int m_capacity;
+    int m_inFlight { 0 };
+    bool m_closed { false };
+    quint64 m_generation { 0 };
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // RESULTSTREAMLIMITER_H
@@ -2,6 +2,9 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "searchworker.h"
+#include "core/searchexecutor.h"
+
+#include <QMutexLocker>
 
 DFM_SEARCH_BEGIN_NS
 
@@ -13,32 +16,87 @@ SearchWorker::SearchWorker(QObject *parent)
     qRegisterMetaType<SearchType>();
     qRegisterMetaType<SearchResultList>();
     qRegisterMetaType<SearchError>();
+    qRegisterMetaType<SearchStatistics>();
 }
 
-SearchWorker::~SearchWorker() = default;
+SearchWorker::~SearchWorker()
+{
+    waitForIdle();
+}
 
 void SearchWorker::setStrategyFactory(std::unique_ptr<SearchStrategyFactory> factory)
 {
     m_strategyFactory = std::move(factory);
 }
 
+void SearchWorker::waitForIdle()
+{
+    QMutexLocker locker(&m_mutex);
+    m_pending.reset();
+
+    // 还在排队的任务直接移出线程池，不必等它开始再退出
+    if (m_queuedTask && SearchExecutor::instance()->cancelPending(m_queuedTask)) {
+        m_queuedTask = nullptr;
+        m_busy = false;
+    }
+
+    while (m_busy)
+        m_idle.wait(&m_mutex);
+}
+
 void SearchWorker::doSearch(const SearchQuery &query,
                             const SearchOptions &options,
                             SearchType searchType)
 {
-    if (!m_strategyFactory) {
-        emit errorOccurred(SearchError(SearchErrorCode::InternalError));
+    QMutexLocker locker(&m_mutex);
+    // 在引擎线程中记录代号：引擎已在派发前 reset() 限制器，之后的新搜索会再次递增
+    const quint64 generation = m_streamLimiter ? m_streamLimiter->generation() : 0;
+    Request request { query, options, searchType, generation };
+
+    // 上一个搜索仍在执行（通常已被取消），结束后再开始新的搜索
+    if (m_busy) {
+        m_pending = std::move(request);
         return;
     }
 
-    // 断开之前的连接
-    if (m_strategy) {
-        disconnect(m_strategy.get(), nullptr, this, nullptr);
+    submitLocked(std::move(request));
+}
+
+void SearchWorker::submitLocked(Request request)
+{
+    m_busy = true;
+    const int priority = request.options.searchPriority();
+    auto task = [this, request = std::move(request)]() {
+        runRequest(request);
+    };
+    m_queuedTask = SearchExecutor::instance()->submit(std::move(task), priority);
+}
+
+void SearchWorker::runRequest(const Request &request)
+{
+    {
+        // 任务已开始，句柄随任务结束失效，不能再用于取消排队
+        QMutexLocker locker(&m_mutex);
+        m_queuedTask = nullptr;
+    }
+
+    execute(request);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_pending) {
+        Request next = std::move(*m_pending);
+        m_pending.reset();
+        submitLocked(std::move(next));
+        return;
     }
 
-    // 创建策略
-    m_strategy = m_strategyFactory->createStrategy(searchType, options);
-    if (!m_strategy) {
+    m_busy = false;
+    m_idle.wakeAll();
+}
+
+void SearchWorker::execute(const Request &request)
+{
+    if (!m_strategyFactory) {
         emit errorOccurred(SearchError(SearchErrorCode::InternalError));
         return;
     }
@@ -49,18 +107,33 @@ void SearchWorker::doSearch(const SearchQuery &query,
         emit errorOccurred(SearchError(SearchErrorCode::InternalError));
         return;
     }
-    m_strategy->setCancelledFlag(m_engineCancelled);
 
-    // 连接信号
-    connect(m_strategy.get(), &BaseSearchStrategy::resultFound,
-            this, &SearchWorker::resultFound);
-    connect(m_strategy.get(), &BaseSearchStrategy::searchFinished,
-            this, &SearchWorker::searchFinished);
-    connect(m_strategy.get(), &BaseSearchStrategy::errorOccurred,
-            this, &SearchWorker::errorOccurred);
+    // 创建策略，策略只在本次搜索期间存在
+    std::unique_ptr<BaseSearchStrategy> strategy = m_strategyFactory->createStrategy(request.searchType, request.options);
+    if (!strategy) {
+        emit errorOccurred(SearchError(SearchErrorCode::InternalError));
+        return;
+    }
+
+    strategy->setCancelledFlag(m_engineCancelled);
+    strategy->setResultStreamLimiter(m_streamLimiter, request.streamGeneration);
+
+    // 连接信号：策略在线程池线程中发射，排队回到工作对象所在线程
+    connect(strategy.get(), &BaseSearchStrategy::resultFound,
+            this, &SearchWorker::resultFound, Qt::QueuedConnection);
+    connect(strategy.get(), &BaseSearchStrategy::resultsFound,
+            this, &SearchWorker::resultsFound, Qt::QueuedConnection);
+    connect(strategy.get(), &BaseSearchStrategy::resultsStreamed,
+            this, &SearchWorker::resultsStreamed, Qt::QueuedConnection);
+    connect(strategy.get(), &BaseSearchStrategy::statisticsReady,
+            this, &SearchWorker::statisticsReady, Qt::QueuedConnection);
+    connect(strategy.get(), &BaseSearchStrategy::searchFinished,
+            this, &SearchWorker::searchFinished, Qt::QueuedConnection);
+    connect(strategy.get(), &BaseSearchStrategy::errorOccurred,
+            this, &SearchWorker::errorOccurred, Qt::QueuedConnection);
 
     // 执行搜索
-    m_strategy->search(query);
+    strategy->search(request.query);
 }
 
 DFM_SEARCH_END_NS
@@ -5,8 +5,11 @@
 #define CORE_SEARCHWORKER_H
 
 #include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
 #include <memory>
 #include <functional>
+#include <optional>
 #include <dfm-search/searchquery.h>
 #include <dfm-search/searchoptions.h>
 #include <dfm-search/searchresult.h>
@@ -17,7 +20,12 @@ DFM_SEARCH_BEGIN_NS
 class SearchStrategyFactory;   // 前向声明
 
 /**
- * @brief 通用搜索工作线程
+ * @brief 通用搜索工作对象
+ *
+ * 与所属引擎处于同一线程，本身不持有线程：doSearch() 把搜索提交到共享的
+ * SearchExecutor 执行，策略在线程池中发出的信号经排队连接回到本对象所在线程
+ * 再转发给引擎。同一个工作对象任一时刻只执行一个搜索，执行期间到达的新请求
+ * 会在当前搜索结束后开始（只保留最新的一个）。
  */
 class SearchWorker : public QObject
 {
@@ -31,9 +39,18 @@ public:
 
     void setEngineCancelledFlag(std::atomic<bool> *flag) { m_engineCancelled = flag; }
 
+    void setResultStreamLimiter(ResultStreamLimiter *limiter) { m_streamLimiter = limiter; }
+
+    /**
+     * @brief 丢弃尚未开始的请求，并等待正在执行的搜索结束
+     *
+     * 引擎销毁前调用，调用前应先置位引擎取消标志
+     */
+    void waitForIdle();
+
 public Q_SLOTS:
     /**
-     * @brief 执行搜索操作
+     * @brief 提交搜索操作
      */
     void doSearch(const DFMSEARCH::SearchQuery &query,
                   const DFMSEARCH::SearchOptions &options,
@@ -45,20 +62,53 @@ Q_SIGNALS:
      */
     void resultFound(const DFMSEARCH::SearchResult &result);
 
+    /**
+     * @brief 批量搜索结果信号
+     */
+    void resultsFound(const DFMSEARCH::SearchResultList &results);
+
+    /**
+     * @brief 流式结果块信号，generation 为派发搜索时限制器的代号
+     */
+    void resultsStreamed(const DFMSEARCH::SearchResultList &results, quint64 generation);
+
     /**
      * @brief 搜索完成信号
      */
     void searchFinished(const DFMSEARCH::SearchResultList &results);
 
+    /**
+     * @brief 搜索统计信号，在对应的 searchFinished 之前到达
+     */
+    void statisticsReady(const DFMSEARCH::SearchStatistics &statistics);
+
     /**
      * @brief 搜索错误信号
      */
     void errorOccurred(const DFMSEARCH::SearchError &error);
 
 private:
+    struct Request
+    {
+        SearchQuery query;
+        SearchOptions options;
+        SearchType searchType;
+        quint64 streamGeneration;
+    };
+
+    void submitLocked(Request request);
+    void runRequest(const Request &request);
+    void execute(const Request &request);
+
     std::unique_ptr<SearchStrategyFactory> m_strategyFactory;
-    std::unique_ptr<BaseSearchStrategy> m_strategy;
     std::atomic<bool> *m_engineCancelled { nullptr };
+    ResultStreamLimiter *m_streamLimiter { nullptr };
+
+    QMutex m_mutex;
+    QWaitCondition m_idle;
+    bool m_busy { false };   // 已提交的搜索尚未结束
+    QRunnable *m_queuedTask { nullptr };   // 已提交但尚未开始的任务
+    std::optional<Request> m_pending;   // 当前搜索结束后要执行的请求
 };
 
 /**
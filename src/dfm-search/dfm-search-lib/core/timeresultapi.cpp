@@ -4,6 +4,8 @@
 #include <dfm-search/timeresultapi.h>
 #include <dfm-search/searchresult.h>
 
+#include "searchresultdata.h"
+
 DFM_SEARCH_BEGIN_NS
 
 TimeResultAPI::TimeResultAPI(SearchResult &result)
@@ -13,12 +15,12 @@ TimeResultAPI::TimeResultAPI(SearchResult &result)
 
 void TimeResultAPI::setModifyTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("modifyTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::ModifyTimestamp, timestamp);
 }
 
 qint64 TimeResultAPI::modifyTimestamp() const
 {
-    return m_result.customAttribute("modifyTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::ModifyTimestamp);
 }
 
 QString TimeResultAPI::modifyTimeString() const
@@ -29,12 +31,12 @@ QString TimeResultAPI::modifyTimeString() const
 
 void TimeResultAPI::setBirthTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("birthTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::BirthTimestamp, timestamp);
 }
 
 qint64 TimeResultAPI::birthTimestamp() const
 {
-    return m_result.customAttribute("birthTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::BirthTimestamp);
 }
 
 QString TimeResultAPI::birthTimeString() const
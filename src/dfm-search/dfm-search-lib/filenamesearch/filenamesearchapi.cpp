@@ -6,6 +6,8 @@
 
 #include <QDateTime>
 
+#include "core/searchresultdata.h"
+
 DFM_SEARCH_BEGIN_NS
 
 FileNameOptionsAPI::FileNameOptionsAPI(SearchOptions &options)
@@ -62,86 +64,86 @@ FileNameResultAPI::FileNameResultAPI(SearchResult &result)
 
 QString FileNameResultAPI::size() const
 {
-    return m_result.customAttribute("size").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::Size);
 }
 
 void FileNameResultAPI::setSize(const QString &size)
 {
-    m_result.setCustomAttribute("size", size);
+    SearchResultData::get(m_result)->setString(ResultSlot::Size, size);
 }
 
 QString FileNameResultAPI::modifiedTime() const
 {
-    return m_result.customAttribute("modifiedTime").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::ModifiedTime);
 }
 
 void FileNameResultAPI::setModifiedTime(const QString &time)
 {
-    m_result.setCustomAttribute("modifiedTime", time);
+    SearchResultData::get(m_result)->setString(ResultSlot::ModifiedTime, time);
 }
 
 bool FileNameResultAPI::isDirectory() const
 {
-    return m_result.customAttribute("isDirectory").toBool();
+    return SearchResultData::get(std::as_const(m_result))->boolean(ResultSlot::IsDirectory);
 }
 
 void FileNameResultAPI::setIsDirectory(bool isDir)
 {
-    m_result.setCustomAttribute("isDirectory", isDir);
+    SearchResultData::get(m_result)->setBool(ResultSlot::IsDirectory, isDir);
 }
 
 QString FileNameResultAPI::fileType() const
 {
-    return m_result.customAttribute("fileType").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::FileType);
 }
 
 void FileNameResultAPI::setFileType(const QString &type) const
 {
-    m_result.setCustomAttribute("fileType", type);
+    SearchResultData::get(m_result)->setString(ResultSlot::FileType, type);
 }
 
 // ==================== Extended Attributes ====================
 
 QString FileNameResultAPI::filename() const
 {
-    return m_result.customAttribute("filename").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::Filename);
 }
 
 void FileNameResultAPI::setFilename(const QString &name)
 {
-    m_result.setCustomAttribute("filename", name);
+    SearchResultData::get(m_result)->setString(ResultSlot::Filename, name);
 }
 
 QString FileNameResultAPI::fileExtension() const
 {
-    return m_result.customAttribute("fileExtension").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::FileExtension);
 }
 
 void FileNameResultAPI::setFileExtension(const QString &ext)
 {
-    m_result.setCustomAttribute("fileExtension", ext);
+    SearchResultData::get(m_result)->setString(ResultSlot::FileExtension, ext);
 }
 
 bool FileNameResultAPI::isHidden() const
 {
-    return m_result.customAttribute("isHidden").toBool();
+    return SearchResultData::get(std::as_const(m_result))->boolean(ResultSlot::IsHidden);
 }
 
 void FileNameResultAPI::setIsHidden(bool hidden)
 {
-    m_result.setCustomAttribute("isHidden", hidden);
+    SearchResultData::get(m_result)->setBool(ResultSlot::IsHidden, hidden);
 }
 
 // ==================== Modification Time ====================
 
 void FileNameResultAPI::setModifyTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("modifyTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::ModifyTimestamp, timestamp);
 }
 
 qint64 FileNameResultAPI::modifyTimestamp() const
 {
-    return m_result.customAttribute("modifyTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::ModifyTimestamp);
 }
 
 QString FileNameResultAPI::modifyTimeString() const
@@ -154,12 +156,12 @@ QString FileNameResultAPI::modifyTimeString() const
 
 void FileNameResultAPI::setBirthTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("birthTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::BirthTimestamp, timestamp);
 }
 
 qint64 FileNameResultAPI::birthTimestamp() const
 {
-    return m_result.customAttribute("birthTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::BirthTimestamp);
 }
 
 QString FileNameResultAPI::birthTimeString() const
@@ -172,12 +174,12 @@ QString FileNameResultAPI::birthTimeString() const
 
 void FileNameResultAPI::setFileSizeBytes(qint64 bytes)
 {
-    m_result.setCustomAttribute("fileSizeBytes", bytes);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::FileSizeBytes, bytes);
 }
 
 qint64 FileNameResultAPI::fileSizeBytes() const
 {
-    return m_result.customAttribute("fileSizeBytes").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::FileSizeBytes);
 }
 
 DFM_SEARCH_END_NS
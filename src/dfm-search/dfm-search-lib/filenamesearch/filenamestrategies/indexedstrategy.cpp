@@ -10,13 +10,16 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QDebug>
-#include <QElapsedTimer>
 
 #include <dfm-search/field_names.h>
 #include <dfm-search/timerangefilter.h>
 #include <dfm-search/sizerangefilter.h>
 
+#include "core/searchstrategy/phasetimer.h"
 #include "utils/cancellablecollector.h"
+#include "utils/filenamefieldcollector.h"
+#include "utils/filenameresultcache.h"
+#include "utils/indexreaderpool.h"
 #include "utils/searchutility.h"
 #include "utils/lucenequeryutils.h"
 #include "utils/timerangeutils.h"
@@ -138,71 +141,6 @@ Lucene::QueryPtr QueryBuilder::buildWildcardQuery(const QString &keyword, bool c
                             StringUtils::toUnicode(processedKeyword.toStdString())));
 }
 
-//--------------------------------------------------------------------
-// IndexManager 实现
-//--------------------------------------------------------------------
-
-IndexManager::IndexManager()
-{
-}
-
-FSDirectoryPtr IndexManager::getIndexDirectory(const QString &indexPath) const
-{
-    if (m_cachedDirectory && m_cachedIndexPath == indexPath) {
-        return m_cachedDirectory;
-    }
-
-    m_cachedIndexPath = indexPath;
-    try {
-        m_cachedDirectory = FSDirectory::open(StringUtils::toUnicode(indexPath.toStdString()));
-        return m_cachedDirectory;
-    } catch (const LuceneException &e) {
-        qWarning() << "Failed to open index directory:" << QString::fromStdWString(e.getError());
-        return nullptr;
-    }
-}
-
-IndexReaderPtr IndexManager::getIndexReader(FSDirectoryPtr directory) const
-{
-    if (!directory) {
-        return nullptr;
-    }
-
-    if (m_cachedReader && m_cachedDirectory == directory) {
-        return m_cachedReader;
-    }
-
-    try {
-        if (IndexReader::indexExists(directory)) {
-            m_cachedReader = IndexReader::open(directory, true);
-            return m_cachedReader;
-        }
-    } catch (const LuceneException &e) {
-        qWarning() << "Failed to open index reader:" << QString::fromStdWString(e.getError());
-    }
-
-    return nullptr;
-}
-
-SearcherPtr IndexManager::getSearcher(IndexReaderPtr reader) const
-{
-    if (!reader) {
-        return nullptr;
-    }
-
-    if (m_cachedSearcher && m_cachedReader == reader) {
-        return m_cachedSearcher;
-    }
-
-    try {
-        m_cachedSearcher = newLucene<IndexSearcher>(reader);
-        return m_cachedSearcher;
-    } catch (const LuceneException &e) {
-        qWarning() << "Failed to create searcher:" << QString::fromStdWString(e.getError());
-        return nullptr;
-    }
-}
-
 //--------------------------------------------------------------------
 // FileNameIndexedStrategy 实现
 //--------------------------------------------------------------------
@@ -211,7 +149,6 @@ FileNameIndexedStrategy::FileNameIndexedStrategy(const SearchOptions &options, Q
     : FileNameBaseStrategy(options, parent)
 {
     m_queryBuilder = std::make_unique<QueryBuilder>();
-    m_indexManager = std::make_unique<IndexManager>();
     initializeIndexing();
 }
 
@@ -231,7 +168,7 @@ void FileNameIndexedStrategy::search(const SearchQuery &query)
 
     if (!QFileInfo::exists(m_indexDir)) {
         emit errorOccurred(SearchError(SearchErrorCode::InternalError));
-        emit searchFinished(m_results);
+        finishSearch();
         return;
     }
 
@@ -249,7 +186,8 @@ void FileNameIndexedStrategy::search(const SearchQuery &query)
         emit errorOccurred(SearchError(SearchErrorCode::InternalError));
     }
 
-    emit searchFinished(m_results);
+    flushResults();
+    finishSearch();
 }
 
 void FileNameIndexedStrategy::performIndexSearch(const SearchQuery &query, const FileNameOptionsAPI &api)
@@ -261,11 +199,14 @@ void FileNameIndexedStrategy::performIndexSearch(const SearchQuery &query, const
     bool pinyinEnabled = api.pinyinEnabled();
     bool pinyinAcronymEnabled = api.pinyinAcronymEnabled();
 
+    PhaseTimer queryBuildTimer(m_statistics, SearchStatistics::Phase::QueryBuild);
+
     // 1. 确定搜索类型
     SearchType searchType = determineSearchType(query, pinyinEnabled, pinyinAcronymEnabled, fileTypes, fileExtensions);
 
     // 2. 构建查询
     IndexQuery indexQuery = buildIndexQuery(query, searchType, caseSensitive, pinyinEnabled, pinyinAcronymEnabled, fileTypes, fileExtensions);
+    queryBuildTimer.stop();
 
     // 3. 执行查询并处理结果
     executeIndexQuery(indexQuery);
@@ -385,38 +326,42 @@ FileNameIndexedStrategy::IndexQuery FileNameIndexedStrategy::buildIndexQuery(
 
 void FileNameIndexedStrategy::executeIndexQuery(const IndexQuery &query)
 {
-    // 获取索引目录
-    FSDirectoryPtr directory = m_indexManager->getIndexDirectory(m_indexDir);
-    if (!directory) {
-        emit errorOccurred(SearchError(SearchErrorCode::InternalError));
-        return;
-    }
-
-    if (!IndexReader::indexExists(directory)) {
+    // 从进程级读取器池借用读取器，索引未变化时无需重新打开
+    PhaseTimer indexOpenTimer(m_statistics, SearchStatistics::Phase::IndexOpen);
+    const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(m_indexDir);
+    indexOpenTimer.stop();
+    if (!lease) {
         qWarning() << "Index does not exist:" << m_indexDir;
         emit errorOccurred(SearchError(FileNameSearchErrorCode::FileNameIndexNotFound));
         return;
     }
 
-    // 获取索引读取器
-    IndexReaderPtr reader = m_indexManager->getIndexReader(directory);
-    if (!reader || reader->numDocs() == 0) {
+    const IndexReaderPtr &reader = lease.reader();
+    if (reader->numDocs() == 0) {
         qWarning() << "Index is empty";
         emit errorOccurred(SearchError(SearchErrorCode::InternalError));
         return;
     }
 
-    // 获取搜索器
-    SearcherPtr searcher = m_indexManager->getSearcher(reader);
-    if (!searcher) {
-        emit errorOccurred(SearchError(SearchErrorCode::InternalError));
+    // 相同的查询，或在已缓存结果上追加字符的简单查询，直接由缓存给出结果
+    FileNameResultCache::Key cacheKey;
+    const bool cacheable = buildCacheKey(query, reader->getVersion(), &cacheKey);
+    SearchResultList cachedResults;
+    if (cacheable && FileNameResultCache::instance()->lookup(cacheKey, m_options.maxResults(), &cachedResults)) {
+        m_statistics.addCounter(SearchStatistics::Counter::CacheHits);
+        m_statistics.addCounter(SearchStatistics::Counter::Hits, cachedResults.size());
+        addResults(cachedResults);
         return;
     }
 
+    SearcherPtr searcher = lease.searcher();
+
     // 构建查询
     QueryPtr luceneQuery;
     try {
+        PhaseTimer queryBuildTimer(m_statistics, SearchStatistics::Phase::QueryBuild);
         luceneQuery = buildLuceneQuery(query);
+        queryBuildTimer.stop();
         if (!luceneQuery) {
             emit errorOccurred(SearchError(SearchErrorCode::InvalidQuery));
             return;
@@ -426,77 +371,68 @@ void FileNameIndexedStrategy::executeIndexQuery(const IndexQuery &query)
         emit errorOccurred(SearchError(SearchErrorCode::InvalidQuery));
         return;
     }
-    // Measure the time taken to execute the search
-    QElapsedTimer searchTimer;
-    searchTimer.start();
-
     // 执行搜索
     int32_t maxResults = m_options.maxResults() > 0 ? m_options.maxResults() : reader->numDocs();
 
-    // 使用自定义 CancellableCollector 实现可中断搜索
-    Collection<ScoreDocPtr> scoreDocs;
+    // 命中时直接从字段缓存取列值，不加载 Document
+    const bool detailedResults = m_options.detailedResultsEnabled();
+    // 指定排序时遍历全部命中，只保留排序最靠前的 maxResults 个
+    boost::shared_ptr<FileNameFieldCollector> collector =
+            newLucene<FileNameFieldCollector>(m_cancelledRef, maxResults, detailedResults,
+                                              m_options.resultSortKey(), m_options.resultSortOrder());
+    PhaseTimer collectTimer(m_statistics, SearchStatistics::Phase::Collect);
     try {
-        // 创建可取消的收集器
-        boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(m_cancelledRef, maxResults);
-
-        // 执行搜索，使用自定义收集器
+        // 执行搜索，收满 maxResults 后提前结束
         searcher->search(luceneQuery, collector);
-
-        // 获取收集到的文档
-        scoreDocs = collector->getScoreDocs();
-
-        qInfo() << "Filename search execution time:" << searchTimer.elapsed() << "ms"
-                << "Total hits:" << collector->getTotalHits()
-                << "Collected:" << scoreDocs.size();
+    } catch (const CollectionFullException &) {
     } catch (const SearchCancelledException &e) {
         qInfo() << "Filename search cancelled during execution";
         return;
     }
+    collector->finish();
+    collectTimer.stop();
+
+    const int32_t hitCount = collector->hitCount();
+    m_statistics.addCounter(SearchStatistics::Counter::Hits, collector->getTotalHits());
 
-    // Measure the time taken to process search results
-    QElapsedTimer resultTimer;
-    resultTimer.start();
-    auto docsSize = scoreDocs.size();
-    m_results.reserve(docsSize);
+    // 结果直接取自字段缓存，不加载文档，此阶段只计生成结果的耗时
+    PhaseTimer loadTimer(m_statistics, SearchStatistics::Phase::DocumentLoad);
+    if (!isStreaming())
+        m_results.reserve(hitCount);
 
     // 实时处理搜索结果
-    for (int i = 0; i < docsSize; i++) {
+    for (int32_t i = 0; i < hitCount; i++) {
         if (m_cancelledRef && m_cancelledRef->load()) {
             qInfo() << "Filename search cancelled";
             break;
         }
 
-        try {
-            ScoreDocPtr scoreDoc = scoreDocs[i];
-            DocumentPtr doc = searcher->doc(scoreDoc->doc);
-            QString path = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFullPath));
+        QString path = QString::fromStdWString(collector->path(i));
 
-            // Path filtering, excluded paths, hidden file — handled at query layer
+        // Path filtering, excluded paths, hidden file — handled at query layer
 
-            // 处理搜索结果
-            if (Q_UNLIKELY(m_options.detailedResultsEnabled())) {
-                m_results.append(processDetailedSearchResult(path, doc));
-            } else {
-                SearchResult result(path);
-                m_results.append(std::move(result));
-            }
+        // 处理搜索结果
+        SearchResult result = Q_UNLIKELY(detailedResults)
+                ? processDetailedSearchResult(path, *collector, i)
+                : SearchResult(path);
+        if (!addResult(std::move(result)))
+            break;
+    }
 
-            // 实时发送结果
-            if (Q_UNLIKELY(m_options.resultFoundEnabled()))
-                emit resultFound(m_results.last());
+    loadTimer.stop();
 
-        } catch (const LuceneException &e) {
-            qWarning() << "Error processing result:" << QString::fromStdWString(e.getError());
-            continue;
-        }
+    // 流式模式下结果不保留，无法缓存；被取消的搜索结果不完整
+    const bool cancelled = m_cancelledRef && m_cancelledRef->load();
+    if (cacheable && !isStreaming() && !cancelled && m_results.size() == hitCount) {
+        const bool complete = m_options.maxResults() <= 0 || hitCount < maxResults;
+        FileNameResultCache::instance()->insert(cacheKey, m_results, complete);
     }
-
-    qInfo() << "Filename result processing time:" << resultTimer.elapsed() << "ms";
 }
 
 SearchResult FileNameIndexedStrategy::processDetailedSearchResult(
         const QString &path,
-        const Lucene::DocumentPtr &doc)
+        const FileNameFieldCollector &collector,
+        int32_t hit)
 {
     // 创建搜索结果
     SearchResult result(path);
@@ -504,53 +440,37 @@ SearchResult FileNameIndexedStrategy::processDetailedSearchResult(
     FileNameResultAPI api(result);
 
     // 文件类型
-    QString type = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFileType));
+    QString type = QString::fromStdWString(collector.fileType(hit));
     api.setFileType(type);
     api.setIsDirectory(type == "dir");
 
-    // 文件名和扩展名
-    QString fileName = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFileName));
-    api.setFilename(fileName);
+    // 文件名取自路径末段，file_name 字段经过分词无法放入字段缓存
+    api.setFilename(path.mid(path.lastIndexOf('/') + 1));
 
-    QString fileExt = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFileExt));
-    api.setFileExtension(fileExt);
+    api.setFileExtension(QString::fromStdWString(collector.fileExt(hit)));
 
     // 文件大小
-    QString size = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFileSizeStr));
-    api.setSize(size);
+    api.setSize(QString::fromStdWString(collector.fileSizeStr(hit)));
 
     // 文件大小（数值，字节）
-    QString fileSizeStr = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kFileSize));
-    if (!fileSizeStr.isEmpty()) {
-        bool ok = false;
-        qint64 fileSizeBytes = fileSizeStr.toLongLong(&ok);
-        if (ok && fileSizeBytes >= 0) {
-            api.setFileSizeBytes(fileSizeBytes);
-        }
+    const qint64 fileSizeBytes = collector.fileSize(hit);
+    if (fileSizeBytes >= 0) {
+        api.setFileSizeBytes(fileSizeBytes);
     }
 
     // 隐藏状态
-    QString isHiddenStr = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kIsHidden)).toLower();
-    api.setIsHidden(isHiddenStr == "y");
+    api.setIsHidden(collector.isHidden(hit));
 
     // 修改时间
-    QString modifyTimeStr = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kModifyTime));
-    if (!modifyTimeStr.isEmpty()) {
-        bool ok = false;
-        qint64 modifyTimestamp = modifyTimeStr.toLongLong(&ok);
-        if (ok && modifyTimestamp > 0) {
-            api.setModifyTimestamp(modifyTimestamp);
-        }
+    const qint64 modifyTimestamp = collector.modifyTime(hit);
+    if (modifyTimestamp > 0) {
+        api.setModifyTimestamp(modifyTimestamp);
     }
 
     // 创建时间
-    QString birthTimeStr = QString::fromStdWString(doc->get(LuceneFieldNames::FileName::kBirthTime));
-    if (!birthTimeStr.isEmpty()) {
-        bool ok = false;
-        qint64 birthTimestamp = birthTimeStr.toLongLong(&ok);
-        if (ok && birthTimestamp > 0) {
-            api.setBirthTimestamp(birthTimestamp);
-        }
+    const qint64 birthTimestamp = collector.birthTime(hit);
+    if (birthTimestamp > 0) {
+        api.setBirthTimestamp(birthTimestamp);
     }
 
     return result;
@@ -793,6 +713,52 @@ BooleanQueryPtr FileNameIndexedStrategy::buildBooleanTermsQuery(const IndexQuery
     return hasValidQuery ? booleanQuery : nullptr;
 }
 
+bool FileNameIndexedStrategy::buildCacheKey(const IndexQuery &query, qint64 generation,
+                                            FileNameResultCache::Key *key) const
+{
+    // 相对时间范围随当前时间变化，同样的选项在不同时刻结果不同
+    if (m_options.hasTimeRangeFilter())
+        return false;
+
+    const QChar sep(0x1f);
+    QStringList fileTypes = query.fileTypes;
+    QStringList fileExtensions = query.fileExtensions;
+    fileTypes.sort();
+    fileExtensions.sort();
+
+    QStringList scope {
+        m_indexDir,
+        QString::number(static_cast<int>(query.type)),
+        QString::number(static_cast<int>(query.booleanOp)),
+        QString::number(query.usePinyin) + QString::number(query.usePinyinAcronym),
+        fileTypes.join(sep),
+        fileExtensions.join(sep),
+        m_options.searchPaths().join(sep),
+        m_options.searchExcludedPaths().join(sep),
+        QString::number(m_options.includeHidden()) + QString::number(m_options.hiddenOnly()),
+        QString::number(m_options.detailedResultsEnabled()),
+        QString::number(static_cast<int>(m_options.resultSortKey())) + QString::number(m_options.resultSortOrder())
+    };
+
+    if (m_options.hasSizeRangeFilter()) {
+        const SizeRangeFilter filter = m_options.sizeRangeFilter();
+        scope << QString::number(filter.minSize()) << QString::number(filter.maxSize())
+              << QString::number(filter.includeLower()) + QString::number(filter.includeUpper());
+    }
+
+    key->scope = scope.join(QChar(0x1e));
+    key->keyword = query.terms.join(sep);
+    if (!query.caseSensitive)
+        key->keyword = key->keyword.toLower();
+    key->generation = generation;
+    key->caseSensitive = query.caseSensitive;
+    // 只有不区分大小写的纯关键词包含匹配满足"长关键词命中是短关键词命中的子集"，
+    // 且关键词需能保证内存中按文件名过滤与 n-gram 查询的结果一致
+    key->refinable = query.type == SearchType::Simple && query.terms.size() == 1 && !query.caseSensitive
+            && FileNameResultCache::isRefinableKeyword(query.terms.first());
+    return true;
+}
+
 void FileNameIndexedStrategy::cancel()
 {
     if (m_cancelledRef)
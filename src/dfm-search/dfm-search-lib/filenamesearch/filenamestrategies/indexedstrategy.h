@@ -12,13 +12,14 @@
 
 #include <dfm-search/searchquery.h>
 
+#include "utils/filenameresultcache.h"
+
 using namespace Lucene;
 
 DFM_SEARCH_BEGIN_NS
 
 class QueryBuilder;
-class SearchCache;
-class IndexManager;
+class FileNameFieldCollector;
 /**
  * @brief 文件名索引搜索策略
  * 使用 Lucene 实现高性能文件搜索
@@ -91,15 +92,17 @@ private:
     // 构建布尔查询的辅助方法
     BooleanQueryPtr buildBooleanTermsQuery(const IndexQuery &query) const;
 
-    // 处理详细搜索结果（读取所有索引字段）
-    SearchResult processDetailedSearchResult(const QString &path, const Lucene::DocumentPtr &doc);
+    // 构建结果缓存键，查询不适合缓存时返回 false
+    bool buildCacheKey(const IndexQuery &query, qint64 generation, FileNameResultCache::Key *key) const;
+
+    // 处理详细搜索结果（从字段缓存读取各列）
+    SearchResult processDetailedSearchResult(const QString &path, const FileNameFieldCollector &collector, int32_t hit);
 
     // 成员变量
     QString m_indexDir;   // 索引目录路径
 
     // Lucene 相关组件
     std::unique_ptr<QueryBuilder> m_queryBuilder;   // 查询构建器
-    std::unique_ptr<IndexManager> m_indexManager;   // 索引管理器
 };
 
 /**
@@ -120,29 +123,6 @@ public:
     QueryPtr buildSimpleQuery(const QString &keyword, bool caseSensitive) const;
 };
 
-/**
- * @brief 索引管理器类
- * 管理 Lucene 索引目录和读取器
- */
-class IndexManager
-{
-public:
-    IndexManager();
-
-    // 获取索引目录
-    FSDirectoryPtr getIndexDirectory(const QString &indexPath) const;
-    // 获取索引读取器
-    IndexReaderPtr getIndexReader(FSDirectoryPtr directory) const;
-    // 获取搜索器
-    SearcherPtr getSearcher(IndexReaderPtr reader) const;
-
-private:
-    mutable FSDirectoryPtr m_cachedDirectory;
-    mutable IndexReaderPtr m_cachedReader;
-    mutable SearcherPtr m_cachedSearcher;
-    mutable QString m_cachedIndexPath;
-};
-
 DFM_SEARCH_END_NS
 
 #endif   // FILENAME_INDEXED_STRATEGY_H
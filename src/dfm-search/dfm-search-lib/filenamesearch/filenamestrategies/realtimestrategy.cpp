@@ -3,16 +3,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "realtimestrategy.h"
 
-#include <QDirIterator>
-#include <QDateTime>
 #include <QFileInfo>
-#include <QStack>
-#include <QElapsedTimer>
 #include <QDebug>
-#include <QRegularExpression>
 
-#include <dfm-search/timerangefilter.h>
-#include <dfm-search/sizerangefilter.h>
+#include "core/searchstrategy/phasetimer.h"
+#include "utils/filenamematcher.h"
+#include "utils/paralleldirwalker.h"
 
 DFM_SEARCH_BEGIN_NS
 
@@ -30,218 +26,120 @@ void FileNameRealTimeStrategy::search(const SearchQuery &query)
     // 从搜索选项获取参数
     const QString searchPath = m_options.searchPath();
     const QStringList excludedPaths = m_options.searchExcludedPaths();
-    const bool caseSensitive = m_options.caseSensitive();
     const bool includeHidden = m_options.includeHidden();
     const int maxResults = m_options.maxResults() > 0 ? m_options.maxResults() : INT_MAX;
-
-    // 获取文件类型过滤
-    FileNameOptionsAPI optionsApi(const_cast<SearchOptions &>(m_options));
-    const QStringList fileExts = optionsApi.fileExtensions();
     const bool detailedResults = m_options.detailedResultsEnabled();
-    const bool resultFoundEnabled = m_options.resultFoundEnabled();
 
     // 检查搜索路径
     QFileInfo pathInfo(searchPath);
     if (!pathInfo.exists() || !pathInfo.isDir()) {
         emit errorOccurred(SearchError(SearchErrorCode::PathNotFound));
-        emit searchFinished(m_results);
+        finishSearch();
         return;
     }
 
-    // 性能计时
-    QElapsedTimer searchTimer;
-    searchTimer.start();
-
-    // 设置基础过滤器
-    QDir::Filters dirFilters = QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot;
-    if (includeHidden) {
-        dirFilters |= QDir::Hidden;
-    }
-
-    // 使用非递归的方式进行遍历
-    QStack<QString> directoryStack;
-    directoryStack.push(searchPath);
-
-    int count = 0;
-    QSet<QString> visitedDirs;   // 防止符号链接循环
-
-    while (!directoryStack.isEmpty() && count < maxResults && !(m_cancelledRef && m_cancelledRef->load())) {
-        // 取出一个目录进行处理
-        QString currentDir = directoryStack.pop();
-
-        // 避免符号链接循环
-        QString canonicalPath = QFileInfo(currentDir).canonicalFilePath();
-        if (visitedDirs.contains(canonicalPath)) {
-            continue;
-        }
-        visitedDirs.insert(canonicalPath);
-
-        // 检查是否在排除路径中
-        if (std::any_of(excludedPaths.cbegin(), excludedPaths.cend(),
-                        [&currentDir](const QString &excludedPath) {
-                            return currentDir.startsWith(excludedPath);
-                        })) {
-            continue;
-        }
-
-        // 获取当前目录的内容
-        QDir dir(currentDir);
-        QFileInfoList entries;
-        try {
-            entries = dir.entryInfoList(dirFilters, QDir::Name);
-        } catch (const std::exception &e) {
-            qWarning() << "Permission Denied: " << dir.absolutePath();
-            continue;
-        }
-
-        // 如果无法读取目录，可能是因为权限问题
-        if (entries.isEmpty() && !dir.exists()) {
-            qWarning() << "Permission Denied: " << dir.absolutePath();
-            continue;
+    // 查询只编译一次，所有遍历线程共享同一个只读匹配器
+    PhaseTimer queryBuildTimer(m_statistics, SearchStatistics::Phase::QueryBuild);
+    const FileNameMatcher matcher(query, m_options);
+    queryBuildTimer.stop();
+
+    // 多个工作线程并行遍历目录，匹配结果按批次回到当前线程
+    ParallelDirWalker walker(m_options.maxThreadCount(), m_cancelledRef);
+    walker.setExcludedPaths(excludedPaths);
+    walker.setIncludeHidden(includeHidden);
+
+    std::atomic<int> reserved { 0 };
+    auto visitor = [&](const DirEntry &entry, SearchResultList &batch) {
+        if (!matchEntry(entry, matcher))
+            return;
+
+        // 先占用名额再生成结果，保证并发下结果数不超过 maxResults
+        if (reserved.fetch_add(1) >= maxResults) {
+            walker.stop();
+            return;
         }
+        batch.append(buildResult(entry, detailedResults));
+    };
+
+    // 遍历与匹配交织在多个线程中进行，整体计入收集阶段
+    PhaseTimer collectTimer(m_statistics, SearchStatistics::Phase::Collect);
+    walker.walk(searchPath, visitor, [&](const SearchResultList &batch) {
+        // 添加到结果集合并按需实时发送，流式模式下按块推送
+        if (!addResults(batch))
+            walker.stop();
+    });
+    flushResults();
+    collectTimer.stop();
+
+    // 达到上限后其他线程仍可能占用名额失败，这些匹配没有生成结果
+    m_statistics.addCounter(SearchStatistics::Counter::Hits, qMin(reserved.load(), maxResults));
+    m_statistics.addCounter(SearchStatistics::Counter::DirectoriesVisited, walker.visitedDirectories());
+    m_statistics.addCounter(SearchStatistics::Counter::StatCalls, walker.statCalls());
+    finishSearch();
+}
 
-        // 处理当前目录中的每个条目
-        for (const QFileInfo &info : std::as_const(entries)) {
-            if ((m_cancelledRef && m_cancelledRef->load()) || count >= maxResults) {
-                break;
-            }
-
-            // 将子目录添加到栈中以便后续处理
-            // 符号链接目录不递归进入（防止循环），但其名称仍参与匹配
-            if (info.isDir() && !info.isSymLink()) {
-                directoryStack.push(info.filePath());
-            }
-
-            // 检查文件名是否匹配查询
-            QString fileName = info.fileName();
-            bool matches = false;
-
-            // 如果只有过滤条件（时间/大小）没有关键词，直接匹配
-            bool hasKeyword = !query.keyword().isEmpty() || query.type() == SearchQuery::Type::Boolean;
-            if (!hasKeyword && (m_options.hasTimeRangeFilter() || m_options.hasSizeRangeFilter())) {
-                matches = true;
-            }
-            // 简单查询模式
-            else if (query.type() == SearchQuery::Type::Simple) {
-                matches = fileName.contains(query.keyword(),
-                                            caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
-            }
-            // 通配符查询模式
-            else if (query.type() == SearchQuery::Type::Wildcard) {
-                matches = matchWildcard(fileName, query.keyword(), caseSensitive);
-            }
-            // 布尔查询模式
-            else if (query.type() == SearchQuery::Type::Boolean) {
-                matches = matchBoolean(fileName, query, caseSensitive, false);
-            }
-
-            // 如果文件 suffix 过滤器不为空，检查文件 suffix 是否匹配
-            if (matches && !fileExts.isEmpty()) {
-                const QString &suffix = info.suffix().toLower();
-                if (!fileExts.contains(suffix)) {
-                    matches = false;
-                }
-            }
-
-            // 时间范围过滤
-            if (matches && m_options.hasTimeRangeFilter()) {
-                TimeRangeFilter filter = m_options.timeRangeFilter();
-                auto [start, end] = filter.resolveTimeRange();
-
-                QDateTime fileTime = (filter.timeField() == TimeField::BirthTime)
-                        ? info.birthTime()
-                        : info.lastModified();
-
-                // 时间范围检查
-                bool timeMatch = true;
-                if (start.isValid()) {
-                    if (filter.includeLower()) {
-                        timeMatch = timeMatch && (fileTime >= start);
-                    } else {
-                        timeMatch = timeMatch && (fileTime > start);
-                    }
-                }
-                if (end.isValid()) {
-                    if (filter.includeUpper()) {
-                        timeMatch = timeMatch && (fileTime <= end);
-                    } else {
-                        timeMatch = timeMatch && (fileTime < end);
-                    }
-                }
-                matches = timeMatch;
-            }
-
-            // 文件大小范围过滤
-            if (matches && m_options.hasSizeRangeFilter()) {
-                SizeRangeFilter sizeFilter = m_options.sizeRangeFilter();
-                qint64 fileSize = info.size();
-
-                bool sizeMatch = true;
-                if (sizeFilter.minSize() > 0) {
-                    if (sizeFilter.includeLower()) {
-                        sizeMatch = sizeMatch && (fileSize >= sizeFilter.minSize());
-                    } else {
-                        sizeMatch = sizeMatch && (fileSize > sizeFilter.minSize());
-                    }
-                }
-                if (sizeFilter.maxSize() > 0) {
-                    if (sizeFilter.includeUpper()) {
-                        sizeMatch = sizeMatch && (fileSize <= sizeFilter.maxSize());
-                    } else {
-                        sizeMatch = sizeMatch && (fileSize < sizeFilter.maxSize());
-                    }
-                }
-                matches = sizeMatch;
-            }
+bool FileNameRealTimeStrategy::matchEntry(const DirEntry &entry, const FileNameMatcher &matcher) const
+{
+    // 检查文件名是否匹配查询：只用 dirent 中的名称，不触发 stat
+    if (!matcher.matchName(entry.fileName()))
+        return false;
 
-            if (matches && m_options.hiddenOnly() && !info.isHidden()) {
-                matches = false;
-            }
+    // 如果文件 suffix 过滤器不为空，检查文件 suffix 是否匹配
+    if (matcher.hasSuffixFilter() && !matcher.matchSuffix(entry.suffix()))
+        return false;
 
-            if (matches) {
-                // 创建搜索结果
-                SearchResult result(info.filePath());
+    // 以下过滤条件需要元数据，此时才会对条目执行 statx
+    // 时间范围过滤
+    if (matcher.hasTimeFilter()) {
+        const qint64 fileTimeMs = matcher.useBirthTime() ? entry.birthTimeMSecs() : entry.lastModifiedMSecs();
+        if (!matcher.matchTime(fileTimeMs))
+            return false;
+    }
 
-                if (detailedResults) {
-                    FileNameResultAPI api(result);
-                    api.setIsDirectory(info.isDir());
+    // 文件大小范围过滤
+    if (matcher.hasSizeFilter() && !matcher.matchSize(entry.size()))
+        return false;
 
-                    if (!info.isDir()) {
-                        api.setFileType(info.suffix().isEmpty() ? "unknown" : info.suffix().toLower());
-                        api.setFileExtension(info.suffix().toLower());
-                        api.setSize(QString::number(info.size()));
-                        api.setFileSizeBytes(info.size());
-                    } else {
-                        api.setFileType("dir");
-                    }
+    if (matcher.hiddenOnly() && !entry.isHidden())
+        return false;
 
-                    api.setFilename(info.fileName());
-                    api.setIsHidden(info.isHidden());
+    return true;
+}
 
-                    // 设置修改时间戳
-                    api.setModifyTimestamp(info.lastModified().toSecsSinceEpoch());
+SearchResult FileNameRealTimeStrategy::buildResult(const DirEntry &entry, bool detailedResults) const
+{
+    // 创建搜索结果
+    SearchResult result(entry.filePath());
+
+    if (detailedResults) {
+        FileNameResultAPI api(result);
+        const bool isDir = entry.isDir();
+        api.setIsDirectory(isDir);
+
+        if (!isDir) {
+            const QString suffix = entry.suffix().toLower();
+            api.setFileType(suffix.isEmpty() ? "unknown" : suffix);
+            api.setFileExtension(suffix);
+            api.setSize(QString::number(entry.size()));
+            api.setFileSizeBytes(entry.size());
+        } else {
+            api.setFileType("dir");
+        }
 
-                    // 设置创建时间戳
-                    QDateTime birthTime = info.birthTime();
-                    if (birthTime.isValid()) {
-                        api.setBirthTimestamp(birthTime.toSecsSinceEpoch());
-                    }
-                }
+        api.setFilename(entry.fileName());
+        api.setIsHidden(entry.isHidden());
 
-                // 实时发送结果
-                if (resultFoundEnabled) {
-                    emit resultFound(result);
-                }
+        // 设置修改时间戳
+        api.setModifyTimestamp(entry.lastModifiedMSecs() / 1000);
 
-                // 添加到结果集合
-                m_results.append(result);
-                count++;
-            }
+        // 设置创建时间戳
+        const qint64 birthTimeMs = entry.birthTimeMSecs();
+        if (birthTimeMs >= 0) {
+            api.setBirthTimestamp(birthTimeMs / 1000);
         }
     }
 
-    qInfo() << "Real-time filename search completed in" << searchTimer.elapsed() << "ms with" << count << "results";
-    emit searchFinished(m_results);
+    return result;
 }
 
 bool FileNameRealTimeStrategy::matchPinyin(const QString &fileName, const QString &keyword)
@@ -252,65 +150,6 @@ bool FileNameRealTimeStrategy::matchPinyin(const QString &fileName, const QStrin
     return false;
 }
 
-bool FileNameRealTimeStrategy::matchBoolean(const QString &fileName, const SearchQuery &query,
-                                            bool caseSensitive, bool pinyinEnabled)
-{
-    Q_UNUSED(pinyinEnabled);   // 实时搜索不支持拼音匹配
-
-    // 获取布尔操作符类型
-    auto op = query.booleanOperator();
-
-    // 获取子查询列表
-    const auto &subQueries = query.subQueries();
-
-    // 如果没有子查询，使用简单匹配
-    if (subQueries.isEmpty()) {
-        return fileName.contains(query.keyword(),
-                                 caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
-    }
-
-    // 根据布尔操作符处理
-    switch (op) {
-    case SearchQuery::BooleanOperator::AND: {
-        // 所有子查询都必须匹配
-        for (const auto &subQuery : subQueries) {
-            bool subMatch = matchBoolean(fileName, subQuery, caseSensitive, false);
-            if (!subMatch) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    case SearchQuery::BooleanOperator::OR: {
-        // 任一子查询匹配即可
-        for (const auto &subQuery : subQueries) {
-            bool subMatch = matchBoolean(fileName, subQuery, caseSensitive, false);
-            if (subMatch) {
-                return true;
-            }
-        }
-        return false;
-    }
-    }
-
-    return false;
-}
-
-bool FileNameRealTimeStrategy::matchWildcard(const QString &fileName, const QString &pattern, bool caseSensitive)
-{
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    // 利用Qt内置的通配符匹配功能
-    QRegularExpression regex = QRegularExpression::fromWildcard(
-            pattern,
-            caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
-    return regex.match(fileName).hasMatch();
-#else
-    QRegExp regex = QRegExp(pattern, caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive, QRegExp::Wildcard);
-    return regex.exactMatch(fileName);
-#endif
-}
-
 void FileNameRealTimeStrategy::cancel()
 {
     if (m_cancelledRef)
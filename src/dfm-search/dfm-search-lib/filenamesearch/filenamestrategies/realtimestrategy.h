@@ -8,6 +8,9 @@
 
 DFM_SEARCH_BEGIN_NS
 
+class DirEntry;
+class FileNameMatcher;
+
 /**
  * @brief 文件名实时搜索策略
  */
@@ -23,15 +26,15 @@ public:
     void cancel() override;
 
 private:
-    // 拼音匹配
-    bool matchPinyin(const QString &fileName, const QString &keyword);
+    // 单个条目的关键词与过滤条件匹配，会在多个遍历线程中并发调用
+    // 先按名称匹配，只有时间/大小过滤才会读取元数据
+    bool matchEntry(const DirEntry &entry, const FileNameMatcher &matcher) const;
 
-    // 布尔查询匹配
-    bool matchBoolean(const QString &fileName, const SearchQuery &query,
-                      bool caseSensitive, bool pinyinEnabled);
+    // 构建搜索结果，仅详细结果需要元数据
+    SearchResult buildResult(const DirEntry &entry, bool detailedResults) const;
 
-    // 通配符匹配
-    bool matchWildcard(const QString &fileName, const QString &pattern, bool caseSensitive);
+    // 拼音匹配
+    bool matchPinyin(const QString &fileName, const QString &keyword);
 };
 
 DFM_SEARCH_END_NS
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include <dfm-search/ocrtextsearchapi.h>
 
+#include "core/searchresultdata.h"
+
 DFM_SEARCH_BEGIN_NS
 
 OcrTextOptionsAPI::OcrTextOptionsAPI(SearchOptions &options)
@@ -36,22 +38,22 @@ OcrTextResultAPI::OcrTextResultAPI(SearchResult &result)
 
 QString OcrTextResultAPI::ocrContent() const
 {
-    return m_result.customAttribute("ocrContent").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::OcrContent);
 }
 
 void OcrTextResultAPI::setOcrContent(const QString &content)
 {
-    m_result.setCustomAttribute("ocrContent", content);
+    SearchResultData::get(m_result)->setString(ResultSlot::OcrContent, content);
 }
 
 QString OcrTextResultAPI::checksum() const
 {
-    return m_result.customAttribute("checksum").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::Checksum);
 }
 
 void OcrTextResultAPI::setChecksum(const QString &checksum)
 {
-    m_result.setCustomAttribute("checksum", checksum);
+    SearchResultData::get(m_result)->setString(ResultSlot::Checksum, checksum);
 }
 
 DFM_SEARCH_END_NS
@@ -17,10 +17,14 @@
 #include <dfm-search/timerangefilter.h>
 #include <dfm-search/ocrtextsearchapi.h>
 
+#include "core/searchresultdata.h"
+#include "core/searchstrategy/phasetimer.h"
 #include "utils/cancellablecollector.h"
 #include "utils/contenthighlighter.h"
+#include "utils/indexreaderpool.h"
 #include "utils/lucenequeryutils.h"
 #include "utils/lucene_cancellation_compat.h"
+#include "utils/parallelsegmentsearch.h"
 #include "utils/timerangeutils.h"
 
 using namespace Lucene;
@@ -331,16 +335,16 @@ QueryPtr OcrTextIndexedStrategy::buildSimpleOcrContentsQuery(const SearchQuery &
 void OcrTextIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr &searcher,
                                                   const Lucene::Collection<Lucene::ScoreDocPtr> &scoreDocs)
 {
-    // Measure the time taken to process search results
-    QElapsedTimer resultTimer;
-    resultTimer.start();
-
     auto docsSize = scoreDocs.size();
 
     OcrTextOptionsAPI optAPI(m_options);
     bool enableHTML = optAPI.isSearchResultHighlightEnabled();
     int previewLen = optAPI.maxPreviewLength() > 0 ? optAPI.maxPreviewLength() : 50;
     bool enableRetrieval = optAPI.isFullTextRetrievalEnabled();
+    // 延迟高亮时不读取存储的全文，由调用方按需通过 ContentRetriever 获取
+    const bool deferHighlight = enableRetrieval && optAPI.isDeferredHighlightEnabled();
+    if (deferHighlight)
+        enableRetrieval = false;
     bool detailedResults = m_options.detailedResultsEnabled();
 
     // Build field selector to avoid loading the large 'ocr_contents' field when not needed.
@@ -362,19 +366,22 @@ void OcrTextIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
     Lucene::FieldSelectorPtr fieldSelector = newLucene<Lucene::MapFieldSelector>(fieldsToLoad);
 
     // Pre-allocate to avoid reallocation during append
-    m_results.reserve(m_results.size() + static_cast<int>(docsSize));
+    if (!isStreaming())
+        m_results.reserve(m_results.size() + static_cast<int>(docsSize));
 
-    for (int32_t i = 0; i < docsSize; ++i) {
-        if (m_cancelledRef && m_cancelledRef->load()) {
-            qInfo() << "OCR text search cancelled";
-            break;
-        }
+    // Results may be built on several threads: accumulate atomically, record once at the end
+    std::atomic<qint64> buildNs { 0 };
+    std::atomic<qint64> highlightNs { 0 };
+    std::atomic<qint64> documentsLoaded { 0 };
+    std::atomic<qint64> storedBytes { 0 };
 
+    // Load a document and build its result; called from several threads when processing in parallel
+    const auto buildResult = [&](int32_t i) -> std::optional<SearchResult> {
         try {
             Lucene::ScoreDocPtr scoreDoc = scoreDocs[i];
             if (!scoreDoc || scoreDoc->doc < 0) {
                 qWarning() << "Invalid ScoreDoc at index" << i;
-                continue;
+                return std::nullopt;
             }
 
             Lucene::DocumentPtr doc;
@@ -382,35 +389,42 @@ void OcrTextIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
                 doc = searcher->doc(scoreDoc->doc, fieldSelector);
                 if (!doc) {
                     qWarning() << "Failed to retrieve document at index:" << scoreDoc->doc;
-                    continue;
+                    return std::nullopt;
                 }
             } catch (const Lucene::LuceneException &e) {
                 qWarning() << "Exception while retrieving document:" << QString::fromStdWString(e.getError());
-                continue;
+                return std::nullopt;
             } catch (const std::exception &e) {
                 qWarning() << "Standard exception while retrieving document:" << e.what();
-                continue;
+                return std::nullopt;
             }
+            documentsLoaded.fetch_add(1, std::memory_order_relaxed);
+            storedBytes.fetch_add(LuceneQueryUtils::storedFieldsSize(doc), std::memory_order_relaxed);
 
             // Path filtering, excluded paths, hidden file — handled at query layer
             Lucene::String pathField = doc->get(LuceneFieldNames::OcrText::kPath);
             if (pathField.empty()) {
                 qWarning() << "Document missing path field at index:" << scoreDoc->doc;
-                continue;
+                return std::nullopt;
             }
 
             SearchResult result(QString::fromStdWString(pathField));
 
             // 设置 OCR 内容结果
             OcrTextResultAPI resultApi(result);
-            result.setCustomAttribute("plainContentMatch", QString());
-            result.setCustomAttribute("snippetOffset", -1);
+            SearchResultData *resultData = SearchResultData::get(result);
+            resultData->setString(ResultSlot::PlainContentMatch, QString());
+            resultData->setInt64(ResultSlot::SnippetOffset, -1);
+            if (deferHighlight)
+                resultApi.setHighlightDeferred(true);
 
             // 使用ContentHighlighter命名空间进行高亮
             if (enableRetrieval) {
                 try {
                     Lucene::String ocrContentField = doc->get(LuceneFieldNames::OcrText::kOcrContents);
                     if (!ocrContentField.empty()) {
+                        QElapsedTimer highlightTimer;
+                        highlightTimer.start();
                         const QString content = QString::fromStdWString(ocrContentField);
                         // Fix: keep a dedicated plain-text snippet for CLI verbose output
                         // instead of reusing HTML-oriented highlightedContent.
@@ -423,8 +437,9 @@ void OcrTextIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
                         const QString highlightedContent = ContentHighlighter::customHighlight(
                                 m_keywords, content, previewLen, enableHTML);
                         resultApi.setHighlightedContent(highlightedContent);
-                        result.setCustomAttribute("plainContentMatch", plainSnippet.content);
-                        result.setCustomAttribute("snippetOffset", plainSnippet.snippetOffset);
+                        resultData->setString(ResultSlot::PlainContentMatch, plainSnippet.content);
+                        resultData->setInt64(ResultSlot::SnippetOffset, plainSnippet.snippetOffset);
+                        highlightNs.fetch_add(highlightTimer.nsecsElapsed(), std::memory_order_relaxed);
                     }
                 } catch (const Lucene::LuceneException &e) {
                     qWarning() << "Exception retrieving OCR content field:" << QString::fromStdWString(e.getError());
@@ -484,27 +499,41 @@ void OcrTextIndexedStrategy::processSearchResults(const Lucene::IndexSearcherPtr
                 }
             }
 
-            // Add to result collection
-            m_results.append(std::move(result));
-
-            // Real-time result emission
-            if (Q_UNLIKELY(m_options.resultFoundEnabled()))
-                emit resultFound(m_results.last());
+            return result;
 
         } catch (const Lucene::LuceneException &e) {
             qWarning() << "Error processing result:" << QString::fromStdWString(e.getError());
-            continue;
+            return std::nullopt;
         } catch (const std::exception &e) {
             qWarning() << "Standard exception:" << e.what();
-            continue;
+            return std::nullopt;
         } catch (...) {
             qWarning() << "Unknown exception during result processing";
-            continue;
+            return std::nullopt;
         }
-    }
-
-    qInfo() << "OCR text result processing time:" << resultTimer.elapsed() << "ms";
-    emit searchFinished(m_results);
+    };
+
+    const auto timedBuildResult = [&](int32_t i) {
+        QElapsedTimer buildTimer;
+        buildTimer.start();
+        std::optional<SearchResult> result = buildResult(i);
+        buildNs.fetch_add(buildTimer.nsecsElapsed(), std::memory_order_relaxed);
+        return result;
+    };
+
+    ParallelSegmentSearch::processHits(docsSize, optAPI.isParallelSegmentSearchEnabled(), m_cancelledRef, timedBuildResult,
+                                       [this](SearchResult &&result) { return addResult(std::move(result)); });
+    if (m_cancelledRef && m_cancelledRef->load())
+        qInfo() << "OCR text search cancelled";
+
+    // Highlighting runs inside result building, so it is taken out of the load phase
+    m_statistics.addPhaseTime(SearchStatistics::Phase::DocumentLoad, buildNs.load() - highlightNs.load());
+    m_statistics.addPhaseTime(SearchStatistics::Phase::Highlight, highlightNs.load());
+    m_statistics.addCounter(SearchStatistics::Counter::DocumentsLoaded, documentsLoaded.load());
+    m_statistics.addCounter(SearchStatistics::Counter::StoredBytesRead, storedBytes.load());
+
+    flushResults();
+    finishSearch();
 }
 
 void OcrTextIndexedStrategy::performOcrTextSearch(const SearchQuery &query)
@@ -515,7 +544,7 @@ void OcrTextIndexedStrategy::performOcrTextSearch(const SearchQuery &query)
     if (!m_cancelledRef) {
         qWarning("OcrTextIndexedStrategy::performOcrTextSearch: cancellation flag is null, aborting search");
         emit errorOccurred(SearchError(OcrTextSearchErrorCode::OcrTextIndexException));
-        emit searchFinished(m_results);
+        finishSearch();
         return;
     }
 
@@ -523,27 +552,23 @@ void OcrTextIndexedStrategy::performOcrTextSearch(const SearchQuery &query)
     SearchCancellationGuard guard(m_cancelledRef);
 
     try {
-        // Get index directory
-        FSDirectoryPtr directory = FSDirectory::open(m_indexDir.toStdWString());
-        if (!directory) {
-            qWarning() << "Failed to open OCR text index directory:" << m_indexDir;
+        // Borrow a shared reader from the process-wide pool; it is only reopened when the index changed
+        PhaseTimer indexOpenTimer(m_statistics, SearchStatistics::Phase::IndexOpen);
+        const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(m_indexDir);
+        indexOpenTimer.stop();
+        if (!lease || lease.reader()->numDocs() == 0) {
+            qWarning() << "OCR text index is empty or cannot be opened:" << m_indexDir;
             emit errorOccurred(SearchError(OcrTextSearchErrorCode::OcrTextIndexNotFound));
             return;
         }
 
-        // Get index reader
-        IndexReaderPtr reader = IndexReader::open(directory, true);
-        if (!reader || reader->numDocs() == 0) {
-            qWarning() << "OCR text index is empty or cannot be opened";
-            emit errorOccurred(SearchError(OcrTextSearchErrorCode::OcrTextIndexNotFound));
-            return;
-        }
-
-        // Create searcher
-        IndexSearcherPtr searcher = newLucene<IndexSearcher>(reader);
+        const IndexReaderPtr &reader = lease.reader();
+        const IndexSearcherPtr &searcher = lease.searcher();
 
         // Build query
+        PhaseTimer queryBuildTimer(m_statistics, SearchStatistics::Phase::QueryBuild);
         m_currentQuery = buildLuceneQuery(query);
+        queryBuildTimer.stop();
         if (!m_currentQuery) {
             qWarning() << "Failed to build Lucene query for OCR text search";
             emit errorOccurred(SearchError(OcrTextSearchErrorCode::OcrTextIndexException));
@@ -551,31 +576,44 @@ void OcrTextIndexedStrategy::performOcrTextSearch(const SearchQuery &query)
         }
 
         // Execute search
-        QElapsedTimer searchTimer;
-        searchTimer.start();
-
         int32_t maxResults = m_options.maxResults() > 0 ? m_options.maxResults() : reader->numDocs();
 
+        // With a sort key, all hits are visited and only the best maxResults are kept
+        ParallelSegmentSearch::Sort sort;
+        sort.key = m_options.resultSortKey();
+        sort.order = m_options.resultSortOrder();
+        sort.fields = SortedHitQueue::ocrTextIndexFields();
+
         // Use custom CancellableCollector for interruptible search
         Collection<ScoreDocPtr> scoreDocs;
+        PhaseTimer collectTimer(m_statistics, SearchStatistics::Phase::Collect);
         try {
-            // Create cancellable collector
-            boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(m_cancelledRef, maxResults);
-
-            // Execute search with custom collector
+            int32_t totalHits = 0;
             qInfo() << "OCR text search execution start:" << query.keyword();
-            searcher->search(m_currentQuery, collector);
-            // Get collected documents
-            scoreDocs = collector->getScoreDocs();
-
-            qInfo() << "OCR text search execution time:" << searchTimer.elapsed() << "ms"
-                    << "Total hits:" << collector->getTotalHits()
-                    << "Collected:" << scoreDocs.size()
-                    << "Keyword:" << query.keyword()
-                    << "Cancelled" << (m_cancelledRef ? m_cancelledRef->load() : false);
+            if (OcrTextOptionsAPI(m_options).isParallelSegmentSearchEnabled()) {
+                // Search segments concurrently, one cancellable collector per segment, merged in segment order
+                const ParallelSegmentSearch::Hits hits = ParallelSegmentSearch::search(
+                        searcher, m_currentQuery, m_cancelledRef, maxResults, sort);
+                scoreDocs = hits.scoreDocs;
+                totalHits = hits.totalHits;
+            } else {
+                // Create cancellable collector
+                boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(m_cancelledRef, maxResults);
+                collector->setSort(sort.key, sort.order, sort.fields);
+
+                // Execute search with custom collector
+                searcher->search(m_currentQuery, collector);
+                // Get collected documents
+                scoreDocs = collector->getScoreDocs();
+                totalHits = collector->getTotalHits();
+            }
+
+            collectTimer.stop();
+            m_statistics.addCounter(SearchStatistics::Counter::Hits, totalHits);
         } catch (const SearchCancelledException &e) {
             qInfo() << "OCR text search cancelled during execution";
-            emit searchFinished(m_results);
+            collectTimer.stop();
+            finishSearch();
             return;
         } catch (const RuntimeException &e) {
 #if LUCENE_HAS_SEARCH_CANCELLATION
@@ -583,7 +621,8 @@ void OcrTextIndexedStrategy::performOcrTextSearch(const SearchQuery &query)
             QString errorMsg = QString::fromStdWString(e.getError());
             if (errorMsg.contains("cancelled", Qt::CaseInsensitive)) {
                 qInfo() << "OCR text search cancelled in phraseFreq():" << errorMsg;
-                emit searchFinished(m_results);
+                collectTimer.stop();
+                finishSearch();
                 return;
             }
 #endif
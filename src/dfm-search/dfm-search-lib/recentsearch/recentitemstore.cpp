@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "recentitemstore.h"
+
+#include <QCoreApplication>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusInterface>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QDebug>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QStandardPaths>
+#include <QThread>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+constexpr auto kDBusService = "org.deepin.Filemanager.Daemon";
+constexpr auto kDBusPath = "/org/deepin/Filemanager/Daemon/RecentManager";
+constexpr auto kDBusInterface = "org.deepin.Filemanager.Daemon.RecentManager";
+constexpr auto kDBusMethod = "GetItemsInfo";
+
+// RecentManager 在记录变化后发出的信号
+constexpr const char *kChangeSignals[] = { "ReloadFinished", "PurgeFinished",
+                                           "ItemAdded", "ItemsRemoved", "ItemChanged" };
+
+QString recentFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+            + QStringLiteral("/recently-used.xbel");
+}
+}   // namespace
+
+RecentItemSnapshotPtr RecentItemSnapshot::fromItems(const QList<RecentItem> &items)
+{
+    auto snapshot = std::make_shared<RecentItemSnapshot>();
+    snapshot->paths.reserve(items.size());
+    snapshot->fileNames.reserve(items.size());
+    snapshot->suffixes.reserve(items.size());
+    snapshot->modified.reserve(items.size());
+
+    for (const RecentItem &item : items) {
+        const QFileInfo info(item.path);
+        snapshot->paths.append(item.path);
+        snapshot->fileNames.append(info.fileName());
+        snapshot->suffixes.append(info.suffix().toLower());
+        snapshot->modified.append(item.modified);
+    }
+    return snapshot;
+}
+
+RecentItemStore *RecentItemStore::instance()
+{
+    static RecentItemStore *store = new RecentItemStore;
+    return store;
+}
+
+RecentItemStore::RecentItemStore(QObject *parent)
+    : QObject(parent)
+{
+    // 变更通知在主线程接收；首次调用可能来自搜索线程
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app)
+        return;
+
+    if (thread() != app->thread()) {
+        moveToThread(app->thread());
+        QMetaObject::invokeMethod(this, "startWatching", Qt::QueuedConnection);
+    } else {
+        startWatching();
+    }
+}
+
+void RecentItemStore::startWatching()
+{
+    bool watching = false;
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (bus.isConnected()) {
+        for (const char *signal : kChangeSignals) {
+            // 无参数的槽匹配任意签名的信号
+            watching |= bus.connect(QString::fromLatin1(kDBusService), QString::fromLatin1(kDBusPath),
+                                    QString::fromLatin1(kDBusInterface), QString::fromLatin1(signal),
+                                    this, SLOT(onRecentChanged()));
+        }
+
+        // 守护进程重启后记录可能已变化
+        auto *serviceWatcher = new QDBusServiceWatcher(QString::fromLatin1(kDBusService), bus,
+                                                       QDBusServiceWatcher::WatchForOwnerChange, this);
+        connect(serviceWatcher, &QDBusServiceWatcher::serviceOwnerChanged, this, &RecentItemStore::onRecentChanged);
+    }
+
+    m_fileWatcher = new QFileSystemWatcher(this);
+    connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &RecentItemStore::onRecentFileChanged);
+    const QString recentFile = recentFilePath();
+    if (QFileInfo::exists(recentFile))
+        watching |= m_fileWatcher->addPath(recentFile);
+
+    m_watching.store(watching);
+}
+
+void RecentItemStore::onRecentChanged()
+{
+    invalidate();
+}
+
+void RecentItemStore::onRecentFileChanged(const QString &path)
+{
+    invalidate();
+
+    // 文件被替换写入时监视会失效，重新加入
+    if (!m_fileWatcher->files().contains(path) && QFileInfo::exists(path))
+        m_fileWatcher->addPath(path);
+}
+
+RecentItemSnapshotPtr RecentItemStore::snapshot()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_snapshot && !m_stale.load() && m_watching.load())
+        return m_snapshot;
+
+    // 先清除过期标记：拉取期间到达的变更会再次标记，下次重新拉取
+    m_stale.store(false);
+    bool ok = false;
+    const QList<RecentItem> items = fetchFromDBus(&ok);
+    if (!ok)
+        m_stale.store(true);
+
+    m_snapshot = RecentItemSnapshot::fromItems(items);
+    ++m_refreshCount;
+    return m_snapshot;
+}
+
+void RecentItemStore::invalidate()
+{
+    m_stale.store(true);
+}
+
+quint64 RecentItemStore::refreshCount() const
+{
+    return m_refreshCount.load();
+}
+
+QList<RecentItem> RecentItemStore::fetchFromDBus(bool *ok)
+{
+    QList<RecentItem> items;
+    if (ok)
+        *ok = false;
+
+    QDBusInterface iface(QString::fromLatin1(kDBusService), QString::fromLatin1(kDBusPath),
+                         QString::fromLatin1(kDBusInterface),
+                         QDBusConnection::sessionBus());
+    if (!iface.isValid()) {
+        qWarning() << "RecentManager DBus interface is invalid:"
+                   << iface.lastError().message();
+        return items;
+    }
+
+    QDBusPendingReply<QVariantList> reply = iface.call(QString::fromLatin1(kDBusMethod));
+    if (!reply.isValid()) {
+        qWarning() << "RecentManager GetItemsInfo failed:" << reply.error().message();
+        return items;
+    }
+    const QVariantList &topLevelList = reply.value();
+
+    for (const auto &v : topLevelList) {
+        QVariantMap map;
+        if (v.userType() == qMetaTypeId<QDBusArgument>()) {
+            const QDBusArgument dbusArg = v.value<QDBusArgument>();
+            dbusArg >> map;   // 直接将QDBusArgument解包为QVariantMap
+        } else {
+            map = v.toMap();
+        }
+        if (!map.isEmpty()) {
+            RecentItem item;
+            item.href = map.value("Href").toString();
+            item.path = map.value("Path").toString();
+            item.modified = static_cast<qint64>(map.value("modified").toLongLong());
+            if (!item.path.isEmpty() && item.modified > 0) {
+                items.append(std::move(item));
+            }
+        }
+    }
+
+    if (ok)
+        *ok = true;
+    return items;
+}
+
+DFM_SEARCH_END_NS
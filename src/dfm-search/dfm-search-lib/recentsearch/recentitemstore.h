@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RECENTITEMSTORE_H
+#define RECENTITEMSTORE_H
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+#include <dfm-search/dsearch_global.h>
+
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QFileSystemWatcher;
+QT_END_NAMESPACE
+
+DFM_SEARCH_BEGIN_NS
+
+struct RecentItem {
+    QString path;   // 本地路径 (DBus "Path" 字段)
+    QString href;   // file:// URI (DBus "Href" 字段)
+    qint64 modified = 0;   // 最近访问时间戳，秒级 Unix epoch
+};
+
+/**
+ * @brief 最近使用记录快照（按列存储）
+ *
+ * 每一列按下标对应同一条记录。文件名与小写后缀在构建快照时一次算好，
+ * 过滤时不再为每条记录构造 QFileInfo。快照构建后只读，可在线程间共享。
+ */
+class RecentItemSnapshot
+{
+public:
+    static std::shared_ptr<const RecentItemSnapshot> fromItems(const QList<RecentItem> &items);
+
+    int size() const { return paths.size(); }
+
+    QStringList paths;
+    QStringList fileNames;
+    QStringList suffixes;   // 小写
+    QVector<qint64> modified;   // 秒级 Unix epoch
+};
+
+using RecentItemSnapshotPtr = std::shared_ptr<const RecentItemSnapshot>;
+
+/**
+ * @brief 进程内共享的最近使用记录
+ *
+ * 首次使用时通过 DBus RecentManager.GetItemsInfo 拉取记录并构建快照，之后
+ * 各次搜索直接复用。收到 RecentManager 的变更信号，或 recently-used.xbel
+ * 文件变化时，快照标记为过期，下一次 snapshot() 重新拉取。
+ *
+ * 变更通知需要在主线程的事件循环中接收；没有 QCoreApplication 时无法得知
+ * 变更，此时每次都重新拉取，行为与不缓存时相同。
+ */
+class RecentItemStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static RecentItemStore *instance();
+
+    /**
+     * @brief 当前快照，过期或尚未拉取时同步刷新
+     *
+     * 拉取失败时返回空快照，并在下次调用时重试。
+     */
+    RecentItemSnapshotPtr snapshot();
+
+    /**
+     * @brief 标记快照过期
+     */
+    void invalidate();
+
+    /**
+     * @brief 通过 DBus 拉取全部最近使用记录（阻塞调用）
+     * @param ok 输出：调用是否成功
+     */
+    static QList<RecentItem> fetchFromDBus(bool *ok = nullptr);
+
+    /**
+     * @brief 已执行的刷新次数，用于测试与调优
+     */
+    quint64 refreshCount() const;
+
+private Q_SLOTS:
+    void startWatching();
+    void onRecentChanged();
+    void onRecentFileChanged(const QString &path);
+
+private:
+    explicit RecentItemStore(QObject *parent = nullptr);
+
+    QMutex m_mutex;   // 保护 m_snapshot，并保证同一时间只有一个线程在刷新
+    RecentItemSnapshotPtr m_snapshot;
+    std::atomic<bool> m_stale { true };
+    std::atomic<bool> m_watching { false };
+    std::atomic<quint64> m_refreshCount { 0 };
+    QFileSystemWatcher *m_fileWatcher = nullptr;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // RECENTITEMSTORE_H
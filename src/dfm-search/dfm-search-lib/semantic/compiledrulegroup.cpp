@@ -0,0 +1,398 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiledrulegroup.h"
+#include "semanticruleengine.h"
+
+#include <QBitArray>
+#include <QHash>
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+// A factor of a pattern: every match contains at least one of `anyOf`.
+// An empty list means nothing is known about the factor.
+struct Factor
+{
+    QStringList anyOf;
+
+    bool isKnown() const { return !anyOf.isEmpty(); }
+
+    int shortest() const
+    {
+        int length = INT_MAX;
+        for (const QString &literal : anyOf)
+            length = qMin(length, literal.size());
+        return length;
+    }
+};
+
+// Prefer factors whose shortest literal is longest, then fewer alternatives
+bool isBetter(const Factor &candidate, const Factor &current)
+{
+    if (!current.isKnown())
+        return true;
+    const int a = candidate.shortest();
+    const int b = current.shortest();
+    if (a != b)
+        return a > b;
+    return candidate.anyOf.size() < current.anyOf.size();
+}
+
+// Characters usable as prefilter literals. KeywordScanner treats '?' and '*' as
+// wildcards, and characters with case variants outside ASCII may fold differently
+// from PCRE, so both are left to the regex.
+bool isPrefilterChar(QChar ch)
+{
+    if (ch == QLatin1Char('?') || ch == QLatin1Char('*'))
+        return false;
+    if (ch.unicode() < 0x80)
+        return ch.isPrint();
+    return !ch.isSurrogate() && ch.toLower() == ch && ch.toUpper() == ch;
+}
+
+/**
+ * Conservative analysis of a PCRE pattern. Anything not understood is treated
+ * as an atom that can match any text, which only weakens the prefilter; only
+ * constructs that could make a derived literal wrong (inline options, \Q...\E,
+ * conditionals) abort the analysis.
+ */
+class LiteralAnalyzer
+{
+public:
+    explicit LiteralAnalyzer(const QString &pattern)
+        : m_pattern(pattern) { }
+
+    Factor analyze()
+    {
+        Factor result = parseAlternation();
+        if (m_failed || m_pos != m_pattern.size())
+            return Factor();
+        return result;
+    }
+
+private:
+    bool atEnd() const { return m_pos >= m_pattern.size(); }
+    QChar peek(int offset = 0) const
+    {
+        const int index = m_pos + offset;
+        return index < m_pattern.size() ? m_pattern.at(index) : QChar();
+    }
+
+    Factor parseAlternation()
+    {
+        QStringList literals;
+        bool known = true;
+        for (;;) {
+            const Factor branch = parseSequence();
+            if (branch.isKnown()) {
+                for (const QString &literal : branch.anyOf) {
+                    if (!literals.contains(literal))
+                        literals.append(literal);
+                }
+            } else {
+                known = false;
+            }
+
+            if (!atEnd() && peek() == QLatin1Char('|')) {
+                ++m_pos;
+                continue;
+            }
+            break;
+        }
+        return known ? Factor { literals } : Factor();
+    }
+
+    Factor parseSequence()
+    {
+        Factor best;
+        QString run;
+        const auto flushRun = [&]() {
+            if (!run.isEmpty()) {
+                const Factor factor { QStringList { run } };
+                if (isBetter(factor, best))
+                    best = factor;
+                run.clear();
+            }
+        };
+
+        while (!atEnd() && !m_failed) {
+            const QChar ch = peek();
+            if (ch == QLatin1Char('|') || ch == QLatin1Char(')'))
+                break;
+
+            QChar literal;
+            Factor atom;
+            if (ch == QLatin1Char('(')) {
+                atom = parseGroup();
+            } else if (ch == QLatin1Char('[')) {
+                skipClass();
+            } else if (ch == QLatin1Char('\\')) {
+                literal = parseEscape();
+            } else {
+                ++m_pos;
+                // '.', anchors and braces that do not form a quantifier match unknown text
+                if (ch != QLatin1Char('.') && ch != QLatin1Char('^') && ch != QLatin1Char('$')
+                    && ch != QLatin1Char('{') && ch != QLatin1Char('}'))
+                    literal = ch;
+            }
+            if (m_failed)
+                break;
+
+            const int minRepeat = parseQuantifier();
+            if (!literal.isNull() && isPrefilterChar(literal)) {
+                if (minRepeat == 0) {
+                    flushRun();
+                } else {
+                    run.append(literal);
+                    // A repeated character ends the run: "ab+c" guarantees "ab" but not "abc"
+                    if (minRepeat > 1 || m_repeated)
+                        flushRun();
+                }
+                continue;
+            }
+
+            flushRun();
+            if (minRepeat > 0 && atom.isKnown() && isBetter(atom, best))
+                best = atom;
+        }
+
+        flushRun();
+        return best;
+    }
+
+    Factor parseGroup()
+    {
+        ++m_pos;   // '('
+        bool capture = true;
+        if (peek() == QLatin1Char('?')) {
+            const QChar kind = peek(1);
+            if (kind == QLatin1Char(':')) {
+                m_pos += 2;
+            } else if (kind == QLatin1Char('=') || kind == QLatin1Char('!')) {
+                m_pos += 2;
+                capture = false;
+            } else if (kind == QLatin1Char('<') && (peek(2) == QLatin1Char('=') || peek(2) == QLatin1Char('!'))) {
+                m_pos += 3;
+                capture = false;
+            } else if (kind == QLatin1Char('<') || kind == QLatin1Char('\'')
+                       || (kind == QLatin1Char('P') && peek(2) == QLatin1Char('<'))) {
+                // Named group
+                const QChar close = kind == QLatin1Char('\'') ? QLatin1Char('\'') : QLatin1Char('>');
+                const int end = m_pattern.indexOf(close, m_pos + 2);
+                if (end < 0) {
+                    m_failed = true;
+                    return Factor();
+                }
+                m_pos = end + 1;
+            } else {
+                // Inline options, atomic groups, conditionals, recursion...
+                m_failed = true;
+                return Factor();
+            }
+        }
+
+        const Factor inner = parseAlternation();
+        if (atEnd() || peek() != QLatin1Char(')')) {
+            m_failed = true;
+            return Factor();
+        }
+        ++m_pos;
+        // Lookarounds consume no text; their literals are not part of the match
+        return capture ? inner : Factor();
+    }
+
+    void skipClass()
+    {
+        ++m_pos;   // '['
+        if (peek() == QLatin1Char('^'))
+            ++m_pos;
+        if (peek() == QLatin1Char(']'))
+            ++m_pos;
+        while (!atEnd()) {
+            const QChar ch = peek();
+            if (ch == QLatin1Char('\\')) {
+                m_pos += 2;
+            } else if (ch == QLatin1Char('[') && peek(1) == QLatin1Char(':')) {
+                const int end = m_pattern.indexOf(QLatin1String(":]"), m_pos + 2);
+                m_pos = end < 0 ? m_pattern.size() : end + 2;
+            } else if (ch == QLatin1Char(']')) {
+                ++m_pos;
+                return;
+            } else {
+                ++m_pos;
+            }
+        }
+        m_failed = true;
+    }
+
+    // Returns the escaped character if it is a literal, or a null QChar
+    QChar parseEscape()
+    {
+        ++m_pos;   // '\\'
+        if (atEnd()) {
+            m_failed = true;
+            return QChar();
+        }
+
+        const QChar ch = peek();
+        ++m_pos;
+        if (!ch.isLetterOrNumber())
+            return ch;
+
+        // Quoting, backreferences and octal codes are not analysed
+        if (ch == QLatin1Char('Q') || ch == QLatin1Char('E') || ch.isDigit()) {
+            m_failed = true;
+            return QChar();
+        }
+        if (ch == QLatin1Char('c')) {
+            ++m_pos;
+            return QChar();
+        }
+        // Short forms: \pL, \x41, \g1
+        if ((ch == QLatin1Char('p') || ch == QLatin1Char('P')) && peek() != QLatin1Char('{')) {
+            ++m_pos;
+            return QChar();
+        }
+        if (ch == QLatin1Char('x') && peek() != QLatin1Char('{')) {
+            for (int i = 0; i < 2 && peek().unicode() < 0x80 && std::isxdigit(peek().unicode()); ++i)
+                ++m_pos;
+            return QChar();
+        }
+        if (ch == QLatin1Char('g') && peek() != QLatin1Char('{') && peek() != QLatin1Char('<')
+            && peek() != QLatin1Char('\'')) {
+            m_failed = true;
+            return QChar();
+        }
+
+        // \p{..}, \x{..}, \g{..}, \k<..>, \N{..} and \o{..} carry an argument; the
+        // brace after any other escape (e.g. \d{2,4}) is a quantifier
+        const QChar open = peek();
+        const bool takesArgument = QStringLiteral("pPxgkNo").contains(ch);
+        if (takesArgument && (open == QLatin1Char('{') || open == QLatin1Char('<') || open == QLatin1Char('\''))) {
+            const QChar close = open == QLatin1Char('{') ? QLatin1Char('}')
+                                                         : (open == QLatin1Char('<') ? QLatin1Char('>') : QLatin1Char('\''));
+            const int end = m_pattern.indexOf(close, m_pos + 1);
+            if (end < 0) {
+                m_failed = true;
+                return QChar();
+            }
+            m_pos = end + 1;
+        }
+        return QChar();
+    }
+
+    // Minimum repetition of the preceding atom: 1 without a quantifier
+    int parseQuantifier()
+    {
+        m_repeated = false;
+        if (atEnd())
+            return 1;
+
+        int minRepeat = 1;
+        const QChar ch = peek();
+        if (ch == QLatin1Char('?') || ch == QLatin1Char('*')) {
+            minRepeat = 0;
+            ++m_pos;
+        } else if (ch == QLatin1Char('+')) {
+            m_repeated = true;
+            ++m_pos;
+        } else if (ch == QLatin1Char('{')) {
+            int pos = m_pos + 1;
+            int value = 0;
+            bool hasDigits = false;
+            while (pos < m_pattern.size() && m_pattern.at(pos).isDigit()) {
+                value = value * 10 + m_pattern.at(pos).digitValue();
+                hasDigits = true;
+                ++pos;
+            }
+            bool bounded = true;
+            if (hasDigits && pos < m_pattern.size() && m_pattern.at(pos) == QLatin1Char(',')) {
+                bounded = false;
+                ++pos;
+                while (pos < m_pattern.size() && m_pattern.at(pos).isDigit())
+                    ++pos;
+            }
+            if (!hasDigits || pos >= m_pattern.size() || m_pattern.at(pos) != QLatin1Char('}'))
+                return 1;   // Not a quantifier; the brace is parsed as an atom next
+
+            m_pos = pos + 1;
+            minRepeat = value;
+            m_repeated = !bounded || value > 1;
+        } else {
+            return 1;
+        }
+
+        // Lazy or possessive suffix
+        if (!atEnd() && (peek() == QLatin1Char('?') || peek() == QLatin1Char('+')))
+            ++m_pos;
+        return minRepeat;
+    }
+
+    const QString &m_pattern;
+    int m_pos = 0;
+    bool m_failed = false;
+    bool m_repeated = false;   ///< The last quantifier allows more than one repetition
+};
+
+}   // namespace
+
+CompiledRuleGroup::CompiledRuleGroup(const QList<Rule> &rules)
+{
+    for (int i = 0; i < rules.size(); ++i) {
+        if (rules.at(i).enabled && rules.at(i).regex.isValid())
+            m_order.append(i);
+    }
+    std::stable_sort(m_order.begin(), m_order.end(), [&rules](int a, int b) {
+        return rules.at(a).priority > rules.at(b).priority;
+    });
+
+    QStringList literals;
+    QHash<QString, int> literalIndex;
+    m_literals.reserve(m_order.size());
+    for (int index : std::as_const(m_order)) {
+        QVector<int> required;
+        for (const QString &literal : requiredLiterals(rules.at(index).pattern)) {
+            const QString key = literal.toCaseFolded();
+            auto it = literalIndex.constFind(key);
+            if (it == literalIndex.constEnd()) {
+                it = literalIndex.insert(key, literals.size());
+                literals.append(key);
+            }
+            required.append(*it);
+        }
+        m_literals.append(required);
+    }
+
+    m_scanner = KeywordScanner(literals);
+}
+
+QVector<int> CompiledRuleGroup::candidates(const QString &input) const
+{
+    const QBitArray present = m_scanner.presence(input);
+
+    QVector<int> result;
+    result.reserve(m_order.size());
+    for (int i = 0; i < m_order.size(); ++i) {
+        const QVector<int> &required = m_literals.at(i);
+        const bool possible = required.isEmpty()
+                || std::any_of(required.cbegin(), required.cend(),
+                               [&present](int literal) { return present.testBit(literal); });
+        if (possible)
+            result.append(m_order.at(i));
+    }
+    return result;
+}
+
+QStringList CompiledRuleGroup::requiredLiterals(const QString &pattern)
+{
+    return LiteralAnalyzer(pattern).analyze().anyOf;
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COMPILEDRULEGROUP_H
+#define COMPILEDRULEGROUP_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <dfm-search/dsearch_global.h>
+
+#include "utils/keywordscanner.h"
+
+DFM_SEARCH_BEGIN_NS
+
+struct Rule;
+
+/**
+ * @brief Rule group prepared once at load time for fast matching.
+ *
+ * Enabled rules with a valid regex are ordered by priority when the group is
+ * compiled, so matching no longer copies and sorts the rule list per call.
+ *
+ * Each rule also gets a literal prefilter: a set of literals of which at least
+ * one must occur in any text the regex can match (e.g. "去年|上一年" requires
+ * "去年" or "上一年"). The literals of all rules are scanned together in a single
+ * case-insensitive pass over the input, and rules whose literals are absent are
+ * skipped without running their regex. Rules without such literals (e.g. pure
+ * digit patterns) are always tried.
+ */
+class CompiledRuleGroup
+{
+public:
+    CompiledRuleGroup() = default;
+    explicit CompiledRuleGroup(const QList<Rule> &rules);
+
+    /**
+     * @brief Indices into the rule list of the rules that may match @p input,
+     *        in descending priority order (stable for equal priorities).
+     */
+    QVector<int> candidates(const QString &input) const;
+
+    /**
+     * @brief Literals of which at least one occurs in every match of @p pattern.
+     *
+     * Returns an empty list when no such set can be derived, in which case the
+     * rule cannot be prefiltered.
+     */
+    static QStringList requiredLiterals(const QString &pattern);
+
+private:
+    QVector<int> m_order;   ///< Enabled, valid rules by descending priority
+    QVector<QVector<int>> m_literals;   ///< Literal indices per entry of m_order; empty means no prefilter
+    KeywordScanner m_scanner { QStringList() };
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // COMPILEDRULEGROUP_H
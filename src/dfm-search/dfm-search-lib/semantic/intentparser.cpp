@@ -13,10 +13,18 @@
 #include "extractors/targetextractor.h"
 #include "extractors/timeextractor.h"
 
+#include <QDateTime>
+
 DFM_SEARCH_BEGIN_NS
 
+namespace {
+constexpr int kDefaultCacheCapacity = 64;
+// "最近一小时" etc. resolve to absolute ranges at parse time; reparse them after this
+constexpr qint64 kTimeIntentTtlMs = 30 * 1000;
+}   // namespace
+
 IntentParser::IntentParser(SemanticRuleEngine *engine)
-    : m_engine(engine)
+    : m_engine(engine), m_cache(kDefaultCacheCapacity)
 {
     initDefaultExtractors();
 }
@@ -25,15 +33,72 @@ IntentParser::~IntentParser() = default;
 
 void IntentParser::parse(const QString &input, ParsedIntent &intent)
 {
+    const quint64 generation = m_engine ? m_engine->generation() : 0;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        if (generation != m_cacheGeneration) {
+            m_cache.clear();
+            m_cacheGeneration = generation;
+        }
+        if (const CachedIntent *cached = m_cache.object(input)) {
+            const bool expired = cached->intent.timeConstraint().isValid()
+                    && QDateTime::currentMSecsSinceEpoch() - cached->parsedAtMs > kTimeIntentTtlMs;
+            if (!expired) {
+                ++m_cacheHits;
+                intent = cached->intent;
+                return;
+            }
+            m_cache.remove(input);
+        }
+        ++m_cacheMisses;
+    }
+
+    ParsedIntent parsed;
     for (DimensionExtractor *extractor : m_extractors) {
-        extractor->extract(input, intent);
+        extractor->extract(input, parsed);
     }
+    intent = parsed;
+
+    QMutexLocker locker(&m_cacheMutex);
+    if (generation == m_cacheGeneration && m_cache.maxCost() > 0)
+        m_cache.insert(input, new CachedIntent { std::move(parsed), QDateTime::currentMSecsSinceEpoch() });
 }
 
 void IntentParser::addExtractor(std::unique_ptr<DimensionExtractor> extractor)
 {
     m_extractors.push_back(extractor.get());
     m_extractorOwners.push_back(std::move(extractor));
+    clearCache();
+}
+
+void IntentParser::setCacheCapacity(int capacity)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_cache.setMaxCost(qMax(0, capacity));
+}
+
+int IntentParser::cacheCapacity() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return static_cast<int>(m_cache.maxCost());
+}
+
+quint64 IntentParser::cacheHits() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_cacheHits;
+}
+
+quint64 IntentParser::cacheMisses() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_cacheMisses;
+}
+
+void IntentParser::clearCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_cache.clear();
 }
 
 QStringList IntentParser::extractorNames() const
@@ -9,6 +9,9 @@
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/semantic_types.h>
 
+#include <QCache>
+#include <QMutex>
+
 #include <memory>
 #include <vector>
 
@@ -21,6 +24,13 @@ class SemanticRuleEngine;
  *
  * Extractors run in order. KeywordExtractor MUST be last
  * because it relies on consumedSpans from earlier extractors.
+ *
+ * Parsed intents are kept in a small LRU cache keyed by the input text, so
+ * repeated parses of the same input (search-as-you-type, isSemanticQuery()
+ * followed by search()) skip the extractors. The cache is dropped when the
+ * rule engine reloads its rules or an extractor is added. Intents with a time
+ * constraint are resolved against the current time and expire after a short
+ * while.
  */
 class IntentParser
 {
@@ -31,10 +41,24 @@ public:
     /**
      * @brief Parse natural language input into a structured intent.
      * @param input The raw natural language string
-     * @param intent Output: parsed intent
+     * @param intent Output: parsed intent (any previous content is replaced)
      */
     void parse(const QString &input, ParsedIntent &intent);
 
+    /**
+     * @brief Set the number of cached intents (default 64, 0 disables caching).
+     */
+    void setCacheCapacity(int capacity);
+    int cacheCapacity() const;
+
+    /**
+     * @brief Number of parses answered from / missed by the cache.
+     */
+    quint64 cacheHits() const;
+    quint64 cacheMisses() const;
+
+    void clearCache();
+
     /**
      * @brief Add a custom dimension extractor.
      * Extractors are called in the order they are added.
@@ -52,6 +76,19 @@ private:
     SemanticRuleEngine *m_engine;
     std::vector<DimensionExtractor *> m_extractors;
     std::vector<std::unique_ptr<DimensionExtractor>> m_extractorOwners;
+
+    struct CachedIntent
+    {
+        ParsedIntent intent;
+        qint64 parsedAtMs = 0;   ///< Time constraints are resolved against the parse time
+    };
+
+    // Input text -> parsed intent, valid for rule generation m_cacheGeneration
+    mutable QMutex m_cacheMutex;
+    QCache<QString, CachedIntent> m_cache;
+    quint64 m_cacheGeneration = 0;
+    quint64 m_cacheHits = 0;
+    quint64 m_cacheMisses = 0;
 };
 
 DFM_SEARCH_END_NS
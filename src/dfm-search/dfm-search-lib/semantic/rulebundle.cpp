@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "rulebundle.h"
+#include "ruleconfigloader.h"
+#include "semanticruleengine.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+constexpr quint32 kMagic = 0x44525342;   // "DRSB"
+constexpr quint32 kFormatVersion = 1;
+constexpr int kHashSize = 20;   // SHA-1
+// magic + format version + payload size + checksum + fingerprint
+constexpr qint64 kHeaderSize = 4 + 4 + 8 + kHashSize + kHashSize;
+// Fixed so that bundles do not depend on the Qt minor version that wrote them
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_5_11;
+
+QByteArray checksum(const char *data, qint64 size)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::fromRawData(data, static_cast<int>(size)));
+    return hash.result();
+}
+
+void writePayload(QDataStream &out, const QMap<QString, RuleGroup> &groups,
+                  const QMap<QString, QString> &filePaths)
+{
+    out << static_cast<quint32>(groups.size());
+    for (const RuleGroup &group : groups) {
+        out << group.name << group.version << group.locale;
+        out << static_cast<quint32>(group.rules.size());
+        for (const Rule &rule : group.rules) {
+            out << rule.id << rule.pattern << rule.description << rule.enabled
+                << static_cast<qint32>(rule.priority) << rule.metadata;
+        }
+    }
+    out << filePaths;
+}
+
+bool readPayload(QDataStream &in, QMap<QString, RuleGroup> &groups,
+                 QMap<QString, QString> &filePaths)
+{
+    quint32 groupCount = 0;
+    in >> groupCount;
+    for (quint32 g = 0; g < groupCount && in.status() == QDataStream::Ok; ++g) {
+        RuleGroup group;
+        quint32 ruleCount = 0;
+        in >> group.name >> group.version >> group.locale >> ruleCount;
+        for (quint32 r = 0; r < ruleCount && in.status() == QDataStream::Ok; ++r) {
+            Rule rule;
+            qint32 priority = 0;
+            in >> rule.id >> rule.pattern >> rule.description >> rule.enabled
+                    >> priority >> rule.metadata;
+            rule.priority = priority;
+            // Patterns were validated before the bundle was written
+            rule.regex = SemanticRuleEngine::compileRulePattern(rule.pattern);
+            if (!rule.regex.isValid())
+                return false;
+            group.rules.append(rule);
+        }
+        groups.insert(group.name, group);
+    }
+    in >> filePaths;
+    return in.status() == QDataStream::Ok && in.atEnd();
+}
+
+}   // namespace
+
+QString RuleBundle::bundlePath()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + "/deepin/" + RuleConfigLoader::libName() + "/semantic";
+    return QDir(cacheDir).absoluteFilePath(QStringLiteral("rules-qt%1-%2.bundle")
+                                                   .arg(QT_VERSION >> 16)
+                                                   .arg(RuleConfigLoader::currentLocaleName()));
+}
+
+QByteArray RuleBundle::sourceFingerprint()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(kFormatVersion));
+    hash.addData(RuleConfigLoader::currentLocaleName().toUtf8());
+
+    for (const QString &dir : RuleConfigLoader::ruleDirs()) {
+        const QFileInfoList files = QDir(dir).entryInfoList(
+                QStringList { QStringLiteral("*.json") }, QDir::Files, QDir::Name);
+        for (const QFileInfo &info : files) {
+            hash.addData(info.absoluteFilePath().toUtf8());
+            hash.addData(QByteArray::number(info.size()));
+            hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        }
+        hash.addData(QByteArrayLiteral("\n"));
+    }
+    return hash.result();
+}
+
+bool RuleBundle::load(const QString &path, const QByteArray &fingerprint,
+                      QMap<QString, RuleGroup> &groups, QMap<QString, QString> &filePaths)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < kHeaderSize)
+        return false;
+
+    // The mapping stays valid until the file is closed
+    const uchar *mapped = file.map(0, file.size());
+    if (!mapped)
+        return false;
+    const char *data = reinterpret_cast<const char *>(mapped);
+
+    QDataStream header(QByteArray::fromRawData(data, static_cast<int>(kHeaderSize)));
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint64 payloadSize = 0;
+    header >> magic >> version >> payloadSize;
+    QByteArray storedChecksum(kHashSize, Qt::Uninitialized);
+    QByteArray storedFingerprint(kHashSize, Qt::Uninitialized);
+    header.readRawData(storedChecksum.data(), kHashSize);
+    header.readRawData(storedFingerprint.data(), kHashSize);
+
+    if (header.status() != QDataStream::Ok || magic != kMagic || version != kFormatVersion
+        || storedFingerprint != fingerprint
+        || payloadSize != static_cast<quint64>(file.size() - kHeaderSize)) {
+        return false;
+    }
+
+    const char *payloadData = data + kHeaderSize;
+    if (checksum(payloadData, static_cast<qint64>(payloadSize)) != storedChecksum) {
+        qWarning() << "Corrupt semantic rule bundle:" << path;
+        return false;
+    }
+
+    QMap<QString, RuleGroup> loadedGroups;
+    QMap<QString, QString> loadedPaths;
+    QDataStream payload(QByteArray::fromRawData(payloadData, static_cast<int>(payloadSize)));
+    payload.setVersion(kStreamVersion);
+    if (!readPayload(payload, loadedGroups, loadedPaths) || loadedGroups.isEmpty())
+        return false;
+
+    groups = loadedGroups;
+    filePaths = loadedPaths;
+    return true;
+}
+
+bool RuleBundle::save(const QString &path, const QByteArray &fingerprint,
+                      const QMap<QString, RuleGroup> &groups, const QMap<QString, QString> &filePaths)
+{
+    if (fingerprint.size() != kHashSize || groups.isEmpty())
+        return false;
+
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(kStreamVersion);
+        writePayload(out, groups, filePaths);
+    }
+
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return false;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << kMagic << kFormatVersion << static_cast<quint64>(payload.size());
+    out.writeRawData(checksum(payload.constData(), payload.size()).constData(), kHashSize);
+    out.writeRawData(fingerprint.constData(), kHashSize);
+    out.writeRawData(payload.constData(), payload.size());
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "Failed to write semantic rule bundle:" << path;
+        return false;
+    }
+    return true;
+}
+
+DFM_SEARCH_END_NS
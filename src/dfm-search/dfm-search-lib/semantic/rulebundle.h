@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RULEBUNDLE_H
+#define RULEBUNDLE_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+struct RuleGroup;
+
+/**
+ * @brief Binary snapshot of the validated rule groups.
+ *
+ * Parsing the JSON rule files dominates the first semantic query in
+ * short-lived processes. After the JSON rules have been loaded once, the
+ * merged groups are written to a bundle in the user cache directory; later
+ * loads map the bundle and read it directly when it is still fresh.
+ *
+ * A bundle is fresh when its fingerprint matches the current rule sources:
+ * the locale and the path, size and modification time of every JSON file in
+ * the rule directories. Its payload is protected by a SHA-1 checksum; any
+ * mismatch makes the caller fall back to the JSON files.
+ *
+ * Layout: fixed header (magic, format version, payload size, checksum,
+ * fingerprint) followed by a QDataStream payload.
+ */
+class RuleBundle
+{
+public:
+    /**
+     * @brief Default bundle location for the current Qt major version and locale.
+     */
+    static QString bundlePath();
+
+    /**
+     * @brief Fingerprint of the JSON rule files found in RuleConfigLoader::ruleDirs().
+     */
+    static QByteArray sourceFingerprint();
+
+    /**
+     * @brief Read a bundle.
+     * @param path Bundle file
+     * @param fingerprint Expected source fingerprint
+     * @param groups Output: rule groups with compiled regexes
+     * @param filePaths Output: group name -> rule file the group was loaded from
+     * @return false if the bundle is missing, stale or corrupt
+     */
+    static bool load(const QString &path, const QByteArray &fingerprint,
+                     QMap<QString, RuleGroup> &groups, QMap<QString, QString> &filePaths);
+
+    /**
+     * @brief Atomically write a bundle.
+     * @return true on success
+     */
+    static bool save(const QString &path, const QByteArray &fingerprint,
+                     const QMap<QString, RuleGroup> &groups, const QMap<QString, QString> &filePaths);
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // RULEBUNDLE_H
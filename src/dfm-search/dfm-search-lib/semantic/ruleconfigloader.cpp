@@ -55,15 +55,18 @@ QString RuleConfigLoader::currentLocaleName()
     return QLocale::system().name().simplified();
 }
 
+QStringList RuleConfigLoader::ruleDirs()
+{
+    return { resolveLocaleDir(userRulesDir()),
+             resolveLocaleDir(systemRulesDir()) };
+}
+
 QStringList RuleConfigLoader::ruleFilePaths()
 {
     QStringList paths;
     QSet<QString> seen;   // deduplicate by filename
 
-    const QStringList dirs { resolveLocaleDir(userRulesDir()),
-                             resolveLocaleDir(systemRulesDir()) };
-
-    for (const QString &dir : dirs) {
+    for (const QString &dir : ruleDirs()) {
         const QStringList files = QDir(dir).entryList(
                 QStringList { QStringLiteral("*.json") },
                 QDir::Files | QDir::Readable);
@@ -49,6 +49,11 @@ public:
      */
     static QString currentLocaleName();
 
+    /**
+     * @brief Get the locale directories scanned for rule files, user dir first.
+     */
+    static QStringList ruleDirs();
+
     /**
      * @brief Scan locale directories and return resolved paths for all rule files.
      * Scans user dir first, then system dir; user files take priority.
@@ -4,6 +4,7 @@
 
 #include "semanticruleengine.h"
 #include "ruleconfigloader.h"
+#include "rulebundle.h"
 
 #include <QJsonArray>
 #include <QJsonObject>
@@ -20,6 +21,18 @@ SemanticRuleEngine::~SemanticRuleEngine() = default;
 
 bool SemanticRuleEngine::loadRules()
 {
+    // A bundle written by an earlier run avoids parsing every JSON rule file
+    const QString bundlePath = RuleBundle::bundlePath();
+    const QByteArray fingerprint = RuleBundle::sourceFingerprint();
+    QMap<QString, RuleGroup> bundledGroups;
+    QMap<QString, QString> bundledPaths;
+    if (RuleBundle::load(bundlePath, fingerprint, bundledGroups, bundledPaths)) {
+        m_groups = bundledGroups;
+        m_ruleFilePaths = bundledPaths;
+        compileGroups();
+        return true;
+    }
+
     QMap<QString, RuleGroup> newGroups;
 
     for (const QString &path : RuleConfigLoader::ruleFilePaths()) {
@@ -60,6 +73,8 @@ bool SemanticRuleEngine::loadRules()
     }
 
     m_groups = newGroups;
+    compileGroups();
+    RuleBundle::save(bundlePath, fingerprint, m_groups, m_ruleFilePaths);
 
     return true;
 }
@@ -96,25 +111,23 @@ bool SemanticRuleEngine::loadRuleFile(const QString &path)
         m_ruleFilePaths.insert(group.name, path);
     }
 
+    compileGroups();
     return true;
 }
 
 bool SemanticRuleEngine::match(const QString &group, const QString &input, QRegularExpressionMatch &outMatch,
                                 QString *outRuleId)
 {
-    if (!m_groups.contains(group)) {
+    const auto groupIt = m_groups.constFind(group);
+    const auto compiledIt = m_compiledGroups.constFind(group);
+    if (groupIt == m_groups.constEnd() || compiledIt == m_compiledGroups.constEnd()) {
         return false;
     }
 
-    const QList<Rule> &rules = m_groups.value(group).rules;
-    QList<Rule> sorted = rules;
-    std::stable_sort(sorted.begin(), sorted.end(),
-                     [](const Rule &a, const Rule &b) { return a.priority > b.priority; });
-
-    for (const Rule &rule : sorted) {
-        if (!rule.enabled || !rule.regex.isValid()) {
-            continue;
-        }
+    // Candidates are already in priority order and exclude rules whose literals are absent
+    const QList<Rule> &rules = groupIt->rules;
+    for (int index : compiledIt->candidates(input)) {
+        const Rule &rule = rules.at(index);
         QRegularExpressionMatch m = rule.regex.match(input);
         if (m.hasMatch()) {
             outMatch = m;
@@ -133,19 +146,15 @@ QList<QRegularExpressionMatch> SemanticRuleEngine::matchAll(const QString &group
 {
     QList<QRegularExpressionMatch> results;
 
-    if (!m_groups.contains(group)) {
+    const auto groupIt = m_groups.constFind(group);
+    const auto compiledIt = m_compiledGroups.constFind(group);
+    if (groupIt == m_groups.constEnd() || compiledIt == m_compiledGroups.constEnd()) {
         return results;
     }
 
-    const QList<Rule> &rules = m_groups.value(group).rules;
-    QList<Rule> sorted = rules;
-    std::stable_sort(sorted.begin(), sorted.end(),
-                     [](const Rule &a, const Rule &b) { return a.priority > b.priority; });
-
-    for (const Rule &rule : sorted) {
-        if (!rule.enabled || !rule.regex.isValid()) {
-            continue;
-        }
+    const QList<Rule> &rules = groupIt->rules;
+    for (int index : compiledIt->candidates(input)) {
+        const Rule &rule = rules.at(index);
 
         // Use globalMatch to find ALL occurrences of this rule's pattern.
         // This is important for noise rules (e.g., "和" appearing multiple times).
@@ -214,6 +223,30 @@ QStringList SemanticRuleEngine::groupNames() const
     return m_groups.keys();
 }
 
+quint64 SemanticRuleEngine::generation() const
+{
+    return m_generation;
+}
+
+void SemanticRuleEngine::compileGroups()
+{
+    ++m_generation;
+    m_compiledGroups.clear();
+    for (auto it = m_groups.cbegin(); it != m_groups.cend(); ++it) {
+        m_compiledGroups.insert(it.key(), CompiledRuleGroup(it->rules));
+        // Run PCRE2's JIT compilation now rather than on the first query
+        for (const Rule &rule : it->rules) {
+            if (rule.enabled && rule.regex.isValid())
+                rule.regex.optimize();
+        }
+    }
+}
+
+QRegularExpression SemanticRuleEngine::compileRulePattern(const QString &pattern)
+{
+    return QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption);
+}
+
 bool SemanticRuleEngine::parseRuleGroupStatic(const QJsonObject &groupObj, RuleGroup &outGroup)
 {
     if (!groupObj.contains("name") || !groupObj.contains("rules")) {
@@ -240,8 +273,7 @@ bool SemanticRuleEngine::parseRuleGroupStatic(const QJsonObject &groupObj, RuleG
             continue;
         }
 
-        rule.regex.setPattern(rule.pattern);
-        rule.regex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        rule.regex = compileRulePattern(rule.pattern);
         if (!rule.regex.isValid()) {
             qWarning() << "Invalid regex for rule" << rule.id << ":" << rule.regex.errorString();
             continue;
@@ -13,6 +13,8 @@
 
 #include <dfm-search/dsearch_global.h>
 
+#include "compiledrulegroup.h"
+
 DFM_SEARCH_BEGIN_NS
 
 struct Rule {
@@ -36,6 +38,8 @@ struct RuleGroup {
  * @brief Rule engine that loads regex rules from JSON config files.
  *
  * Provides match/matchAll operations with priority-based ordering.
+ * Groups are compiled when rules are loaded: rules are ordered by priority
+ * once, and a literal prefilter skips rules that cannot match the input.
  */
 class SemanticRuleEngine : public QObject
 {
@@ -47,6 +51,10 @@ public:
 
     /**
      * @brief Load rules from all rule files in the config directory.
+     *
+     * Uses the binary rule bundle from the user cache when it matches the
+     * current rule files (see RuleBundle), and writes a new bundle after
+     * loading from JSON.
      * @return true if at least one valid rule file was loaded.
      */
     bool loadRules();
@@ -112,16 +120,32 @@ public:
      */
     QStringList groupNames() const;
 
+    /**
+     * @brief Version of the loaded rule set.
+     *
+     * Incremented whenever loadRules() or loadRuleFile() changes the rules,
+     * so results derived from earlier rules can be discarded.
+     */
+    quint64 generation() const;
+
     /**
      * @brief Static helper to parse a rule group from JSON.
      */
     static bool parseRuleGroupStatic(const QJsonObject &groupObj, RuleGroup &outGroup);
 
+    /**
+     * @brief Compile a rule pattern with the options used for all rules.
+     */
+    static QRegularExpression compileRulePattern(const QString &pattern);
+
 private:
     bool parseRuleGroup(const QJsonObject &groupObj, RuleGroup &outGroup);
+    void compileGroups();
 
     QMap<QString, RuleGroup> m_groups;
+    QHash<QString, CompiledRuleGroup> m_compiledGroups;   // group name -> prepared for matching
     QMap<QString, QString> m_ruleFilePaths;    // group name -> resolved file path
+    quint64 m_generation = 0;
 };
 
 DFM_SEARCH_END_NS
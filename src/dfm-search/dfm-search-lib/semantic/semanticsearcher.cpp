@@ -14,7 +14,6 @@
 #include <QDebug>
 #include <QDir>
 #include <QEventLoop>
-#include <QFileInfo>
 #include <QTimer>
 #include <QVariant>
 
@@ -24,6 +23,9 @@ DFM_SEARCH_BEGIN_NS
 
 namespace {
 
+// 子引擎按块推送结果的块大小，语义搜索边收边合并
+constexpr int kEngineStreamChunkSize = 64;
+
 bool hasKeywordRuleSpan(const ParsedIntent &intent)
 {
     for (const MatchSpan &span : intent.consumedSpans()) {
@@ -166,14 +168,19 @@ void SemanticSearcherData::doSearch(const QString &naturalLanguage, const QStrin
     }
 
     excludeNamePatterns.clear();
+    excludeNameMatchers.clear();
     for (const MatchSpan &span : intent.consumedSpans()) {
         const QVariantMap meta = ruleEngine->ruleMetadataById(span.ruleId());
         const QVariant ep = meta.value("exclude_patterns");
         if (ep.userType() == QMetaType::QVariantList) {
             for (const auto &v : ep.toList()) {
                 const QString p = v.toString();
-                if (!p.isEmpty() && !excludeNamePatterns.contains(p))
+                if (!p.isEmpty() && !excludeNamePatterns.contains(p)) {
                     excludeNamePatterns.append(p);
+                    // Compiled once here instead of running QDir::match on every result.
+                    // Default options are case-insensitive, like QDir::match.
+                    excludeNameMatchers.emplace_back(SearchQuery(p, SearchQuery::Type::Wildcard), SearchOptions());
+                }
             }
         }
     }
@@ -275,8 +282,19 @@ void SemanticSearcherData::createAndLaunchEngine(
         std::function<void(const SearchError &)> onError)
 {
     SearchEngine *engine = SearchEngine::create(type, q);
-    engine->setSearchOptions(options);
 
+    // Sub-engines stream their results in chunks so they can be merged and forwarded
+    // while the slower engines are still running. The merged list is kept here, so
+    // the engines do not need to aggregate their own.
+    SearchOptions engineOptions = options;
+    if (engineOptions.streamingChunkSize() <= 0)
+        engineOptions.setStreamingChunkSize(kEngineStreamChunkSize);
+    engineOptions.setResultAggregationEnabled(false);
+    engine->setSearchOptions(engineOptions);
+
+    QObject::connect(engine, &SearchEngine::resultsFound, q, [this, engine](const SearchResultList &results) {
+        onEngineResults(engine, results);
+    });
     QObject::connect(engine, &SearchEngine::searchFinished, q, onFinished);
     QObject::connect(engine, &SearchEngine::errorOccurred, q, onError);
 
@@ -285,30 +303,66 @@ void SemanticSearcherData::createAndLaunchEngine(
     engine->search(query);
 }
 
-void SemanticSearcherData::onEngineFinished(const SearchResultList &results)
+SearchResultList SemanticSearcherData::mergeResults(const SearchResultList &results)
 {
+    SearchResultList accepted;
     for (const SearchResult &r : results) {
-        if (!excludeNamePatterns.isEmpty()) {
-            const QString fileName = QFileInfo(r.path()).fileName();
-            bool excluded = std::any_of(excludeNamePatterns.cbegin(), excludeNamePatterns.cend(),
-                                        [&fileName](const QString &pattern) {
-                                            return QDir::match(pattern, fileName);
-                                        });
-            if (excluded) continue;
-        }
-        if (!seenPaths.contains(r.path())) {
-            seenPaths.insert(r.path());
-            allResults.append(r);
-        }
+        if (maxResults > 0 && allResults.size() >= maxResults)
+            break;
+
+        const QString path = r.path();
+        if (isExcludedName(path))
+            continue;
+
+        // A single hash lookup both checks and records the path; the set shares
+        // the result's path data instead of copying it.
+        const int seenCount = seenPaths.size();
+        seenPaths.insert(path);
+        if (seenPaths.size() == seenCount)
+            continue;
+
+        allResults.append(r);
+        accepted.append(r);
+    }
+    return accepted;
+}
+
+bool SemanticSearcherData::isExcludedName(const QString &path) const
+{
+    if (excludeNameMatchers.empty())
+        return false;
+
+    const QString fileName = path.mid(path.lastIndexOf(QLatin1Char('/')) + 1);
+    return std::any_of(excludeNameMatchers.cbegin(), excludeNameMatchers.cend(),
+                       [&fileName](const FileNameMatcher &matcher) {
+                           return matcher.matchName(fileName);
+                       });
+}
+
+void SemanticSearcherData::onEngineResults(SearchEngine *engine, const SearchResultList &results)
+{
+    // Ignore chunks still queued from engines of a previous or cancelled search
+    if (cancelled.load() || !engines.contains(engine))
+        return;
+
+    const SearchResultList accepted = mergeResults(results);
+    if (!accepted.isEmpty())
+        Q_EMIT q->resultsFound(accepted);
+}
+
+void SemanticSearcherData::onEngineFinished(const SearchResultList &results)
+{
+    // Streaming engines finish with an empty list; engines that do not stream
+    // deliver everything here and are merged the same way.
+    if (!cancelled.load()) {
+        const SearchResultList accepted = mergeResults(results);
+        if (!accepted.isEmpty())
+            Q_EMIT q->resultsFound(accepted);
     }
 
     if (pendingFinishCount.fetch_sub(1) == 1) {
         timeoutTimer->stop();
 
-        if (maxResults > 0 && allResults.size() > maxResults) {
-            allResults = allResults.mid(0, maxResults);
-        }
-
         if (cancelled.load()) {
             status.store(SearchStatus::Cancelled);
             Q_EMIT q->statusChanged(SearchStatus::Cancelled);
@@ -9,12 +9,15 @@
 #include <QTimer>
 
 #include <functional>
+#include <vector>
 
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/searchengine.h>
 #include <dfm-search/searchquery.h>
 #include <dfm-search/searchoptions.h>
 
+#include "utils/filenamematcher.h"
+
 DFM_SEARCH_BEGIN_NS
 
 class SemanticRuleEngine;
@@ -62,6 +65,18 @@ public:
                                std::function<void(const SearchResultList &)> onFinished,
                                std::function<void(const SearchError &)> onError);
 
+    /**
+     * @brief Merge a batch of sub-engine results into the aggregated list.
+     *
+     * Results are filtered by the exclude name patterns and deduplicated by path
+     * as they arrive; merging stops once maxResults is reached.
+     *
+     * @return The results of this batch that were not seen before.
+     */
+    SearchResultList mergeResults(const SearchResultList &results);
+    bool isExcludedName(const QString &path) const;
+
+    void onEngineResults(SearchEngine *engine, const SearchResultList &results);
     void onEngineFinished(const SearchResultList &results);
     void onEngineError(const SearchError &error);
 
@@ -93,6 +108,7 @@ public:
     int maxResults = 0;   // 0 = unlimited
     QStringList excludedPaths;   // directories to exclude from search
     QStringList excludeNamePatterns;   // glob patterns to filter from results (e.g. *_thumb.jpg)
+    std::vector<FileNameMatcher> excludeNameMatchers;   // excludeNamePatterns compiled once per search
 };
 
 DFM_SEARCH_END_NS
@@ -6,6 +6,8 @@
 
 #include <QDateTime>
 
+#include "core/searchresultdata.h"
+
 DFM_SEARCH_BEGIN_NS
 
 // ==================== TextSearchOptionsAPI ====================
@@ -45,6 +47,26 @@ bool TextSearchOptionsAPI::isFullTextRetrievalEnabled() const
     return m_options.customOption("fullTextRetrieval").toBool();
 }
 
+void TextSearchOptionsAPI::setDeferredHighlightEnabled(bool enable)
+{
+    m_options.setCustomOption("deferredHighlight", enable);
+}
+
+bool TextSearchOptionsAPI::isDeferredHighlightEnabled() const
+{
+    return m_options.customOption("deferredHighlight").toBool();
+}
+
+void TextSearchOptionsAPI::setParallelSegmentSearchEnabled(bool enable)
+{
+    m_options.setCustomOption("parallelSegmentSearch", enable);
+}
+
+bool TextSearchOptionsAPI::isParallelSegmentSearchEnabled() const
+{
+    return m_options.customOption("parallelSegmentSearch").toBool();
+}
+
 void TextSearchOptionsAPI::setFileExtensions(const QStringList &extensions)
 {
     m_options.setCustomOption("fileExtensions", extensions);
@@ -69,22 +91,22 @@ QString TextSearchOptionsAPI::filenameKeyword() const
 
 void TextSearchResultAPI::setFileSizeBytes(qint64 bytes)
 {
-    m_result.setCustomAttribute("fileSizeBytes", bytes);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::FileSizeBytes, bytes);
 }
 
 qint64 TextSearchResultAPI::fileSizeBytes() const
 {
-    return m_result.customAttribute("fileSizeBytes").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::FileSizeBytes);
 }
 
 void TextSearchResultAPI::setCharCount(int count)
 {
-    m_result.setCustomAttribute("charCount", count);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::CharCount, count);
 }
 
 int TextSearchResultAPI::charCount() const
 {
-    return m_result.customAttribute("charCount").toInt();
+    return static_cast<int>(SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::CharCount));
 }
 
 TextSearchResultAPI::TextSearchResultAPI(SearchResult &result)
@@ -94,42 +116,52 @@ TextSearchResultAPI::TextSearchResultAPI(SearchResult &result)
 
 QString TextSearchResultAPI::highlightedContent() const
 {
-    return m_result.customAttribute("highlightedContent").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::HighlightedContent);
 }
 
 void TextSearchResultAPI::setHighlightedContent(const QString &content)
 {
-    m_result.setCustomAttribute("highlightedContent", content);
+    SearchResultData::get(m_result)->setString(ResultSlot::HighlightedContent, content);
+}
+
+bool TextSearchResultAPI::isHighlightDeferred() const
+{
+    return SearchResultData::get(std::as_const(m_result))->boolean(ResultSlot::HighlightDeferred);
+}
+
+void TextSearchResultAPI::setHighlightDeferred(bool deferred)
+{
+    SearchResultData::get(m_result)->setBool(ResultSlot::HighlightDeferred, deferred);
 }
 
 QString TextSearchResultAPI::filename() const
 {
-    return m_result.customAttribute("filename").toString();
+    return SearchResultData::get(std::as_const(m_result))->string(ResultSlot::Filename);
 }
 
 void TextSearchResultAPI::setFilename(const QString &name)
 {
-    m_result.setCustomAttribute("filename", name);
+    SearchResultData::get(m_result)->setString(ResultSlot::Filename, name);
 }
 
 bool TextSearchResultAPI::isHidden() const
 {
-    return m_result.customAttribute("isHidden").toBool();
+    return SearchResultData::get(std::as_const(m_result))->boolean(ResultSlot::IsHidden);
 }
 
 void TextSearchResultAPI::setIsHidden(bool hidden)
 {
-    m_result.setCustomAttribute("isHidden", hidden);
+    SearchResultData::get(m_result)->setBool(ResultSlot::IsHidden, hidden);
 }
 
 void TextSearchResultAPI::setModifyTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("modifyTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::ModifyTimestamp, timestamp);
 }
 
 qint64 TextSearchResultAPI::modifyTimestamp() const
 {
-    return m_result.customAttribute("modifyTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::ModifyTimestamp);
 }
 
 QString TextSearchResultAPI::modifyTimeString() const
@@ -140,12 +172,12 @@ QString TextSearchResultAPI::modifyTimeString() const
 
 void TextSearchResultAPI::setBirthTimestamp(qint64 timestamp)
 {
-    m_result.setCustomAttribute("birthTimestamp", timestamp);
+    SearchResultData::get(m_result)->setInt64(ResultSlot::BirthTimestamp, timestamp);
 }
 
 qint64 TextSearchResultAPI::birthTimestamp() const
 {
-    return m_result.customAttribute("birthTimestamp").toLongLong();
+    return SearchResultData::get(std::as_const(m_result))->int64(ResultSlot::BirthTimestamp);
 }
 
 QString TextSearchResultAPI::birthTimeString() const
@@ -16,6 +16,14 @@ CancellableCollector::CancellableCollector(std::atomic<bool> *cancelled, int32_t
     m_scoreDocs = Collection<ScoreDocPtr>::newInstance();
 }
 
+void CancellableCollector::setSort(ResultSortKey key, Qt::SortOrder order, const SortedHitQueue::Fields &fields)
+{
+    if (key == ResultSortKey::None)
+        m_sorted.reset();
+    else
+        m_sorted.emplace(key, order, m_maxDocs, fields);
+}
+
 void CancellableCollector::setScorer(const ScorerPtr &scorer)
 {
     if (m_cancelled && m_cancelled->load()) {
@@ -37,6 +45,12 @@ void CancellableCollector::collect(int32_t doc)
 
     m_totalHits++;
 
+    // 排序时必须看到全部命中才能确定前 maxDocs 个
+    if (m_sorted) {
+        m_sorted->offer(doc);
+        return;
+    }
+
     // 只收集不超过最大数量的文档
     if (m_scoreDocs.size() < m_maxDocs) {
         try {
@@ -58,7 +72,6 @@ void CancellableCollector::collect(int32_t doc)
 
 void CancellableCollector::setNextReader(const IndexReaderPtr &reader, int32_t docBase)
 {
-    Q_UNUSED(reader);
     if (m_cancelled && m_cancelled->load()) {
         // 抛出异常中断搜索过程
         throw SearchCancelledException();
@@ -66,6 +79,8 @@ void CancellableCollector::setNextReader(const IndexReaderPtr &reader, int32_t d
 
     // 设置当前段的文档基址，用于计算全局文档 ID
     m_docBase = docBase;
+    if (m_sorted)
+        m_sorted->setNextReader(reader, docBase);
 }
 
 bool CancellableCollector::acceptsDocsOutOfOrder()
@@ -77,6 +92,8 @@ bool CancellableCollector::acceptsDocsOutOfOrder()
 
 Collection<ScoreDocPtr> CancellableCollector::getScoreDocs() const
 {
+    if (m_sorted)
+        return m_sorted->sortedScoreDocs();
     return m_scoreDocs;
 }
 
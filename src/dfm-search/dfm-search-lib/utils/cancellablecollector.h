@@ -6,12 +6,15 @@
 
 #include <atomic>
 #include <exception>
+#include <optional>
 
 #include <lucene++/LuceneHeaders.h>
 #include <lucene++/Collector.h>
 
 #include <dfm-search/dsearch_global.h>
 
+#include "sortedhitqueue.h"
+
 DFM_SEARCH_BEGIN_NS
 
 /**
@@ -30,6 +33,9 @@ public:
  *
  * 继承自 Lucene::Collector，在收集文档过程中检查取消标志
  * 如果检测到取消请求，立即抛出 SearchCancelledException 中断搜索
+ *
+ * 调用 setSort() 后不再按收集顺序保留前 maxDocs 个文档，而是遍历全部命中，
+ * 在 SortedHitQueue 中保留排序最靠前的 maxDocs 个
  */
 class CancellableCollector : public Lucene::Collector
 {
@@ -42,6 +48,19 @@ public:
     CancellableCollector(std::atomic<bool> *cancelled, int32_t maxDocs);
     ~CancellableCollector() override = default;
 
+    /**
+     * @brief 按排序键保留命中，须在搜索开始前调用
+     * @param key 排序键，ResultSortKey::None 时按收集顺序
+     * @param order 排序方向
+     * @param fields 排序键所在的字段
+     */
+    void setSort(ResultSortKey key, Qt::SortOrder order, const SortedHitQueue::Fields &fields);
+
+    /**
+     * @brief 排序时保留的命中，未排序时为 nullptr
+     */
+    const SortedHitQueue *sortedHits() const { return m_sorted ? &*m_sorted : nullptr; }
+
     // Lucene::Collector 接口实现
     void setScorer(const Lucene::ScorerPtr &scorer) override;
     void collect(int32_t doc) override;
@@ -50,7 +69,7 @@ public:
 
     /**
      * @brief 获取收集到的文档列表
-     * @return 按评分排序的文档列表
+     * @return 收集顺序的文档列表，排序时为按排序键排好的文档
      */
     Lucene::Collection<Lucene::ScoreDocPtr> getScoreDocs() const;
 
@@ -67,6 +86,7 @@ private:
     int32_t m_docBase;   // 当前段的文档基址
     int32_t m_totalHits;   // 总命中数
     Lucene::ScorerPtr m_scorer;   // 评分器
+    std::optional<SortedHitQueue> m_sorted;   // 指定排序键时保留前 maxDocs 个命中
 };
 
 DFM_SEARCH_END_NS
@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "contenthighlighter.h"
+#include "keywordscanner.h"
 
 #include <QRegularExpression>
 #include <QStringList>
@@ -22,13 +23,6 @@ namespace ContentHighlighter {
 
 namespace {
 
-struct KeywordMatch
-{
-    int position;
-    int length;
-    QString keyword;
-};
-
 int positioningBeforeLength(int maxLength, int positioningMaxLength)
 {
     const int effectivePositioningLength = qMax(30, positioningMaxLength);
@@ -134,52 +128,6 @@ int findOptimalEndPosition(const QString &content, int keywordPos, int keywordLe
     return qMin(content.length(), end);
 }
 
-QString highlightKeyword(const QString &text, const QString &keyword)
-{
-    if (text.isEmpty() || keyword.isEmpty()) return text;
-    QString result = text;
-    int pos = 0;
-    const int keywordLength = keyword.length();
-    while ((pos = result.indexOf(keyword, pos, Qt::CaseInsensitive)) != -1) {
-        result.insert(pos + keywordLength, "</b>");
-        result.insert(pos, "<b>");
-        pos += keywordLength + 7;
-    }
-    return result;
-}
-
-KeywordMatch findFirstKeywordMatch(const QString &content, const QStringList &keywords)
-{
-    KeywordMatch match = { -1, 0, QString() };
-    for (const QString &keyword : keywords) {
-        int pos = content.indexOf(keyword, 0, Qt::CaseInsensitive);
-        if (pos != -1 && (match.position == -1 || pos < match.position)) {
-            match.position = pos;
-            match.length = keyword.length();
-            match.keyword = keyword;
-            break;
-        }
-    }
-    return match;
-}
-
-KeywordMatch findEarliestKeywordMatch(const QString &content, const QStringList &keywords)
-{
-    KeywordMatch match = { -1, 0, QString() };
-    for (const QString &keyword : keywords) {
-        if (keyword.isEmpty()) {
-            continue;
-        }
-
-        const int pos = content.indexOf(keyword, 0, Qt::CaseInsensitive);
-        if (pos != -1 && (match.position == -1 || pos < match.position)) {
-            match.position = pos;
-            match.length = keyword.length();
-            match.keyword = keyword;
-        }
-    }
-    return match;
-}
 }   // namespace
 
 QString customHighlight(const QStringList &keywords, const QString &content, int maxLength, bool enableHtml, int positioningMaxLength)
@@ -188,34 +136,29 @@ QString customHighlight(const QStringList &keywords, const QString &content, int
         return QString();
     }
 
-    // Ensure there's at least one non-empty keyword.
-    // findFirstKeywordMatch handles empty strings in the list, but if all are empty, it's like no keywords.
-    bool hasValidKeyword = false;
-    for (const QString &kw : keywords) {
-        if (!kw.isEmpty()) {
-            hasValidKeyword = true;
-            break;
-        }
-    }
-    if (!hasValidKeyword) {
+    // All keywords are matched in a single pass; keywords that are empty or
+    // consist of wildcards only are ignored.
+    const KeywordScanner scanner(keywords);
+    if (scanner.isEmpty()) {
         return QString();
     }
 
-    KeywordMatch match = findFirstKeywordMatch(content, keywords);
-    if (match.position == -1) {
+    const KeywordScanner::Match match = scanner.firstInKeywordOrder(content);
+    if (!match.isValid()) {
         // No keyword found in content.
         // As per problem, if no keyword, no range to show.
         // Alternative: return content.left(maxLength).simplified(); if some default text is needed.
         return QString();
     }
 
-    // If the keyword itself is longer than or equal to the final desired maxLength
+    // If the matched text itself is longer than or equal to the final desired maxLength
     if (match.length >= maxLength) {
+        const QString matchedText = content.mid(match.position, match.length);
         if (enableHtml) {
-            // Highlight the keyword itself if HTML is enabled
-            return highlightKeyword(match.keyword, match.keyword);
+            // Highlight the match itself if HTML is enabled
+            return scanner.highlight(matchedText);
         }
-        return match.keyword;   // Return the keyword as is (original behavior)
+        return matchedText;
     }
 
     // Enforce minimum of 30 for the positioning window
@@ -247,16 +190,9 @@ QString customHighlight(const QStringList &keywords, const QString &content, int
     resultSnippet = resultSnippet.simplified();
 
     if (enableHtml) {
-        // Highlight all keywords from the list that appear in the *extracted and simplified* snippet.
-        // Create a temporary string for highlighting because highlightKeyword modifies the string it's given,
-        // and we are iterating.
-        QString tempHighlightedSnippet = resultSnippet;
-        for (const QString &kwToHighlight : keywords) {
-            if (!kwToHighlight.isEmpty()) {
-                tempHighlightedSnippet = highlightKeyword(tempHighlightedSnippet, kwToHighlight);
-            }
-        }
-        resultSnippet = tempHighlightedSnippet;
+        // Highlight all keywords from the list that appear in the *extracted and simplified* snippet,
+        // building the result in one pass instead of inserting tags keyword by keyword.
+        resultSnippet = scanner.highlight(resultSnippet);
     }
 
     // 只有在段落开头被截断时才添加省略号
@@ -277,8 +213,8 @@ PlainSnippetResult plainSnippet(const QStringList &keywords, const QString &cont
         return result;
     }
 
-    const KeywordMatch match = findEarliestKeywordMatch(content, keywords);
-    if (match.position == -1) {
+    const KeywordScanner::Match match = KeywordScanner(keywords).earliest(content);
+    if (!match.isValid()) {
         return result;
     }
 
@@ -6,17 +6,22 @@
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/field_names.h>
 
+#include "core/searchexecutor.h"
 #include "utils/contenthighlighter.h"
 #include "utils/highlightoptions_p.h"
+#include "utils/indexreaderpool.h"
 #include "utils/previewoptions_p.h"
 #include "utils/previewresult_p.h"
 #include "utils/searchutility.h"
+#include "utils/termoffsethighlighter.h"
 
 #include <QDebug>
 #include <QFileInfo>
 #include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
+#include <QWaitCondition>
 
 #include <lucene++/Document.h>
 #include <lucene++/FSDirectory.h>
@@ -26,6 +31,8 @@
 #include <lucene++/Term.h>
 #include <lucene++/TermQuery.h>
 #include <lucene++/TopDocs.h>
+#include <atomic>
+#include <memory>
 #include <optional>
 
 using namespace Lucene;
@@ -34,6 +41,11 @@ DFM_SEARCH_BEGIN_NS
 
 namespace {
 
+// 异步高亮每批处理的文件数，批次较小时可见行的结果能更早送达
+constexpr int kHighlightBatchSize = 8;
+// 单个请求同时处理的批次上限，避免占满与搜索共享的执行器
+constexpr int kMaxParallelHighlightBatches = 4;
+
 const wchar_t *contentFieldName(SearchType type)
 {
     return (type == SearchType::Ocr)
@@ -83,7 +95,8 @@ QStringList splitKeywords(const QString &keyword)
 
 DocumentPtr findDocumentByPath(const SearcherPtr &searcher,
                                const QString &path,
-                               SearchType type)
+                               SearchType type,
+                               int32_t *docId = nullptr)
 {
     TermPtr term = newLucene<Term>(pathFieldName(type), path.toStdWString());
     QueryPtr query = newLucene<TermQuery>(term);
@@ -93,15 +106,58 @@ DocumentPtr findDocumentByPath(const SearcherPtr &searcher,
         return nullptr;
     }
 
+    if (docId) {
+        *docId = topDocs->scoreDocs[0]->doc;
+    }
     return searcher->doc(topDocs->scoreDocs[0]->doc);
 }
 
-struct CachedIndexContext
+QString highlightDocumentByPath(const IndexReaderPool::Lease &lease,
+                                const QString &path,
+                                SearchType type,
+                                const QStringList &keywords,
+                                const HighlightOptions &options)
+{
+    int32_t docId = -1;
+    const DocumentPtr doc = findDocumentByPath(lease.searcher(), path, type, &docId);
+    if (!doc) {
+        return {};
+    }
+
+    const String contentField = doc->get(contentFieldName(type));
+    if (contentField.empty()) {
+        return {};
+    }
+
+    // 索引存储了词偏移时只解码命中附近的文本，否则扫描全文
+    const TermOffsetHighlighter offsetHighlighter(lease.reader(), docId, contentFieldName(type), contentField);
+    if (const std::optional<QString> highlighted = offsetHighlighter.customHighlight(
+                keywords, options.maxPreviewLength(), options.enableHtml(), options.positioningMaxLength())) {
+        return *highlighted;
+    }
+
+    return ContentHighlighter::customHighlight(
+            keywords, QString::fromStdWString(contentField), options.maxPreviewLength(), options.enableHtml(),
+            options.positioningMaxLength());
+}
+
+// 批量读取时每种索引只借用一次读取器
+class BatchLeases
 {
-    QString indexDirectory;
-    FSDirectoryPtr directory;
-    IndexReaderPtr reader;
-    SearcherPtr searcher;
+public:
+    const IndexReaderPool::Lease &lease(SearchType type, const QString &indexDir)
+    {
+        const int slot = (type == SearchType::Ocr) ? 1 : 0;
+        if (!m_acquired[slot]) {
+            m_leases[slot] = IndexReaderPool::instance()->acquire(indexDir);
+            m_acquired[slot] = true;
+        }
+        return m_leases[slot];
+    }
+
+private:
+    IndexReaderPool::Lease m_leases[2];
+    bool m_acquired[2] { false, false };
 };
 
 /**
@@ -247,56 +303,117 @@ int PreviewResult::keywordOffset() const
 
 struct ContentRetriever::Private
 {
+    // 一个异步高亮请求，由处理它的各个任务共享
+    struct HighlightRequest
+    {
+        int id { -1 };
+        QString keyword;
+        SearchType type { SearchType::Content };
+        HighlightOptions options;
+        QStringList pending;   ///< 尚未开始处理的路径，按优先级排列
+        QHash<int, QRunnable *> queuedTasks;   ///< 尚未开始的任务句柄，按任务 id 索引
+        int runningTasks { 0 };   ///< 已提交但尚未结束的任务数
+        std::atomic<bool> cancelled { false };
+    };
+    using RequestPtr = std::shared_ptr<HighlightRequest>;
+
+    void submitTaskLocked(ContentRetriever *q, const RequestPtr &request);
+    void runHighlightTask(ContentRetriever *q, const RequestPtr &request, int taskId);
+    void finishTaskLocked(ContentRetriever *q, const RequestPtr &request);
+    void cancelLocked(ContentRetriever *q, const RequestPtr &request);
+
     QString contentIndexDirectory;
     QString ocrIndexDirectory;
     mutable QMutex mutex;
-    mutable QHash<int, CachedIndexContext> cacheByType;
 
-    CachedIndexContext *ensureIndexContext(SearchType type, const QString &indexDir) const
+    // 以下成员由 requestMutex 保护
+    QMutex requestMutex;
+    QWaitCondition idle;
+    QHash<int, RequestPtr> requests;
+    int nextRequestId { 0 };
+    int nextTaskId { 0 };
+    int activeTasks { 0 };   ///< 所有请求中尚未结束的任务数
+};
+
+void ContentRetriever::Private::submitTaskLocked(ContentRetriever *q, const RequestPtr &request)
+{
+    const int taskId = nextTaskId++;
+    ++request->runningTasks;
+    ++activeTasks;
+
+    // 任务开始时需要先获取 requestMutex，因此句柄一定在任务移除它之前登记
+    auto task = [this, q, request, taskId]() { runHighlightTask(q, request, taskId); };
+    request->queuedTasks.insert(taskId, SearchExecutor::instance()->submit(task, 0));
+}
+
+void ContentRetriever::Private::runHighlightTask(ContentRetriever *q, const RequestPtr &request, int taskId)
+{
     {
-        CachedIndexContext &ctx = cacheByType[static_cast<int>(type)];
-        if (ctx.searcher && ctx.reader && ctx.directory && ctx.indexDirectory == indexDir) {
-            try {
-                if (!ctx.reader->isCurrent()) {
-                    IndexReaderPtr reopened = ctx.reader->reopen(true);
-                    if (reopened != ctx.reader) {
-                        ctx.reader = reopened;
-                        ctx.searcher = newLucene<IndexSearcher>(ctx.reader);
-                    }
-                }
-                return &ctx;
-            } catch (const LuceneException &e) {
-                qWarning() << "ContentRetriever: failed to refresh index reader"
-                           << QString::fromStdWString(e.getError());
-                ctx = {};
-            } catch (const std::exception &e) {
-                qWarning() << "ContentRetriever: failed to refresh index reader" << e.what();
-                ctx = {};
+        QMutexLocker locker(&requestMutex);
+        request->queuedTasks.remove(taskId);
+    }
+
+    // 每次从队首取一批，优先级调整会影响之后取出的批次
+    forever {
+        QStringList batch;
+        {
+            QMutexLocker locker(&requestMutex);
+            if (!request->cancelled.load()) {
+                const int count = qMin(kHighlightBatchSize, request->pending.size());
+                batch = request->pending.mid(0, count);
+                request->pending.erase(request->pending.begin(), request->pending.begin() + count);
+            }
+            if (batch.isEmpty()) {
+                finishTaskLocked(q, request);
+                return;
             }
         }
 
-        try {
-            ctx.indexDirectory = indexDir;
-            ctx.directory = FSDirectory::open(indexDir.toStdWString());
-            if (!IndexReader::indexExists(ctx.directory)) {
-                ctx = {};
-                return nullptr;
-            }
+        const QMap<QString, QString> highlights = q->fetchHighlights(batch, request->keyword,
+                                                                     request->type, request->options);
+        if (request->cancelled.load())
+            continue;
 
-            ctx.reader = IndexReader::open(ctx.directory, true);
-            ctx.searcher = newLucene<IndexSearcher>(ctx.reader);
-            return &ctx;
-        } catch (const LuceneException &e) {
-            qWarning() << "ContentRetriever: failed to open index"
-                       << QString::fromStdWString(e.getError());
-        } catch (const std::exception &e) {
-            qWarning() << "ContentRetriever: failed to open index" << e.what();
-        }
+        QMetaObject::invokeMethod(
+                q, [q, request, highlights]() {
+                    // 排队期间被取消的批次不再投递
+                    if (!request->cancelled.load())
+                        emit q->highlightsReady(request->id, highlights);
+                },
+                Qt::QueuedConnection);
+    }
+}
 
-        ctx = {};
-        return nullptr;
+void ContentRetriever::Private::finishTaskLocked(ContentRetriever *q, const RequestPtr &request)
+{
+    if (--request->runningTasks == 0) {
+        requests.remove(request->id);
+        const int requestId = request->id;
+        QMetaObject::invokeMethod(
+                q, [q, requestId]() { emit q->highlightsFinished(requestId); },
+                Qt::QueuedConnection);
     }
-};
+
+    if (--activeTasks == 0)
+        idle.wakeAll();
+}
+
+void ContentRetriever::Private::cancelLocked(ContentRetriever *q, const RequestPtr &request)
+{
+    if (!request)
+        return;
+
+    request->cancelled.store(true);
+    request->pending.clear();
+
+    // 尚未开始的任务直接移出执行器队列，已开始的任务处理完当前批次后退出
+    const QList<QRunnable *> handles = request->queuedTasks.values();
+    request->queuedTasks.clear();
+    for (QRunnable *handle : handles) {
+        if (SearchExecutor::instance()->cancelPending(handle))
+            finishTaskLocked(q, request);
+    }
+}
 
 ContentRetriever::ContentRetriever(QObject *parent)
     : QObject(parent),
@@ -304,7 +421,15 @@ ContentRetriever::ContentRetriever(QObject *parent)
 {
 }
 
-ContentRetriever::~ContentRetriever() = default;
+ContentRetriever::~ContentRetriever()
+{
+    cancelAllHighlights();
+
+    // 异步任务引用了本对象，必须等它们结束后才能销毁
+    QMutexLocker locker(&d->requestMutex);
+    while (d->activeTasks > 0)
+        d->idle.wait(&d->requestMutex);
+}
 
 void ContentRetriever::setIndexDirectory(SearchType type, const QString &indexDirectory)
 {
@@ -318,11 +443,11 @@ void ContentRetriever::setIndexDirectory(SearchType type, const QString &indexDi
     } else {
         d->contentIndexDirectory = indexDirectory;
     }
-    d->cacheByType.remove(static_cast<int>(type));
 }
 
 QString ContentRetriever::indexDirectory(SearchType type) const
 {
+    QMutexLocker locker(&d->mutex);
     if (type == SearchType::Ocr) {
         return d->ocrIndexDirectory.isEmpty()
                 ? defaultIndexDirectoryForType(type)
@@ -362,22 +487,13 @@ QString ContentRetriever::fetchHighlight(const QString &path,
 
     const QString indexDir = indexDirectory(type);
 
-    QMutexLocker locker(&d->mutex);
-    CachedIndexContext *ctx = d->ensureIndexContext(type, indexDir);
-    if (!ctx || !ctx->searcher) {
+    const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(indexDir);
+    if (!lease) {
         return {};
     }
 
     try {
-        const DocumentPtr doc = findDocumentByPath(ctx->searcher, path, type);
-        const QString content = storedContentFromDocument(doc, type);
-        if (content.isEmpty()) {
-            return {};
-        }
-
-        return ContentHighlighter::customHighlight(
-                keywords, content, options.maxPreviewLength(), options.enableHtml(),
-                options.positioningMaxLength());
+        return highlightDocumentByPath(lease, path, type, keywords, options);
     } catch (const LuceneException &e) {
         qWarning() << "ContentRetriever: error fetching highlight for" << path
                    << QString::fromStdWString(e.getError());
@@ -402,7 +518,7 @@ QMap<QString, QString> ContentRetriever::fetchHighlights(const QStringList &path
     const QStringList keywords = splitKeywords(keyword);
     if (keywords.isEmpty()) return results;
 
-    QMutexLocker locker(&d->mutex);
+    BatchLeases leases;
 
     for (const QString &path : paths) {
         // For Semantic, route each path individually based on its extension
@@ -419,23 +535,14 @@ QMap<QString, QString> ContentRetriever::fetchHighlights(const QStringList &path
         }
 
         const QString indexDir = indexDirectory(effectiveType);
-        CachedIndexContext *ctx = d->ensureIndexContext(effectiveType, indexDir);
-        if (!ctx || !ctx->searcher) {
+        const IndexReaderPool::Lease &lease = leases.lease(effectiveType, indexDir);
+        if (!lease) {
             results.insert(path, {});
             continue;
         }
 
         try {
-            const DocumentPtr doc = findDocumentByPath(ctx->searcher, path, effectiveType);
-            const QString content = storedContentFromDocument(doc, effectiveType);
-            if (content.isEmpty()) {
-                results.insert(path, {});
-                continue;
-            }
-
-            results.insert(path, ContentHighlighter::customHighlight(
-                                         keywords, content, options.maxPreviewLength(), options.enableHtml(),
-                                         options.positioningMaxLength()));
+            results.insert(path, highlightDocumentByPath(lease, path, effectiveType, keywords, options));
         } catch (const LuceneException &e) {
             qWarning() << "ContentRetriever: error for" << path
                        << QString::fromStdWString(e.getError());
@@ -467,14 +574,13 @@ QString ContentRetriever::fetchContent(const QString &path, SearchType type) con
 
     const QString indexDir = indexDirectory(type);
 
-    QMutexLocker locker(&d->mutex);
-    CachedIndexContext *ctx = d->ensureIndexContext(type, indexDir);
-    if (!ctx || !ctx->searcher) {
+    const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(indexDir);
+    if (!lease) {
         return {};
     }
 
     try {
-        return storedContentFromDocument(findDocumentByPath(ctx->searcher, path, type), type);
+        return storedContentFromDocument(findDocumentByPath(lease.searcher(), path, type), type);
     } catch (const LuceneException &e) {
         qWarning() << "ContentRetriever: error fetching content for" << path
                    << QString::fromStdWString(e.getError());
@@ -494,7 +600,7 @@ QMap<QString, QString> ContentRetriever::fetchContents(const QStringList &paths,
     if (type != SearchType::Content && type != SearchType::Ocr && type != SearchType::Semantic)
         return results;
 
-    QMutexLocker locker(&d->mutex);
+    BatchLeases leases;
 
     for (const QString &path : paths) {
         SearchType effectiveType = type;
@@ -510,14 +616,14 @@ QMap<QString, QString> ContentRetriever::fetchContents(const QStringList &paths,
         }
 
         const QString indexDir = indexDirectory(effectiveType);
-        CachedIndexContext *ctx = d->ensureIndexContext(effectiveType, indexDir);
-        if (!ctx || !ctx->searcher) {
+        const IndexReaderPool::Lease &lease = leases.lease(effectiveType, indexDir);
+        if (!lease) {
             results.insert(path, {});
             continue;
         }
 
         try {
-            results.insert(path, storedContentFromDocument(findDocumentByPath(ctx->searcher, path, effectiveType), effectiveType));
+            results.insert(path, storedContentFromDocument(findDocumentByPath(lease.searcher(), path, effectiveType), effectiveType));
         } catch (const LuceneException &e) {
             qWarning() << "ContentRetriever: error for" << path
                        << QString::fromStdWString(e.getError());
@@ -557,15 +663,14 @@ PreviewResult ContentRetriever::fetchPreview(const QString &path, SearchType typ
 
     const QString indexDir = indexDirectory(type);
 
-    QMutexLocker locker(&d->mutex);
-    CachedIndexContext *ctx = d->ensureIndexContext(type, indexDir);
-    if (!ctx || !ctx->searcher) {
+    const IndexReaderPool::Lease lease = IndexReaderPool::instance()->acquire(indexDir);
+    if (!lease) {
         result.d->status = PreviewStatus::NotIndexed;
         return result;
     }
 
     try {
-        const DocumentPtr doc = findDocumentByPath(ctx->searcher, path, type);
+        const DocumentPtr doc = findDocumentByPath(lease.searcher(), path, type);
         if (!doc) {
             result.d->status = PreviewStatus::NotIndexed;
             return result;
@@ -594,4 +699,86 @@ PreviewResult ContentRetriever::fetchPreview(const QString &path, SearchType typ
     return result;
 }
 
+int ContentRetriever::requestHighlights(const QStringList &paths,
+                                        const QString &keyword,
+                                        SearchType type,
+                                        const HighlightOptions &options)
+{
+    if (paths.isEmpty() || splitKeywords(keyword).isEmpty())
+        return -1;
+
+    if (type != SearchType::Content && type != SearchType::Ocr && type != SearchType::Semantic)
+        return -1;
+
+    auto request = std::make_shared<Private::HighlightRequest>();
+    request->keyword = keyword;
+    request->type = type;
+    request->options = options;
+    request->pending = paths;
+
+    QMutexLocker locker(&d->requestMutex);
+    request->id = d->nextRequestId++;
+    d->requests.insert(request->id, request);
+
+    const int batchCount = (paths.size() + kHighlightBatchSize - 1) / kHighlightBatchSize;
+    const int taskCount = qMin(batchCount, kMaxParallelHighlightBatches);
+    for (int i = 0; i < taskCount; ++i)
+        d->submitTaskLocked(this, request);
+
+    return request->id;
+}
+
+void ContentRetriever::prioritizeHighlights(int requestId, const QStringList &paths)
+{
+    if (paths.isEmpty())
+        return;
+
+    QMutexLocker locker(&d->requestMutex);
+    const Private::RequestPtr request = d->requests.value(requestId);
+    if (!request || request->cancelled.load())
+        return;
+
+    // 一次遍历拆分队列，被提前的路径保持调用方给出的顺序
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    const QSet<QString> wanted(paths.cbegin(), paths.cend());
+#else
+    const QSet<QString> wanted = paths.toSet();
+#endif
+    QSet<QString> moved;
+    QStringList rest;
+    rest.reserve(request->pending.size());
+    for (const QString &path : std::as_const(request->pending)) {
+        if (wanted.contains(path))
+            moved.insert(path);
+        else
+            rest.append(path);
+    }
+
+    if (moved.isEmpty())
+        return;
+
+    QStringList front;
+    front.reserve(moved.size());
+    for (const QString &path : paths) {
+        if (moved.remove(path))
+            front.append(path);
+    }
+
+    request->pending = front + rest;
+}
+
+void ContentRetriever::cancelHighlights(int requestId)
+{
+    QMutexLocker locker(&d->requestMutex);
+    d->cancelLocked(this, d->requests.value(requestId));
+}
+
+void ContentRetriever::cancelAllHighlights()
+{
+    QMutexLocker locker(&d->requestMutex);
+    const QList<Private::RequestPtr> requests = d->requests.values();
+    for (const Private::RequestPtr &request : requests)
+        d->cancelLocked(this, request);
+}
+
 DFM_SEARCH_END_NS
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "filenamefieldcollector.h"
+#include "cancellablecollector.h"
+
+#include <algorithm>
+
+#include <QDebug>
+
+#include <dfm-search/field_names.h>
+
+using namespace Lucene;
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// 首批预留的命中数，超过后按需增长
+constexpr int32_t kInitialHitReserve = 4096;
+const String kEmptyString;
+}   // namespace
+
+FileNameFieldCollector::FileNameFieldCollector(std::atomic<bool> *cancelled, int32_t maxDocs, bool loadDetails,
+                                               ResultSortKey sortKey, Qt::SortOrder sortOrder)
+    : m_cancelled(cancelled), m_maxDocs(maxDocs), m_loadDetails(loadDetails)
+{
+    if (sortKey != ResultSortKey::None) {
+        m_sorted.emplace(sortKey, sortOrder, maxDocs, SortedHitQueue::fileNameIndexFields());
+        return;
+    }
+    m_hits.reserve(static_cast<size_t>(std::max(0, std::min(maxDocs, kInitialHitReserve))));
+}
+
+void FileNameFieldCollector::setScorer(const ScorerPtr &scorer)
+{
+    // 结果不按评分排序，无需评分器
+    Q_UNUSED(scorer);
+    checkCancelled();
+}
+
+void FileNameFieldCollector::collect(int32_t doc)
+{
+    checkCancelled();
+
+    // 排序时必须看到全部命中才能确定前 maxDocs 个，不能提前结束
+    if (m_sorted) {
+        ++m_totalHits;
+        m_sorted->offer(doc);
+        return;
+    }
+
+    // maxDocs <= 0 时不收集任何结果
+    if (static_cast<int32_t>(m_hits.size()) >= m_maxDocs)
+        throw CollectionFullException();
+
+    ++m_totalHits;
+    m_hits.push_back({ static_cast<int32_t>(m_segments.size()) - 1, doc });
+
+    // 已收满，无需再遍历剩余的命中文档
+    if (static_cast<int32_t>(m_hits.size()) >= m_maxDocs)
+        throw CollectionFullException();
+}
+
+void FileNameFieldCollector::setNextReader(const IndexReaderPtr &reader, int32_t docBase)
+{
+    checkCancelled();
+
+    // 每个段只取一次列数组，FieldCache 按段读取器缓存，读取器复用时不会重复加载
+    FieldCachePtr cache = FieldCache::DEFAULT();
+    Segment segment;
+    segment.paths = cache->getStrings(reader, LuceneFieldNames::FileName::kFullPath);
+
+    if (m_loadDetails) {
+        segment.types = cache->getStringIndex(reader, LuceneFieldNames::FileName::kFileType);
+        segment.exts = cache->getStringIndex(reader, LuceneFieldNames::FileName::kFileExt);
+        segment.hidden = cache->getStringIndex(reader, LuceneFieldNames::FileName::kIsHidden);
+        segment.sizeStrs = cache->getStrings(reader, LuceneFieldNames::FileName::kFileSizeStr);
+        segment.sizes = loadLongs(reader, LuceneFieldNames::FileName::kFileSize);
+        segment.modifyTimes = loadLongs(reader, LuceneFieldNames::FileName::kModifyTime);
+        segment.birthTimes = loadLongs(reader, LuceneFieldNames::FileName::kBirthTime);
+    }
+
+    m_segments.push_back(std::move(segment));
+    if (m_sorted)
+        m_sorted->setNextReader(reader, docBase);
+}
+
+bool FileNameFieldCollector::acceptsDocsOutOfOrder()
+{
+    // 不依赖文档顺序，允许乱序以获得更快的评分器
+    return true;
+}
+
+void FileNameFieldCollector::finish()
+{
+    if (!m_sorted)
+        return;
+
+    // 两者的段序号都按 setNextReader() 的调用顺序编号
+    const std::vector<SortedHitQueue::Hit> hits = m_sorted->sortedHits();
+    m_hits.clear();
+    m_hits.reserve(hits.size());
+    for (const SortedHitQueue::Hit &hit : hits)
+        m_hits.push_back({ hit.segment, hit.doc });
+}
+
+const String &FileNameFieldCollector::path(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    return m_segments[static_cast<size_t>(h.segment)].paths[h.doc];
+}
+
+const String &FileNameFieldCollector::fileType(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    return lookup(m_segments[static_cast<size_t>(h.segment)].types, h.doc);
+}
+
+const String &FileNameFieldCollector::fileExt(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    return lookup(m_segments[static_cast<size_t>(h.segment)].exts, h.doc);
+}
+
+const String &FileNameFieldCollector::fileSizeStr(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    const Segment &segment = m_segments[static_cast<size_t>(h.segment)];
+    return segment.sizeStrs ? segment.sizeStrs[h.doc] : kEmptyString;
+}
+
+bool FileNameFieldCollector::isHidden(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    const String &value = lookup(m_segments[static_cast<size_t>(h.segment)].hidden, h.doc);
+    return value == L"Y" || value == L"y";
+}
+
+int64_t FileNameFieldCollector::fileSize(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    const Segment &segment = m_segments[static_cast<size_t>(h.segment)];
+    return segment.sizes ? segment.sizes[h.doc] : -1;
+}
+
+int64_t FileNameFieldCollector::modifyTime(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    const Segment &segment = m_segments[static_cast<size_t>(h.segment)];
+    return segment.modifyTimes ? segment.modifyTimes[h.doc] : 0;
+}
+
+int64_t FileNameFieldCollector::birthTime(int32_t hit) const
+{
+    const Hit &h = m_hits[static_cast<size_t>(hit)];
+    const Segment &segment = m_segments[static_cast<size_t>(h.segment)];
+    return segment.birthTimes ? segment.birthTimes[h.doc] : 0;
+}
+
+const String &FileNameFieldCollector::lookup(const StringIndexPtr &index, int32_t doc)
+{
+    if (!index)
+        return kEmptyString;
+    return index->lookup[index->order[doc]];
+}
+
+Collection<int64_t> FileNameFieldCollector::loadLongs(const IndexReaderPtr &reader, const String &field)
+{
+    // 数值字段以 NumericField 编码索引；旧索引若不是该格式则视为不可用
+    try {
+        return FieldCache::DEFAULT()->getLongs(reader, field, FieldCache::NUMERIC_UTILS_LONG_PARSER());
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to load numeric field cache:" << QString::fromStdWString(field)
+                   << QString::fromStdWString(e.getError());
+    }
+    return Collection<int64_t>();
+}
+
+void FileNameFieldCollector::checkCancelled() const
+{
+    if (m_cancelled && m_cancelled->load(std::memory_order_relaxed)) {
+        // 抛出异常中断搜索过程
+        throw SearchCancelledException();
+    }
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef FILENAME_FIELD_COLLECTOR_H
+#define FILENAME_FIELD_COLLECTOR_H
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include <lucene++/LuceneHeaders.h>
+#include <lucene++/Collector.h>
+#include <lucene++/FieldCache.h>
+
+#include <dfm-search/dsearch_global.h>
+
+#include "sortedhitqueue.h"
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 收集数量已达上限
+ * 由 FileNameFieldCollector 抛出以提前结束搜索，调用方应视为正常结束
+ */
+class CollectionFullException : public std::exception
+{
+public:
+    CollectionFullException() = default;
+    const char *what() const noexcept override { return "Collector reached max docs"; }
+};
+
+/**
+ * @brief 基于字段缓存的文件名结果收集器
+ *
+ * 与 CancellableCollector 不同，命中时不加载 Document，也不创建 ScoreDoc：
+ * - 每个段在 setNextReader() 时取一次 FieldCache 列数组（路径、类型、
+ *   后缀、隐藏标记、大小、时间），之后按段内文档号直接索引
+ * - collect() 只记录 (段, 文档号)，不做任何堆分配
+ * - 收集到 maxDocs 条后抛出 CollectionFullException 提前结束搜索
+ * - 指定排序键时改为遍历全部命中，只在 SortedHitQueue 中保留排序最靠前的
+ *   maxDocs 条，搜索结束后调用 finish() 得到排好序的结果
+ *
+ * 字段缓存随段读取器缓存，读取器由 IndexReaderPool 复用时可跨搜索命中。
+ * 代价是 full_path 与 file_size_str 两列为段内每个文档常驻一个字符串，
+ * 即使只取少量结果也会整列加载；池在读取器刷新或失效时释放对应的缓存，
+ * 参见 IndexReaderPool。
+ * 要求路径、类型等字符串字段以 NOT_ANALYZED 方式索引，数值字段为 NumericField。
+ */
+class FileNameFieldCollector : public Lucene::Collector
+{
+public:
+    /**
+     * @param cancelled 取消标志的指针（atomic bool）
+     * @param maxDocs 最大文档数量限制
+     * @param loadDetails 是否加载详细结果所需的列
+     * @param sortKey 排序键，ResultSortKey::None 时按收集顺序
+     * @param sortOrder 排序方向
+     */
+    FileNameFieldCollector(std::atomic<bool> *cancelled, int32_t maxDocs, bool loadDetails,
+                           ResultSortKey sortKey = ResultSortKey::None,
+                           Qt::SortOrder sortOrder = Qt::AscendingOrder);
+    ~FileNameFieldCollector() override = default;
+
+    // Lucene::Collector 接口实现
+    void setScorer(const Lucene::ScorerPtr &scorer) override;
+    void collect(int32_t doc) override;
+    void setNextReader(const Lucene::IndexReaderPtr &reader, int32_t docBase) override;
+    bool acceptsDocsOutOfOrder() override;
+
+    /**
+     * @brief 搜索结束后调用，排序时将保留的命中按顺序填入结果
+     */
+    void finish();
+
+    int32_t hitCount() const { return static_cast<int32_t>(m_hits.size()); }
+    int32_t getTotalHits() const { return m_totalHits; }
+
+    // 以下访问器的 hit 为 [0, hitCount()) 内的收集序号
+    const Lucene::String &path(int32_t hit) const;
+    const Lucene::String &fileType(int32_t hit) const;
+    const Lucene::String &fileExt(int32_t hit) const;
+    const Lucene::String &fileSizeStr(int32_t hit) const;
+    bool isHidden(int32_t hit) const;
+    int64_t fileSize(int32_t hit) const;   // 字段不可用时返回 -1
+    int64_t modifyTime(int32_t hit) const;   // 字段不可用时返回 0
+    int64_t birthTime(int32_t hit) const;   // 字段不可用时返回 0
+
+private:
+    // 单个段的列数组
+    struct Segment
+    {
+        Lucene::Collection<Lucene::String> paths;
+        Lucene::Collection<Lucene::String> sizeStrs;
+        Lucene::StringIndexPtr types;
+        Lucene::StringIndexPtr exts;
+        Lucene::StringIndexPtr hidden;
+        Lucene::Collection<int64_t> sizes;
+        Lucene::Collection<int64_t> modifyTimes;
+        Lucene::Collection<int64_t> birthTimes;
+    };
+
+    struct Hit
+    {
+        int32_t segment;
+        int32_t doc;   // 段内文档号
+    };
+
+    static const Lucene::String &lookup(const Lucene::StringIndexPtr &index, int32_t doc);
+    static Lucene::Collection<int64_t> loadLongs(const Lucene::IndexReaderPtr &reader, const Lucene::String &field);
+
+    void checkCancelled() const;
+
+    std::atomic<bool> *m_cancelled;   // 取消标志指针
+    int32_t m_maxDocs;   // 最大文档数
+    bool m_loadDetails;   // 是否加载详细字段
+    int32_t m_totalHits { 0 };   // 总命中数
+
+    std::vector<Segment> m_segments;
+    std::vector<Hit> m_hits;
+    std::optional<SortedHitQueue> m_sorted;   // 指定排序键时保留前 maxDocs 个命中
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // FILENAME_FIELD_COLLECTOR_H
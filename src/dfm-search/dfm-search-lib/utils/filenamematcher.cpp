@@ -0,0 +1,348 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "filenamematcher.h"
+
+#include <dfm-search/filenamesearchapi.h>
+#include <dfm-search/timerangefilter.h>
+#include <dfm-search/sizerangefilter.h>
+
+DFM_SEARCH_BEGIN_NS
+
+FileNameMatcher::FileNameMatcher(const SearchQuery &query, const SearchOptions &options)
+    : m_caseSensitive(options.caseSensitive()),
+      m_hiddenOnly(options.hiddenOnly())
+{
+    // 扩展名过滤
+    FileNameOptionsAPI optionsApi(const_cast<SearchOptions &>(options));
+    const QStringList fileExts = optionsApi.fileExtensions();
+    for (const QString &ext : fileExts)
+        m_fileExts.insert(ext);
+
+    // 时间范围只解析一次，避免在每个条目上重复计算预设范围
+    if (options.hasTimeRangeFilter()) {
+        const TimeRangeFilter filter = options.timeRangeFilter();
+        const auto [start, end] = filter.resolveTimeRange();
+        m_hasTimeFilter = true;
+        m_useBirthTime = filter.timeField() == TimeField::BirthTime;
+        m_hasTimeStart = start.isValid();
+        m_hasTimeEnd = end.isValid();
+        m_timeStartMs = m_hasTimeStart ? start.toMSecsSinceEpoch() : 0;
+        m_timeEndMs = m_hasTimeEnd ? end.toMSecsSinceEpoch() : 0;
+        m_timeIncludeLower = filter.includeLower();
+        m_timeIncludeUpper = filter.includeUpper();
+    }
+
+    if (options.hasSizeRangeFilter()) {
+        const SizeRangeFilter filter = options.sizeRangeFilter();
+        m_hasSizeFilter = true;
+        m_minSize = filter.minSize();
+        m_maxSize = filter.maxSize();
+        m_sizeIncludeLower = filter.includeLower();
+        m_sizeIncludeUpper = filter.includeUpper();
+    }
+
+    // 如果只有过滤条件（时间/大小）没有关键词，直接匹配
+    const bool hasKeyword = !query.keyword().isEmpty() || query.type() == SearchQuery::Type::Boolean;
+    if (!hasKeyword && (m_hasTimeFilter || m_hasSizeFilter)) {
+        m_mode = Mode::MatchAll;
+        return;
+    }
+
+    switch (query.type()) {
+    case SearchQuery::Type::Simple:
+        m_mode = Mode::Simple;
+        m_needle = compileNeedle(query.keyword());
+        break;
+    case SearchQuery::Type::Wildcard:
+        m_mode = Mode::Wildcard;
+        compileGlob(query.keyword());
+        break;
+    case SearchQuery::Type::Boolean:
+        m_mode = Mode::Boolean;
+        compileBoolean(query);
+        break;
+    }
+}
+
+bool FileNameMatcher::matchName(const QString &fileName) const
+{
+    switch (m_mode) {
+    case Mode::MatchAll:
+        return true;
+    case Mode::Simple:
+        return containsNeedle(fileName, m_needle);
+    case Mode::Wildcard:
+        return matchGlob(fileName);
+    case Mode::Boolean:
+        return evalBoolean(0, fileName);
+    }
+    return false;
+}
+
+bool FileNameMatcher::matchSuffix(const QString &suffix) const
+{
+    if (m_fileExts.isEmpty())
+        return true;
+    return m_fileExts.contains(suffix.toLower());
+}
+
+bool FileNameMatcher::matchTime(qint64 msecs) const
+{
+    if (!m_hasTimeFilter)
+        return true;
+
+    // 时间不可用时视为早于任何有效时间，与无效 QDateTime 的比较结果一致
+    if (msecs < 0)
+        return !m_hasTimeStart;
+
+    if (m_hasTimeStart && (m_timeIncludeLower ? msecs < m_timeStartMs : msecs <= m_timeStartMs))
+        return false;
+    if (m_hasTimeEnd && (m_timeIncludeUpper ? msecs > m_timeEndMs : msecs >= m_timeEndMs))
+        return false;
+    return true;
+}
+
+bool FileNameMatcher::matchSize(qint64 size) const
+{
+    if (!m_hasSizeFilter)
+        return true;
+
+    if (m_minSize > 0 && (m_sizeIncludeLower ? size < m_minSize : size <= m_minSize))
+        return false;
+    if (m_maxSize > 0 && (m_sizeIncludeUpper ? size > m_maxSize : size >= m_maxSize))
+        return false;
+    return true;
+}
+
+char16_t FileNameMatcher::fold(char16_t c) const
+{
+    if (m_caseSensitive)
+        return c;
+    if (c < 0x80)
+        return (c >= u'A' && c <= u'Z') ? char16_t(c + 32) : c;
+    return char16_t(QChar::toCaseFolded(uint(c)));
+}
+
+FileNameMatcher::Needle FileNameMatcher::compileNeedle(const QString &keyword) const
+{
+    Needle needle;
+    needle.text = keyword;
+    if (m_caseSensitive || keyword.isEmpty()) {
+        needle.caseless = true;
+        return needle;
+    }
+
+    for (QChar &ch : needle.text)
+        ch = QChar(fold(ch.unicode()));
+
+    // 没有大小写之分的首字符（中文、数字、符号等）不会由其他字符折叠而来，
+    // 可以直接用 QString::indexOf(QChar) 的向量化实现定位候选位置。
+    // 按大小写映射判断而不是按字符类别：Ⓐ（So）、Ⅰ（Nl）等也有大小写之分
+    const char16_t first = needle.text.at(0).unicode();
+    needle.caseless = QChar::toUpper(uint(first)) == first
+            && QChar::toLower(uint(first)) == first
+            && QChar::toTitleCase(uint(first)) == first;
+    return needle;
+}
+
+bool FileNameMatcher::containsNeedle(const QString &haystack, const Needle &needle) const
+{
+    const int needleSize = needle.text.size();
+    if (needleSize == 0)
+        return true;
+    if (m_caseSensitive)
+        return haystack.contains(needle.text, Qt::CaseSensitive);
+
+    const int last = haystack.size() - needleSize;
+    if (last < 0)
+        return false;
+
+    const QChar *hay = haystack.constData();
+    const QChar *text = needle.text.constData();
+    const char16_t first = text[0].unicode();
+
+    for (int i = 0; i <= last; ++i) {
+        if (needle.caseless) {
+            i = haystack.indexOf(text[0], i, Qt::CaseSensitive);
+            if (i < 0 || i > last)
+                return false;
+        } else if (fold(hay[i].unicode()) != first) {
+            continue;
+        }
+
+        int j = 1;
+        while (j < needleSize && fold(hay[i + j].unicode()) == text[j].unicode())
+            ++j;
+        if (j == needleSize)
+            return true;
+    }
+
+    return false;
+}
+
+void FileNameMatcher::compileGlob(const QString &pattern)
+{
+    const int size = pattern.size();
+    for (int i = 0; i < size; ++i) {
+        const char16_t c = pattern.at(i).unicode();
+        GlobToken token;
+
+        if (c == u'*') {
+            // 连续的 * 等价于一个
+            if (!m_glob.isEmpty() && m_glob.last().op == GlobOp::AnyString)
+                continue;
+            token.op = GlobOp::AnyString;
+        } else if (c == u'?') {
+            token.op = GlobOp::AnyChar;
+        } else if (c == u'[') {
+            // 解析字符集，未闭合的 [ 按普通字符处理
+            int j = i + 1;
+            if (j < size && (pattern.at(j) == QLatin1Char('!') || pattern.at(j) == QLatin1Char('^'))) {
+                token.negate = true;
+                ++j;
+            }
+            // 紧跟在 [ 或 [! 后的 ] 是普通字符
+            const int setStart = j;
+            while (j < size && (pattern.at(j) != QLatin1Char(']') || j == setStart))
+                ++j;
+
+            if (j >= size) {
+                token = GlobToken();
+                token.ch = fold(c);
+            } else {
+                token.op = GlobOp::CharSet;
+                for (int k = setStart; k < j; ++k) {
+                    const char16_t lo = pattern.at(k).unicode();
+                    if (k + 2 < j && pattern.at(k + 1) == QLatin1Char('-')) {
+                        token.ranges.append({ lo, pattern.at(k + 2).unicode() });
+                        k += 2;
+                    } else {
+                        token.ranges.append({ lo, lo });
+                    }
+                }
+                i = j;
+            }
+        } else {
+            token.ch = fold(c);
+        }
+
+        m_glob.append(token);
+    }
+}
+
+bool FileNameMatcher::matchGlobSet(const GlobToken &token, char16_t c) const
+{
+    auto inRanges = [&token](char16_t value) {
+        for (const auto &range : token.ranges) {
+            if (value >= range.first && value <= range.second)
+                return true;
+        }
+        return false;
+    };
+
+    bool hit = inRanges(c);
+    if (!hit && !m_caseSensitive) {
+        const QChar ch(c);
+        hit = inRanges(ch.toLower().unicode()) || inRanges(ch.toUpper().unicode());
+    }
+    return hit != token.negate;
+}
+
+bool FileNameMatcher::matchGlob(const QString &name) const
+{
+    // 经典的回溯到最近一个 * 的线性匹配，整个文件名须完全匹配
+    const int tokenCount = m_glob.size();
+    const int nameSize = name.size();
+    const GlobToken *tokens = m_glob.constData();
+    const QChar *chars = name.constData();
+
+    int t = 0;
+    int n = 0;
+    int starToken = -1;
+    int starPos = 0;
+
+    while (n < nameSize) {
+        if (t < tokenCount) {
+            const GlobToken &token = tokens[t];
+            bool hit = false;
+            switch (token.op) {
+            case GlobOp::Literal:
+                hit = fold(chars[n].unicode()) == token.ch;
+                break;
+            case GlobOp::AnyChar:
+                hit = true;
+                break;
+            case GlobOp::CharSet:
+                hit = matchGlobSet(token, chars[n].unicode());
+                break;
+            case GlobOp::AnyString:
+                starToken = t++;
+                starPos = n;
+                continue;
+            }
+
+            if (hit) {
+                ++t;
+                ++n;
+                continue;
+            }
+        }
+
+        if (starToken < 0)
+            return false;
+
+        // 让最近的 * 多吞一个字符后重试
+        t = starToken + 1;
+        n = ++starPos;
+    }
+
+    while (t < tokenCount && tokens[t].op == GlobOp::AnyString)
+        ++t;
+    return t == tokenCount;
+}
+
+void FileNameMatcher::compileBoolean(const SearchQuery &query)
+{
+    const int index = m_boolProgram.size();
+    m_boolProgram.append(BoolNode());
+
+    const QList<SearchQuery> subQueries = query.subQueries();
+    if (subQueries.isEmpty()) {
+        // 没有子查询时按普通关键字匹配
+        m_boolProgram[index].kind = BoolNode::Leaf;
+        m_boolProgram[index].needle = m_boolNeedles.size();
+        m_boolNeedles.append(compileNeedle(query.keyword()));
+    } else {
+        m_boolProgram[index].kind = query.booleanOperator() == SearchQuery::BooleanOperator::AND
+                ? BoolNode::And
+                : BoolNode::Or;
+        for (const SearchQuery &subQuery : subQueries)
+            compileBoolean(subQuery);
+    }
+
+    m_boolProgram[index].end = m_boolProgram.size();
+}
+
+bool FileNameMatcher::evalBoolean(int index, const QString &name) const
+{
+    const BoolNode *program = m_boolProgram.constData();
+    const BoolNode &node = program[index];
+
+    if (node.kind == BoolNode::Leaf)
+        return containsNeedle(name, m_boolNeedles.at(node.needle));
+
+    // 子节点按先序连续存放，下一个兄弟节点位于当前子树的 end
+    const bool isAnd = node.kind == BoolNode::And;
+    for (int child = index + 1; child < node.end; child = program[child].end) {
+        const bool subMatch = evalBoolean(child, name);
+        if (isAnd && !subMatch)
+            return false;
+        if (!isAnd && subMatch)
+            return true;
+    }
+
+    return isAnd;
+}
+
+DFM_SEARCH_END_NS
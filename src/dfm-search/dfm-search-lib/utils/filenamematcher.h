@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef FILENAMEMATCHER_H
+#define FILENAMEMATCHER_H
+
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <dfm-search/dsearch_global.h>
+#include <dfm-search/searchquery.h>
+#include <dfm-search/searchoptions.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 预编译的文件名匹配器
+ *
+ * 每次搜索只编译一次 SearchQuery 与过滤条件，之后可在多个线程中并发复用：
+ * - 简单查询：预先做大小写折叠的关键字，按首字符定位候选后逐字比较
+ * - 通配符查询：编译为 token 序列，由手写的 glob 自动机匹配，无需构造正则
+ * - 布尔查询：展平为先序数组，按子树区间求值，不再递归拷贝 SearchQuery
+ * - 后缀、时间、大小过滤：一次性解析为集合和毫秒/字节边界
+ *
+ * 匹配时不分配内存（后缀过滤除外），所有成员函数都是 const 且线程安全。
+ */
+class FileNameMatcher
+{
+public:
+    FileNameMatcher(const SearchQuery &query, const SearchOptions &options);
+
+    /**
+     * @brief 文件名是否满足关键词条件（不涉及元数据）
+     */
+    bool matchName(const QString &fileName) const;
+
+    /**
+     * @brief 后缀是否满足扩展名过滤，未设置过滤时总是返回 true
+     */
+    bool matchSuffix(const QString &suffix) const;
+
+    bool hasSuffixFilter() const { return !m_fileExts.isEmpty(); }
+    bool hasTimeFilter() const { return m_hasTimeFilter; }
+    bool hasSizeFilter() const { return m_hasSizeFilter; }
+    bool hiddenOnly() const { return m_hiddenOnly; }
+
+    /**
+     * @brief 时间过滤使用创建时间还是修改时间
+     */
+    bool useBirthTime() const { return m_useBirthTime; }
+
+    /**
+     * @brief 检查毫秒时间戳是否落在时间范围内
+     * @param msecs 文件时间，< 0 表示该时间不可用
+     */
+    bool matchTime(qint64 msecs) const;
+
+    /**
+     * @brief 检查文件大小是否落在大小范围内
+     */
+    bool matchSize(qint64 size) const;
+
+private:
+    // 预先折叠大小写的子串
+    struct Needle
+    {
+        QString text;   // 不区分大小写时已折叠
+        bool caseless { false };   // 首字符没有大小写变体，可直接用 SIMD 的 indexOf 定位
+    };
+
+    enum class GlobOp : quint8 {
+        Literal,
+        AnyChar,   // ?
+        AnyString,   // *
+        CharSet   // [...] / [!...]
+    };
+
+    struct GlobToken
+    {
+        GlobOp op { GlobOp::Literal };
+        char16_t ch { 0 };
+        bool negate { false };
+        QVector<QPair<char16_t, char16_t>> ranges;
+    };
+
+    // 布尔查询的展平节点，子节点紧随父节点存放，end 为子树结束位置
+    struct BoolNode
+    {
+        enum Kind : quint8 { Leaf, And, Or } kind { Leaf };
+        int needle { -1 };
+        int end { 0 };
+    };
+
+    Needle compileNeedle(const QString &keyword) const;
+    void compileGlob(const QString &pattern);
+    void compileBoolean(const SearchQuery &query);
+
+    bool containsNeedle(const QString &haystack, const Needle &needle) const;
+    bool matchGlob(const QString &name) const;
+    bool matchGlobSet(const GlobToken &token, char16_t c) const;
+    bool evalBoolean(int index, const QString &name) const;
+
+    char16_t fold(char16_t c) const;
+
+    enum class Mode : quint8 {
+        MatchAll,
+        Simple,
+        Wildcard,
+        Boolean
+    };
+
+    Mode m_mode { Mode::MatchAll };
+    bool m_caseSensitive { false };
+
+    Needle m_needle;
+    QVector<GlobToken> m_glob;
+    QVector<Needle> m_boolNeedles;
+    QVector<BoolNode> m_boolProgram;
+
+    QSet<QString> m_fileExts;
+
+    bool m_hasTimeFilter { false };
+    bool m_useBirthTime { false };
+    bool m_hasTimeStart { false };
+    bool m_hasTimeEnd { false };
+    bool m_timeIncludeLower { true };
+    bool m_timeIncludeUpper { true };
+    qint64 m_timeStartMs { 0 };
+    qint64 m_timeEndMs { 0 };
+
+    bool m_hasSizeFilter { false };
+    bool m_sizeIncludeLower { true };
+    bool m_sizeIncludeUpper { true };
+    qint64 m_minSize { 0 };
+    qint64 m_maxSize { 0 };
+
+    bool m_hiddenOnly { false };
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // FILENAMEMATCHER_H
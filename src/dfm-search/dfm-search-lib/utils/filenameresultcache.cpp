@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "filenameresultcache.h"
+
+#include <QMutexLocker>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// 条目数上限，覆盖一次连续输入的所有前缀
+constexpr int kMaxEntries = 16;
+// 所有条目的结果总数上限，超过时淘汰最久未用的条目
+constexpr int kMaxTotalResults = 200000;
+
+// 关键词是否出现在路径的文件名部分
+// 不区分大小写时与索引一致：关键词已小写，文件名小写后再按子串匹配
+bool fileNameContains(const QString &path, const QString &keyword, Qt::CaseSensitivity cs)
+{
+    const int nameStart = path.lastIndexOf(QLatin1Char('/')) + 1;
+    if (cs == Qt::CaseSensitive)
+        return path.indexOf(keyword, nameStart) >= 0;
+    return path.mid(nameStart).toLower().contains(keyword);
+}
+}   // namespace
+
+FileNameResultCache *FileNameResultCache::instance()
+{
+    static FileNameResultCache cache;
+    return &cache;
+}
+
+bool FileNameResultCache::isRefinableKeyword(const QString &keyword)
+{
+    if (keyword.isEmpty())
+        return false;
+
+    for (const QChar ch : keyword) {
+        if (ch.isSpace())
+            return false;
+        if (ch.unicode() < 0x80)
+            continue;
+        if (ch.isSurrogate() || ch.toLower() != ch || ch.toUpper() != ch || ch.toCaseFolded() != ch)
+            return false;
+    }
+    return true;
+}
+
+bool FileNameResultCache::lookup(const Key &key, int maxResults, SearchResultList *results)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // 完全相同的查询：完整结果，或截断结果但数量足够
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (!sameQuery(it->key, key) || it->key.keyword != key.keyword)
+            continue;
+        if (!it->complete && (maxResults <= 0 || it->results.size() < maxResults))
+            break;
+
+        m_entries.splice(m_entries.begin(), m_entries, it);
+        *results = truncated(m_entries.front().results, maxResults);
+        return true;
+    }
+
+    if (!key.refinable)
+        return false;
+
+    // 细化：选关键词最长（超集最小）的完整条目
+    const Qt::CaseSensitivity cs = key.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    auto best = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (!it->complete || !it->key.refinable || !sameQuery(it->key, key))
+            continue;
+        if (!key.keyword.contains(it->key.keyword, cs))
+            continue;
+        if (best == m_entries.end() || it->key.keyword.size() > best->key.keyword.size())
+            best = it;
+    }
+    if (best == m_entries.end())
+        return false;
+
+    Entry refined;
+    refined.key = key;
+    refined.complete = true;
+    for (const SearchResult &result : best->results) {
+        if (fileNameContains(result.path(), key.keyword, cs))
+            refined.results.append(result);
+    }
+
+    *results = truncated(refined.results, maxResults);
+    insertLocked(std::move(refined));
+    return true;
+}
+
+void FileNameResultCache::insert(const Key &key, const SearchResultList &results, bool complete)
+{
+    if (results.size() > kMaxTotalResults)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    insertLocked({ key, results, complete });
+}
+
+void FileNameResultCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_totalResults = 0;
+}
+
+int FileNameResultCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_entries.size());
+}
+
+void FileNameResultCache::insertLocked(Entry entry)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        const bool sameScope = it->key.scope == entry.key.scope;
+        // 同一查询的旧条目，以及索引版本已过期的条目
+        if (sameScope && (it->key.generation != entry.key.generation || it->key.keyword == entry.key.keyword)) {
+            m_totalResults -= it->results.size();
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_totalResults += entry.results.size();
+    m_entries.push_front(std::move(entry));
+    evictLocked();
+}
+
+void FileNameResultCache::evictLocked()
+{
+    // 至少保留刚插入的条目
+    while (m_entries.size() > 1
+           && (m_entries.size() > kMaxEntries || m_totalResults > kMaxTotalResults)) {
+        m_totalResults -= m_entries.back().results.size();
+        m_entries.pop_back();
+    }
+}
+
+bool FileNameResultCache::sameQuery(const Key &a, const Key &b)
+{
+    return a.generation == b.generation && a.caseSensitive == b.caseSensitive && a.scope == b.scope;
+}
+
+SearchResultList FileNameResultCache::truncated(const SearchResultList &results, int maxResults)
+{
+    if (maxResults <= 0 || results.size() <= maxResults)
+        return results;
+    return results.mid(0, maxResults);
+}
+
+DFM_SEARCH_END_NS
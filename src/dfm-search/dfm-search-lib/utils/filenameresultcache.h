@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef FILENAMERESULTCACHE_H
+#define FILENAMERESULTCACHE_H
+
+#include <list>
+
+#include <QMutex>
+
+#include <dfm-search/dsearch_global.h>
+#include <dfm-search/searchresult.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 文件名索引搜索的查询结果缓存（进程级 LRU）
+ *
+ * 边输入边搜索时会连续发出 "r"、"re"、"rep"、"repo" 等查询。对简单包含查询，
+ * 较长关键词的命中一定是较短关键词命中的子集，因此可以在内存中过滤已缓存的
+ * 超集，而不必再次查询索引。
+ *
+ * 条目按 Key 区分：scope 包含除关键词外所有影响结果的条件（索引目录、查询类型、
+ * 文件类型/后缀、路径、隐藏文件等选项），generation 为索引版本，索引更新后旧条目
+ * 自然失效。
+ */
+class FileNameResultCache
+{
+public:
+    struct Key
+    {
+        QString scope;   // 除关键词外影响结果的全部条件
+        QString keyword;   // 规范化后的关键词（不区分大小写时为小写）
+        qint64 generation { 0 };   // 索引版本
+        bool refinable { false };   // 简单包含查询，可由更短关键词的结果过滤得到
+        bool caseSensitive { false };
+    };
+
+    static FileNameResultCache *instance();
+
+    /**
+     * @brief 关键词能否用内存过滤代替 file_name 字段上的 n-gram 查询
+     *
+     * 细化时把文件名小写后按子串过滤，只有关键词在分词后一定是小写化的
+     * 相邻 n-gram 时两者才一致：不含空白（分词器会裁剪首尾空白），
+     * 且每个字符是 ASCII 或没有大小写之分（如中日韩文字），避免大小写
+     * 映射在索引与内存过滤之间出现差异。
+     */
+    static bool isRefinableKeyword(const QString &keyword);
+
+    /**
+     * @brief 查找缓存结果
+     *
+     * 先找完全相同的查询；没有时，对可细化的查询寻找关键词是其子串的已完整缓存条目，
+     * 在内存中按文件名过滤，过滤结果也会加入缓存。
+     *
+     * @param key 查询键
+     * @param maxResults 最大结果数，<= 0 表示不限制
+     * @param results 命中时输出结果
+     * @return 是否命中
+     */
+    bool lookup(const Key &key, int maxResults, SearchResultList *results);
+
+    /**
+     * @brief 缓存一次索引查询的结果
+     * @param complete 结果是否完整（未因 maxResults 截断），只有完整结果可用于细化
+     */
+    void insert(const Key &key, const SearchResultList &results, bool complete);
+
+    void clear();
+    int size() const;
+
+private:
+    FileNameResultCache() = default;
+    Q_DISABLE_COPY(FileNameResultCache)
+
+    struct Entry
+    {
+        Key key;
+        SearchResultList results;
+        bool complete { false };
+    };
+    using EntryList = std::list<Entry>;
+
+    void insertLocked(Entry entry);
+    void evictLocked();
+    static bool sameQuery(const Key &a, const Key &b);
+    static SearchResultList truncated(const SearchResultList &results, int maxResults);
+
+    mutable QMutex m_mutex;
+    EntryList m_entries;   // 最近使用的在前
+    int m_totalResults { 0 };
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // FILENAMERESULTCACHE_H
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "indexreaderpool.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSet>
+
+#include <lucene++/FieldCache.h>
+
+using namespace Lucene;
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+// 读取器的段列表；单段索引打开的就是段读取器本身
+Collection<IndexReaderPtr> segmentReaders(const IndexReaderPtr &reader)
+{
+    Collection<IndexReaderPtr> segments = reader->getSequentialSubReaders();
+    if (!segments) {
+        segments = Collection<IndexReaderPtr>::newInstance();
+        segments.add(reader);
+    }
+    return segments;
+}
+
+}   // namespace
+
+//--------------------------------------------------------------------
+// IndexReaderPool::Lease 实现
+//--------------------------------------------------------------------
+
+IndexReaderPool::Lease::Lease(const IndexReaderPtr &reader, const IndexSearcherPtr &searcher)
+    : m_reader(reader),
+      m_searcher(searcher)
+{
+}
+
+IndexReaderPool::Lease::~Lease()
+{
+    release();
+}
+
+IndexReaderPool::Lease::Lease(Lease &&other) noexcept
+    : m_reader(std::move(other.m_reader)),
+      m_searcher(std::move(other.m_searcher))
+{
+    other.m_reader.reset();
+    other.m_searcher.reset();
+}
+
+IndexReaderPool::Lease &IndexReaderPool::Lease::operator=(Lease &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_reader = std::move(other.m_reader);
+        m_searcher = std::move(other.m_searcher);
+        other.m_reader.reset();
+        other.m_searcher.reset();
+    }
+    return *this;
+}
+
+void IndexReaderPool::Lease::release()
+{
+    if (!m_reader)
+        return;
+
+    // 归还借用时增加的引用，若池已换用新读取器，最后一次归还会关闭旧读取器
+    try {
+        m_reader->decRef();
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to release index reader:" << QString::fromStdWString(e.getError());
+    }
+
+    m_searcher.reset();
+    m_reader.reset();
+}
+
+//--------------------------------------------------------------------
+// IndexReaderPool 实现
+//--------------------------------------------------------------------
+
+IndexReaderPool *IndexReaderPool::instance()
+{
+    static IndexReaderPool pool;
+    return &pool;
+}
+
+IndexReaderPool::Lease IndexReaderPool::acquire(const QString &indexDir)
+{
+    if (indexDir.isEmpty())
+        return {};
+
+    std::shared_ptr<Entry> entry = entryFor(indexDir);
+    QMutexLocker locker(&entry->mutex);
+
+    if (entry->reader) {
+        try {
+            refreshEntry(*entry);
+        } catch (const LuceneException &e) {
+            // 索引被删除或重建时 reopen 可能失败，丢弃后重新打开
+            qWarning() << "Failed to refresh index reader:" << indexDir << QString::fromStdWString(e.getError());
+            resetEntry(*entry);
+        } catch (const std::exception &e) {
+            qWarning() << "Failed to refresh index reader:" << indexDir << e.what();
+            resetEntry(*entry);
+        }
+    }
+
+    if (!entry->reader && !openEntry(*entry, indexDir))
+        return {};
+
+    entry->reader->incRef();
+    return Lease(entry->reader, entry->searcher);
+}
+
+void IndexReaderPool::invalidate(const QString &indexDir)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        QMutexLocker locker(&m_mutex);
+        entry = m_entries.take(indexDir);
+    }
+
+    if (entry) {
+        QMutexLocker locker(&entry->mutex);
+        resetEntry(*entry);
+    }
+}
+
+std::shared_ptr<IndexReaderPool::Entry> IndexReaderPool::entryFor(const QString &indexDir)
+{
+    QMutexLocker locker(&m_mutex);
+    std::shared_ptr<Entry> &entry = m_entries[indexDir];
+    if (!entry)
+        entry = std::make_shared<Entry>();
+    return entry;
+}
+
+bool IndexReaderPool::openEntry(Entry &entry, const QString &indexDir)
+{
+    try {
+        entry.directory = FSDirectory::open(indexDir.toStdWString());
+        if (!IndexReader::indexExists(entry.directory)) {
+            entry.directory.reset();
+            return false;
+        }
+
+        entry.reader = IndexReader::open(entry.directory, true);
+        entry.searcher = newLucene<IndexSearcher>(entry.reader);
+        return true;
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to open index reader:" << indexDir << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        qWarning() << "Failed to open index reader:" << indexDir << e.what();
+    }
+
+    resetEntry(entry);
+    return false;
+}
+
+void IndexReaderPool::refreshEntry(Entry &entry)
+{
+    if (entry.reader->isCurrent())
+        return;
+
+    IndexReaderPtr reopened = entry.reader->reopen(true);
+    if (reopened == entry.reader)
+        return;
+
+    // 先切换到新读取器，再释放池对旧读取器的引用
+    IndexReaderPtr previous = entry.reader;
+    entry.reader = reopened;
+    entry.searcher = newLucene<IndexSearcher>(reopened);
+    purgeFieldCache(previous, reopened);
+    previous->decRef();
+}
+
+void IndexReaderPool::resetEntry(Entry &entry)
+{
+    if (entry.reader) {
+        try {
+            purgeFieldCache(entry.reader, IndexReaderPtr());
+            entry.reader->decRef();
+        } catch (const LuceneException &e) {
+            qWarning() << "Failed to close index reader:" << QString::fromStdWString(e.getError());
+        }
+    }
+
+    entry.searcher.reset();
+    entry.reader.reset();
+    entry.directory.reset();
+}
+
+void IndexReaderPool::purgeFieldCache(const IndexReaderPtr &previous, const IndexReaderPtr &current)
+{
+    try {
+        // 未变化的段及只新增了删除标记的段与新读取器共用缓存键，保留其字段缓存
+        QSet<LuceneObject *> liveKeys;
+        if (current) {
+            for (const IndexReaderPtr &segment : segmentReaders(current))
+                liveKeys.insert(segment->getFieldCacheKey().get());
+        }
+
+        // FieldCache 只弱引用读取器，不主动清除时列数组要等下次访问缓存才会释放
+        FieldCachePtr cache = FieldCache::DEFAULT();
+        for (const IndexReaderPtr &segment : segmentReaders(previous)) {
+            if (!liveKeys.contains(segment->getFieldCacheKey().get()))
+                cache->purge(segment);
+        }
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to purge field cache:" << QString::fromStdWString(e.getError());
+    }
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef INDEXREADERPOOL_H
+#define INDEXREADERPOOL_H
+
+#include <memory>
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 进程级的 Lucene 读取器池
+ *
+ * 按索引目录缓存 FSDirectory / IndexReader / IndexSearcher，供文件名、
+ * 全文、OCR 搜索策略以及 ContentRetriever 共享。每次借用时用 isCurrent()
+ * 检查索引是否变化，变化时通过 reopen(true) 增量刷新（只加载新段）。
+ *
+ * 读取器使用 Lucene 自身的引用计数：池持有当前读取器的一个引用，每次借用
+ * 再增加一个。刷新后旧读取器只释放池的引用，仍在使用它的搜索结束归还后
+ * 才会真正关闭，因此刷新不会影响正在进行的搜索。
+ *
+ * 内存开销：FileNameFieldCollector 通过 FieldCache 为每个段常驻整列数组，
+ * 其中 full_path 与 file_size_str 每个文档各保留一个字符串，约为索引中
+ * 全部路径的总长（宽字符）。这些列随池中读取器一起存活，刷新时释放已
+ * 被替换的段的缓存，invalidate() 或重新打开时释放整个读取器的缓存。
+ */
+class IndexReaderPool
+{
+public:
+    /**
+     * @brief 一次借用，析构时归还读取器引用
+     *
+     * 只能移动不能复制，借用期间读取器和搜索器保持打开。
+     */
+    class Lease
+    {
+    public:
+        Lease() = default;
+        ~Lease();
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        explicit operator bool() const { return m_reader.get() != nullptr; }
+
+        const Lucene::IndexReaderPtr &reader() const { return m_reader; }
+        const Lucene::IndexSearcherPtr &searcher() const { return m_searcher; }
+
+    private:
+        friend class IndexReaderPool;
+        Lease(const Lucene::IndexReaderPtr &reader, const Lucene::IndexSearcherPtr &searcher);
+        void release();
+
+        Lucene::IndexReaderPtr m_reader;
+        Lucene::IndexSearcherPtr m_searcher;
+    };
+
+    static IndexReaderPool *instance();
+
+    /**
+     * @brief 借用指定索引目录的读取器
+     * @return 索引不存在或打开失败时返回无效的借用
+     */
+    Lease acquire(const QString &indexDir);
+
+    /**
+     * @brief 丢弃指定目录的缓存，下次借用时重新打开
+     */
+    void invalidate(const QString &indexDir);
+
+private:
+    IndexReaderPool() = default;
+    Q_DISABLE_COPY(IndexReaderPool)
+
+    struct Entry
+    {
+        QMutex mutex;   // 只串行化同一目录的打开与刷新
+        Lucene::FSDirectoryPtr directory;
+        Lucene::IndexReaderPtr reader;
+        Lucene::IndexSearcherPtr searcher;
+    };
+
+    std::shared_ptr<Entry> entryFor(const QString &indexDir);
+    static bool openEntry(Entry &entry, const QString &indexDir);
+    static void refreshEntry(Entry &entry);
+    static void resetEntry(Entry &entry);
+    static void purgeFieldCache(const Lucene::IndexReaderPtr &previous, const Lucene::IndexReaderPtr &current);
+
+    QMutex m_mutex;
+    QHash<QString, std::shared_ptr<Entry>> m_entries;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // INDEXREADERPOOL_H
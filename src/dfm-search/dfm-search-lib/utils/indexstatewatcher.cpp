@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexstatewatcher.h"
+#include "searchutility.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTimer>
+
+#include <lucene++/LuceneHeaders.h>
+#include <lucene++/FSDirectory.h>
+
+DFM_SEARCH_BEGIN_NS
+using namespace Lucene;
+
+namespace {
+// 索引更新通常连续写入多个文件，合并后再读取
+constexpr int kRecheckDelayMs = 200;
+
+bool luceneIndexExists(const QString &indexDir)
+{
+    if (!QFileInfo(indexDir).isDir())
+        return false;
+
+    try {
+        return IndexReader::indexExists(FSDirectory::open(indexDir.toStdWString()));
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to check index existence:" << QString::fromStdWString(e.getError());
+        return false;
+    }
+}
+
+// 目录不存在时返回最近的已存在上级目录
+QString nearestExistingPath(const QString &path)
+{
+    QDir dir(path);
+    while (!dir.exists()) {
+        if (!dir.cdUp())
+            return QString();
+    }
+    return dir.absolutePath();
+}
+}   // namespace
+
+IndexStateWatcher *IndexStateWatcher::instance()
+{
+    static IndexStateWatcher *watcher = new IndexStateWatcher(Global::fileNameIndexDirectory(),
+                                                              Global::contentIndexDirectory(),
+                                                              Global::ocrTextIndexDirectory());
+    return watcher;
+}
+
+IndexStateWatcher::IndexStateWatcher(const QString &fileNameIndexDir, const QString &contentIndexDir,
+                                     const QString &ocrTextIndexDir, QObject *parent)
+    : QObject(parent)
+{
+    m_entries[static_cast<int>(Index::FileName)] = { fileNameIndexDir, QStringLiteral("status.json") };
+    m_entries[static_cast<int>(Index::Content)] = { contentIndexDir, QStringLiteral("index_status.json") };
+    m_entries[static_cast<int>(Index::OcrText)] = { ocrTextIndexDir, QStringLiteral("index_status.json") };
+
+    // 变更通知在主线程接收；首次调用可能来自搜索线程
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app)
+        return;
+
+    if (thread() != app->thread()) {
+        moveToThread(app->thread());
+        QMetaObject::invokeMethod(this, "startWatching", Qt::QueuedConnection);
+    } else {
+        startWatching();
+    }
+}
+
+void IndexStateWatcher::startWatching()
+{
+    m_recheckTimer = new QTimer(this);
+    m_recheckTimer->setSingleShot(true);
+    m_recheckTimer->setInterval(kRecheckDelayMs);
+    connect(m_recheckTimer, &QTimer::timeout, this, &IndexStateWatcher::recheck);
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &IndexStateWatcher::onPathChanged);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &IndexStateWatcher::onPathChanged);
+
+    // 先建立监视再读取，避免错过两者之间的变化
+    updateWatchedPaths();
+    {
+        QMutexLocker locker(&m_mutex);
+        for (Entry &entry : m_entries) {
+            entry.state = readState(entry.indexDir, entry.statusFile);
+            entry.valid = true;
+            entry.reported = entry.state;
+        }
+    }
+    m_watching.store(true);
+}
+
+void IndexStateWatcher::onPathChanged(const QString &path)
+{
+    Q_UNUSED(path)
+
+    // 变化到重新读取之间的查询直接读取磁盘，不返回旧状态
+    {
+        QMutexLocker locker(&m_mutex);
+        for (Entry &entry : m_entries)
+            entry.valid = false;
+    }
+    m_recheckTimer->start();
+}
+
+void IndexStateWatcher::recheck()
+{
+    // 状态文件被替换写入后监视会失效；索引目录创建后改为直接监视
+    updateWatchedPaths();
+
+    QList<Index> changed;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (int i = 0; i < kIndexCount; ++i) {
+            Entry &entry = m_entries[i];
+            entry.state = readState(entry.indexDir, entry.statusFile);
+            entry.valid = true;
+            if (entry.state != entry.reported) {
+                entry.reported = entry.state;
+                changed.append(static_cast<Index>(i));
+            }
+        }
+    }
+
+    for (Index index : std::as_const(changed))
+        Q_EMIT indexStateChanged(index);
+}
+
+void IndexStateWatcher::updateWatchedPaths()
+{
+    QSet<QString> wanted;
+    for (const Entry &entry : m_entries) {
+        const QString dir = nearestExistingPath(entry.indexDir);
+        if (!dir.isEmpty())
+            wanted.insert(dir);
+
+        const QString statusPath = QDir(entry.indexDir).filePath(entry.statusFile);
+        if (QFileInfo::exists(statusPath))
+            wanted.insert(statusPath);
+    }
+
+    const QStringList watched = m_watcher->files() + m_watcher->directories();
+    for (const QString &path : watched) {
+        if (!wanted.contains(path))
+            m_watcher->removePath(path);
+    }
+    for (const QString &path : std::as_const(wanted)) {
+        if (!watched.contains(path))
+            m_watcher->addPath(path);
+    }
+}
+
+IndexState IndexStateWatcher::state(Index index)
+{
+    QMutexLocker locker(&m_mutex);
+    Entry &entry = m_entries[static_cast<int>(index)];
+    if (!entry.valid || !m_watching.load()) {
+        entry.state = readState(entry.indexDir, entry.statusFile);
+        entry.valid = true;
+    }
+    return entry.state;
+}
+
+void IndexStateWatcher::invalidate(Index index)
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries[static_cast<int>(index)].valid = false;
+}
+
+IndexState IndexStateWatcher::readState(const QString &indexDir, const QString &statusFile)
+{
+    IndexState state;
+    state.exists = luceneIndexExists(indexDir);
+
+    const QString statusPath = QDir(indexDir).filePath(statusFile);
+    QFile file(statusPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Index status file not readable:" << statusPath;
+        return state;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "Failed to parse index status JSON:" << statusPath << parseError.errorString();
+        return state;
+    }
+
+    const QJsonObject obj = doc.object();
+    const QJsonValue status = obj.value("status");
+    if (status.isString())
+        state.status = status.toString().toLower();
+
+    state.lastUpdateTime = obj.value("lastUpdateTime").toString();
+
+    // 版本号可能是数字或字符串
+    if (obj.contains("version")) {
+        const QJsonValue versionValue = obj.value("version");
+        state.version = versionValue.isDouble() ? versionValue.toInt() : versionValue.toString().toInt();
+    }
+
+    return state;
+}
+
+DFM_SEARCH_END_NS
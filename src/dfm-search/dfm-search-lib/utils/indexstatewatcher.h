@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef INDEXSTATEWATCHER_H
+#define INDEXSTATEWATCHER_H
+
+#include <atomic>
+#include <optional>
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include <dfm-search/dsearch_global.h>
+
+QT_BEGIN_NAMESPACE
+class QFileSystemWatcher;
+class QTimer;
+QT_END_NAMESPACE
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 索引的当前状态
+ */
+struct IndexState
+{
+    bool exists = false;   // Lucene 索引在目录中存在
+    std::optional<QString> status;   // 状态文件中的 status 字段（小写），文件名索引使用
+    QString lastUpdateTime;   // 状态文件中的 lastUpdateTime 字段，全文与 OCR 索引使用
+    int version = -1;   // 状态文件中的 version 字段，读取失败时为 -1
+
+    bool operator==(const IndexState &other) const
+    {
+        return exists == other.exists && status == other.status
+                && lastUpdateTime == other.lastUpdateTime && version == other.version;
+    }
+    bool operator!=(const IndexState &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 进程级的索引状态缓存
+ *
+ * 缓存文件名、全文、OCR 三个索引的存在性、状态与版本。原先每次就绪检查都
+ * 打开 Lucene 目录并解析状态 JSON，语义搜索的每次查询都要付出这部分文件 I/O。
+ *
+ * 索引目录与状态文件通过 QFileSystemWatcher（Linux 上基于 inotify）监视，
+ * 目录尚未创建时监视最近的已存在上级目录。收到变化后短暂合并，再重新读取
+ * 状态，状态不同时发出 indexStateChanged()。查询只读取缓存。
+ *
+ * 变更通知需要在主线程的事件循环中接收；没有 QCoreApplication 时无法得知
+ * 变化，此时每次查询都重新读取，行为与不缓存时相同。
+ */
+class IndexStateWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Index {
+        FileName,
+        Content,
+        OcrText
+    };
+    Q_ENUM(Index)
+
+    static IndexStateWatcher *instance();
+
+    /**
+     * @brief 监视指定目录中的索引，instance() 使用默认索引目录
+     */
+    IndexStateWatcher(const QString &fileNameIndexDir, const QString &contentIndexDir,
+                      const QString &ocrTextIndexDir, QObject *parent = nullptr);
+
+    /**
+     * @brief 索引的当前状态，缓存无效时同步读取
+     */
+    IndexState state(Index index);
+
+    /**
+     * @brief 丢弃缓存，下次查询时重新读取
+     */
+    void invalidate(Index index);
+
+    /**
+     * @brief 读取索引状态（不使用缓存）
+     * @param indexDir   索引目录
+     * @param statusFile 状态文件名
+     */
+    static IndexState readState(const QString &indexDir, const QString &statusFile);
+
+Q_SIGNALS:
+    /**
+     * @brief 监视到索引状态变化
+     */
+    void indexStateChanged(DFMSEARCH::IndexStateWatcher::Index index);
+
+private Q_SLOTS:
+    void startWatching();
+    void onPathChanged(const QString &path);
+    void recheck();
+
+private:
+    static constexpr int kIndexCount = 3;
+
+    struct Entry
+    {
+        QString indexDir;
+        QString statusFile;
+        IndexState state;
+        bool valid = false;   // state 与磁盘一致
+        IndexState reported;   // 最近一次通知时的状态，用于判断是否发出信号
+    };
+
+    void updateWatchedPaths();
+
+    QMutex m_mutex;
+    Entry m_entries[kIndexCount];
+    std::atomic<bool> m_watching { false };
+    QFileSystemWatcher *m_watcher = nullptr;
+    QTimer *m_recheckTimer = nullptr;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // INDEXSTATEWATCHER_H
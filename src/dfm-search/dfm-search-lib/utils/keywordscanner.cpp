@@ -0,0 +1,353 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "keywordscanner.h"
+
+#include <algorithm>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+// '*' 最多匹配的字符数，限制每次命中后校验通配部分的范围
+constexpr int kMaxStarSpan = 256;
+
+inline ushort fold(ushort ch)
+{
+    return static_cast<ushort>(QChar::toCaseFolded(ch));
+}
+
+inline bool isWildcard(QChar ch)
+{
+    return ch == QLatin1Char('*') || ch == QLatin1Char('?');
+}
+
+// 校验命中后的通配部分。'*' 之后剩余部分能否从 k 开始匹配只取决于 k，
+// 因此为每个 '*' 记录已确认失败的连续区间：同一个 '*' 从区间内的位置再次尝试时
+// 直接从区间末尾继续，每个位置只校验一次，代价与窗口长度和通配部分长度成正比，
+// 而不是随 '*' 的个数指数增长
+class TailMatcher
+{
+public:
+    TailMatcher(const QString &text, const QString &tail)
+        : m_text(text), m_tail(tail)
+    {
+    }
+
+    // 从 pos 开始匹配通配部分，返回匹配结束位置，不匹配时返回 -1
+    int match(int pos, int index)
+    {
+        const int size = m_text.size();
+        while (index < m_tail.size()) {
+            const QChar c = m_tail.at(index);
+            if (c == QLatin1Char('*'))
+                return matchStar(pos, index);
+
+            if (pos >= size)
+                return -1;
+            if (c != QLatin1Char('?') && fold(m_text.at(pos).unicode()) != c.unicode())
+                return -1;
+            ++pos;
+            ++index;
+        }
+        return pos;
+    }
+
+private:
+    // [from, to] 内的位置都无法匹配 '*' 之后的部分；newline 表示 to 处是换行
+    struct Failed
+    {
+        int from = -1;
+        int to = -1;
+        bool newline = false;
+    };
+
+    int matchStar(int pos, int index)
+    {
+        if (m_failed.isEmpty())
+            m_failed.resize(m_tail.size());
+        Failed &failed = m_failed[index];
+
+        int k = pos;
+        if (failed.from >= 0 && pos >= failed.from && pos <= failed.to) {
+            if (failed.newline)
+                return -1;
+            k = failed.to + 1;
+        } else if (failed.from < 0 || pos != failed.to + 1 || failed.newline) {
+            failed = Failed { pos, pos - 1, false };
+        }
+
+        // 取最短匹配，且不跨行
+        const int size = m_text.size();
+        const int limit = qMin(size, pos + kMaxStarSpan);
+        for (; k <= limit; ++k) {
+            const int end = match(k, index + 1);
+            if (end >= 0)
+                return end;
+            failed.to = k;
+            if (k < size && m_text.at(k) == QLatin1Char('\n')) {
+                failed.newline = true;
+                break;
+            }
+        }
+        return -1;
+    }
+
+    const QString &m_text;
+    const QString &m_tail;
+    QVector<Failed> m_failed;   ///< 按 '*' 在通配部分中的下标
+};
+
+}   // namespace
+
+KeywordScanner::KeywordScanner(const QStringList &keywords)
+    : m_keywordCount(keywords.size())
+{
+    m_nodes.append(Node());
+
+    for (int k = 0; k < keywords.size(); ++k) {
+        QString folded = keywords.at(k);
+        for (QChar &ch : folded)
+            ch = QChar(fold(ch.unicode()));
+
+        Pattern pattern;
+        pattern.keyword = k;
+
+        // 第一段普通文本之前的 '*' 取最短匹配，相当于不存在
+        int i = 0;
+        while (i < folded.size() && isWildcard(folded.at(i))) {
+            if (folded.at(i) == QLatin1Char('?'))
+                ++pattern.leadingAny;
+            ++i;
+        }
+
+        const int anchorStart = i;
+        while (i < folded.size() && !isWildcard(folded.at(i)))
+            ++i;
+        pattern.anchorLength = i - anchorStart;
+        if (pattern.anchorLength == 0)
+            continue;
+
+        pattern.tail = folded.mid(i);
+        while (pattern.tail.endsWith(QLatin1Char('*')))
+            pattern.tail.chop(1);
+
+        int node = 0;
+        for (int j = anchorStart; j < i; ++j) {
+            const ushort ch = folded.at(j).unicode();
+            int target = child(node, ch);
+            if (target < 0) {
+                target = m_nodes.size();
+                m_nodes.append(Node());
+                QVector<QPair<ushort, int>> &edges = m_nodes[node].edges;
+                auto it = std::lower_bound(edges.begin(), edges.end(), ch,
+                                           [](const QPair<ushort, int> &edge, ushort c) { return edge.first < c; });
+                edges.insert(it, qMakePair(ch, target));
+            }
+            node = target;
+        }
+        m_nodes[node].outputs.append(m_patterns.size());
+
+        const ushort first = folded.at(anchorStart).unicode();
+        if (first < 128) {
+            m_asciiFirst[first >> 6] |= quint64(1) << (first & 63);
+        } else {
+            auto it = std::lower_bound(m_firstChars.begin(), m_firstChars.end(), first);
+            if (it == m_firstChars.end() || *it != first)
+                m_firstChars.insert(it, first);
+        }
+
+        m_maxLeadSpan = qMax(m_maxLeadSpan, pattern.anchorLength + pattern.leadingAny);
+        m_patterns.append(pattern);
+    }
+
+    // 按层次建立失败链接，并把失败链上的输出合并到每个节点
+    QVector<int> queue;
+    for (const auto &edge : std::as_const(m_nodes[0].edges))
+        queue.append(edge.second);
+
+    for (int head = 0; head < queue.size(); ++head) {
+        const int node = queue.at(head);
+        const QVector<QPair<ushort, int>> edges = m_nodes.at(node).edges;
+        for (const auto &edge : edges) {
+            int fail = m_nodes.at(node).fail;
+            int target = child(fail, edge.first);
+            while (target < 0 && fail != 0) {
+                fail = m_nodes.at(fail).fail;
+                target = child(fail, edge.first);
+            }
+
+            Node &childNode = m_nodes[edge.second];
+            childNode.fail = (target >= 0 && target != edge.second) ? target : 0;
+            childNode.outputs += m_nodes.at(childNode.fail).outputs;
+            queue.append(edge.second);
+        }
+    }
+}
+
+template<typename Visitor>
+void KeywordScanner::scan(const QString &text, int &limit, Visitor visit) const
+{
+    const QChar *data = text.constData();
+    int node = 0;
+    for (int i = 0; i < limit; ++i) {
+        ushort ch = fold(data[i].unicode());
+        if (node == 0) {
+            // 位于根节点时跳过不可能开始匹配的字符
+            while (!isFirstChar(ch)) {
+                if (++i >= limit)
+                    return;
+                ch = fold(data[i].unicode());
+            }
+        }
+
+        node = next(node, ch);
+        for (int index : m_nodes.at(node).outputs) {
+            const Pattern &pattern = m_patterns.at(index);
+            const int start = i + 1 - pattern.anchorLength - pattern.leadingAny;
+            if (start < 0)
+                continue;
+
+            const int end = pattern.tail.isEmpty() ? i + 1 : TailMatcher(text, pattern.tail).match(i + 1, 0);
+            if (end < 0)
+                continue;
+
+            visit(Match { start, end - start, pattern.keyword });
+        }
+    }
+}
+
+bool KeywordScanner::isEmpty() const
+{
+    return m_patterns.isEmpty();
+}
+
+KeywordScanner::Match KeywordScanner::firstInKeywordOrder(const QString &text) const
+{
+    Match best;
+    if (isEmpty())
+        return best;
+
+    // 每个关键词第一次命中即为它最早的匹配；列表中最靠前的可用关键词命中后即可结束
+    const int firstKeyword = m_patterns.first().keyword;
+    int limit = text.size();
+    scan(text, limit, [&](const Match &match) {
+        if (!best.isValid() || match.keyword < best.keyword) {
+            best = match;
+            if (best.keyword == firstKeyword)
+                limit = 0;
+        }
+    });
+    return best;
+}
+
+KeywordScanner::Match KeywordScanner::earliest(const QString &text) const
+{
+    Match best;
+    if (isEmpty())
+        return best;
+
+    int limit = text.size();
+    scan(text, limit, [&](const Match &match) {
+        if (!best.isValid() || match.position < best.position
+            || (match.position == best.position && match.keyword < best.keyword)) {
+            best = match;
+            // 之后的命中起点都会晚于当前最早匹配
+            limit = qMin(limit, best.position + m_maxLeadSpan);
+        }
+    });
+    return best;
+}
+
+QVector<KeywordScanner::Match> KeywordScanner::matches(const QString &text) const
+{
+    QVector<Match> candidates;
+    if (isEmpty())
+        return candidates;
+
+    int limit = text.size();
+    scan(text, limit, [&](const Match &match) {
+        candidates.append(match);
+    });
+
+    std::sort(candidates.begin(), candidates.end(), [](const Match &a, const Match &b) {
+        if (a.position != b.position)
+            return a.position < b.position;
+        return a.length > b.length;
+    });
+
+    QVector<Match> result;
+    int end = 0;
+    for (const Match &match : std::as_const(candidates)) {
+        if (match.position >= end && match.length > 0) {
+            result.append(match);
+            end = match.position + match.length;
+        }
+    }
+    return result;
+}
+
+QBitArray KeywordScanner::presence(const QString &text) const
+{
+    QBitArray found(m_keywordCount);
+    if (isEmpty())
+        return found;
+
+    int remaining = m_patterns.size();
+    int limit = text.size();
+    scan(text, limit, [&](const Match &match) {
+        if (found.testBit(match.keyword))
+            return;
+        found.setBit(match.keyword);
+        if (--remaining == 0)
+            limit = 0;
+    });
+    return found;
+}
+
+QString KeywordScanner::highlight(const QString &text, const QString &openTag, const QString &closeTag) const
+{
+    const QVector<Match> found = matches(text);
+    if (found.isEmpty())
+        return text;
+
+    QString result;
+    result.reserve(text.size() + found.size() * (openTag.size() + closeTag.size()));
+    int last = 0;
+    for (const Match &match : found) {
+        result.append(text.constData() + last, match.position - last);
+        result.append(openTag);
+        result.append(text.constData() + match.position, match.length);
+        result.append(closeTag);
+        last = match.position + match.length;
+    }
+    result.append(text.constData() + last, text.size() - last);
+    return result;
+}
+
+int KeywordScanner::next(int node, ushort ch) const
+{
+    int target = child(node, ch);
+    while (target < 0 && node != 0) {
+        node = m_nodes.at(node).fail;
+        target = child(node, ch);
+    }
+    return target < 0 ? 0 : target;
+}
+
+int KeywordScanner::child(int node, ushort ch) const
+{
+    const QVector<QPair<ushort, int>> &edges = m_nodes.at(node).edges;
+    auto it = std::lower_bound(edges.cbegin(), edges.cend(), ch,
+                               [](const QPair<ushort, int> &edge, ushort c) { return edge.first < c; });
+    return (it != edges.cend() && it->first == ch) ? it->second : -1;
+}
+
+bool KeywordScanner::isFirstChar(ushort ch) const
+{
+    if (ch < 128)
+        return m_asciiFirst[ch >> 6] & (quint64(1) << (ch & 63));
+    return std::binary_search(m_firstChars.cbegin(), m_firstChars.cend(), ch);
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef KEYWORDSCANNER_H
+#define KEYWORDSCANNER_H
+
+#include <QBitArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 大小写无关的多关键词单遍扫描器
+ *
+ * 所有关键词编译为一个 Aho-Corasick 自动机，文本（UTF-16）只扫描一遍即可得到
+ * 每个关键词的匹配，不再按关键词逐个 indexOf。比较前对两侧都做大小写折叠。
+ *
+ * 关键词支持通配符：'?' 匹配任意单个字符，'*' 匹配任意长度的字符（不跨行，
+ * 取最短匹配）。自动机只索引关键词中的第一段普通文本，通配部分在命中后校验。
+ * 只由通配符组成的关键词被忽略。
+ */
+class KeywordScanner
+{
+public:
+    struct Match
+    {
+        int position = -1;
+        int length = 0;
+        int keyword = -1;   ///< 关键词在构造列表中的下标
+
+        bool isValid() const { return position >= 0; }
+    };
+
+    explicit KeywordScanner(const QStringList &keywords);
+
+    /**
+     * @brief 没有任何可用关键词
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief 按关键词列表顺序，返回第一个在文本中出现的关键词的首次匹配
+     */
+    Match firstInKeywordOrder(const QString &text) const;
+
+    /**
+     * @brief 返回所有关键词中起始位置最早的匹配，起始位置相同时取列表中靠前的关键词
+     */
+    Match earliest(const QString &text) const;
+
+    /**
+     * @brief 返回所有不重叠的匹配，从左到右，同一起点取最长者
+     */
+    QVector<Match> matches(const QString &text) const;
+
+    /**
+     * @brief 返回每个关键词是否在文本中出现，下标与构造列表一致
+     *
+     * 所有可用关键词都已出现时提前结束扫描
+     */
+    QBitArray presence(const QString &text) const;
+
+    /**
+     * @brief 为所有不重叠的匹配加上标记，结果在一次线性拼接中生成
+     */
+    QString highlight(const QString &text,
+                      const QString &openTag = QStringLiteral("<b>"),
+                      const QString &closeTag = QStringLiteral("</b>")) const;
+
+private:
+    struct Pattern
+    {
+        int keyword = -1;
+        int anchorLength = 0;   ///< 自动机中第一段普通文本的长度
+        int leadingAny = 0;   ///< 第一段普通文本之前 '?' 的个数
+        QString tail;   ///< 第一段普通文本之后的剩余部分（已折叠，含通配符）
+    };
+
+    struct Node
+    {
+        QVector<QPair<ushort, int>> edges;   ///< 按字符有序
+        QVector<int> outputs;   ///< 在此结束的模式，包括失败链上的
+        int fail = 0;
+    };
+
+    // 扫描 [0, limit) 范围，visit 可以通过缩小 limit 提前结束
+    template<typename Visitor>
+    void scan(const QString &text, int &limit, Visitor visit) const;
+
+    int next(int node, ushort ch) const;
+    int child(int node, ushort ch) const;
+    bool isFirstChar(ushort ch) const;
+
+    QVector<Pattern> m_patterns;
+    QVector<Node> m_nodes;
+    QVector<ushort> m_firstChars;   ///< 非 ASCII 的首字符，有序
+    quint64 m_asciiFirst[2] { 0, 0 };   ///< ASCII 首字符位图
+    int m_maxLeadSpan = 0;   ///< 命中位置到匹配起点的最大距离
+    int m_keywordCount = 0;   ///< 构造列表的长度，包括被忽略的关键词
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // KEYWORDSCANNER_H
@@ -148,6 +148,20 @@ Lucene::QueryPtr buildMultiPathPrefixQuery(const QStringList &paths, const QStri
     return hasValid ? boolQuery : nullptr;
 }
 
+qint64 storedFieldsSize(const Lucene::DocumentPtr &doc)
+{
+    if (!doc)
+        return 0;
+
+    // Only the lengths are read: scanning large contents values to get their
+    // exact UTF-8 size would cost as much as the highlighting that avoids it
+    qint64 size = 0;
+    const Lucene::Collection<Lucene::FieldablePtr> fields = doc->getFields();
+    for (const Lucene::FieldablePtr &field : fields)
+        size += field->isBinary() ? field->getBinaryLength() : static_cast<qint64>(field->stringValue().size());
+    return size;
+}
+
 }   // namespace LuceneQueryUtils
 
 DFM_SEARCH_END_NS
@@ -66,6 +66,18 @@ Lucene::QueryPtr buildPathPrefixQuery(const QString &pathPrefix, const QString &
  */
 Lucene::QueryPtr buildMultiPathPrefixQuery(const QStringList &paths, const QString &fieldName);
 
+/**
+ * @brief Compute the size of the stored field values loaded into a document
+ *
+ * String values are counted in characters, which equals their stored size
+ * for ASCII text; binary values are counted in bytes. The cost does not
+ * depend on the size of the values.
+ *
+ * @param doc The loaded document
+ * @return Size of the values, 0 for a null document
+ */
+qint64 storedFieldsSize(const Lucene::DocumentPtr &doc);
+
 }   // namespace LuceneQueryUtils
 
 DFM_SEARCH_END_NS
@@ -0,0 +1,497 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "paralleldirwalker.h"
+#include "core/searchexecutor.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <QFile>
+#include <QThread>
+#include <QDebug>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+// getdents64 返回的原始记录布局（glibc 2.30 之前没有导出该结构体）
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+constexpr int kDirentBufferSize = 32 * 1024;
+constexpr int kDefaultBatchSize = 200;
+constexpr int kIdleSpinRounds = 64;   // 空闲时先让出若干次 CPU，再短暂休眠
+constexpr unsigned long kIdleSleepUs = 200;
+constexpr unsigned long kOutboxWaitMs = 100;
+// 每个工作者在待投递队列中平均可以积压的批次数
+constexpr int kOutboxBatchesPerWorker = 2;
+// 辅助工作任务在共享执行器中的优先级，与搜索任务的默认优先级相同
+constexpr int kHelperPriority = 0;
+}   // namespace
+
+//--------------------------------------------------------------------
+// DirEntry 实现
+//--------------------------------------------------------------------
+
+DirEntry::DirEntry(int dirFd, const QString &dirPath, const char *rawName, unsigned char type,
+                   std::atomic<int> *statCounter)
+    : m_dirFd(dirFd),
+      m_dirPath(dirPath),
+      m_rawName(rawName),
+      m_fileName(QFile::decodeName(rawName)),
+      m_type(type),
+      m_statCounter(statCounter)
+{
+}
+
+QString DirEntry::filePath() const
+{
+    if (m_dirPath.endsWith(QLatin1Char('/')))
+        return m_dirPath + m_fileName;
+    return m_dirPath + QLatin1Char('/') + m_fileName;
+}
+
+QString DirEntry::suffix() const
+{
+    // 与 QFileInfo::suffix() 一致：隐藏文件开头的点不视为后缀分隔符
+    const int lastDot = m_fileName.lastIndexOf(QLatin1Char('.'));
+    if (lastDot <= 0)
+        return QString();
+    return m_fileName.mid(lastDot + 1);
+}
+
+bool DirEntry::isDir() const
+{
+    // 文件系统未填 d_type 时先用一次 lstat 确定类型，结果缓存在条目中
+    if (m_type == DT_UNKNOWN)
+        resolveType();
+    if (m_type == DT_DIR)
+        return true;
+    if (m_type == DT_LNK)
+        return ensureStat() && m_targetIsDir;
+    return false;
+}
+
+bool DirEntry::isFile() const
+{
+    if (m_type == DT_UNKNOWN)
+        resolveType();
+    if (m_type == DT_REG)
+        return true;
+    if (m_type == DT_LNK)
+        return ensureStat() && m_targetIsFile;
+    return false;
+}
+
+bool DirEntry::isSymLink() const
+{
+    if (m_type == DT_UNKNOWN)
+        resolveType();
+    return m_type == DT_LNK;
+}
+
+qint64 DirEntry::size() const
+{
+    return ensureStat() ? m_size : 0;
+}
+
+qint64 DirEntry::lastModifiedMSecs() const
+{
+    return ensureStat() ? m_mtimeMs : 0;
+}
+
+qint64 DirEntry::birthTimeMSecs() const
+{
+    return ensureStat() ? m_btimeMs : -1;
+}
+
+bool DirEntry::resolveType() const
+{
+    if (m_type == DT_UNKNOWN) {
+        // 部分文件系统（如某些网络/FUSE 文件系统）不填 d_type，需要 lstat 一次
+        struct stat st;
+        m_statCounter->fetch_add(1);
+        if (::fstatat(m_dirFd, m_rawName, &st, AT_SYMLINK_NOFOLLOW) != 0)
+            return false;
+        if (S_ISDIR(st.st_mode))
+            m_type = DT_DIR;
+        else if (S_ISREG(st.st_mode))
+            m_type = DT_REG;
+        else if (S_ISLNK(st.st_mode))
+            m_type = DT_LNK;
+        else
+            return false;
+    }
+
+    switch (m_type) {
+    case DT_DIR:
+    case DT_REG:
+        return true;
+    case DT_LNK:
+        // 与 QDir::Files | QDir::Dirs 一致：失效链接及指向特殊文件的链接不出现在结果中
+        return ensureStat() && (m_targetIsDir || m_targetIsFile);
+    default:
+        // 设备、管道、套接字等对应 QDir::System，不参与搜索
+        return false;
+    }
+}
+
+bool DirEntry::ensureStat() const
+{
+    if (m_statDone)
+        return m_statOk;
+
+    m_statDone = true;
+    m_statCounter->fetch_add(1);
+
+#ifdef STATX_BTIME
+    struct statx stx;
+    if (::statx(m_dirFd, m_rawName, AT_STATX_SYNC_AS_STAT,
+                STATX_TYPE | STATX_SIZE | STATX_MTIME | STATX_BTIME, &stx)
+        != 0) {
+        return false;
+    }
+
+    m_targetIsDir = S_ISDIR(stx.stx_mode);
+    m_targetIsFile = S_ISREG(stx.stx_mode);
+    m_size = static_cast<qint64>(stx.stx_size);
+    m_mtimeMs = static_cast<qint64>(stx.stx_mtime.tv_sec) * 1000 + stx.stx_mtime.tv_nsec / 1000000;
+    if (stx.stx_mask & STATX_BTIME)
+        m_btimeMs = static_cast<qint64>(stx.stx_btime.tv_sec) * 1000 + stx.stx_btime.tv_nsec / 1000000;
+#else
+    struct stat st;
+    if (::fstatat(m_dirFd, m_rawName, &st, 0) != 0)
+        return false;
+
+    m_targetIsDir = S_ISDIR(st.st_mode);
+    m_targetIsFile = S_ISREG(st.st_mode);
+    m_size = static_cast<qint64>(st.st_size);
+    m_mtimeMs = static_cast<qint64>(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+#endif
+
+    m_statOk = true;
+    return true;
+}
+
+//--------------------------------------------------------------------
+// ParallelDirWalker 实现
+//--------------------------------------------------------------------
+
+ParallelDirWalker::ParallelDirWalker(int threadCount, std::atomic<bool> *cancelled)
+    : m_threadCount(threadCount > 0 ? threadCount : qMax(1, QThread::idealThreadCount())),
+      m_batchSize(kDefaultBatchSize),
+      m_outboxCapacity(m_threadCount * kOutboxBatchesPerWorker),
+      m_cancelled(cancelled)
+{
+}
+
+ParallelDirWalker::~ParallelDirWalker() = default;
+
+void ParallelDirWalker::setExcludedPaths(const QStringList &paths)
+{
+    m_excluded = PathMatcher(paths);
+}
+
+void ParallelDirWalker::setIncludeHidden(bool include)
+{
+    m_includeHidden = include;
+}
+
+void ParallelDirWalker::setBatchSize(int size)
+{
+    m_batchSize = qMax(1, size);
+}
+
+void ParallelDirWalker::setOutboxCapacity(int batches)
+{
+    m_outboxCapacity = qMax(1, batches);
+}
+
+int ParallelDirWalker::queuedBatches() const
+{
+    QMutexLocker locker(&m_outboxMutex);
+    return m_outbox.size();
+}
+
+void ParallelDirWalker::walk(const QString &root, const Visitor &visitor, const BatchHandler &onBatch)
+{
+    m_stopped.store(false);
+    m_visitedDirCount.store(0);
+    m_statCount.store(0);
+    m_visitedDirs.clear();
+    m_outbox.clear();
+
+    // 根目录本身被排除时无需遍历
+    if (m_excluded.matches(root))
+        return;
+
+    m_queues.clear();
+    for (int i = 0; i < m_threadCount; ++i)
+        m_queues.push_back(std::make_unique<WorkQueue>());
+
+    // 根目录交给 0 号工作者，其余工作者通过窃取获得任务
+    m_queues.front()->dirs.push_back(root);
+    m_pendingDirs.store(1);
+    m_runningWorkers.store(m_threadCount - 1);
+
+    // 辅助工作者作为任务提交到共享执行器，不再为每次遍历创建、销毁线程
+    {
+        // 持锁提交，任务开始时清空句柄的操作一定发生在句柄记录之后
+        QMutexLocker locker(&m_helperMutex);
+        m_helperTasks.assign(static_cast<size_t>(m_threadCount - 1), nullptr);
+        for (int i = 1; i < m_threadCount; ++i) {
+            auto task = [this, i, &visitor]() {
+                {
+                    // 任务已开始，句柄随任务结束失效，不能再用于取消排队
+                    QMutexLocker locker(&m_helperMutex);
+                    m_helperTasks[static_cast<size_t>(i - 1)] = nullptr;
+                }
+                workerLoop(i, visitor);
+            };
+            m_helperTasks[static_cast<size_t>(i - 1)] = SearchExecutor::instance()->submit(std::move(task), kHelperPriority);
+        }
+    }
+
+    // 调用者线程作为 0 号工作者参与遍历，执行器繁忙、辅助任务迟迟不能开始时遍历仍能推进
+    m_onBatch = &onBatch;
+    workerLoop(0, visitor);
+
+    // 遍历已结束，尚未开始的辅助任务直接移出队列，不必再等它们被调度
+    {
+        // 只置空句柄不缩小数组，已出队但还在等锁的任务仍会写入自己的位置
+        QMutexLocker locker(&m_helperMutex);
+        for (QRunnable *&helper : m_helperTasks) {
+            if (SearchExecutor::instance()->cancelPending(helper))
+                finishWorker();
+            helper = nullptr;
+        }
+    }
+
+    // 等待已开始的辅助工作者结束，期间继续汇总批次，批次回调只在调用者线程中执行
+    bool finished = false;
+    while (!finished) {
+        QList<SearchResultList> ready;
+        {
+            QMutexLocker locker(&m_outboxMutex);
+            while (m_outbox.isEmpty() && m_runningWorkers.load() > 0)
+                m_outboxReady.wait(&m_outboxMutex, kOutboxWaitMs);
+            ready.swap(m_outbox);
+            finished = m_runningWorkers.load() == 0;
+            m_outboxNotFull.wakeAll();
+        }
+
+        for (const SearchResultList &batch : std::as_const(ready))
+            onBatch(batch);
+    }
+
+    m_onBatch = nullptr;
+    m_queues.clear();
+}
+
+void ParallelDirWalker::stop()
+{
+    m_stopped.store(true);
+
+    // 唤醒等待队列空位的工作者，使其尽快结束
+    QMutexLocker locker(&m_outboxMutex);
+    m_outboxNotFull.wakeAll();
+}
+
+bool ParallelDirWalker::isStopped() const
+{
+    return m_stopped.load() || (m_cancelled && m_cancelled->load());
+}
+
+void ParallelDirWalker::workerLoop(int id, const Visitor &visitor)
+{
+    SearchResultList batch;
+    int idleRounds = 0;
+
+    while (!isStopped()) {
+        // 调用者线程在目录之间顺带投递其他工作者积压的批次
+        if (id == 0)
+            deliverBatches();
+
+        QString dir;
+        if (!takeDirectory(id, &dir)) {
+            // 所有队列为空且没有正在处理的目录时，遍历结束
+            if (m_pendingDirs.load() == 0)
+                break;
+
+            if (++idleRounds < kIdleSpinRounds)
+                QThread::yieldCurrentThread();
+            else
+                QThread::usleep(kIdleSleepUs);
+            continue;
+        }
+
+        idleRounds = 0;
+        processDirectory(id, dir, visitor, batch);
+        // 子目录已在 processDirectory 中计入，最后再减去当前目录，计数不会提前归零
+        m_pendingDirs.fetch_sub(1);
+    }
+
+    publishBatch(id, batch);
+    if (id != 0)
+        finishWorker();
+}
+
+void ParallelDirWalker::finishWorker()
+{
+    QMutexLocker locker(&m_outboxMutex);
+    m_runningWorkers.fetch_sub(1);
+    m_outboxReady.wakeAll();
+}
+
+void ParallelDirWalker::deliverBatches()
+{
+    QList<SearchResultList> ready;
+    {
+        QMutexLocker locker(&m_outboxMutex);
+        ready.swap(m_outbox);
+        if (!ready.isEmpty())
+            m_outboxNotFull.wakeAll();
+    }
+
+    for (const SearchResultList &batch : std::as_const(ready))
+        (*m_onBatch)(batch);
+}
+
+bool ParallelDirWalker::takeDirectory(int id, QString *dir)
+{
+    {
+        WorkQueue &own = *m_queues[id];
+        QMutexLocker locker(&own.mutex);
+        if (!own.dirs.empty()) {
+            *dir = std::move(own.dirs.back());
+            own.dirs.pop_back();
+            return true;
+        }
+    }
+
+    for (int i = 1; i < m_threadCount; ++i) {
+        WorkQueue &victim = *m_queues[(id + i) % m_threadCount];
+        QMutexLocker locker(&victim.mutex);
+        if (!victim.dirs.empty()) {
+            *dir = std::move(victim.dirs.front());
+            victim.dirs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ParallelDirWalker::processDirectory(int id, const QString &dir, const Visitor &visitor, SearchResultList &batch)
+{
+    const int dirFd = ::open(QFile::encodeName(dir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        // 如果无法读取目录，可能是因为权限问题
+        qWarning() << "Permission Denied: " << dir;
+        return;
+    }
+
+    // 避免循环：以 (dev, ino) 标识目录，比逐个解析 canonical path 便宜得多
+    struct stat dirStat;
+    if (::fstat(dirFd, &dirStat) == 0) {
+        const QPair<quint64, quint64> key(static_cast<quint64>(dirStat.st_dev), static_cast<quint64>(dirStat.st_ino));
+        QMutexLocker locker(&m_visitedMutex);
+        if (m_visitedDirs.contains(key)) {
+            locker.unlock();
+            ::close(dirFd);
+            return;
+        }
+        m_visitedDirs.insert(key);
+    }
+
+    m_visitedDirCount.fetch_add(1);
+
+    // 直接读取原始 dirent：不排序、不为每个条目构造 QFileInfo，元数据由 DirEntry 按需获取
+    alignas(LinuxDirent64) char buffer[kDirentBufferSize];
+    QStringList subDirs;
+    while (!isStopped()) {
+        const long bytesRead = ::syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+        if (bytesRead < 0) {
+            qWarning() << "Failed to read directory:" << dir << strerror(errno);
+            break;
+        }
+        if (bytesRead == 0)
+            break;
+
+        for (long offset = 0; offset < bytesRead && !isStopped();) {
+            const auto *raw = reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+            offset += raw->d_reclen;
+
+            const char *name = raw->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+            if (!m_includeHidden && name[0] == '.')
+                continue;
+
+            DirEntry entry(dirFd, dir, name, raw->d_type, &m_statCount);
+            if (!entry.resolveType())
+                continue;
+
+            // 符号链接目录不递归进入（防止循环），但其名称仍参与匹配
+            // 排除的目录在入队前剪枝，其名称同样参与匹配
+            if (entry.m_type == DT_DIR) {
+                QString subDir = entry.filePath();
+                if (!m_excluded.matches(subDir))
+                    subDirs.append(std::move(subDir));
+            }
+
+            visitor(entry, batch);
+            if (batch.size() >= m_batchSize)
+                publishBatch(id, batch);
+        }
+    }
+
+    ::close(dirFd);
+
+    if (subDirs.isEmpty())
+        return;
+
+    m_pendingDirs.fetch_add(subDirs.size());
+    WorkQueue &own = *m_queues[id];
+    QMutexLocker locker(&own.mutex);
+    for (QString &subDir : subDirs)
+        own.dirs.push_back(std::move(subDir));
+}
+
+void ParallelDirWalker::publishBatch(int id, SearchResultList &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    // 调用者线程自己就是消费方，直接投递，不能等待自己腾出队列空位
+    if (id == 0) {
+        deliverBatches();
+        (*m_onBatch)(batch);
+        batch.clear();
+        return;
+    }
+
+    // 消费方跟不上（如流式输出被背压阻塞）时在此等待，结果不会在内存中无限堆积。
+    // 已停止时不再等待：剩余批次中的结果已占用名额，仍需交给消费方
+    QMutexLocker locker(&m_outboxMutex);
+    while (m_outbox.size() >= m_outboxCapacity && !isStopped())
+        m_outboxNotFull.wait(&m_outboxMutex, kOutboxWaitMs);
+
+    m_outbox.append(batch);
+    batch.clear();
+    m_outboxReady.wakeOne();
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PARALLELDIRWALKER_H
+#define PARALLELDIRWALKER_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QMutex>
+#include <QRunnable>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QWaitCondition>
+
+#include <dfm-search/dsearch_global.h>
+#include <dfm-search/searchresult.h>
+
+#include "pathmatcher.h"
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 遍历时的目录条目
+ *
+ * 直接由 getdents64 返回的原始 dirent 构造：文件名和类型（d_type）无需额外
+ * 系统调用即可获得，大小、时间等元数据只在首次访问时通过一次 statx 取得。
+ * 文件系统不填 d_type（DT_UNKNOWN）时，类型也在首次查询时才通过一次 lstat 确定。
+ * 语义与 QFileInfo 保持一致：isDir()/size()/时间跟随符号链接，isSymLink()
+ * 描述条目本身。
+ *
+ * 条目引用遍历缓冲区中的数据，只在访问回调期间有效。
+ */
+class DirEntry
+{
+public:
+    DirEntry(int dirFd, const QString &dirPath, const char *rawName, unsigned char type,
+             std::atomic<int> *statCounter);
+
+    const QString &fileName() const { return m_fileName; }
+    QString filePath() const;
+    QString suffix() const;
+
+    bool isDir() const;
+    bool isFile() const;
+    bool isSymLink() const;
+    bool isHidden() const { return m_fileName.startsWith(QLatin1Char('.')); }
+
+    qint64 size() const;
+    qint64 lastModifiedMSecs() const;   // 毫秒时间戳
+    qint64 birthTimeMSecs() const;   // 毫秒时间戳，文件系统不支持时返回 -1
+
+private:
+    friend class ParallelDirWalker;
+
+    // 解析 DT_UNKNOWN / DT_LNK，判断条目是否应当出现在结果中（普通文件、目录或有效链接）
+    bool resolveType() const;
+    bool ensureStat() const;
+
+    int m_dirFd;
+    const QString &m_dirPath;
+    const char *m_rawName;
+    QString m_fileName;
+    mutable unsigned char m_type;
+    std::atomic<int> *m_statCounter;
+
+    mutable bool m_statDone { false };
+    mutable bool m_statOk { false };
+    mutable bool m_targetIsDir { false };
+    mutable bool m_targetIsFile { false };
+    mutable qint64 m_size { 0 };
+    mutable qint64 m_mtimeMs { 0 };
+    mutable qint64 m_btimeMs { -1 };
+};
+
+/**
+ * @brief 并行目录遍历器（工作窃取）
+ *
+ * 每个工作线程持有一个目录双端队列：自己从队尾取（深度优先，局部性好），
+ * 空闲线程从其他线程的队首窃取（通常是更大的子树）。
+ *
+ * 调用 walk() 的线程本身是 0 号工作者，其余工作者作为任务提交到共享的
+ * SearchExecutor，遍历结束时撤回尚未开始的任务，并等待已开始的任务结束。
+ *
+ * 访问回调在工作线程中执行，匹配结果先写入线程本地批次，攒满后交给
+ * 调用 walk() 的线程，由该线程调用批次回调。因此批次回调始终在调用者
+ * 线程执行，可以安全地发射信号或修改调用者的成员。待投递的批次数有上限，
+ * 批次回调阻塞（如流式输出的背压）时其他工作者随之等待。
+ */
+class ParallelDirWalker
+{
+public:
+    /**
+     * @brief 条目访问回调
+     * @param entry 当前条目，应先按名称匹配，确有需要时再读取元数据
+     * @param batch 当前工作线程的本地结果批次，匹配时向其追加结果
+     *
+     * 会在多个工作线程中并发调用，实现必须是线程安全的。
+     */
+    using Visitor = std::function<void(const DirEntry &entry, SearchResultList &batch)>;
+
+    /**
+     * @brief 批次回调，在调用 walk() 的线程中执行
+     */
+    using BatchHandler = std::function<void(const SearchResultList &batch)>;
+
+    /**
+     * @param threadCount 工作者数（含调用者线程），<= 0 时使用 QThread::idealThreadCount()
+     * @param cancelled 引擎级取消标志，可以为空
+     */
+    ParallelDirWalker(int threadCount, std::atomic<bool> *cancelled);
+    ~ParallelDirWalker();
+
+    /**
+     * @brief 排除的目录，按路径边界匹配，命中的目录不会进入遍历
+     */
+    void setExcludedPaths(const QStringList &paths);
+    void setIncludeHidden(bool include);
+    void setBatchSize(int size);
+
+    /**
+     * @brief 待投递批次的上限，默认每个工作者 2 批
+     *
+     * 批次回调处理不过来时，其他工作者在队列满后等待，不再继续遍历。
+     */
+    void setOutboxCapacity(int batches);
+
+    /**
+     * @brief 已由工作者产出、尚未交给批次回调的批次数
+     */
+    int queuedBatches() const;
+
+    /**
+     * @brief 遍历 root 下的全部目录，阻塞直到遍历结束、被取消或被 stop()
+     */
+    void walk(const QString &root, const Visitor &visitor, const BatchHandler &onBatch);
+
+    /**
+     * @brief 请求提前结束遍历（如已达到 maxResults），可在访问回调中调用
+     */
+    void stop();
+
+    int threadCount() const { return m_threadCount; }
+    int visitedDirectories() const { return m_visitedDirCount.load(); }
+    int statCalls() const { return m_statCount.load(); }
+
+private:
+    struct WorkQueue
+    {
+        QMutex mutex;
+        std::deque<QString> dirs;
+    };
+
+    // 0 号工作者运行在调用者线程中，负责投递批次
+    void workerLoop(int id, const Visitor &visitor);
+    void finishWorker();
+    void deliverBatches();
+    bool takeDirectory(int id, QString *dir);
+    void processDirectory(int id, const QString &dir, const Visitor &visitor, SearchResultList &batch);
+    void publishBatch(int id, SearchResultList &batch);
+    bool isStopped() const;
+
+    int m_threadCount;
+    int m_batchSize;
+    int m_outboxCapacity;
+    std::atomic<bool> *m_cancelled;
+    std::atomic<bool> m_stopped { false };
+    std::atomic<int> m_pendingDirs { 0 };   // 已入队或正在处理的目录数
+    std::atomic<int> m_runningWorkers { 0 };   // 已提交且尚未结束的辅助工作者数
+    std::atomic<int> m_visitedDirCount { 0 };
+    std::atomic<int> m_statCount { 0 };
+
+    PathMatcher m_excluded;
+    bool m_includeHidden { false };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    QMutex m_helperMutex;
+    std::vector<QRunnable *> m_helperTasks;   // 尚未开始的辅助任务句柄，开始后置空
+
+    QMutex m_visitedMutex;
+    QSet<QPair<quint64, quint64>> m_visitedDirs;   // (dev, ino)，防止绑定挂载等造成的循环
+
+    mutable QMutex m_outboxMutex;
+    QWaitCondition m_outboxReady;
+    QWaitCondition m_outboxNotFull;
+    QList<SearchResultList> m_outbox;
+    const BatchHandler *m_onBatch { nullptr };   // 仅在 walk() 期间有效
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // PARALLELDIRWALKER_H
@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "parallelsegmentsearch.h"
+#include "cancellablecollector.h"
+#include "lucene_cancellation_compat.h"
+#include "core/searchexecutor.h"
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <QMutex>
+#include <QRunnable>
+#include <QWaitCondition>
+
+using namespace Lucene;
+
+DFM_SEARCH_BEGIN_NS
+
+namespace ParallelSegmentSearch {
+
+namespace {
+
+// 结果处理时每个块包含的文档数为线程数的倍数，块之间按顺序输出
+constexpr int kDocsPerThread = 4;
+// 段任务与搜索共用 SearchExecutor 的线程预算，优先级低于搜索任务的默认值，
+// 排队中的新搜索先开始；调用线程本身也参与执行，执行器繁忙时不会死锁
+constexpr int kHelperPriority = -1;
+
+struct RunState
+{
+    RunState(int n, const std::function<void(int)> &t)
+        : count(n), task(t) { }
+
+    const int count;
+    const std::function<void(int)> task;
+    std::atomic<int> next { 0 };
+    std::atomic<bool> failed { false };
+
+    QMutex mutex;
+    QWaitCondition allDone;
+    int finished = 0;
+    std::exception_ptr error;
+    std::vector<QRunnable *> helpers;   // 尚未开始的辅助任务句柄，开始后置空
+};
+
+void drain(RunState *state)
+{
+    for (;;) {
+        // 任务全部领取后立即返回，晚启动的工作线程不会再访问 task 引用的数据
+        const int index = state->next.fetch_add(1);
+        if (index >= state->count)
+            return;
+
+        if (!state->failed.load()) {
+            try {
+                state->task(index);
+            } catch (...) {
+                QMutexLocker locker(&state->mutex);
+                if (!state->error)
+                    state->error = std::current_exception();
+                state->failed.store(true);
+            }
+        }
+
+        QMutexLocker locker(&state->mutex);
+        if (++state->finished == state->count)
+            state->allDone.wakeAll();
+    }
+}
+
+void gatherSegments(const IndexReaderPtr &reader, std::vector<IndexReaderPtr> &segments)
+{
+    const Collection<IndexReaderPtr> subReaders = reader->getSequentialSubReaders();
+    if (!subReaders || subReaders.empty()) {
+        segments.push_back(reader);
+        return;
+    }
+
+    for (int32_t i = 0; i < subReaders.size(); ++i)
+        gatherSegments(subReaders[i], segments);
+}
+
+}   // namespace
+
+int maxThreadCount()
+{
+    // 调用线程本身就是执行器的线程，总并行度不超过执行器的上限
+    return SearchExecutor::instance()->maxThreadCount();
+}
+
+void run(int count, const std::function<void(int)> &task)
+{
+    if (count <= 0)
+        return;
+
+    auto state = std::make_shared<RunState>(count, task);
+    const int helpers = qMin(count - 1, maxThreadCount() - 1);
+    {
+        // 持锁提交，任务开始时清空句柄的操作一定发生在句柄记录之后
+        QMutexLocker locker(&state->mutex);
+        state->helpers.assign(static_cast<size_t>(qMax(0, helpers)), nullptr);
+        for (int i = 0; i < helpers; ++i) {
+            auto helper = [state, i]() {
+                {
+                    QMutexLocker locker(&state->mutex);
+                    state->helpers[static_cast<size_t>(i)] = nullptr;
+                }
+                drain(state.get());
+            };
+            state->helpers[static_cast<size_t>(i)] = SearchExecutor::instance()->submit(std::move(helper), kHelperPriority);
+        }
+    }
+
+    drain(state.get());
+
+    QMutexLocker locker(&state->mutex);
+    // 任务已全部领取，尚未开始的辅助任务不再有事可做，直接移出执行器队列
+    // 只置空句柄不缩小数组，已出队但还在等锁的任务仍会写入自己的位置
+    for (QRunnable *&helper : state->helpers) {
+        SearchExecutor::instance()->cancelPending(helper);
+        helper = nullptr;
+    }
+
+    while (state->finished < state->count)
+        state->allDone.wait(&state->mutex);
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+Hits search(const IndexSearcherPtr &searcher, const QueryPtr &query,
+            std::atomic<bool> *cancelled, int32_t maxResults, const Sort &sort)
+{
+    Hits hits;
+
+    std::vector<IndexReaderPtr> segments;
+    gatherSegments(searcher->getIndexReader(), segments);
+
+    if (segments.size() <= 1 || maxThreadCount() <= 1) {
+        boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(cancelled, maxResults);
+        collector->setSort(sort.key, sort.order, sort.fields);
+        searcher->search(query, collector);
+        hits.scoreDocs = collector->getScoreDocs();
+        hits.totalHits = collector->getTotalHits();
+        return hits;
+    }
+
+    // 权重只创建一次由各段共用，打分与 IndexSearcher::search() 相同
+    const WeightPtr weight = query->weight(searcher);
+
+    std::vector<int32_t> docStarts(segments.size());
+    int32_t maxDoc = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        docStarts[i] = maxDoc;
+        maxDoc += segments[i]->maxDoc();
+    }
+
+    std::vector<boost::shared_ptr<CancellableCollector>> collectors(segments.size());
+    run(static_cast<int>(segments.size()), [&](int i) {
+        // 取消上下文按线程设置，调用线程已由策略安装，工作线程需要自行安装
+        std::optional<SearchCancellationGuard> guard;
+        if (SearchCancellation::getFlag() != cancelled)
+            guard.emplace(cancelled);
+
+        boost::shared_ptr<CancellableCollector> collector = newLucene<CancellableCollector>(cancelled, maxResults);
+        collector->setSort(sort.key, sort.order, sort.fields);
+        collector->setNextReader(segments[i], docStarts[i]);
+        const ScorerPtr scorer = weight->scorer(segments[i], !collector->acceptsDocsOutOfOrder(), true);
+        if (scorer)
+            scorer->score(collector);
+        collectors[i] = collector;
+    });
+
+    if (sort.key != ResultSortKey::None) {
+        // 全局前 maxResults 个一定在各段各自的前 maxResults 个之中
+        SortedHitQueue merged(sort.key, sort.order, maxResults, sort.fields);
+        for (const auto &collector : collectors) {
+            hits.totalHits += collector->getTotalHits();
+            merged.merge(*collector->sortedHits());
+        }
+        hits.scoreDocs = merged.sortedScoreDocs();
+        return hits;
+    }
+
+    // 按段顺序合并，与串行收集器得到的前 maxResults 个文档一致
+    hits.scoreDocs = Collection<ScoreDocPtr>::newInstance();
+    for (const auto &collector : collectors) {
+        hits.totalHits += collector->getTotalHits();
+        const Collection<ScoreDocPtr> docs = collector->getScoreDocs();
+        for (int32_t i = 0; i < docs.size() && hits.scoreDocs.size() < maxResults; ++i)
+            hits.scoreDocs.add(docs[i]);
+    }
+    return hits;
+}
+
+void processHits(int32_t count, bool parallel, std::atomic<bool> *cancelled,
+                 const ResultBuilder &build, const ResultSink &sink)
+{
+    const auto isCancelled = [cancelled] { return cancelled && cancelled->load(); };
+
+    if (!parallel || count <= 1 || maxThreadCount() <= 1) {
+        for (int32_t i = 0; i < count && !isCancelled(); ++i) {
+            std::optional<SearchResult> result = build(i);
+            if (result && !sink(std::move(*result)))
+                return;
+        }
+        return;
+    }
+
+    // 文档读取与高亮按块并行，块内结果按命中顺序交给 sink，流式输出的顺序不变
+    const int32_t chunkSize = maxThreadCount() * kDocsPerThread;
+    std::vector<std::optional<SearchResult>> chunk;
+    for (int32_t start = 0; start < count && !isCancelled(); start += chunkSize) {
+        const int32_t size = qMin(chunkSize, count - start);
+        chunk.assign(static_cast<size_t>(size), std::nullopt);
+        run(size, [&](int k) {
+            if (!isCancelled())
+                chunk[static_cast<size_t>(k)] = build(start + k);
+        });
+
+        for (std::optional<SearchResult> &result : chunk) {
+            if (result && !sink(std::move(*result)))
+                return;
+        }
+    }
+}
+
+}   // namespace ParallelSegmentSearch
+
+DFM_SEARCH_END_NS
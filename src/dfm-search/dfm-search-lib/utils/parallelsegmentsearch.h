@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PARALLELSEGMENTSEARCH_H
+#define PARALLELSEGMENTSEARCH_H
+
+#include <atomic>
+#include <functional>
+#include <optional>
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <dfm-search/dsearch_global.h>
+#include <dfm-search/searchresult.h>
+
+#include "sortedhitqueue.h"
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 按索引段并行执行的搜索与结果处理
+ *
+ * 大型全文、OCR 索引由许多段组成，IndexSearcher::search() 在一个线程上依次
+ * 遍历所有段。这里为每个段使用独立的 CancellableCollector，借助共享的
+ * SearchExecutor 并行打分收集，再按段的顺序合并，结果与串行搜索完全相同。
+ *
+ * 命中文档的读取与高亮同样可以分块并行，块内结果仍按命中顺序输出。
+ *
+ * 任务总是由调用线程和执行器共同完成：辅助任务以低于搜索的优先级提交，
+ * 调用线程自己也领取任务，执行器繁忙时退化为串行执行，不会因为等待而阻塞。
+ */
+namespace ParallelSegmentSearch {
+
+struct Hits
+{
+    Lucene::Collection<Lucene::ScoreDocPtr> scoreDocs;   ///< 按段顺序合并后的前 maxResults 个文档
+    int32_t totalHits = 0;
+};
+
+// 结果排序，key 为 ResultSortKey::None 时按收集顺序
+struct Sort
+{
+    ResultSortKey key = ResultSortKey::None;
+    Qt::SortOrder order = Qt::AscendingOrder;
+    SortedHitQueue::Fields fields;
+};
+
+/**
+ * @brief 并行执行 task(0) … task(count - 1)，全部结束后返回
+ *
+ * 某个任务抛出异常后不再开始新的任务，已开始的任务结束后在调用线程重新抛出
+ * 第一个异常。task 需要自行保证线程安全。
+ */
+void run(int count, const std::function<void(int)> &task);
+
+/**
+ * @brief 可用于并行的工作线程数（含调用线程）
+ */
+int maxThreadCount();
+
+/**
+ * @brief 按段并行搜索
+ *
+ * 每个段的收集器都检查 cancelled，取消时抛出 SearchCancelledException，
+ * 与串行搜索的异常相同。索引只有一个段时直接在调用线程搜索。
+ * 指定排序时每个段各自保留前 maxResults 个命中，合并后再取前 maxResults 个。
+ *
+ * @param searcher   搜索器
+ * @param query      查询
+ * @param cancelled  取消标志
+ * @param maxResults 最多收集的文档数
+ * @param sort       结果排序
+ */
+Hits search(const Lucene::IndexSearcherPtr &searcher, const Lucene::QueryPtr &query,
+            std::atomic<bool> *cancelled, int32_t maxResults, const Sort &sort = Sort());
+
+using ResultBuilder = std::function<std::optional<SearchResult>(int32_t index)>;
+using ResultSink = std::function<bool(SearchResult &&result)>;
+
+/**
+ * @brief 按命中顺序处理 count 个文档
+ *
+ * build 读取第 index 个命中的文档并生成结果，不需要该文档时返回 std::nullopt；
+ * parallel 为 true 时 build 在多个线程中并行调用，必须线程安全。
+ * sink 始终在调用线程按命中顺序调用，返回 false 时停止处理。
+ * 取消后不再调用 build。
+ */
+void processHits(int32_t count, bool parallel, std::atomic<bool> *cancelled,
+                 const ResultBuilder &build, const ResultSink &sink);
+
+}   // namespace ParallelSegmentSearch
+
+DFM_SEARCH_END_NS
+
+#endif   // PARALLELSEGMENTSEARCH_H
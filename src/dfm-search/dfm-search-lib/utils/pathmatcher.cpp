@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "pathmatcher.h"
+
+#include <QDir>
+
+DFM_SEARCH_BEGIN_NS
+
+PathMatcher::PathMatcher()
+    : m_nodes(1)
+{
+}
+
+PathMatcher::PathMatcher(const QStringList &absolutePrefixes, const QStringList &segmentNames)
+    : m_nodes(1)
+{
+    for (const QString &prefix : absolutePrefixes)
+        addPrefix(prefix);
+
+    for (const QString &name : segmentNames) {
+        if (!name.isEmpty())
+            m_segmentNames.insert(name);
+    }
+}
+
+PathMatcher PathMatcher::fromBlacklist(const QStringList &entries)
+{
+    QStringList prefixes;
+    QStringList names;
+    for (const QString &entry : entries) {
+        const QString trimmed = entry.trimmed();
+        if (trimmed.isEmpty())
+            continue;
+        if (QDir::isAbsolutePath(trimmed))
+            prefixes.append(trimmed);
+        else
+            names.append(trimmed);
+    }
+    return PathMatcher(prefixes, names);
+}
+
+void PathMatcher::addPrefix(const QString &prefix)
+{
+    const QString cleaned = QDir::cleanPath(prefix.trimmed());
+    if (!cleaned.startsWith(QLatin1Char('/')))
+        return;
+
+    int node = 0;
+    const QStringList parts = cleaned.split(QLatin1Char('/'));
+    for (const QString &part : parts) {
+        if (part.isEmpty())
+            continue;
+        auto it = m_nodes[node].children.constFind(part);
+        if (it == m_nodes[node].children.constEnd()) {
+            m_nodes.emplace_back();
+            const int child = static_cast<int>(m_nodes.size()) - 1;
+            m_nodes[node].children.insert(part, child);
+            node = child;
+        } else {
+            node = it.value();
+        }
+    }
+    m_nodes[node].terminal = true;
+    m_hasPrefixes = true;
+}
+
+bool PathMatcher::matches(const QString &path) const
+{
+    if (isEmpty() || path.isEmpty())
+        return false;
+
+    // 含 ".." 的路径少见，只有此时才规范化
+    if (path.contains(QLatin1String("..")))
+        return matchesSegments(QDir::cleanPath(path));
+    return matchesSegments(path);
+}
+
+bool PathMatcher::matchesSegments(const QString &path) const
+{
+    // node < 0 表示已经离开前缀树，后续只检查目录名
+    int node = -1;
+    if (m_hasPrefixes && path.startsWith(QLatin1Char('/'))) {
+        node = 0;
+        if (m_nodes[0].terminal)
+            return true;
+    }
+
+    const QChar *data = path.constData();
+    const int length = path.size();
+    int start = 0;
+    while (start < length) {
+        int end = path.indexOf(QLatin1Char('/'), start);
+        if (end < 0)
+            end = length;
+
+        const int partLength = end - start;
+        if (partLength > 0 && !(partLength == 1 && data[start] == QLatin1Char('.'))) {
+            // 不复制字符，仅用于查找
+            const QString part = QString::fromRawData(data + start, partLength);
+            if (m_segmentNames.contains(part))
+                return true;
+
+            if (node >= 0) {
+                auto it = m_nodes[node].children.constFind(part);
+                if (it == m_nodes[node].children.constEnd()) {
+                    node = -1;
+                    if (m_segmentNames.isEmpty())
+                        return false;
+                } else {
+                    node = it.value();
+                    if (m_nodes[node].terminal)
+                        return true;
+                }
+            } else if (m_segmentNames.isEmpty()) {
+                return false;
+            }
+        }
+        start = end + 1;
+    }
+
+    return false;
+}
+
+DFM_SEARCH_END_NS
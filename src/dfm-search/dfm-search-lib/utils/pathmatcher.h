@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PATHMATCHER_H
+#define PATHMATCHER_H
+
+#include <vector>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 编译后的路径规则匹配器
+ *
+ * 规则分两类：
+ * - 绝对路径前缀：路径等于该前缀或位于其下时命中，按路径边界比较，
+ *   /home/a/fo 不会命中 /home/a/foo；"/" 命中所有绝对路径
+ * - 目录名：路径中任意一段与之相同时命中
+ *
+ * 绝对前缀按路径段组织为前缀树，目录名存放在哈希集合中。检查一个路径只需
+ * 从左到右走一遍路径段，耗时与路径深度成正比，与规则数量无关。
+ *
+ * 每次搜索开始时构建一次，之后只读，可以在多个线程中并发使用。
+ * 目录命中时其下所有路径都命中，遍历时可以据此整棵剪枝。
+ */
+class PathMatcher
+{
+public:
+    PathMatcher();
+
+    /**
+     * @param absolutePrefixes 绝对路径前缀，非绝对路径与空串被忽略
+     * @param segmentNames     目录名
+     */
+    explicit PathMatcher(const QStringList &absolutePrefixes, const QStringList &segmentNames = QStringList());
+
+    /**
+     * @brief 按黑名单规则构建：绝对路径作为前缀，其余作为目录名
+     */
+    static PathMatcher fromBlacklist(const QStringList &entries);
+
+    bool isEmpty() const { return !m_hasPrefixes && m_segmentNames.isEmpty(); }
+
+    /**
+     * @brief 路径是否命中任一规则
+     *
+     * 路径中多余的 '/' 与 "." 段被忽略，包含 ".." 时先规范化再匹配。
+     */
+    bool matches(const QString &path) const;
+
+private:
+    struct Node
+    {
+        QHash<QString, int> children;
+        bool terminal = false;   // 某条前缀在此结束
+    };
+
+    void addPrefix(const QString &prefix);
+    bool matchesSegments(const QString &path) const;
+
+    std::vector<Node> m_nodes;   // m_nodes[0] 为根 "/"
+    QSet<QString> m_segmentNames;
+    bool m_hasPrefixes = false;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // PATHMATCHER_H
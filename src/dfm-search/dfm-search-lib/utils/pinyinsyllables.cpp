@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "pinyinsyllables.h"
+
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+DFM_SEARCH_BEGIN_NS
+
+namespace PinyinSyllables {
+
+namespace {
+
+// 合法的拼音音节表（预先定义所有可能的拼音音节组合），ü 统一写作 v
+constexpr std::string_view kSyllables[] = {
+    // 单韵母音节 - 只有 a, o, e 可以单独成音节
+    "a", "o", "e", "ai", "ei", "ao", "ou", "an", "en", "ang", "eng", "er",
+    // b开头音节
+    "ba", "bo", "bi", "bu", "bai", "bei", "bao", "ban", "ben", "bin", "bie", "biao", "bian", "bing", "bang", "beng",
+    // p开头音节
+    "pa", "po", "pi", "pu", "pai", "pei", "pao", "pan", "pen", "pin", "pie", "piao", "pian", "ping", "pang", "peng",
+    // m开头音节
+    "ma", "mo", "me", "mi", "mu", "mai", "mei", "mao", "mou", "man", "men", "min", "mie", "miao", "miu", "mian", "min", "ming", "mang", "meng",
+    // f开头音节
+    "fa", "fo", "fu", "fei", "fan", "fen", "fang", "feng",
+    // d开头音节
+    "da", "de", "di", "du", "dai", "dao", "dou", "dan", "den", "dang", "deng", "ding", "dong", "die", "diao", "diu", "dian", "duan", "dun", "duo",
+    // t开头音节
+    "ta", "te", "ti", "tu", "tai", "tao", "tou", "tan", "tang", "teng", "ting", "tong", "tie", "tiao", "tian", "tuan", "tun", "tuo",
+    // n开头音节
+    "na", "ne", "ni", "nu", "nv", "nai", "nei", "nao", "nou", "nan", "nen", "nang", "neng", "ning", "nong", "nie", "niao", "niu", "nian", "niang", "nuan", "nve", "nuo", "nun",
+    // l开头音节
+    "la", "le", "li", "lu", "lv", "lai", "lei", "lao", "lou", "lan", "lang", "leng", "ling", "long", "lie", "liao", "liu", "lian", "liang", "luan", "lun", "luo", "lve",
+    // g开头音节
+    "ga", "ge", "gu", "gai", "gei", "gao", "gou", "gan", "gen", "gang", "geng", "gong", "gua", "guo", "guai", "gui", "guan", "gun", "guang",
+    // k开头音节
+    "ka", "ke", "ku", "kai", "kao", "kou", "kan", "ken", "kang", "keng", "kong", "kua", "kuo", "kuai", "kui", "kuan", "kun", "kuang",
+    // h开头音节
+    "ha", "he", "hu", "hai", "hei", "hao", "hou", "han", "hen", "hang", "heng", "hong", "hua", "huo", "huai", "hui", "huan", "hun", "huang",
+    // j开头音节
+    "ji", "ju", "jue", "jiu", "jie", "jia", "jin", "jing", "jiang", "jiong", "juan", "jun", "jian", "jiao",
+    // q开头音节
+    "qi", "qu", "que", "qiu", "qie", "qia", "qin", "qing", "qiang", "qiong", "quan", "qun", "qian", "qiao",
+    // x开头音节
+    "xi", "xu", "xue", "xiu", "xie", "xia", "xin", "xing", "xiang", "xiong", "xuan", "xun", "xian", "xiao",
+    // zh开头音节
+    "zha", "zhe", "zhi", "zhu", "zhai", "zhao", "zhou", "zhan", "zhen", "zhang", "zheng", "zhong", "zhua", "zhuo", "zhuai", "zhui", "zhuan", "zhun", "zhuang",
+    // ch开头音节
+    "cha", "che", "chi", "chu", "chai", "chao", "chou", "chan", "chen", "chang", "cheng", "chong", "chua", "chuo", "chuai", "chui", "chuan", "chun", "chuang",
+    // sh开头音节
+    "sha", "she", "shi", "shu", "shai", "shao", "shou", "shan", "shen", "shang", "sheng", "shua", "shuo", "shuai", "shui", "shuan", "shun", "shuang",
+    // r开头音节
+    "ra", "re", "ri", "ru", "rao", "rou", "ran", "ren", "rang", "reng", "rong", "rua", "ruo", "rui", "ruan", "run",
+    // z开头音节
+    "za", "ze", "zi", "zu", "zai", "zei", "zao", "zou", "zan", "zen", "zang", "zeng", "zong", "zuo", "zui", "zuan", "zun",
+    // c开头音节
+    "ca", "ce", "ci", "cu", "cai", "cao", "cou", "can", "cen", "cang", "ceng", "cong", "cuo", "cui", "cuan", "cun",
+    // s开头音节
+    "sa", "se", "si", "su", "sai", "sao", "sou", "san", "sen", "sang", "seng", "song", "suo", "sui", "suan", "sun",
+    // y开头音节 - 注意yi/you/yao等整体认读音节
+    "ya", "ye", "yi", "yo", "yu", "yue", "yao", "you", "yan", "yin", "yang", "ying", "yong", "yuan", "yun",
+    // w开头音节 - 注意wu/wei等整体认读音节
+    "wa", "wo", "wu", "wai", "wei", "wan", "wen", "wang", "weng"
+};
+
+constexpr int kAlphabetSize = 26;
+
+constexpr int totalLength()
+{
+    int length = 0;
+    for (std::string_view syllable : kSyllables)
+        length += static_cast<int>(syllable.size());
+    return length;
+}
+
+constexpr bool isLowerAsciiTable()
+{
+    for (std::string_view syllable : kSyllables) {
+        for (char ch : syllable) {
+            if (ch < 'a' || ch > 'z')
+                return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isLowerAsciiTable(), "pinyin syllables must be lowercase ASCII");
+
+// 字典树节点数的上限：每个字母一个节点，加上根节点
+constexpr int kMaxNodes = totalLength() + 1;
+
+struct TrieBuilder
+{
+    uint16_t next[kMaxNodes][kAlphabetSize] {};
+    bool terminal[kMaxNodes] {};
+    int nodeCount = 1;   // 节点 0 为根
+    int maxDepth = 0;
+};
+
+constexpr TrieBuilder buildTrie()
+{
+    TrieBuilder trie {};
+    for (std::string_view syllable : kSyllables) {
+        int node = 0;
+        for (char ch : syllable) {
+            const int letter = ch - 'a';
+            if (trie.next[node][letter] == 0)
+                trie.next[node][letter] = static_cast<uint16_t>(trie.nodeCount++);
+            node = trie.next[node][letter];
+        }
+        trie.terminal[node] = true;
+        if (static_cast<int>(syllable.size()) > trie.maxDepth)
+            trie.maxDepth = static_cast<int>(syllable.size());
+    }
+    return trie;
+}
+
+// 只在编译期使用，运行时使用按实际节点数压缩后的表
+constexpr TrieBuilder kBuiltTrie = buildTrie();
+static_assert(kBuiltTrie.nodeCount <= 0xffff, "pinyin trie does not fit 16-bit node indices");
+
+template<int NodeCount>
+struct Trie
+{
+    uint16_t next[NodeCount][kAlphabetSize] {};   // 0 表示没有出边（根节点不会是任何节点的子节点）
+    bool terminal[NodeCount] {};
+};
+
+constexpr Trie<kBuiltTrie.nodeCount> compactTrie()
+{
+    Trie<kBuiltTrie.nodeCount> trie {};
+    for (int node = 0; node < kBuiltTrie.nodeCount; ++node) {
+        for (int letter = 0; letter < kAlphabetSize; ++letter)
+            trie.next[node][letter] = kBuiltTrie.next[node][letter];
+        trie.terminal[node] = kBuiltTrie.terminal[node];
+    }
+    return trie;
+}
+
+constexpr Trie<kBuiltTrie.nodeCount> kTrie = compactTrie();
+
+// 同时存活的状态来自不同的切分点，深度各不相同，最多 maxDepth 个，另加一个根状态
+constexpr int kMaxStates = kBuiltTrie.maxDepth + 1;
+
+}   // namespace
+
+bool isSyllableSequence(const QString &input)
+{
+    uint16_t states[kMaxStates] = { 0 };   // 位置 0 是切分点，从根出发
+    int stateCount = 1;
+    bool atBoundary = false;   // 已处理的字母能否恰好切分完
+
+    int letterCount = 0;
+    int firstLetter = -1;
+    bool allSame = true;
+
+    const QChar *data = input.constData();
+    const int size = input.size();
+    for (int i = 0; i < size; ++i) {
+        const ushort ch = data[i].unicode();
+        int letter;
+        if (ch >= 'a' && ch <= 'z')
+            letter = ch - 'a';
+        else if (ch >= 'A' && ch <= 'Z')
+            letter = ch - 'A';
+        else
+            continue;   // 只保留字母用于拼音检验
+
+        if (letterCount++ == 0)
+            firstLetter = letter;
+        else if (letter != firstLetter)
+            allSame = false;
+
+        int nextCount = 0;
+        atBoundary = false;
+        for (int s = 0; s < stateCount; ++s) {
+            const uint16_t node = kTrie.next[states[s]][letter];
+            if (node == 0)
+                continue;
+            states[nextCount++] = node;
+            atBoundary |= kTrie.terminal[node];
+        }
+        // 音节在此结束，下一个字母可以开始新的音节
+        if (atBoundary)
+            states[nextCount++] = 0;
+
+        // 没有任何切分方式能继续
+        if (nextCount == 0)
+            return false;
+        stateCount = nextCount;
+    }
+
+    if (letterCount == 0)
+        return false;
+
+    // 特殊处理规则：单个字母 i、u、v 不能单独成音节（音节表中本就没有，这里直接返回）
+    if (letterCount == 1 && (firstLetter == 'i' - 'a' || firstLetter == 'u' - 'a' || firstLetter == 'v' - 'a'))
+        return false;
+
+    // 特殊处理规则：重复字母如 'vvv'、'aaa'
+    if (letterCount >= 3 && allSame)
+        return false;
+
+    return atBoundary;
+}
+
+QStringList syllables()
+{
+    QStringList result;
+    result.reserve(static_cast<int>(std::size(kSyllables)));
+    for (std::string_view syllable : kSyllables)
+        result.append(QString::fromLatin1(syllable.data(), static_cast<int>(syllable.size())));
+    result.removeDuplicates();
+    return result;
+}
+
+}   // namespace PinyinSyllables
+
+DFM_SEARCH_END_NS
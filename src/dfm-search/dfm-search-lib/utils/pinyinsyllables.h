@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PINYINSYLLABLES_H
+#define PINYINSYLLABLES_H
+
+#include <QString>
+#include <QStringList>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 拼音音节切分
+ *
+ * 音节表在编译期生成为一棵字典树（每个节点 26 个出边），切分时对输入只扫描
+ * 一遍：同时跟踪从每个可达切分点出发、仍在字典树内的状态（音节最长 6 个字母，
+ * 状态数有上限），到达音节结尾时当前位置成为新的切分点。整个过程不分配内存，
+ * 也不需要回溯。
+ */
+namespace PinyinSyllables {
+
+/**
+ * @brief 输入中的 ASCII 字母能否完整切分为拼音音节
+ *
+ * 非 ASCII 字母的字符被忽略，字母不区分大小写。以下输入视为非拼音：
+ * 不含字母；只有单个 i、u、v；三个及以上字母全部相同（如 "vvv"）。
+ */
+bool isSyllableSequence(const QString &input);
+
+/**
+ * @brief 音节表（小写，ü 写作 v），供测试与对照使用
+ */
+QStringList syllables();
+
+}   // namespace PinyinSyllables
+
+DFM_SEARCH_END_NS
+
+#endif   // PINYINSYLLABLES_H
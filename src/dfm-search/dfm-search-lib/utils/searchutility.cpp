@@ -2,7 +2,9 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 #include "searchutility.h"
-#include "filenameblacklistmatcher.h"
+#include "indexstatewatcher.h"
+#include "pathmatcher.h"
+#include "pinyinsyllables.h"
 
 #include <unistd.h>
 
@@ -11,86 +13,12 @@
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
-#include <QRegularExpression>
 #include <QStandardPaths>
-#include <QJsonDocument>
-#include <QJsonObject>
-
-#include <lucene++/LuceneHeaders.h>
-#include <lucene++/FSDirectory.h>
 
 DFM_SEARCH_BEGIN_NS
-using namespace Lucene;
 
 namespace Global {
 
-/**
- * @brief Read index version from a JSON status file
- * @param indexDir The index directory path
- * @param statusFile The name of the status JSON file
- * @return The version number, or -1 if reading fails
- */
-static int readIndexVersion(const QString &indexDir, const QString &statusFile)
-{
-    const QString versionFilePath = QDir(indexDir).filePath(statusFile);
-
-    QFile file(versionFilePath);
-    if (!file.exists()) {
-        qWarning() << "Index version file not found:" << versionFilePath;
-        return -1;
-    }
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open index version file:" << file.errorString();
-        return -1;
-    }
-
-    QByteArray jsonData = file.readAll();
-    file.close();
-
-    QJsonParseError parseError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData, &parseError);
-
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Failed to parse index version JSON:" << parseError.errorString();
-        return -1;
-    }
-
-    QJsonObject jsonObj = jsonDoc.object();
-    if (!jsonObj.contains("version")) {
-        qWarning() << "Index version JSON missing 'version' field";
-        return -1;
-    }
-
-    // Handle both numeric and string version values
-    const QJsonValue versionValue = jsonObj.value("version");
-    return versionValue.isDouble() ? versionValue.toInt() : versionValue.toString().toInt();
-}
-
-// 辅助递归函数，尝试所有可能的分割方法
-static bool isPinyinSequenceHelper(const QString &str, int startPos, const QSet<QString> &validSyllables)
-{
-    int len = str.length();
-
-    // 如果已经处理到字符串末尾，则匹配成功
-    if (startPos >= len)
-        return true;
-
-    // 尝试从长到短匹配音节
-    for (int syllableLen = qMin(6, len - startPos); syllableLen >= 1; syllableLen--) {
-        QString syllable = str.mid(startPos, syllableLen);
-
-        if (validSyllables.contains(syllable)) {
-            // 当前音节匹配成功，递归处理剩余部分
-            if (isPinyinSequenceHelper(str, startPos + syllableLen, validSyllables))
-                return true;
-        }
-    }
-
-    // 所有可能的分割方式都尝试失败
-    return false;
-}
-
 // This function is internal to this unit (static) and handles the core DConfig loading.
 static std::optional<QStringList> tryLoadStringListFromDConfigInternal(
         const QString &appId,
@@ -354,105 +282,23 @@ static QSet<QString> loadSemanticExtensionsFromDConfig(const QString &keyName)
 
 bool isPinyinSequence(const QString &input)
 {
-    if (input.isEmpty())
-        return false;
-
-    // 清洗输入：移除所有非字母字符，只保留字母用于拼音检验
-    QString cleanedInput = input;
-    cleanedInput.remove(QRegularExpression("[^a-zA-Z]"));
-
-    if (cleanedInput.isEmpty())
-        return false;
-
-    // 合法的拼音音节表（预先定义所有可能的拼音音节组合）
-    static const QSet<QString> validSyllables = {
-        // 单韵母音节 - 只有 a, o, e 可以单独成音节
-        "a", "o", "e", "ai", "ei", "ao", "ou", "an", "en", "ang", "eng", "er",
-        // b开头音节
-        "ba", "bo", "bi", "bu", "bai", "bei", "bao", "ban", "ben", "bin", "bie", "biao", "bian", "bing", "bang", "beng",
-        // p开头音节
-        "pa", "po", "pi", "pu", "pai", "pei", "pao", "pan", "pen", "pin", "pie", "piao", "pian", "ping", "pang", "peng",
-        // m开头音节
-        "ma", "mo", "me", "mi", "mu", "mai", "mei", "mao", "mou", "man", "men", "min", "mie", "miao", "miu", "mian", "min", "ming", "mang", "meng",
-        // f开头音节
-        "fa", "fo", "fu", "fei", "fan", "fen", "fang", "feng",
-        // d开头音节
-        "da", "de", "di", "du", "dai", "dao", "dou", "dan", "den", "dang", "deng", "ding", "dong", "die", "diao", "diu", "dian", "duan", "dun", "duo",
-        // t开头音节
-        "ta", "te", "ti", "tu", "tai", "tao", "tou", "tan", "tang", "teng", "ting", "tong", "tie", "tiao", "tian", "tuan", "tun", "tuo",
-        // n开头音节
-        "na", "ne", "ni", "nu", "nv", "nai", "nei", "nao", "nou", "nan", "nen", "nang", "neng", "ning", "nong", "nie", "niao", "niu", "nian", "niang", "nuan", "nve", "nuo", "nun",
-        // l开头音节
-        "la", "le", "li", "lu", "lv", "lai", "lei", "lao", "lou", "lan", "lang", "leng", "ling", "long", "lie", "liao", "liu", "lian", "liang", "luan", "lun", "luo", "lve",
-        // g开头音节
-        "ga", "ge", "gu", "gai", "gei", "gao", "gou", "gan", "gen", "gang", "geng", "gong", "gua", "guo", "guai", "gui", "guan", "gun", "guang",
-        // k开头音节
-        "ka", "ke", "ku", "kai", "kao", "kou", "kan", "ken", "kang", "keng", "kong", "kua", "kuo", "kuai", "kui", "kuan", "kun", "kuang",
-        // h开头音节
-        "ha", "he", "hu", "hai", "hei", "hao", "hou", "han", "hen", "hang", "heng", "hong", "hua", "huo", "huai", "hui", "huan", "hun", "huang",
-        // j开头音节
-        "ji", "ju", "jue", "jiu", "jie", "jia", "jin", "jing", "jiang", "jiong", "juan", "jun", "jian", "jiao",
-        // q开头音节
-        "qi", "qu", "que", "qiu", "qie", "qia", "qin", "qing", "qiang", "qiong", "quan", "qun", "qian", "qiao",
-        // x开头音节
-        "xi", "xu", "xue", "xiu", "xie", "xia", "xin", "xing", "xiang", "xiong", "xuan", "xun", "xian", "xiao",
-        // zh开头音节
-        "zha", "zhe", "zhi", "zhu", "zhai", "zhao", "zhou", "zhan", "zhen", "zhang", "zheng", "zhong", "zhua", "zhuo", "zhuai", "zhui", "zhuan", "zhun", "zhuang",
-        // ch开头音节
-        "cha", "che", "chi", "chu", "chai", "chao", "chou", "chan", "chen", "chang", "cheng", "chong", "chua", "chuo", "chuai", "chui", "chuan", "chun", "chuang",
-        // sh开头音节
-        "sha", "she", "shi", "shu", "shai", "shao", "shou", "shan", "shen", "shang", "sheng", "shua", "shuo", "shuai", "shui", "shuan", "shun", "shuang",
-        // r开头音节
-        "ra", "re", "ri", "ru", "rao", "rou", "ran", "ren", "rang", "reng", "rong", "rua", "ruo", "rui", "ruan", "run",
-        // z开头音节
-        "za", "ze", "zi", "zu", "zai", "zei", "zao", "zou", "zan", "zen", "zang", "zeng", "zong", "zuo", "zui", "zuan", "zun",
-        // c开头音节
-        "ca", "ce", "ci", "cu", "cai", "cao", "cou", "can", "cen", "cang", "ceng", "cong", "cuo", "cui", "cuan", "cun",
-        // s开头音节
-        "sa", "se", "si", "su", "sai", "sao", "sou", "san", "sen", "sang", "seng", "song", "suo", "sui", "suan", "sun",
-        // y开头音节 - 注意yi/you/yao等整体认读音节
-        "ya", "ye", "yi", "yo", "yu", "yue", "yao", "you", "yan", "yin", "yang", "ying", "yong", "yuan", "yun",
-        // w开头音节 - 注意wu/wei等整体认读音节
-        "wa", "wo", "wu", "wai", "wei", "wan", "wen", "wang", "weng"
-    };
-
-    // 特殊处理规则：单个字母'i', 'u', 'v', 'ü'不能单独成音节
-    if (cleanedInput.length() == 1) {
-        QChar ch = cleanedInput.toLower()[0];
-        if (ch == 'i' || ch == 'u' || ch == 'v' || ch == QChar(0x00FC))   // 0x00FC是ü的Unicode编码
-            return false;
-    }
-
-    // 特殊处理规则：检查重复字母如'vvv'
-    if (cleanedInput.length() >= 3) {
-        bool allSame = true;
-        QChar firstChar = cleanedInput.toLower()[0];
-        for (int i = 1; i < cleanedInput.length(); i++) {
-            if (cleanedInput.toLower()[i] != firstChar) {
-                allSame = false;
-                break;
-            }
-        }
-        if (allSame)
-            return false;
-    }
-
-    QString str = cleanedInput.toLower();
-    str.replace("ü", "v");   // 统一处理 ü
-
-    // 尝试所有可能的分割方式
-    return isPinyinSequenceHelper(str, 0, validSyllables);
+    // 每次文件名查询都会调用，使用编译期生成的音节字典树单遍切分
+    return PinyinSyllables::isSyllableSequence(input);
 }
 
 bool isPinyinAcronymSequence(const QString &input)
 {
-    if (input.isEmpty())
-        return false;
-
-    QString str = input.trimmed();
+    // 去除首尾空白，只计算边界，不复制字符串
+    const QChar *data = input.constData();
+    int begin = 0;
+    int end = input.size();
+    while (begin < end && data[begin].isSpace())
+        ++begin;
+    while (end > begin && data[end - 1].isSpace())
+        --end;
 
     // 长度检查
-    if (str.length() == 0 || str.length() > 255)
+    if (end == begin || end - begin > 255)
         return false;
 
     // 核心验证：
@@ -461,13 +307,24 @@ bool isPinyinAcronymSequence(const QString &input)
     // 3. 允许数字、符号等其他任意字符
 
     bool hasLetter = false;
-    for (const QChar &ch : str) {
+    for (int i = begin; i < end; ++i) {
+        const QChar ch = data[i];
+
+        // ASCII 字符不是中文，字母即拉丁字母，无需查询 Unicode 属性
+        const ushort code = ch.unicode();
+        if (code < 0x80) {
+            if ((code >= 'a' && code <= 'z') || (code >= 'A' && code <= 'Z'))
+                hasLetter = true;
+            continue;
+        }
+
         // 检查是否为中文（拼音缩写不应包含中文）
-        if (ch.script() == QChar::Script_Han)
+        const QChar::Script script = ch.script();
+        if (script == QChar::Script_Han)
             return false;
 
         // 检查是否为英文字母（拉丁字母）
-        if (ch.isLetter() && ch.script() == QChar::Script_Latin)
+        if (script == QChar::Script_Latin && ch.isLetter())
             hasLetter = true;
     }
 
@@ -582,77 +439,21 @@ QStringList defaultBlacklistPaths()
     return pathsFromDConfig;
 }
 
-/**
- * @brief Check if a path is within any of the specified directories.
- * @param path The path to check
- * @param dirs The directories to check against
- * @return true if the path is within any of the directories, false otherwise
- */
-static bool isPathInAnyDirectory(const QString &path, const QStringList &dirs)
-{
-    // Normalize the path once (it doesn't change during iteration)
-    QString normalizedPath = path;
-    if (normalizedPath.endsWith('/') && normalizedPath.length() > 1) {
-        normalizedPath.chop(1);
-    }
-
-    return std::any_of(dirs.cbegin(), dirs.cend(), [&normalizedPath](const QString &dir) {
-        QString normalizedDir = dir;
-
-        if (normalizedDir.endsWith('/') && normalizedDir.length() > 1) {
-            normalizedDir.chop(1);
-        }
-
-        // Exact match - the path is the indexed directory itself
-        if (normalizedPath == normalizedDir) {
-            return true;
-        }
-
-        // Check if path is within the directory by ensuring proper path separation
-        const QString dirWithSeparator = normalizedDir + '/';
-        return normalizedPath.startsWith(dirWithSeparator);
-    });
-}
-
 bool isPathInContentIndexDirectory(const QString &path)
 {
     if (!isContentIndexAvailable())
         return false;
 
-    static const QStringList kDirs = DFMSEARCH::Global::defaultIndexedDirectory();
-    return isPathInAnyDirectory(path, kDirs);
+    // 索引目录在进程内不变，只编译一次
+    static const PathMatcher kDirs(DFMSEARCH::Global::defaultIndexedDirectory());
+    return kDirs.matches(path);
 }
 
 bool isContentIndexAvailable()
 {
-    const QString &dir = contentIndexDirectory();
-    if (!IndexReader::indexExists(FSDirectory::open(dir.toStdWString())))
-        return false;
-
-    const QString &statusFile = dir + "/index_status.json";
-
-    // 1. 尝试打开文件
-    QFile file(statusFile);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return false;   // 文件无法打开
-    }
-
-    // 2. 读取并解析 JSON
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    file.close();
-
-    if (doc.isNull() || !doc.isObject()) {
-        return false;   // JSON 格式无效
-    }
-
-    // 3. 检查 lastUpdateTime 字段
-    QJsonObject obj = doc.object();
-    if (!obj.contains("lastUpdateTime")) {
-        return false;   // 字段不存在
-    }
-
-    const QString lastUpdateTime = obj["lastUpdateTime"].toString();
-    return !lastUpdateTime.isEmpty();   // 字段值非空则为有效
+    // 索引存在且状态文件中 lastUpdateTime 非空则为有效
+    const IndexState state = IndexStateWatcher::instance()->state(IndexStateWatcher::Index::Content);
+    return state.exists && !state.lastUpdateTime.isEmpty();
 }
 
 QString contentIndexDirectory()
@@ -677,40 +478,16 @@ bool isPathInOcrTextIndexDirectory(const QString &path)
     if (!isOcrTextIndexAvailable())
         return false;
 
-    static const QStringList kDirs = DFMSEARCH::Global::defaultIndexedDirectory();
-    return isPathInAnyDirectory(path, kDirs);
+    // 索引目录在进程内不变，只编译一次
+    static const PathMatcher kDirs(DFMSEARCH::Global::defaultIndexedDirectory());
+    return kDirs.matches(path);
 }
 
 bool isOcrTextIndexAvailable()
 {
-    const QString &dir = ocrTextIndexDirectory();
-    if (!IndexReader::indexExists(FSDirectory::open(dir.toStdWString())))
-        return false;
-
-    const QString &statusFile = dir + "/index_status.json";
-
-    // 1. 尝试打开文件
-    QFile file(statusFile);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return false;   // 文件无法打开
-    }
-
-    // 2. 读取并解析 JSON
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-    file.close();
-
-    if (doc.isNull() || !doc.isObject()) {
-        return false;   // JSON 格式无效
-    }
-
-    // 3. 检查 lastUpdateTime 字段
-    QJsonObject obj = doc.object();
-    if (!obj.contains("lastUpdateTime")) {
-        return false;   // 字段不存在
-    }
-
-    const QString lastUpdateTime = obj["lastUpdateTime"].toString();
-    return !lastUpdateTime.isEmpty();   // 字段值非空则为有效
+    // 索引存在且状态文件中 lastUpdateTime 非空则为有效
+    const IndexState state = IndexStateWatcher::instance()->state(IndexStateWatcher::Index::OcrText);
+    return state.exists && !state.lastUpdateTime.isEmpty();
 }
 
 bool isPathInFileNameIndexDirectory(const QString &path)
@@ -718,24 +495,17 @@ bool isPathInFileNameIndexDirectory(const QString &path)
     if (!isFileNameIndexDirectoryAvailable())
         return false;
 
-    static const QStringList kBlackPaths = defaultBlacklistPaths();
-    if (BlacklistMatcher::isPathBlacklisted(path, kBlackPaths))
+    static const PathMatcher kBlacklist = PathMatcher::fromBlacklist(defaultBlacklistPaths());
+    if (kBlacklist.matches(path.trimmed()))
         return false;
 
-    static const QStringList kIndexedDirs = DFMSEARCH::Global::defaultIndexedDirectory();
-    return isPathInAnyDirectory(path, kIndexedDirs);
+    static const PathMatcher kIndexedDirs(DFMSEARCH::Global::defaultIndexedDirectory());
+    return kIndexedDirs.matches(path);
 }
 
 bool isFileNameIndexDirectoryAvailable()
 {
-    try {
-        const QString &indexDir = fileNameIndexDirectory();
-        bool exists = IndexReader::indexExists(FSDirectory::open(indexDir.toStdWString()));
-        return exists;
-    } catch (const LuceneException &e) {
-        qWarning() << "Failed to check index existence:" << QString::fromStdWString(e.getError());
-        return false;
-    }
+    return IndexStateWatcher::instance()->state(IndexStateWatcher::Index::FileName).exists;
 }
 
 bool isFileNameIndexReadyForSearch()
@@ -766,49 +536,19 @@ bool isFileNameIndexReadyForSearch()
 
 std::optional<QString> fileNameIndexStatus()
 {
-    if (!isFileNameIndexDirectoryAvailable()) {
+    const IndexState state = IndexStateWatcher::instance()->state(IndexStateWatcher::Index::FileName);
+    if (!state.exists) {
         qWarning() << "Index directory not available";
         return std::nullopt;
     }
 
-    const QString &statusFilePath = QDir(fileNameIndexDirectory()).filePath("status.json");
-    QFile statusFile(statusFilePath);
-
-    // 检查文件是否存在和可读
-    if (!statusFile.exists()) {
-        qWarning() << "Status file does not exist:" << statusFilePath;
-        return std::nullopt;
-    }
-    if (!statusFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open status file:" << statusFile.errorString();
-        return std::nullopt;
-    }
-
-    // 读取和解析JSON
-    QJsonParseError jsonError;
-    const QJsonDocument doc = QJsonDocument::fromJson(statusFile.readAll(), &jsonError);
-    statusFile.close();
-
-    if (jsonError.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error:" << jsonError.errorString()
-                   << "at offset:" << jsonError.offset;
-        return std::nullopt;
-    }
-
-    // 检查JSON结构
-    if (!doc.isObject()) {
-        qWarning() << "Invalid JSON format: root is not an object";
-        return std::nullopt;
-    }
-
-    const QJsonObject root = doc.object();
-    if (!root.contains("status") || !root["status"].isString()) {
-        qWarning() << "Missing or invalid 'status' field";
+    if (!state.status) {
+        qWarning() << "Missing or invalid 'status' field in" << QDir(fileNameIndexDirectory()).filePath("status.json");
         return std::nullopt;
     }
 
-    // 返回小写状态
-    return root["status"].toString().toLower();
+    // 小写状态
+    return state.status;
 }
 
 QString fileNameIndexDirectory()
@@ -818,17 +558,17 @@ QString fileNameIndexDirectory()
 
 int fileNameIndexVersion()
 {
-    return readIndexVersion(fileNameIndexDirectory(), "status.json");
+    return IndexStateWatcher::instance()->state(IndexStateWatcher::Index::FileName).version;
 }
 
 int contentIndexVersion()
 {
-    return readIndexVersion(contentIndexDirectory(), "index_status.json");
+    return IndexStateWatcher::instance()->state(IndexStateWatcher::Index::Content).version;
 }
 
 int ocrTextIndexVersion()
 {
-    return readIndexVersion(ocrTextIndexDirectory(), "index_status.json");
+    return IndexStateWatcher::instance()->state(IndexStateWatcher::Index::OcrText).version;
 }
 
 }   //  namespace Global
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "sortedhitqueue.h"
+
+#include <algorithm>
+
+#include <QChar>
+#include <QDebug>
+
+#include <lucene++/FieldCache.h>
+
+#include <dfm-search/field_names.h>
+
+using namespace Lucene;
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+// 字段的每个词项都解析为 1，缺少该字段的文档保持 0。
+// 字段缓存按解析器区分缓存项，因此使用同一个实例
+class FieldPresenceParser : public ByteParser
+{
+public:
+    uint8_t parseByte(const String &) override { return 1; }
+};
+
+ByteParserPtr fieldPresenceParser()
+{
+    static const ByteParserPtr parser = newLucene<FieldPresenceParser>();
+    return parser;
+}
+
+}   // namespace
+
+SortedHitQueue::Fields SortedHitQueue::fileNameIndexFields()
+{
+    return { LuceneFieldNames::FileName::kModifyTime, LuceneFieldNames::FileName::kBirthTime,
+             LuceneFieldNames::FileName::kFileSize, LuceneFieldNames::FileName::kFullPath };
+}
+
+SortedHitQueue::Fields SortedHitQueue::contentIndexFields()
+{
+    return { LuceneFieldNames::Content::kModifyTime, LuceneFieldNames::Content::kBirthTime,
+             LuceneFieldNames::Content::kFileSize, LuceneFieldNames::Content::kPath };
+}
+
+SortedHitQueue::Fields SortedHitQueue::ocrTextIndexFields()
+{
+    return { LuceneFieldNames::OcrText::kModifyTime, LuceneFieldNames::OcrText::kBirthTime,
+             LuceneFieldNames::OcrText::kFileSize, LuceneFieldNames::OcrText::kPath };
+}
+
+SortedHitQueue::SortedHitQueue(ResultSortKey key, Qt::SortOrder order, int32_t capacity, const Fields &fields)
+    : m_key(key), m_order(order), m_capacity(std::max(0, capacity))
+{
+    switch (key) {
+    case ResultSortKey::ModifyTime:
+        m_field = fields.modifyTime;
+        break;
+    case ResultSortKey::BirthTime:
+        m_field = fields.birthTime;
+        break;
+    case ResultSortKey::FileSize:
+        m_field = fields.fileSize;
+        break;
+    case ResultSortKey::FileName:
+    case ResultSortKey::None:
+        m_field = fields.path;
+        break;
+    }
+
+    // 命中数通常远多于 K，一次预留到位
+    m_heap.reserve(static_cast<size_t>(std::min(m_capacity, 4096)));
+}
+
+void SortedHitQueue::setNextReader(const IndexReaderPtr &reader, int32_t docBase)
+{
+    Segment segment;
+    segment.docBase = docBase;
+
+    FieldCachePtr cache = FieldCache::DEFAULT();
+    try {
+        if (m_key == ResultSortKey::FileName) {
+            segment.paths = cache->getStrings(reader, m_field);
+        } else {
+            segment.values = cache->getLongs(reader, m_field, FieldCache::NUMERIC_UTILS_LONG_PARSER());
+            segment.hasValue = cache->getBytes(reader, m_field, fieldPresenceParser());
+        }
+    } catch (const LuceneException &e) {
+        // 旧索引中字段不是期望的格式时，该段的文档都视为缺少排序键
+        qWarning() << "Failed to load sort field cache:" << QString::fromStdWString(m_field)
+                   << QString::fromStdWString(e.getError());
+    }
+
+    m_segments.push_back(std::move(segment));
+}
+
+void SortedHitQueue::offer(int32_t doc)
+{
+    if (m_capacity == 0 || m_segments.empty())
+        return;
+
+    push(makeEntry(static_cast<int32_t>(m_segments.size()) - 1, doc));
+}
+
+void SortedHitQueue::merge(const SortedHitQueue &other)
+{
+    const int32_t segmentOffset = static_cast<int32_t>(m_segments.size());
+    m_segments.insert(m_segments.end(), other.m_segments.begin(), other.m_segments.end());
+
+    // 名称指针指向字段缓存中的字符串，段的列数组一并复制后仍然有效
+    for (Entry entry : other.m_heap) {
+        entry.segment += segmentOffset;
+        push(entry);
+    }
+}
+
+std::vector<SortedHitQueue::Hit> SortedHitQueue::sortedHits() const
+{
+    const std::vector<Entry> entries = sortedEntries();
+    std::vector<Hit> hits;
+    hits.reserve(entries.size());
+    for (const Entry &entry : entries)
+        hits.push_back({ entry.segment, entry.doc });
+    return hits;
+}
+
+Collection<ScoreDocPtr> SortedHitQueue::sortedScoreDocs() const
+{
+    // 结果按排序键输出，不再按评分排序，因此不计算评分
+    Collection<ScoreDocPtr> scoreDocs = Collection<ScoreDocPtr>::newInstance();
+    for (const Entry &entry : sortedEntries())
+        scoreDocs.add(newLucene<ScoreDoc>(entry.globalDoc, 0.0));
+    return scoreDocs;
+}
+
+SortedHitQueue::Entry SortedHitQueue::makeEntry(int32_t segment, int32_t doc) const
+{
+    const Segment &seg = m_segments[static_cast<size_t>(segment)];
+
+    Entry entry;
+    entry.segment = segment;
+    entry.doc = doc;
+    entry.globalDoc = seg.docBase + doc;
+
+    if (m_key == ResultSortKey::FileName) {
+        if (seg.paths) {
+            const String &path = seg.paths[doc];
+            const String::size_type slash = path.rfind(L'/');
+            const String::size_type start = slash == String::npos ? 0 : slash + 1;
+            entry.name = path.data() + start;
+            entry.nameLength = static_cast<int32_t>(path.size() - start);
+            entry.hasKey = entry.nameLength > 0;
+        }
+    } else if (seg.values && seg.hasValue && seg.hasValue[doc] != 0) {
+        entry.value = seg.values[doc];
+        entry.hasKey = true;
+    }
+    return entry;
+}
+
+void SortedHitQueue::push(const Entry &entry)
+{
+    const auto comp = [this](const Entry &a, const Entry &b) { return precedes(a, b); };
+
+    if (static_cast<int32_t>(m_heap.size()) < m_capacity) {
+        m_heap.push_back(entry);
+        std::push_heap(m_heap.begin(), m_heap.end(), comp);
+        return;
+    }
+
+    // 不优于当前最后一名的命中直接丢弃，绝大多数命中在这里返回
+    if (m_heap.empty() || !precedes(entry, m_heap.front()))
+        return;
+
+    std::pop_heap(m_heap.begin(), m_heap.end(), comp);
+    m_heap.back() = entry;
+    std::push_heap(m_heap.begin(), m_heap.end(), comp);
+}
+
+bool SortedHitQueue::precedes(const Entry &a, const Entry &b) const
+{
+    if (a.hasKey != b.hasKey)
+        return a.hasKey;
+
+    int result = a.hasKey ? compareKeys(a, b) : 0;
+    if (m_order == Qt::DescendingOrder)
+        result = -result;
+    if (result != 0)
+        return result < 0;
+    return a.globalDoc < b.globalDoc;
+}
+
+int SortedHitQueue::compareKeys(const Entry &a, const Entry &b) const
+{
+    if (m_key != ResultSortKey::FileName)
+        return a.value < b.value ? -1 : (a.value > b.value ? 1 : 0);
+
+    const int32_t length = std::min(a.nameLength, b.nameLength);
+    for (int32_t i = 0; i < length; ++i) {
+        const uint ca = static_cast<uint>(a.name[i]);
+        const uint cb = static_cast<uint>(b.name[i]);
+        if (ca == cb)
+            continue;
+        const uint fa = QChar::toCaseFolded(ca);
+        const uint fb = QChar::toCaseFolded(cb);
+        if (fa != fb)
+            return fa < fb ? -1 : 1;
+    }
+    if (a.nameLength != b.nameLength)
+        return a.nameLength < b.nameLength ? -1 : 1;
+
+    // 仅大小写不同的名称按原始字符排列，保证顺序确定
+    for (int32_t i = 0; i < length; ++i) {
+        if (a.name[i] != b.name[i])
+            return a.name[i] < b.name[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+std::vector<SortedHitQueue::Entry> SortedHitQueue::sortedEntries() const
+{
+    std::vector<Entry> entries = m_heap;
+    std::sort(entries.begin(), entries.end(),
+              [this](const Entry &a, const Entry &b) { return precedes(a, b); });
+    return entries;
+}
+
+DFM_SEARCH_END_NS
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef SORTEDHITQUEUE_H
+#define SORTEDHITQUEUE_H
+
+#include <vector>
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <dfm-search/dsearch_global.h>
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 按排序键保留前 K 个命中的有界堆
+ *
+ * 供收集器在遍历命中时使用：堆顶是当前保留的最差命中，新命中优于堆顶时
+ * 替换，否则直接丢弃。整次搜索只遍历一遍，内存为 O(K)，结果与先收集全部
+ * 命中再排序取前 K 个完全相同。
+ *
+ * 排序键从字段缓存读取，每个段在 setNextReader() 时只取一次列数组：
+ * - 修改时间、创建时间、大小：NumericField 编码的 long 列，与
+ *   TimeRangeUtils::buildNumericRangeQuery 依赖的字段相同。long 列对缺少
+ *   字段的文档填 0，另取一列同样缓存的标记区分缺少字段的文档
+ * - 名称：路径列（NOT_ANALYZED）的末段，逐字符按大小写折叠比较，
+ *   不复制字符串
+ *
+ * 键相同时按全局文档号排列，即与不排序时的收集顺序一致。
+ * 缺少排序字段的文档无论升降序都排在最后。
+ */
+class SortedHitQueue
+{
+public:
+    // 索引中排序键所在的字段
+    struct Fields
+    {
+        Lucene::String modifyTime;
+        Lucene::String birthTime;
+        Lucene::String fileSize;
+        Lucene::String path;
+    };
+
+    static Fields fileNameIndexFields();
+    static Fields contentIndexFields();
+    static Fields ocrTextIndexFields();
+
+    struct Hit
+    {
+        int32_t segment;   // setNextReader() 的调用序号
+        int32_t doc;   // 段内文档号
+    };
+
+    /**
+     * @param key      排序键，不能为 ResultSortKey::None
+     * @param order    排序方向
+     * @param capacity 保留的命中数，<= 0 时不保留任何命中
+     * @param fields   排序键所在的字段
+     */
+    SortedHitQueue(ResultSortKey key, Qt::SortOrder order, int32_t capacity, const Fields &fields);
+
+    /**
+     * @brief 开始一个新段，之后 offer() 的文档号属于该段
+     */
+    void setNextReader(const Lucene::IndexReaderPtr &reader, int32_t docBase);
+
+    /**
+     * @brief 提交当前段内的一个命中
+     */
+    void offer(int32_t doc);
+
+    /**
+     * @brief 合并另一个队列保留的命中，用于按段并行收集后汇总
+     *
+     * 两个队列的排序键与方向必须相同；other 的段追加在本队列的段之后。
+     */
+    void merge(const SortedHitQueue &other);
+
+    int32_t size() const { return static_cast<int32_t>(m_heap.size()); }
+
+    /**
+     * @brief 保留的命中，按排序结果从前到后
+     */
+    std::vector<Hit> sortedHits() const;
+
+    /**
+     * @brief 保留的命中，按排序结果从前到后，文档号为全局文档号
+     */
+    Lucene::Collection<Lucene::ScoreDocPtr> sortedScoreDocs() const;
+
+private:
+    struct Segment
+    {
+        int32_t docBase = 0;
+        Lucene::Collection<int64_t> values;   // 数值排序键
+        Lucene::Collection<uint8_t> hasValue;   // 非 0 表示文档有数值排序键
+        Lucene::Collection<Lucene::String> paths;   // 名称排序键
+    };
+
+    struct Entry
+    {
+        int64_t value = 0;
+        const wchar_t *name = nullptr;   // 指向字段缓存中的路径末段
+        int32_t nameLength = 0;
+        bool hasKey = false;
+        int32_t segment = 0;
+        int32_t doc = 0;
+        int32_t globalDoc = 0;
+    };
+
+    Entry makeEntry(int32_t segment, int32_t doc) const;
+    void push(const Entry &entry);
+    bool precedes(const Entry &a, const Entry &b) const;
+    int compareKeys(const Entry &a, const Entry &b) const;
+    std::vector<Entry> sortedEntries() const;
+
+    ResultSortKey m_key;
+    Qt::SortOrder m_order;
+    int32_t m_capacity;
+    Lucene::String m_field;   // 当前排序键读取的字段
+
+    std::vector<Segment> m_segments;
+    std::vector<Entry> m_heap;   // 堆顶为保留命中中排序最靠后的一个
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // SORTEDHITQUEUE_H
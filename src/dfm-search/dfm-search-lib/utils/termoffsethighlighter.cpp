@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "termoffsethighlighter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QDebug>
+#include <QVector>
+
+#include <lucene++/TermPositionVector.h>
+#include <lucene++/TermVectorOffsetInfo.h>
+
+using namespace Lucene;
+
+DFM_SEARCH_BEGIN_NS
+
+namespace {
+
+// 窗口在定位区间两侧额外保留的字符数，使换行和段落开头的判断与全文扫描一致
+constexpr int kWindowMargin = 64;
+
+// wchar_t 为 UTF-32 时，BMP 之外的字符在 QString 中占两个单位
+int utf16Length(const wchar_t *text, size_t length)
+{
+    int count = static_cast<int>(length);
+    if (sizeof(wchar_t) == 4) {
+        for (size_t i = 0; i < length; ++i) {
+            if (static_cast<uint>(text[i]) > 0xFFFF)
+                ++count;
+        }
+    }
+    return count;
+}
+
+bool matchesAt(const String &content, int32_t offset, const QVector<uint> &folded)
+{
+    if (offset < 0 || static_cast<size_t>(offset) + static_cast<size_t>(folded.size()) > content.size())
+        return false;
+
+    for (int i = 0; i < folded.size(); ++i) {
+        if (QChar::toCaseFolded(static_cast<uint>(content[static_cast<size_t>(offset + i)])) != folded[i])
+            return false;
+    }
+    return true;
+}
+
+// 索引未必做过小写化，按首个 n-gram 中每个字符的大小写组合生成候选词
+std::vector<String> headTerms(const QVector<uint> &ucs4)
+{
+    const int length = std::min(2, static_cast<int>(ucs4.size()));
+    std::vector<String> terms;
+    for (int mask = 0; mask < (1 << length); ++mask) {
+        String term;
+        for (int i = 0; i < length; ++i) {
+            const uint ch = (mask & (1 << i)) ? QChar::toUpper(ucs4[i]) : QChar::toLower(ucs4[i]);
+            term.push_back(static_cast<wchar_t>(ch));
+        }
+        if (std::find(terms.begin(), terms.end(), term) == terms.end())
+            terms.push_back(term);
+    }
+    return terms;
+}
+
+// 通配符关键词没有固定的首个 n-gram，交给全文扫描
+bool hasWildcard(const QStringList &keywords)
+{
+    for (const QString &keyword : keywords) {
+        if (keyword.contains(QLatin1Char('*')) || keyword.contains(QLatin1Char('?')))
+            return true;
+    }
+    return false;
+}
+
+}   // namespace
+
+TermOffsetHighlighter::TermOffsetHighlighter(const IndexReaderPtr &reader, int32_t docId,
+                                             const String &field, const String &content)
+    : m_content(content)
+{
+    if (!reader || content.empty())
+        return;
+
+    try {
+        m_vector = boost::dynamic_pointer_cast<TermPositionVector>(reader->getTermFreqVector(docId, field));
+    } catch (const LuceneException &e) {
+        qWarning() << "Failed to load term vector:" << QString::fromStdWString(e.getError());
+        m_vector.reset();
+    }
+}
+
+bool TermOffsetHighlighter::isAvailable() const
+{
+    return m_vector != nullptr;
+}
+
+std::optional<QString> TermOffsetHighlighter::customHighlight(const QStringList &keywords, int maxLength,
+                                                              bool enableHtml, int positioningMaxLength) const
+{
+    if (!m_vector || hasWildcard(keywords))
+        return std::nullopt;
+
+    // 与全文扫描一致：取列表中第一个在文中出现的关键词的首次出现位置
+    for (const QString &keyword : keywords) {
+        if (keyword.isEmpty())
+            continue;
+
+        int length = 0;
+        bool indexed = false;
+        const int position = findKeyword(keyword, &length, &indexed);
+        // 词向量中没有该关键词的首个 n-gram 时不能断定它不在文中，不能跳到下一个关键词
+        if (!indexed)
+            return std::nullopt;
+        if (position < 0)
+            continue;
+
+        const Window window = decodeWindow(position, length, maxLength, positioningMaxLength);
+        return ContentHighlighter::customHighlight(keywords, window.text, maxLength, enableHtml, positioningMaxLength);
+    }
+
+    // 没有任何关键词的偏移能通过校验，可能是索引的分词方式不同，交给全文扫描判断
+    return std::nullopt;
+}
+
+std::optional<ContentHighlighter::PlainSnippetResult> TermOffsetHighlighter::plainSnippet(const QStringList &keywords, int maxLength,
+                                                                                          int positioningMaxLength) const
+{
+    if (!m_vector || hasWildcard(keywords))
+        return std::nullopt;
+
+    // 与全文扫描一致：取所有关键词中最早出现的位置
+    int earliest = -1;
+    int earliestLength = 0;
+    for (const QString &keyword : keywords) {
+        if (keyword.isEmpty())
+            continue;
+
+        int length = 0;
+        bool indexed = false;
+        const int position = findKeyword(keyword, &length, &indexed);
+        // 无法判断的关键词可能出现在更早的位置
+        if (!indexed)
+            return std::nullopt;
+        if (position >= 0 && (earliest < 0 || position < earliest)) {
+            earliest = position;
+            earliestLength = length;
+        }
+    }
+
+    if (earliest < 0)
+        return std::nullopt;
+
+    const Window window = decodeWindow(earliest, earliestLength, maxLength, positioningMaxLength);
+    ContentHighlighter::PlainSnippetResult result = ContentHighlighter::plainSnippet(
+            keywords, window.text, maxLength, positioningMaxLength);
+    if (result.snippetOffset >= 0)
+        result.snippetOffset += window.offset;
+    return result;
+}
+
+int TermOffsetHighlighter::charCount() const
+{
+    return utf16Length(m_content.data(), m_content.size());
+}
+
+int TermOffsetHighlighter::findKeyword(const QString &keyword, int *length, bool *indexed) const
+{
+    const QVector<uint> ucs4 = keyword.toUcs4();
+    QVector<uint> folded;
+    folded.reserve(ucs4.size());
+    for (uint ch : ucs4)
+        folded.append(QChar::toCaseFolded(ch));
+
+    // 与 LuceneQueryUtils::buildNGramSearchQuery 一致：索引中的词为 1-gram 和 2-gram，
+    // 关键词首个 n-gram 的偏移只作为候选位置，逐个在存储文本上校验完整关键词
+    int best = -1;
+    *indexed = false;
+    for (const String &term : headTerms(ucs4)) {
+        const int32_t termIndex = m_vector->indexOf(term);
+        if (termIndex < 0)
+            continue;
+        *indexed = true;
+
+        const Collection<TermVectorOffsetInfoPtr> offsets = m_vector->getOffsets(termIndex);
+        if (!offsets)
+            continue;
+
+        for (int32_t i = 0; i < offsets.size(); ++i) {
+            const int32_t start = offsets[i]->getStartOffset();
+            if ((best < 0 || start < best) && matchesAt(m_content, start, folded))
+                best = start;
+        }
+    }
+
+    *length = static_cast<int>(folded.size());
+    return best;
+}
+
+TermOffsetHighlighter::Window TermOffsetHighlighter::decodeWindow(int position, int length, int maxLength,
+                                                                  int positioningMaxLength) const
+{
+    const size_t reach = static_cast<size_t>(qMax(30, positioningMaxLength) + kWindowMargin);
+    const size_t matchStart = static_cast<size_t>(position);
+    const size_t start = matchStart > reach ? matchStart - reach : 0;
+    const size_t end = maxLength > 0
+            ? qMin(m_content.size(), matchStart + static_cast<size_t>(length + maxLength) + reach)
+            : m_content.size();
+
+    Window window;
+    window.text = QString::fromWCharArray(m_content.data() + start, static_cast<int>(end - start));
+    window.offset = utf16Length(m_content.data(), start);
+    return window;
+}
+
+DFM_SEARCH_END_NS
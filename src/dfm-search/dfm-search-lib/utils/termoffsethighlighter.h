@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef TERMOFFSETHIGHLIGHTER_H
+#define TERMOFFSETHIGHLIGHTER_H
+
+#include <optional>
+
+#include <QString>
+#include <QStringList>
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <dfm-search/dsearch_global.h>
+
+#include "contenthighlighter.h"
+
+DFM_SEARCH_BEGIN_NS
+
+/**
+ * @brief 基于索引中存储的词偏移生成高亮片段
+ *
+ * ContentHighlighter 需要把整篇存储文本转换为 QString，并对每个关键词做一次
+ * 大小写无关的全文扫描。索引为全文字段存储了带偏移的词向量时，可以由关键词
+ * 首个 n-gram 的偏移直接得到候选位置，在存储文本上逐个校验后只解码命中附近的
+ * 一小段窗口，再交给 ContentHighlighter 生成与全文扫描相同的片段。
+ *
+ * 文档没有词向量或偏移、关键词首个 n-gram 不在词向量中、或偏移与存储文本
+ * 对不上时各方法返回 std::nullopt，调用方应回退到 ContentHighlighter 的全文扫描。
+ */
+class TermOffsetHighlighter
+{
+public:
+    /**
+     * @param reader  文档所在的索引读取器
+     * @param docId   文档在 reader 中的编号
+     * @param field   全文字段名，需使用 NGramAnalyzer(1, 2) 建立索引
+     * @param content 该字段的存储文本，生命周期需长于本对象
+     */
+    TermOffsetHighlighter(const Lucene::IndexReaderPtr &reader, int32_t docId,
+                          const Lucene::String &field, const Lucene::String &content);
+
+    /**
+     * @brief 文档是否存储了带偏移的词向量
+     */
+    bool isAvailable() const;
+
+    /**
+     * @brief 与 ContentHighlighter::customHighlight 结果相同
+     */
+    std::optional<QString> customHighlight(const QStringList &keywords, int maxLength,
+                                           bool enableHtml, int positioningMaxLength = 30) const;
+
+    /**
+     * @brief 与 ContentHighlighter::plainSnippet 结果相同，snippetOffset 为全文中的位置
+     */
+    std::optional<ContentHighlighter::PlainSnippetResult> plainSnippet(const QStringList &keywords, int maxLength,
+                                                                       int positioningMaxLength = 30) const;
+
+    /**
+     * @brief 全文长度，与 QString 的长度单位一致
+     */
+    int charCount() const;
+
+private:
+    struct Window
+    {
+        QString text;
+        int offset = 0;   ///< 窗口在全文中的起始位置（QString 单位）
+    };
+
+    // 返回关键词在全文中的最早位置，不存在时返回 -1；
+    // 关键词首个 n-gram 的各种大小写形式都不在词向量中时 indexed 为 false，此时无法判断
+    int findKeyword(const QString &keyword, int *length, bool *indexed) const;
+    Window decodeWindow(int position, int length, int maxLength, int positioningMaxLength) const;
+
+    Lucene::TermPositionVectorPtr m_vector;
+    const Lucene::String &m_content;
+};
+
+DFM_SEARCH_END_NS
+
+#endif   // TERMOFFSETHIGHLIGHTER_H